@@ -181,7 +181,7 @@ class Archive {
 
   const std::string url_part(const int i) { return url_parts[i]; }
 
-  std::string entryName() { return std::string(archive_entry_pathname(entry)); }
+  virtual std::string entryName() { return std::string(archive_entry_pathname(entry)); }
 
  protected:
   std::string url;
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Archive/ParallelGzipDecoder.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Size of the compressed chunks handed to decompression tasks
+constexpr size_t kChunkSize = 8 * 1024 * 1024;
+
+// Upper bound on the compressed data read ahead of the consumer, which limits the
+// memory held by decompressed chunks waiting to be consumed regardless of thread count
+constexpr size_t kMaxInFlightBytes = 64 * 1024 * 1024;
+
+// Fixed gzip header fields followed by XLEN
+constexpr size_t kMemberHeaderSize = 12;
+
+/**
+ * Returns the total size of the BGZF member starting at data, 0 if the member header is
+ * incomplete. Throws if data does not start with a BGZF member.
+ */
+size_t get_bgzf_member_size(const unsigned char* data,
+                            const size_t size,
+                            const std::string& file_path) {
+  if (size < kMemberHeaderSize) {
+    return 0;
+  }
+  // ID1, ID2, CM (deflate) and FLG with FEXTRA set
+  if (data[0] != 0x1f || data[1] != 0x8b || data[2] != 8 || !(data[3] & 4)) {
+    throw std::runtime_error("Invalid BGZF member in file: " + file_path);
+  }
+  const size_t extra_length = data[10] | (data[11] << 8);
+  if (size < kMemberHeaderSize + extra_length) {
+    return 0;
+  }
+  const auto extra = data + kMemberHeaderSize;
+  for (size_t pos = 0; pos + 4 <= extra_length;) {
+    const size_t subfield_length = extra[pos + 2] | (extra[pos + 3] << 8);
+    if (extra[pos] == 'B' && extra[pos + 1] == 'C' && subfield_length == 2 &&
+        pos + 6 <= extra_length) {
+      return (extra[pos + 4] | (extra[pos + 5] << 8)) + 1;
+    }
+    pos += 4 + subfield_length;
+  }
+  throw std::runtime_error("Missing BGZF block size in file: " + file_path);
+}
+
+// Inflates a sequence of complete gzip members.
+std::vector<char> inflate_members(const std::vector<char>& compressed,
+                                  const std::string& file_path) {
+  std::vector<char> decompressed;
+  z_stream stream{};
+  if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+    throw std::runtime_error("Unable to initialize decompression of file: " + file_path);
+  }
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+  stream.avail_in = compressed.size();
+  // BGZF members hold up to 64KB each and usually compress to a third or less
+  decompressed.resize(compressed.size() * 4);
+  size_t output_size = 0;
+  while (stream.avail_in > 0) {
+    if (output_size == decompressed.size()) {
+      decompressed.resize(decompressed.size() * 2);
+    }
+    stream.next_out = reinterpret_cast<Bytef*>(decompressed.data() + output_size);
+    stream.avail_out = decompressed.size() - output_size;
+    const auto result = inflate(&stream, Z_NO_FLUSH);
+    output_size = decompressed.size() - stream.avail_out;
+    if (result == Z_STREAM_END) {
+      inflateReset(&stream);
+    } else if (result != Z_OK && !(result == Z_BUF_ERROR && stream.avail_out == 0)) {
+      inflateEnd(&stream);
+      throw std::runtime_error("Error decompressing file " + file_path + ": " +
+                               (stream.msg ? stream.msg : std::to_string(result)));
+    }
+  }
+  inflateEnd(&stream);
+  decompressed.resize(output_size);
+  return decompressed;
+}
+
+}  // namespace
+
+ParallelGzipDecoder::ParallelGzipDecoder(const std::string& file_path,
+                                         const size_t thread_count)
+    : file_path_(file_path)
+    , file_(nullptr)
+    , max_pending_chunks_(
+          std::clamp<size_t>(thread_count, 1, kMaxInFlightBytes / kChunkSize))
+    , end_of_file_(false)
+    , compressed_position_(0) {
+  if (nullptr == (file_ = fopen(file_path.c_str(), "rb"))) {
+    throw std::runtime_error(std::string("fopen(") + file_path + "): " + strerror(errno));
+  }
+}
+
+ParallelGzipDecoder::~ParallelGzipDecoder() {
+  for (auto& [compressed_size, chunk] : pending_chunks_) {
+    if (chunk.valid()) {
+      chunk.wait();
+    }
+  }
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+bool ParallelGzipDecoder::isBgzfFile(const std::string& file_path) {
+  FILE* file = fopen(file_path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+  unsigned char header[kMemberHeaderSize + 256];
+  const auto size = fread(header, 1, sizeof(header), file);
+  fclose(file);
+  try {
+    return get_bgzf_member_size(header, size, file_path) > 0;
+  } catch (const std::runtime_error&) {
+    return false;
+  }
+}
+
+bool ParallelGzipDecoder::scheduleChunk() {
+  if (end_of_file_) {
+    return false;
+  }
+  std::vector<char> chunk(std::move(partial_member_));
+  const auto carried_size = chunk.size();
+  chunk.resize(carried_size + kChunkSize);
+  const auto bytes_read = fread(chunk.data() + carried_size, 1, kChunkSize, file_);
+  if (bytes_read < kChunkSize) {
+    if (ferror(file_)) {
+      throw std::runtime_error("Error reading file " + file_path_ + ": " +
+                               strerror(errno));
+    }
+    end_of_file_ = true;
+  }
+  chunk.resize(carried_size + bytes_read);
+
+  // Cut the chunk after its last complete member
+  const auto data = reinterpret_cast<const unsigned char*>(chunk.data());
+  size_t members_size = 0;
+  while (members_size < chunk.size()) {
+    const auto member_size =
+        get_bgzf_member_size(data + members_size, chunk.size() - members_size, file_path_);
+    if (member_size == 0 || members_size + member_size > chunk.size()) {
+      break;
+    }
+    members_size += member_size;
+  }
+  if (members_size < chunk.size()) {
+    if (end_of_file_) {
+      throw std::runtime_error("Truncated BGZF member at the end of file: " + file_path_);
+    }
+    partial_member_.assign(chunk.begin() + members_size, chunk.end());
+    chunk.resize(members_size);
+  }
+  if (chunk.empty()) {
+    return !end_of_file_;
+  }
+  const auto compressed_size = chunk.size();
+  pending_chunks_.emplace_back(
+      compressed_size,
+      std::async(std::launch::async,
+                 [compressed = std::move(chunk), file_path = file_path_] {
+                   return inflate_members(compressed, file_path);
+                 }));
+  return true;
+}
+
+bool ParallelGzipDecoder::nextBlock(const void** buff, size_t* size) {
+  while (true) {
+    while (pending_chunks_.size() < max_pending_chunks_ && scheduleChunk()) {
+    }
+    if (pending_chunks_.empty()) {
+      return false;
+    }
+    auto [compressed_size, chunk] = std::move(pending_chunks_.front());
+    pending_chunks_.pop_front();
+    current_block_ = chunk.get();
+    compressed_position_ += compressed_size;
+    // BGZF files end with an empty member
+    if (!current_block_.empty()) {
+      *buff = current_block_.data();
+      *size = current_block_.size();
+      return true;
+    }
+  }
+}
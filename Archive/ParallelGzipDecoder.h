@@ -0,0 +1,71 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ARCHIVE_PARALLELGZIPDECODER_H_
+#define ARCHIVE_PARALLELGZIPDECODER_H_
+
+#include <cstdio>
+#include <deque>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Decompresses BGZF files, i.e. gzip files made of independent members which record
+// their compressed size in a "BC" extra field (as written by bgzip), on several threads.
+// Compressed input is read sequentially in large chunks, split into members, and the
+// members of each chunk are inflated by a separate task. At most thread_count chunks,
+// and no more than a fixed amount of compressed data, are in flight at any time.
+// Decompressed data is returned in file order.
+//
+// Regular single member gzip files are not handled here: a deflate stream has no
+// boundaries where decoding could start without the preceding 32KB of output, so they
+// keep being decompressed by libarchive on the thread reading the archive.
+class ParallelGzipDecoder {
+ public:
+  ParallelGzipDecoder(const std::string& file_path, const size_t thread_count);
+  ~ParallelGzipDecoder();
+
+  ParallelGzipDecoder(const ParallelGzipDecoder&) = delete;
+  ParallelGzipDecoder& operator=(const ParallelGzipDecoder&) = delete;
+
+  // Returns true if the file starts with a BGZF member.
+  static bool isBgzfFile(const std::string& file_path);
+
+  // Gets the next block of decompressed data, which stays valid until the next call.
+  // Returns false at the end of the file.
+  bool nextBlock(const void** buff, size_t* size);
+
+  // Number of compressed bytes consumed so far.
+  int64_t compressedPosition() const { return compressed_position_; }
+
+ private:
+  // Reads the next chunk of compressed members and schedules its decompression.
+  bool scheduleChunk();
+
+  std::string file_path_;
+  FILE* file_;
+  const size_t max_pending_chunks_;
+  // Compressed size and decompressed data of the chunks being decompressed
+  std::deque<std::pair<size_t, std::future<std::vector<char>>>> pending_chunks_;
+  // Start of a member cut off at the end of the previous chunk
+  std::vector<char> partial_member_;
+  bool end_of_file_;
+  std::vector<char> current_block_;
+  int64_t compressed_position_;
+};
+
+#endif /* ARCHIVE_PARALLELGZIPDECODER_H_ */
@@ -18,33 +18,45 @@
 #define ARCHIVE_POSIXFILEARCHIVE_H_
 
 #include <cstdio>
+#include <memory>
 
 #include "Archive.h"
+#include "ParallelGzipDecoder.h"
 
 // archive read buffer size, configurable for unit test.
 extern size_t g_archive_read_buf_size;
 
 // this is the archive class for files hosted locally or remotely with
 // POSIX compliant file name. !! 7z files work only with this class !!
+// thread_count bounds the threads used to decompress BGZF files.
 class PosixFileArchive : public Archive {
  public:
-  PosixFileArchive(const std::string url, const bool plain_text)
+  PosixFileArchive(const std::string url,
+                   const bool plain_text,
+                   const size_t thread_count = 1)
       : Archive(url, plain_text) {
-    // some well-known file.exts imply plain text
     if (!this->plain_text) {
-      this->plain_text = boost::filesystem::extension(url_part(5)) == ".csv" ||
-                         boost::filesystem::extension(url_part(5)) == ".tsv" ||
-                         boost::filesystem::extension(url_part(5)) == ".txt" ||
-                         boost::filesystem::extension(url_part(5)) == "";
+      this->plain_text = hasPlainTextExtension(url_part(5));
     }
 
     if (this->plain_text) {
       buf = new char[g_archive_read_buf_size];
+    } else if (ParallelGzipDecoder::isBgzfFile(url_part(5))) {
+      // BGZF members are independent, so they can be decompressed on several threads
+      // instead of libarchive's single stream
+      gzip_decoder = std::make_unique<ParallelGzipDecoder>(url_part(5), thread_count);
     }
 
     init_for_read();
   }
 
+  // some well-known file.exts imply plain text
+  static bool hasPlainTextExtension(const std::string& file_path) {
+    const auto extension = boost::filesystem::extension(file_path);
+    return extension == ".csv" || extension == ".tsv" || extension == ".txt" ||
+           extension == "";
+  }
+
   ~PosixFileArchive() override {
     if (fp) {
       fclose(fp);
@@ -56,6 +68,9 @@ class PosixFileArchive : public Archive {
 
   void init_for_read() override {
     auto file_path = url_part(5);
+    if (gzip_decoder) {
+      return;
+    }
     if (plain_text) {
       if (nullptr == (fp = fopen(file_path.c_str(), "r"))) {
         throw std::runtime_error(std::string("fopen(") + file_path +
@@ -70,6 +85,14 @@ class PosixFileArchive : public Archive {
   }
 
   bool read_next_header() override {
+    if (gzip_decoder) {
+      // A gzip file holds a single entry
+      if (gzip_entry_read) {
+        return false;
+      }
+      gzip_entry_read = true;
+      return true;
+    }
     if (plain_text) {
       return !feof(fp);
     } else {
@@ -78,6 +101,11 @@ class PosixFileArchive : public Archive {
   }
 
   bool read_data_block(const void** buff, size_t* size, int64_t* offset) override {
+    if (gzip_decoder) {
+      auto ret = gzip_decoder->nextBlock(buff, size);
+      *offset = gzip_decoder->compressedPosition();
+      return ret;
+    }
     if (plain_text) {
       size_t nread;
       if (0 >= (nread = fread(buf, 1, g_archive_read_buf_size, fp))) {
@@ -95,9 +123,26 @@ class PosixFileArchive : public Archive {
     }
   }
 
+  int64_t get_position_compressed() const override {
+    if (gzip_decoder) {
+      return gzip_decoder->compressedPosition();
+    }
+    return Archive::get_position_compressed();
+  }
+
+  std::string entryName() override {
+    if (gzip_decoder) {
+      // same name as given by libarchive to the data of raw (non archive) formats
+      return "data";
+    }
+    return Archive::entryName();
+  }
+
  private:
   char* buf = nullptr;
   FILE* fp = nullptr;
+  std::unique_ptr<ParallelGzipDecoder> gzip_decoder;
+  bool gzip_entry_read = false;
 };
 
 #endif /* ARCHIVE_POSIXFILEARCHIVE_H_ */
@@ -0,0 +1,539 @@
+import csv
+import datetime
+import json
+import logging
+import queue
+import re
+import shlex
+import sys
+import threading
+import timeit
+from argparse import ArgumentParser
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy
+
+# For usage info, run: `./<script_name>.py --help`
+
+STDLOG_FUNCS = ("sql_execute", "sql_execute_df", "sql_execute_gdf")
+READ_ONLY_PREFIXES = ("SELECT", "WITH", "EXPLAIN", "SHOW")
+TIMESTAMP_PATTERN = re.compile(r"^\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d+ ")
+STDLOG_PATTERN = re.compile(
+    r"^(?P<timestamp>\S+) (?P<severity>\S+) (?P<pid>\d+) (?:(?P<thread_id>\d+) )?"
+    r"(?P<location>\S+:\d+) stdlog (?P<func>\S+) (?P<match_id>\d+) "
+    r"(?P<time_ms>\d+) (?P<rest>.*)$",
+    re.DOTALL,
+)
+
+
+def parse_sql_array(array_str):
+    """
+      Parses an array of names or values as logged by StdLog, e.g.
+        {"query_str","total_time_ms"}. Values are quoted with doubled quotes
+        as escapes, which is the csv dialect.
+
+      Returns:
+        values(list): Parsed strings
+    """
+    if not array_str.startswith("{") or not array_str.endswith("}"):
+        return []
+    return next(
+        csv.reader([array_str[1:-1]], quotechar='"', doublequote=True)
+    )
+
+
+def split_names_values(rest):
+    """
+      Splits the part of a stdlog entry following the time in ms into the
+        session fields and the names and values arrays.
+
+      Returns:
+        session(list): [dbname, username, public_session_id]
+        names(list): Logged value names
+        values(list): Logged values
+    """
+    names_start = rest.find('{"')
+    if names_start < 0:
+        return shlex.split(rest), [], []
+    session = shlex.split(rest[:names_start])
+    names_end = rest.find("} {", names_start)
+    if names_end < 0:
+        return session, [], []
+    names = parse_sql_array(rest[names_start : names_end + 1])
+    values = parse_sql_array(rest[names_end + 2 :].rstrip())
+    return session, names, values
+
+
+def read_log_entries(log_file):
+    """
+      Yields the entries of a log file, joining the continuation lines of
+        entries whose logged values contain newlines.
+    """
+    entry = None
+    with open(log_file, "r") as f:
+        for line in f:
+            if TIMESTAMP_PATTERN.match(line):
+                if entry is not None:
+                    yield entry
+                entry = line.rstrip("\n")
+            elif entry is not None:
+                entry += "\n" + line.rstrip("\n")
+    if entry is not None:
+        yield entry
+
+
+def read_query_log(**kwargs):
+    """
+      Reads the queries executed through DBHandler from one or more server
+        log files, in log order.
+
+      Kwargs:
+        log_files(list): Paths of the INFO log files
+        include_writes(bool): Also replay statements which modify data
+        db_name(str): Only replay queries run against this database, if set
+
+      Returns:
+        queries(list):::
+            timestamp(datetime): Time the query finished
+            start_offset_ms(float): Start time relative to the first query
+            query_str(str): SQL text
+            original_time_ms(int): Total time logged by the server
+            func(str): Thrift endpoint which ran the query
+    """
+    queries = []
+    for log_file in kwargs["log_files"]:
+        for entry in read_log_entries(log_file):
+            match = STDLOG_PATTERN.match(entry)
+            if not match or match.group("func") not in STDLOG_FUNCS:
+                continue
+            session, names, values = split_names_values(match.group("rest"))
+            fields = dict(zip(names, values))
+            query_str = fields.get("query_str", "").strip()
+            if not query_str:
+                continue
+            if kwargs["db_name"] and (
+                not session or session[0] != kwargs["db_name"]
+            ):
+                continue
+            if not kwargs["include_writes"] and not query_str.upper().startswith(
+                READ_ONLY_PREFIXES
+            ):
+                continue
+            finish_time = datetime.datetime.strptime(
+                match.group("timestamp"), "%Y-%m-%dT%H:%M:%S.%f"
+            )
+            time_ms = int(fields.get("total_time_ms", match.group("time_ms")))
+            queries.append(
+                {
+                    "timestamp": finish_time
+                    - datetime.timedelta(milliseconds=time_ms),
+                    "query_str": query_str,
+                    "original_time_ms": time_ms,
+                    "func": match.group("func"),
+                }
+            )
+    queries.sort(key=lambda query: query["timestamp"])
+    if queries:
+        first_timestamp = queries[0]["timestamp"]
+        for query in queries:
+            query["start_offset_ms"] = (
+                query["timestamp"] - first_timestamp
+            ).total_seconds() * 1000
+    return queries
+
+
+class ServerBackend:
+    """
+      Runs queries against a server through pymapd, with one connection per
+        replay thread since connections must not be shared between threads.
+        Queries go through the Thrift sql_execute call, so that the total
+        time measured by the server is available, as logged in the original
+        run.
+    """
+
+    def __init__(self, **kwargs):
+        import pymapd
+
+        self.connect_args = dict(
+            user=kwargs["db_user"],
+            password=kwargs["db_passwd"],
+            host=kwargs["db_server"],
+            port=kwargs["db_port"],
+            dbname=kwargs["db_name"] or "omnisci",
+        )
+        self.pymapd = pymapd
+        self.local = threading.local()
+
+    def execute(self, query_str):
+        """
+          Returns:
+            total_time_ms(int): Total time of the query measured by the server
+        """
+        if not hasattr(self.local, "con"):
+            self.local.con = self.pymapd.connect(**self.connect_args)
+        con = self.local.con
+        result = con._client.sql_execute(
+            con._session, query_str, True, None, -1, -1
+        )
+        return result.total_time_ms
+
+
+class EmbeddedBackend:
+    """
+      Runs queries in process through the embedded DBEngine. The Python
+        bindings hold the GIL while a query runs, so queries are effectively
+        serialized regardless of the replay concurrency.
+    """
+
+    def __init__(self, **kwargs):
+        import ctypes
+
+        ctypes._dlopen("libDBEngine.so", ctypes.RTLD_GLOBAL)
+        import dbe
+
+        self.engine = dbe.PyDbEngine(
+            data=kwargs["data_path"], calcite_port=kwargs["calcite_port"]
+        )
+
+    def execute(self, query_str):
+        """
+          Returns:
+            total_time_ms(None): There is no server side time, but the in
+              process wall clock time has no client overhead either
+        """
+        self.engine.executeDML(query_str)
+        return None
+
+
+def execute_query(backend, query):
+    """
+      Runs a single query and times it.
+
+      Returns:
+        result(dict):::
+            query_str(str): SQL text
+            original_time_ms(int): Total time logged in the original run
+            replay_time_ms(float): Total time of the replayed query measured
+              by the server, comparable to original_time_ms, or the wall
+              clock time if the backend has no server side time
+            replay_wall_time_ms(float): Wall clock time of the replayed query,
+              including client and network overhead
+            replay_time_source(str): "server" or "wall_clock"
+            succeeded(bool): Query succeeded
+            error(str): Error message of a failed query
+    """
+    result = {
+        "query_str": query["query_str"],
+        "original_time_ms": query["original_time_ms"],
+        "succeeded": True,
+        "error": "",
+    }
+    server_time_ms = None
+    start_time = timeit.default_timer()
+    try:
+        server_time_ms = backend.execute(query["query_str"])
+    except Exception as e:
+        result["succeeded"] = False
+        result["error"] = str(e)
+    result["replay_wall_time_ms"] = (timeit.default_timer() - start_time) * 1000
+    if server_time_ms is not None:
+        result["replay_time_ms"] = float(server_time_ms)
+        result["replay_time_source"] = "server"
+    else:
+        result["replay_time_ms"] = result["replay_wall_time_ms"]
+        result["replay_time_source"] = "wall_clock"
+    return result
+
+
+def replay_timed(backend, queries, max_workers, speedup):
+    """
+      Replays queries at their original start offsets, scaled by speedup. A
+        query starts late when all workers are busy; the lag is recorded.
+    """
+    results = []
+    futures = []
+    with ThreadPoolExecutor(max_workers=max_workers) as executor:
+        start_time = timeit.default_timer()
+
+        def run(query, scheduled_ms):
+            lag_ms = (timeit.default_timer() - start_time) * 1000 - scheduled_ms
+            result = execute_query(backend, query)
+            result["start_lag_ms"] = max(lag_ms, 0)
+            return result
+
+        for query in queries:
+            scheduled_ms = query["start_offset_ms"] / speedup
+            delay_s = scheduled_ms / 1000 - (timeit.default_timer() - start_time)
+            if delay_s > 0:
+                threading.Event().wait(delay_s)
+            futures.append(executor.submit(run, query, scheduled_ms))
+        for future in futures:
+            results.append(future.result())
+    return results
+
+
+def replay_concurrent(backend, queries, concurrency):
+    """
+      Replays queries in log order as fast as possible with a fixed number of
+        queries in flight.
+    """
+    pending = queue.Queue()
+    for idx, query in enumerate(queries):
+        pending.put((idx, query))
+    results = [None] * len(queries)
+
+    def worker():
+        while True:
+            try:
+                idx, query = pending.get_nowait()
+            except queue.Empty:
+                return
+            results[idx] = execute_query(backend, query)
+
+    workers = [threading.Thread(target=worker) for _ in range(concurrency)]
+    for thread in workers:
+        thread.start()
+    for thread in workers:
+        thread.join()
+    return results
+
+
+def latency_summary(times_ms):
+    if not times_ms:
+        return {}
+    return {
+        "count": len(times_ms),
+        "mean_ms": float(numpy.mean(times_ms)),
+        "p50_ms": float(numpy.percentile(times_ms, 50)),
+        "p95_ms": float(numpy.percentile(times_ms, 95)),
+        "p99_ms": float(numpy.percentile(times_ms, 99)),
+        "max_ms": float(numpy.max(times_ms)),
+    }
+
+
+def summarize_results(results, wall_time_s):
+    """
+      Builds the replay report: latency percentiles of the original and the
+        replayed run, and per query deltas, with repeated query texts grouped
+        together and compared on their medians. Deltas compare the server
+        side times of both runs; the client side wall clock times of the
+        replay are summarized separately.
+    """
+    succeeded = [result for result in results if result["succeeded"]]
+    per_query = {}
+    for result in succeeded:
+        entry = per_query.setdefault(
+            result["query_str"], {"original": [], "replay": []}
+        )
+        entry["original"].append(result["original_time_ms"])
+        entry["replay"].append(result["replay_time_ms"])
+    deltas = []
+    for query_str, times in per_query.items():
+        original_ms = float(numpy.median(times["original"]))
+        replay_ms = float(numpy.median(times["replay"]))
+        deltas.append(
+            {
+                "query_str": query_str,
+                "executions": len(times["replay"]),
+                "original_median_ms": original_ms,
+                "replay_median_ms": replay_ms,
+                "delta_ms": replay_ms - original_ms,
+                "ratio": replay_ms / original_ms if original_ms else None,
+            }
+        )
+    deltas.sort(key=lambda delta: delta["delta_ms"], reverse=True)
+    report = {
+        "queries": len(results),
+        "failed": len(results) - len(succeeded),
+        "wall_time_s": wall_time_s,
+        "throughput_qps": len(results) / wall_time_s if wall_time_s else None,
+        "original_latency": latency_summary(
+            [result["original_time_ms"] for result in succeeded]
+        ),
+        "replay_latency": latency_summary(
+            [result["replay_time_ms"] for result in succeeded]
+        ),
+        "replay_wall_latency": latency_summary(
+            [result["replay_wall_time_ms"] for result in succeeded]
+        ),
+        "replay_time_sources": sorted(
+            set(result["replay_time_source"] for result in succeeded)
+        ),
+        "per_query_deltas": deltas,
+        "errors": [
+            {"query_str": result["query_str"], "error": result["error"]}
+            for result in results
+            if not result["succeeded"]
+        ],
+    }
+    lags = [result["start_lag_ms"] for result in results if "start_lag_ms" in result]
+    if lags:
+        report["start_lag"] = latency_summary(lags)
+    return report
+
+
+def print_report(report, top_n):
+    print("Replayed %d queries, %d failed" % (report["queries"], report["failed"]))
+    print(
+        "Wall time %.2f s, throughput %.2f queries/s"
+        % (report["wall_time_s"], report["throughput_qps"] or 0)
+    )
+    print("%-10s %10s %10s %10s %10s" % ("", "p50 ms", "p95 ms", "p99 ms", "max ms"))
+    labels = {
+        "original_latency": "original",
+        "replay_latency": "replay",
+        "replay_wall_latency": "client",
+        "start_lag": "start lag",
+    }
+    for name, label in labels.items():
+        summary = report.get(name)
+        if summary:
+            print(
+                "%-10s %10.1f %10.1f %10.1f %10.1f"
+                % (
+                    label,
+                    summary["p50_ms"],
+                    summary["p95_ms"],
+                    summary["p99_ms"],
+                    summary["max_ms"],
+                )
+            )
+    if report["per_query_deltas"] and top_n > 0:
+        print("Largest regressions (median replay - median original):")
+        for delta in report["per_query_deltas"][:top_n]:
+            print(
+                "%+10.1f ms  x%-5d %s"
+                % (
+                    delta["delta_ms"],
+                    delta["executions"],
+                    " ".join(delta["query_str"].split())[:100],
+                )
+            )
+
+
+def process_arguments(input_arguments):
+    parser = ArgumentParser(
+        description="Replay the queries of a server log against a server "
+        + "or an embedded DBEngine and report latency percentiles and "
+        + "per query deltas against the original run."
+    )
+    parser.add_argument(
+        "log_files", nargs="+", help="Server INFO log files to replay"
+    )
+    parser.add_argument(
+        "-v", "--verbose", action="store_true", help="Turn on debug logging"
+    )
+    parser.add_argument(
+        "-b",
+        "--backend",
+        choices=["server", "embedded"],
+        default="server",
+        help="Replay against a running server or an embedded DBEngine",
+    )
+    parser.add_argument(
+        "-m",
+        "--mode",
+        choices=["timed", "concurrency"],
+        default="timed",
+        help="timed: keep the original inter-arrival times. "
+        + "concurrency: run with a fixed number of queries in flight",
+    )
+    parser.add_argument(
+        "-c",
+        "--concurrency",
+        type=int,
+        default=4,
+        help="Queries in flight in concurrency mode, max workers in timed mode",
+    )
+    parser.add_argument(
+        "--speedup",
+        type=float,
+        default=1.0,
+        help="Divide the original inter-arrival times by this factor",
+    )
+    parser.add_argument(
+        "--limit", type=int, default=0, help="Only replay the first N queries"
+    )
+    parser.add_argument(
+        "--include-writes",
+        action="store_true",
+        help="Also replay statements other than SELECT/WITH/EXPLAIN/SHOW",
+    )
+    parser.add_argument("-u", "--user", dest="user", default="admin")
+    parser.add_argument(
+        "-p", "--passwd", dest="passwd", default="HyperInteractive"
+    )
+    parser.add_argument("-s", "--server", dest="server", default="localhost")
+    parser.add_argument("-o", "--port", dest="port", type=int, default=6274)
+    parser.add_argument(
+        "-n",
+        "--name",
+        dest="name",
+        default="",
+        help="Only replay queries logged against this database",
+    )
+    parser.add_argument(
+        "--data", dest="data_path", default="data", help="Embedded data path"
+    )
+    parser.add_argument(
+        "--calcite-port", dest="calcite_port", type=int, default=9091
+    )
+    parser.add_argument(
+        "-j", "--output-file-json", help="Write the full report to this file"
+    )
+    parser.add_argument(
+        "--top", type=int, default=10, help="Number of per query deltas to print"
+    )
+    return parser.parse_args(input_arguments)
+
+
+def replay(input_arguments):
+    args = process_arguments(input_arguments)
+    logging.basicConfig(
+        level=logging.DEBUG if args.verbose else logging.INFO,
+        format="%(asctime)s - %(levelname)s - %(message)s",
+    )
+    queries = read_query_log(
+        log_files=args.log_files,
+        include_writes=args.include_writes,
+        db_name=args.name,
+    )
+    if args.limit > 0:
+        queries = queries[: args.limit]
+    if not queries:
+        logging.error("No queries found in the given logs")
+        exit(1)
+    logging.info("Read %d queries from the logs" % len(queries))
+
+    if args.backend == "server":
+        backend = ServerBackend(
+            db_user=args.user,
+            db_passwd=args.passwd,
+            db_server=args.server,
+            db_port=args.port,
+            db_name=args.name,
+        )
+    else:
+        backend = EmbeddedBackend(
+            data_path=args.data_path, calcite_port=args.calcite_port
+        )
+
+    start_time = timeit.default_timer()
+    if args.mode == "timed":
+        results = replay_timed(backend, queries, args.concurrency, args.speedup)
+    else:
+        results = replay_concurrent(backend, queries, args.concurrency)
+    report = summarize_results(results, timeit.default_timer() - start_time)
+    report["mode"] = args.mode
+    report["concurrency"] = args.concurrency
+    report["backend"] = args.backend
+
+    print_report(report, args.top)
+    if args.output_file_json:
+        with open(args.output_file_json, "w") as f:
+            json.dump(report, f, indent=2)
+        logging.info("Wrote report to " + args.output_file_json)
+
+
+if __name__ == "__main__":
+    replay(sys.argv[1:])
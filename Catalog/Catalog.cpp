@@ -66,6 +66,7 @@
 #include "MigrationMgr/MigrationMgr.h"
 #include "Parser/ParserNode.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/FragmentSpatialIndex.h"
 #include "QueryEngine/TableOptimizer.h"
 #include "RefreshTimeCalculator.h"
 #include "Shared/DateTimeParser.h"
@@ -3003,6 +3004,18 @@ std::vector<TableEpochInfo> Catalog::getTableEpochs(const int32_t db_id,
 
 void Catalog::setTableEpochs(const int32_t db_id,
                              const std::vector<TableEpochInfo>& table_epochs) const {
+  {
+    cat_read_lock read_lock(this);
+    for (const auto& table_epoch_info : table_epochs) {
+      removeChunksUnlocked(table_epoch_info.table_id);
+    }
+  }
+  setTableStorageEpochs(db_id, table_epochs);
+}
+
+void Catalog::setTableStorageEpochs(
+    const int32_t db_id,
+    const std::vector<TableEpochInfo>& table_epochs) const {
   const auto td = getMetadataForTable(table_epochs[0].table_id, false);
   CHECK(td);
   File_Namespace::FileMgrParams file_mgr_params;
@@ -3010,7 +3023,6 @@ void Catalog::setTableEpochs(const int32_t db_id,
 
   cat_read_lock read_lock(this);
   for (const auto& table_epoch_info : table_epochs) {
-    removeChunksUnlocked(table_epoch_info.table_id);
     file_mgr_params.epoch = table_epoch_info.table_epoch;
     dataMgr_->getGlobalFileMgr()->setFileMgrParams(
         db_id, table_epoch_info.table_id, file_mgr_params);
@@ -3346,6 +3358,7 @@ void Catalog::doTruncateTable(const TableDescriptor* td) {
   dataMgr_->deleteChunksWithPrefix(chunkKeyPrefix, MemoryLevel::GPU_LEVEL);
 
   dataMgr_->removeTableRelatedDS(currentDB_.dbId, tableId);
+  FragmentSpatialIndex::invalidateTable(currentDB_.dbId, tableId);
 
   std::unique_ptr<StringDictionaryClient> client;
   if (SysCatalog::instance().isAggregator()) {
@@ -3427,6 +3440,7 @@ void Catalog::removeChunksUnlocked(const int table_id) const {
 
   dataMgr_->deleteChunksWithPrefix(chunkKey, MemoryLevel::CPU_LEVEL);
   dataMgr_->deleteChunksWithPrefix(chunkKey, MemoryLevel::GPU_LEVEL);
+  FragmentSpatialIndex::invalidateTable(currentDB_.dbId, table_id);
 }
 
 void Catalog::dropTable(const TableDescriptor* td) {
@@ -3468,6 +3482,7 @@ void Catalog::doDropTable(const TableDescriptor* td) {
     dropTableFromJsonUnlocked(td->tableName);
   }
   eraseTablePhysicalData(td);
+  FragmentSpatialIndex::invalidateTable(currentDB_.dbId, td->tableId);
 }
 
 void Catalog::executeDropTableSqliteQueries(const TableDescriptor* td) {
@@ -4020,28 +4035,41 @@ std::string Catalog::generatePhysicalTableName(const std::string& logicalTableNa
   return (physicalTableName);
 }
 
-void Catalog::vacuumDeletedRows(const int logicalTableId) const {
+bool Catalog::vacuumDeletedRows(const int logicalTableId,
+                                const float min_selectivity) const {
   // shard here to serve request from TableOptimizer and elsewhere
   const auto td = getMetadataForTable(logicalTableId);
   const auto shards = getPhysicalTablesDescriptors(td);
+  bool vacuumed = false;
   for (const auto shard : shards) {
-    vacuumDeletedRows(shard);
+    vacuumed |= vacuumDeletedRows(shard, min_selectivity);
   }
+  return vacuumed;
 }
 
-void Catalog::vacuumDeletedRows(const TableDescriptor* td) const {
+bool Catalog::vacuumDeletedRows(const TableDescriptor* td,
+                                const float min_selectivity) const {
   // "if not a table that supports delete return nullptr,  nothing more to do"
   const ColumnDescriptor* cd = getDeletedColumn(td);
   if (nullptr == cd) {
-    return;
+    return false;
   }
   // vacuum chunks which show sign of deleted rows in metadata
   ChunkKey chunkKeyPrefix = {currentDB_.dbId, td->tableId, cd->columnId};
   ChunkMetadataVector chunkMetadataVec;
   dataMgr_->getChunkMetadataVecForKeyPrefix(chunkMetadataVec, chunkKeyPrefix);
+  bool vacuumed = false;
   for (auto cm : chunkMetadataVec) {
     // "delete has occured"
     if (cm.second->chunkStats.max.tinyintval == 1) {
+      // updates and deletes of other fragments may run concurrently, and may have changed
+      // this one before it was locked
+      const auto fragment_lock = lockmgr::FragmentDataLockMgr::getWriteLockForFragment(
+          currentDB_.dbId, td->tableId, cm.first[3]);
+      ChunkMetadataVector fragment_chunk_metadata;
+      dataMgr_->getChunkMetadataVecForKeyPrefix(fragment_chunk_metadata, cm.first);
+      CHECK_EQ(fragment_chunk_metadata.size(), size_t(1));
+      cm = fragment_chunk_metadata.front();
       UpdelRoll updel_roll;
       updel_roll.catalog = this;
       updel_roll.logicalTableId = getLogicalTableId(td->tableId);
@@ -4055,15 +4083,20 @@ void Catalog::vacuumDeletedRows(const TableDescriptor* td) const {
                                                    0,
                                                    cm.second->numBytes,
                                                    cm.second->numElements);
-      td->fragmenter->compactRows(this,
-                                  td,
-                                  cm.first[3],
-                                  td->fragmenter->getVacuumOffsets(chunk),
-                                  updel_roll.memoryLevel,
-                                  updel_roll);
+      const auto vacuum_offsets = td->fragmenter->getVacuumOffsets(chunk);
+      // only rewrite fragments whose share of deleted rows reaches the requested
+      // selectivity, rewriting every column of a mostly live fragment is not worth it
+      if (min_selectivity > 0.f &&
+          vacuum_offsets.size() < min_selectivity * cm.second->numElements) {
+        continue;
+      }
+      td->fragmenter->compactRows(
+          this, td, cm.first[3], vacuum_offsets, updel_roll.memoryLevel, updel_roll);
       updel_roll.stageUpdate();
+      vacuumed = true;
     }
   }
+  return vacuumed;
 }
 
 void Catalog::buildForeignServerMap() {
@@ -4191,6 +4224,23 @@ std::string Catalog::getColumnDictDirectory(const ColumnDescriptor* cd) const {
   return std::string();
 }
 
+void Catalog::reloadTableDictionaries(const TableDescriptor* td) const {
+  cat_read_lock read_lock(this);
+  for (const auto cd : getAllColumnMetadataForTable(td->tableId, false, false, true)) {
+    if (getColumnDictDirectory(cd).empty()) {
+      continue;
+    }
+    const DictRef dict_ref(currentDB_.dbId, cd->columnType.get_comp_param());
+    const auto dit = dictDescriptorMapByRef_.find(dict_ref);
+    CHECK(dit != dictDescriptorMapByRef_.end());
+    {
+      std::lock_guard string_dict_lock(*dit->second->string_dict_mutex);
+      dit->second->stringDict.reset();
+    }
+    getMetadataForDictUnlocked(dict_ref.dictId, true);
+  }
+}
+
 // get a table's dict dirs
 std::vector<std::string> Catalog::getTableDictDirectories(
     const TableDescriptor* td) const {
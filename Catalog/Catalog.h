@@ -268,6 +268,10 @@ class Catalog final {
                                              const int32_t table_id) const;
   void setTableEpochs(const int32_t db_id,
                       const std::vector<TableEpochInfo>& table_epochs) const;
+  // Resets the storage of the tables to the given epochs, keeping their cached chunks
+  // and fragmenters. Callers evict the chunks which no longer match the storage.
+  void setTableStorageEpochs(const int32_t db_id,
+                             const std::vector<TableEpochInfo>& table_epochs) const;
 
   void setTableEpochsLogExceptions(const int32_t db_id,
                                    const std::vector<TableEpochInfo>& table_epochs) const;
@@ -292,13 +296,18 @@ class Catalog final {
   std::string name() const { return getCurrentDB().dbName; }
   void eraseDBData();
   void eraseTablePhysicalData(const TableDescriptor* td);
-  void vacuumDeletedRows(const TableDescriptor* td) const;
-  void vacuumDeletedRows(const int logicalTableId) const;
+  bool vacuumDeletedRows(const TableDescriptor* td,
+                         const float min_selectivity = 0.f) const;
+  bool vacuumDeletedRows(const int logicalTableId,
+                         const float min_selectivity = 0.f) const;
   void setForReload(const int32_t tableId);
 
   std::vector<std::string> getTableDataDirectories(const TableDescriptor* td) const;
   std::vector<std::string> getTableDictDirectories(const TableDescriptor* td) const;
   std::string getColumnDictDirectory(const ColumnDescriptor* cd) const;
+  // Drops the loaded dictionaries of a table and loads them again from their
+  // directories, after these were replaced on disk
+  void reloadTableDictionaries(const TableDescriptor* td) const;
   std::string dumpSchema(const TableDescriptor* td) const;
   std::string dumpCreateTable(const TableDescriptor* td,
                               bool multiline_formatting = true,
@@ -21,6 +21,9 @@ outside of the header file in order to prevent unnecessary re-compilation.
 
 #include "AbstractBuffer.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace Data_Namespace {
 
 void AbstractBuffer::initEncoder(const SQLTypeInfo& tmp_sql_type) {
@@ -41,6 +44,40 @@ void AbstractBuffer::syncEncoder(const AbstractBuffer* src_buffer) {
   }
 }
 
+void AbstractBuffer::setUpdatedRange(const size_t offset, const size_t num_bytes) {
+  // past this many disjoint ranges, tracking costs more than rewriting the buffer
+  constexpr size_t max_updated_ranges{1 << 16};
+  if (num_bytes == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(updated_ranges_mutex_);
+  const bool is_tracked = !is_updated_ || !updated_ranges_.empty();
+  is_updated_ = true;
+  is_dirty_ = true;
+  if (!is_tracked) {
+    return;
+  }
+  auto begin = offset;
+  auto end = offset + num_bytes;
+  auto it = updated_ranges_.upper_bound(begin);
+  if (it != updated_ranges_.begin()) {
+    auto prev_it = std::prev(it);
+    if (prev_it->second >= begin) {
+      begin = prev_it->first;
+      end = std::max(end, prev_it->second);
+      updated_ranges_.erase(prev_it);
+    }
+  }
+  while (it != updated_ranges_.end() && it->first <= end) {
+    end = std::max(end, it->second);
+    it = updated_ranges_.erase(it);
+  }
+  updated_ranges_.emplace(begin, end);
+  if (updated_ranges_.size() > max_updated_ranges) {
+    updated_ranges_.clear();
+  }
+}
+
 void AbstractBuffer::copyTo(AbstractBuffer* destination_buffer, const size_t num_bytes) {
   size_t chunk_size = (num_bytes == 0) ? size() : num_bytes;
   destination_buffer->reserve(chunk_size);
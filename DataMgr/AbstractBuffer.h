@@ -21,7 +21,9 @@
  */
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 
 #ifdef BUFFER_MUTEX
 #include <boost/thread/locks.hpp>
@@ -108,8 +110,29 @@ class AbstractBuffer {
   inline void setDirty() { is_dirty_ = true; }
 
   inline void setUpdated() {
+    std::lock_guard<std::mutex> lock(updated_ranges_mutex_);
     is_updated_ = true;
     is_dirty_ = true;
+    updated_ranges_.clear();
+  }
+
+  /**
+   * @brief Marks bytes [offset, offset + num_bytes) as updated in place.
+   *
+   * As long as every in place update of the buffer since the last flush has been
+   * recorded this way, getUpdatedRanges() returns the (coalesced) byte ranges that
+   * changed and the parent buffer manager only has to write the pages covering them.
+   * Any untracked update (setUpdated()) falls back to writing the whole buffer.
+   */
+  void setUpdatedRange(const size_t offset, const size_t num_bytes);
+
+  /**
+   * @brief Returns a snapshot of the byte ranges (begin -> end) updated in place since
+   * the last flush, or an empty map if the whole buffer has to be considered updated.
+   */
+  inline std::map<size_t, size_t> getUpdatedRanges() const {
+    std::lock_guard<std::mutex> lock(updated_ranges_mutex_);
+    return updated_ranges_;
   }
 
   inline void setAppended() {
@@ -119,9 +142,11 @@ class AbstractBuffer {
 
   inline void setSize(const size_t size) { size_ = size; }
   inline void clearDirtyBits() {
+    std::lock_guard<std::mutex> lock(updated_ranges_mutex_);
     is_appended_ = false;
     is_updated_ = false;
     is_dirty_ = false;
+    updated_ranges_.clear();
   }
 
   void initEncoder(const SQLTypeInfo& tmp_sql_type);
@@ -139,6 +164,9 @@ class AbstractBuffer {
   bool is_dirty_;
   bool is_appended_;
   bool is_updated_;
+  std::map<size_t, size_t> updated_ranges_;
+  // update publishing and checkpoints touch the ranges from different threads
+  mutable std::mutex updated_ranges_mutex_;
 
 #ifdef BUFFER_MUTEX
   boost::shared_mutex read_write_mutex_;
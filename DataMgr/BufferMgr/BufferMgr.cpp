@@ -78,6 +78,20 @@ BufferMgr::BufferMgr(const int device_id,
                                 // fail - this is the high water mark
 }
 
+void BufferMgr::initMetrics(const std::string& level) {
+  auto& registry = metrics::Registry::instance();
+  hits_counter_ = &registry.counter("omnisci_buffer_pool_hits_total",
+                                    "Chunk requests served from the buffer pool.",
+                                    {{"level", level}});
+  misses_counter_ = &registry.counter(
+      "omnisci_buffer_pool_misses_total",
+      "Chunk requests which had to fetch the chunk from the parent buffer manager.",
+      {{"level", level}});
+  evictions_counter_ = &registry.counter("omnisci_buffer_pool_evictions_total",
+                                         "Chunks evicted from the buffer pool.",
+                                         {{"level", level}});
+}
+
 /// Frees the heap-allocated buffer pool memory
 BufferMgr::~BufferMgr() {
   clear();
@@ -165,6 +179,9 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
       chunk_index_.erase(evict_it->chunk_key);
+      if (evictions_counter_) {
+        evictions_counter_->increment();
+      }
     }
     evict_it = slab_segments_[slab_num].erase(
         evict_it);  // erase operations returns next iterator - safe if we ever move
@@ -720,6 +737,9 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
   auto buffer_it = chunk_index_.find(key);
   bool found_buffer = buffer_it != chunk_index_.end();
   chunk_index_lock.unlock();
+  if (hits_counter_) {
+    (found_buffer ? hits_counter_ : misses_counter_)->increment();
+  }
   if (found_buffer) {
     CHECK(buffer_it->second->buffer);
     buffer_it->second->buffer->pin();
@@ -762,6 +782,9 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
   auto buffer_it = chunk_index_.find(key);
   bool found_buffer = buffer_it != chunk_index_.end();
   chunk_index_lock.unlock();
+  if (hits_counter_) {
+    (found_buffer ? hits_counter_ : misses_counter_)->increment();
+  }
   AbstractBuffer* buffer;
   if (!found_buffer) {
     sized_segs_lock.unlock();
@@ -34,6 +34,7 @@
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
 #include "DataMgr/BufferMgr/BufferSeg.h"
+#include "Shared/Metrics.h"
 #include "Shared/boost_stacktrace.hpp"
 #include "Shared/types.h"
 
@@ -181,6 +182,10 @@ class BufferMgr : public AbstractBufferMgr {  // implements
                                 /// allocation of the buffer pool
   std::vector<BufferList> slab_segments_;
 
+  /// Registers the buffer pool hit, miss and eviction counters of the given memory level
+  /// (cpu or gpu). Called by the constructor of the concrete buffer manager.
+  void initMetrics(const std::string& level);
+
  private:
   BufferMgr(const BufferMgr&);             // private copy constructor
   BufferMgr& operator=(const BufferMgr&);  // private assignment
@@ -212,6 +217,10 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   BufferList unsized_segs_;
 
+  metrics::Counter* hits_counter_{nullptr};
+  metrics::Counter* misses_counter_{nullptr};
+  metrics::Counter* evictions_counter_{nullptr};
+
   BufferList::iterator evict(BufferList::iterator& evict_start,
                              const size_t num_pages_requested,
                              const int slab_num);
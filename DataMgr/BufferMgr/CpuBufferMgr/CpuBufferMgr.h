@@ -43,7 +43,9 @@ class CpuBufferMgr : public BufferMgr {
                   parent_mgr)
       , cuda_mgr_(cuda_mgr)
       , allocator_(std::make_unique<Arena>(/*min_block_size=*/max_slab_size +
-                                           kArenaBlockOverhead)) {}
+                                           kArenaBlockOverhead)) {
+    initMetrics("cpu");
+  }
 
   ~CpuBufferMgr() {
     /* the destruction of the allocator automatically frees all memory */
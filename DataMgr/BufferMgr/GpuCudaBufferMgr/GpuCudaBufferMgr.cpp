@@ -35,7 +35,9 @@ GpuCudaBufferMgr::GpuCudaBufferMgr(const int device_id,
                 max_slab_size,
                 page_size,
                 parent_mgr)
-    , cuda_mgr_(cuda_mgr) {}
+    , cuda_mgr_(cuda_mgr) {
+  initMetrics("gpu");
+}
 
 GpuCudaBufferMgr::~GpuCudaBufferMgr() {
   try {
@@ -25,6 +25,7 @@
 #include "CudaMgr/CudaMgr.h"
 #include "FileMgr/GlobalFileMgr.h"
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
+#include "Shared/Metrics.h"
 
 #ifdef __APPLE__
 #include <sys/sysctl.h>
@@ -486,6 +487,9 @@ void DataMgr::copy(AbstractBuffer* destBuffer, AbstractBuffer* srcBuffer) {
 //} /
 
 void DataMgr::checkpoint(const int db_id, const int tb_id) {
+  static auto& checkpoint_seconds = metrics::Registry::instance().histogram(
+      "omnisci_checkpoint_seconds", "Checkpoint latency.", {{"scope", "table"}});
+  const auto clock_begin = std::chrono::steady_clock::now();
   // TODO(adb): do we need a buffer mgr lock here?
   for (auto levelIt = bufferMgrs_.rbegin(); levelIt != bufferMgrs_.rend(); ++levelIt) {
     // use reverse iterator so we start at GPU level, then CPU then DISK
@@ -493,6 +497,7 @@ void DataMgr::checkpoint(const int db_id, const int tb_id) {
       (*deviceIt)->checkpoint(db_id, tb_id);
     }
   }
+  checkpoint_seconds.observeSince(clock_begin);
 }
 
 void DataMgr::checkpoint(const int db_id,
@@ -506,6 +511,9 @@ void DataMgr::checkpoint(const int db_id,
 }
 
 void DataMgr::checkpoint() {
+  static auto& checkpoint_seconds = metrics::Registry::instance().histogram(
+      "omnisci_checkpoint_seconds", "Checkpoint latency.", {{"scope", "all"}});
+  const auto clock_begin = std::chrono::steady_clock::now();
   // TODO(adb): SAA
   for (auto levelIt = bufferMgrs_.rbegin(); levelIt != bufferMgrs_.rend(); ++levelIt) {
     // use reverse iterator so we start at GPU level, then CPU then DISK
@@ -513,6 +521,7 @@ void DataMgr::checkpoint() {
       (*deviceIt)->checkpoint();
     }
   }
+  checkpoint_seconds.observeSince(clock_begin);
 }
 
 void DataMgr::removeTableRelatedDS(const int db_id, const int tb_id) {
@@ -873,13 +873,18 @@ FileBuffer* FileMgr::putBuffer(const ChunkKey& key,
     if (0 == numBytes && !chunk->isDirty()) {
       chunk->setSize(newChunkSize);
     }
-    //@todo use dirty flags to only flush pages of chunk that need to
-    // be flushed
-    chunk->write((int8_t*)srcBuffer->getMemoryPtr(),
-                 newChunkSize,
-                 0,
-                 srcBuffer->getType(),
-                 srcBuffer->getDeviceId());
+    const auto updated_ranges = srcBuffer->getUpdatedRanges();
+    if (!updated_ranges.empty() && !srcBuffer->isAppended() &&
+        newChunkSize == oldChunkSize) {
+      // in place update of a few rows, only rewrite the pages covering them
+      writeUpdatedPages(chunk, srcBuffer, updated_ranges);
+    } else {
+      chunk->write((int8_t*)srcBuffer->getMemoryPtr(),
+                   newChunkSize,
+                   0,
+                   srcBuffer->getType(),
+                   srcBuffer->getDeviceId());
+    }
   } else if (srcBuffer->isAppended()) {
     CHECK_LT(oldChunkSize, newChunkSize);
     chunk->append((int8_t*)srcBuffer->getMemoryPtr() + oldChunkSize,
@@ -897,6 +902,36 @@ FileBuffer* FileMgr::putBuffer(const ChunkKey& key,
   return chunk;
 }
 
+void FileMgr::writeUpdatedPages(FileBuffer* chunk,
+                                AbstractBuffer* srcBuffer,
+                                const std::map<size_t, size_t>& updatedRanges) {
+  const auto page_data_size = chunk->pageDataSize();
+  const auto chunk_size = chunk->size();
+  auto src = reinterpret_cast<int8_t*>(srcBuffer->getMemoryPtr());
+  // Whole pages are written, so that partially updated pages never need their old
+  // contents to be copied into the new page version.
+  auto range_it = updatedRanges.begin();
+  while (range_it != updatedRanges.end()) {
+    CHECK_LE(range_it->second, chunk_size);
+    const size_t start_page = range_it->first / page_data_size;
+    size_t end_page = (range_it->second + page_data_size - 1) / page_data_size;
+    // merge ranges whose pages overlap or are adjacent into one write
+    for (++range_it; range_it != updatedRanges.end() &&
+                     range_it->first / page_data_size <= end_page;
+         ++range_it) {
+      end_page = std::max(end_page,
+                          (range_it->second + page_data_size - 1) / page_data_size);
+    }
+    const size_t offset = start_page * page_data_size;
+    const size_t num_bytes = std::min(end_page * page_data_size, chunk_size) - offset;
+    chunk->write(src + offset,
+                 num_bytes,
+                 offset,
+                 srcBuffer->getType(),
+                 srcBuffer->getDeviceId());
+  }
+}
+
 AbstractBuffer* FileMgr::alloc(const size_t numBytes = 0) {
   LOG(FATAL) << "Operation not supported";
   return nullptr;  // satisfy return-type warning
@@ -441,6 +441,14 @@ class FileMgr : public AbstractBufferMgr {  // implements
                                    size_t pageSize = 0,
                                    const size_t numBytes = 0);
 
+  /**
+   * @brief Writes only the pages of chunk covering the given byte ranges of srcBuffer,
+   * which has been updated in place without changing its size.
+   */
+  void writeUpdatedPages(FileBuffer* chunk,
+                         AbstractBuffer* srcBuffer,
+                         const std::map<size_t, size_t>& updatedRanges);
+
   // Migration functions
   void migrateToLatestFileMgrVersion();
   void migrateEpochFileV0();
@@ -24,6 +24,7 @@
 #include <tbb/task_group.h>
 #include <array>
 #include <future>
+#include <set>
 #include <vector>
 
 #include "Catalog/DataframeTableDescriptor.h"
@@ -66,7 +67,8 @@ class ArrowForeignStorageBase : public PersistentForeignStorageInterface {
                        const TableDescriptor& td,
                        const std::list<ColumnDescriptor>& cols,
                        Data_Namespace::AbstractBufferMgr* mgr,
-                       const arrow::Table& table);
+                       const arrow::Table& table,
+                       const bool align_fragments_to_chunks = false);
 
   std::shared_ptr<arrow::ChunkedArray> createDictionaryEncodedColumn(
       StringDictionary* dict,
@@ -281,37 +283,67 @@ int64_t ArrowForeignStorageBase::makeFragment(
   return varlen;
 }
 
+// Returns the number of rows of each fragment of an arrow column. If
+// align_to_chunks is set, fragments also end at chunk boundaries, so that each fragment
+// of a column chunked like array is a slice of a single arrow chunk and its buffers
+// can be adopted without a copy (see tryZeroCopy).
+std::vector<size_t> calculateFragmentSizes(const arrow::ChunkedArray& array,
+                                           size_t maxFragRows,
+                                           bool align_to_chunks) {
+  std::vector<size_t> fragment_sizes;
+  size_t frag_rows = 0;
+  for (const auto& chunk : array.chunks()) {
+    size_t chunk_rows = chunk->length();
+    while (chunk_rows) {
+      const auto rows = std::min(chunk_rows, maxFragRows - frag_rows);
+      frag_rows += rows;
+      chunk_rows -= rows;
+      if (frag_rows == maxFragRows) {
+        fragment_sizes.push_back(frag_rows);
+        frag_rows = 0;
+      }
+    }
+    if (align_to_chunks && frag_rows) {
+      fragment_sizes.push_back(frag_rows);
+      frag_rows = 0;
+    }
+  }
+  if (frag_rows) {
+    fragment_sizes.push_back(frag_rows);
+  }
+  return fragment_sizes;
+}
+
 std::vector<Frag> calculateFragmentsOffsets(const arrow::ChunkedArray& array,
-                                            size_t maxFragRows) {
+                                            const std::vector<size_t>& fragment_sizes) {
   std::vector<Frag> fragments;
-  size_t sz = 0;
-  size_t offset = 0;
-  fragments.push_back({0, 0, 0, 0});
-  size_t num_chunks = (size_t)array.num_chunks();
-  for (size_t i = 0; i < num_chunks;) {
-    auto& chunk = *array.chunk(i);
-    auto& frag = *fragments.rbegin();
-    if (maxFragRows - sz > chunk.length() - offset) {
-      sz += chunk.length() - offset;
-      if (i == num_chunks - 1) {
-        fragments.rbegin()->last_chunk = num_chunks - 1;
-        fragments.rbegin()->last_chunk_size =
-            array.chunk((int)num_chunks - 1)->length() - offset;
+  const size_t num_chunks = (size_t)array.num_chunks();
+  size_t chunk_idx = 0;
+  size_t chunk_offset = 0;
+  for (const auto fragment_size : fragment_sizes) {
+    // start the fragment at the next non-exhausted chunk
+    while (chunk_idx < num_chunks &&
+           chunk_offset == (size_t)array.chunk(chunk_idx)->length()) {
+      ++chunk_idx;
+      chunk_offset = 0;
+    }
+    Frag frag{chunk_idx, chunk_offset, chunk_idx, 0};
+    size_t rows_left = fragment_size;
+    while (true) {
+      CHECK_LT(chunk_idx, num_chunks);
+      const auto rows = std::min(
+          rows_left, (size_t)array.chunk(chunk_idx)->length() - chunk_offset);
+      frag.last_chunk = chunk_idx;
+      frag.last_chunk_size = rows;
+      chunk_offset += rows;
+      rows_left -= rows;
+      if (!rows_left) {
+        break;
       }
-      offset = 0;
-      i++;
-    } else {
-      frag.last_chunk = i;
-      frag.last_chunk_size = maxFragRows - sz;
-      offset += maxFragRows - sz;
-      sz = 0;
-      fragments.push_back({i, offset, 0, 0});
+      ++chunk_idx;
+      chunk_offset = 0;
     }
-  }
-  if (fragments.rbegin()->first_chunk == fragments.rbegin()->first_chunk &&
-      fragments.rbegin()->last_chunk_size == 0) {
-    // remove empty fragment at the end if any
-    fragments.pop_back();
+    fragments.push_back(frag);
   }
   return fragments;
 }
@@ -322,7 +354,8 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
                                               const TableDescriptor& td,
                                               const std::list<ColumnDescriptor>& cols,
                                               Data_Namespace::AbstractBufferMgr* mgr,
-                                              const arrow::Table& table) {
+                                              const arrow::Table& table,
+                                              const bool align_fragments_to_chunks) {
   std::map<std::array<int, 3>, StringDictionary*> dictionaries;
   for (auto& c : cols) {
     std::array<int, 3> col_key{table_key.first, table_key.second, c.columnId};
@@ -335,11 +368,19 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
     }
   }
 
+  // all columns share the fragment sizes, which follow the chunks of the first column
+  // if aligned. converted columns come in a single chunk and remain copy-free slices.
+  const auto fragment_sizes =
+      table.num_columns() ? calculateFragmentSizes(
+                                *table.column(0), td.maxFragRows, align_fragments_to_chunks)
+                          : std::vector<size_t>{};
+
   tbb::task_group tg;
 
   tbb::parallel_for(
       tbb::blocked_range(0, (int)cols.size()),
-      [this, &tg, &table_key, &td, mgr, &table, &cols, &dictionaries](auto range) {
+      [this, &tg, &table_key, &td, mgr, &table, &cols, &dictionaries, &fragment_sizes](
+          auto range) {
         auto columnIter = std::next(cols.begin(), range.begin());
         for (auto col_idx = range.begin(); col_idx != range.end(); col_idx++) {
           auto& c = *(columnIter++);
@@ -400,7 +441,7 @@ void ArrowForeignStorageBase::parseArrowTable(Catalog_Namespace::Catalog* catalo
               arr_col_chunked_array->null_count() == arr_col_chunked_array->length();
 
           auto fragments =
-              calculateFragmentsOffsets(*arr_col_chunked_array, td.maxFragRows);
+              calculateFragmentsOffsets(*arr_col_chunked_array, fragment_sizes);
 
           auto ctype = c.columnType.get_type();
           auto& col = m_columns[col_key];
@@ -755,10 +796,13 @@ class ArrowForeignStorage : public ArrowForeignStorageBase {
   std::string name;
 
   static std::map<std::string, std::shared_ptr<arrow::Table>> tables;
+  // tables whose fragments follow their record batches
+  static std::set<std::string> batch_aligned_tables;
 };
 
 std::map<std::string, std::shared_ptr<arrow::Table>> ArrowForeignStorage::tables =
     std::map<std::string, std::shared_ptr<arrow::Table>>();
+std::set<std::string> ArrowForeignStorage::batch_aligned_tables;
 
 static SQLTypeInfo getOmnisciType(const arrow::DataType& type) {
   using namespace arrow;
@@ -840,7 +884,14 @@ void ArrowForeignStorage::registerTable(Catalog_Namespace::Catalog* catalog,
                                         const TableDescriptor& td,
                                         const std::list<ColumnDescriptor>& cols,
                                         Data_Namespace::AbstractBufferMgr* mgr) {
-  parseArrowTable(catalog, table_key, info, td, cols, mgr, *(tables[name].get()));
+  parseArrowTable(catalog,
+                  table_key,
+                  info,
+                  td,
+                  cols,
+                  mgr,
+                  *(tables[name].get()),
+                  batch_aligned_tables.count(name) > 0);
 }
 
 std::string ArrowForeignStorage::getType() const {
@@ -849,12 +900,18 @@ std::string ArrowForeignStorage::getType() const {
   return "ARROW";
 }
 
-void setArrowTable(std::string name, std::shared_ptr<arrow::Table> table) {
+void setArrowTable(std::string name,
+                   std::shared_ptr<arrow::Table> table,
+                   const bool align_fragments_to_batches) {
   ArrowForeignStorage::tables[name] = table;
+  if (align_fragments_to_batches) {
+    ArrowForeignStorage::batch_aligned_tables.insert(name);
+  }
 }
 
 void releaseArrowTable(std::string name) {
   ArrowForeignStorage::tables.erase(name);
+  ArrowForeignStorage::batch_aligned_tables.erase(name);
 }
 
 void registerArrowForeignStorage(std::shared_ptr<ForeignStorageInterface> fsi) {
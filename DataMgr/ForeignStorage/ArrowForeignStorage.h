@@ -18,6 +18,7 @@
 #include <arrow/api.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "ForeignStorageInterface.h"
 
@@ -25,6 +26,15 @@ void registerArrowCsvForeignStorage(std::shared_ptr<ForeignStorageInterface> fsi
 
 void registerArrowForeignStorage(std::shared_ptr<ForeignStorageInterface> fsi);
 
-void setArrowTable(std::string name, std::shared_ptr<arrow::Table> table);
+// If align_fragments_to_batches is set, table fragments do not span record batches of
+// the arrow table, so that fixed width columns are read from arrow buffers in place.
+void setArrowTable(std::string name,
+                   std::shared_ptr<arrow::Table> table,
+                   const bool align_fragments_to_batches = false);
 
 void releaseArrowTable(std::string name);
+
+// Returns the number of rows of each fragment of an arrow column, see setArrowTable.
+std::vector<size_t> calculateFragmentSizes(const arrow::ChunkedArray& array,
+                                           size_t maxFragRows,
+                                           bool align_to_chunks);
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CacheAdmissionPolicy.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Logger/Logger.h"
+
+namespace foreign_storage {
+
+namespace {
+constexpr uint64_t kRowSeeds[] = {0xcbf29ce484222325ULL,
+                                  0x9e3779b97f4a7c15ULL,
+                                  0xc2b2ae3d27d4eb4fULL,
+                                  0x165667b19e3779f9ULL};
+}  // namespace
+
+FrequencySketch::FrequencySketch(const size_t width)
+    : width_(width), sample_size_(10 * width), num_increments_(0) {
+  // Indexes are computed by masking hashes
+  CHECK(width_ > 0 && (width_ & (width_ - 1)) == 0);
+  counters_.resize(kRows * width_, 0);
+}
+
+size_t FrequencySketch::getIndex(const ChunkKey& chunk_key, const size_t row) const {
+  uint64_t hash = kRowSeeds[row];
+  for (const auto id : chunk_key) {
+    hash = (hash ^ static_cast<uint32_t>(id)) * 0x100000001b3ULL;
+  }
+  hash ^= hash >> 29;
+  return row * width_ + (hash & (width_ - 1));
+}
+
+void FrequencySketch::increment(const ChunkKey& chunk_key) {
+  for (size_t row = 0; row < kRows; row++) {
+    auto& counter = counters_[getIndex(chunk_key, row)];
+    if (counter < kMaxCount) {
+      counter++;
+    }
+  }
+  if (++num_increments_ >= sample_size_) {
+    halve();
+  }
+}
+
+uint8_t FrequencySketch::estimate(const ChunkKey& chunk_key) const {
+  uint8_t count = kMaxCount;
+  for (size_t row = 0; row < kRows; row++) {
+    count = std::min(count, counters_[getIndex(chunk_key, row)]);
+  }
+  return count;
+}
+
+void FrequencySketch::halve() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  num_increments_ /= 2;
+}
+
+void FrequencySketch::clear() {
+  std::fill(counters_.begin(), counters_.end(), 0);
+  num_increments_ = 0;
+}
+
+CacheAdmissionPolicy::CacheAdmissionPolicy(const size_t size_limit,
+                                           const size_t table_size_limit)
+    : size_limit_(size_limit), table_size_limit_(table_size_limit), cached_size_(0) {}
+
+void CacheAdmissionPolicy::recordAccess(const ChunkKey& chunk_key) {
+  std::lock_guard lock(mutex_);
+  sketch_.increment(chunk_key);
+  auto it = cached_chunks_.find(chunk_key);
+  if (it != cached_chunks_.end()) {
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_position);
+  }
+}
+
+bool CacheAdmissionPolicy::admit(const ChunkKey& chunk_key,
+                                 const size_t size,
+                                 const std::set<ChunkKey>& excluded_keys,
+                                 std::vector<ChunkKey>& victims) {
+  std::lock_guard lock(mutex_);
+  victims.clear();
+  if (!isSizeLimited()) {
+    return true;
+  }
+  if ((size_limit_ > 0 && size > size_limit_) ||
+      (table_size_limit_ > 0 && size > table_size_limit_)) {
+    return false;
+  }
+
+  std::set<ChunkKey> victim_set;
+  size_t freed_size = 0;
+  if (table_size_limit_ > 0) {
+    const auto table_key = get_table_key(chunk_key);
+    auto it = size_per_table_.find(table_key);
+    const size_t table_size = (it == size_per_table_.end()) ? 0 : it->second;
+    if (table_size + size > table_size_limit_) {
+      const auto space_needed = table_size + size - table_size_limit_;
+      freed_size += pickVictims(space_needed, &table_key, excluded_keys, victim_set);
+      if (freed_size < space_needed) {
+        return false;
+      }
+    }
+  }
+  if (size_limit_ > 0 && cached_size_ - freed_size + size > size_limit_) {
+    const auto space_needed = cached_size_ - freed_size + size - size_limit_;
+    if (pickVictims(space_needed, nullptr, excluded_keys, victim_set) < space_needed) {
+      return false;
+    }
+  }
+
+  // The candidate has to be requested more often than every chunk it would displace.
+  const auto frequency = sketch_.estimate(chunk_key);
+  for (const auto& victim : victim_set) {
+    if (sketch_.estimate(victim) >= frequency) {
+      return false;
+    }
+  }
+  victims.assign(victim_set.begin(), victim_set.end());
+  return true;
+}
+
+size_t CacheAdmissionPolicy::pickVictims(const size_t space_needed,
+                                         const ChunkKey* table_key,
+                                         const std::set<ChunkKey>& excluded_keys,
+                                         std::set<ChunkKey>& victims) const {
+  size_t freed_size = 0;
+  for (auto it = lru_list_.rbegin(); it != lru_list_.rend() && freed_size < space_needed;
+       ++it) {
+    if ((table_key && !in_same_table(*it, *table_key)) ||
+        excluded_keys.find(*it) != excluded_keys.end() ||
+        victims.find(*it) != victims.end()) {
+      continue;
+    }
+    victims.emplace(*it);
+    freed_size += cached_chunks_.at(*it).size;
+  }
+  return freed_size;
+}
+
+void CacheAdmissionPolicy::insert(const ChunkKey& chunk_key, const size_t size) {
+  std::lock_guard lock(mutex_);
+  auto& table_size = size_per_table_[get_table_key(chunk_key)];
+  auto it = cached_chunks_.find(chunk_key);
+  if (it != cached_chunks_.end()) {
+    cached_size_ -= it->second.size;
+    table_size -= it->second.size;
+    it->second.size = size;
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_position);
+  } else {
+    lru_list_.emplace_front(chunk_key);
+    cached_chunks_.emplace(chunk_key, CachedChunk{size, lru_list_.begin()});
+  }
+  cached_size_ += size;
+  table_size += size;
+}
+
+void CacheAdmissionPolicy::erase(const ChunkKey& chunk_key) {
+  std::lock_guard lock(mutex_);
+  eraseUnlocked(chunk_key);
+}
+
+void CacheAdmissionPolicy::eraseUnlocked(const ChunkKey& chunk_key) {
+  auto it = cached_chunks_.find(chunk_key);
+  if (it == cached_chunks_.end()) {
+    return;
+  }
+  const auto table_key = get_table_key(chunk_key);
+  cached_size_ -= it->second.size;
+  auto table_it = size_per_table_.find(table_key);
+  CHECK(table_it != size_per_table_.end());
+  table_it->second -= it->second.size;
+  lru_list_.erase(it->second.lru_position);
+  cached_chunks_.erase(it);
+}
+
+void CacheAdmissionPolicy::eraseTable(const ChunkKey& table_key) {
+  CHECK(is_table_key(table_key));
+  std::lock_guard lock(mutex_);
+  ChunkKey upper_prefix(table_key);
+  upper_prefix.push_back(std::numeric_limits<int>::max());
+  auto end_it = cached_chunks_.upper_bound(upper_prefix);
+  std::vector<ChunkKey> chunk_keys;
+  for (auto it = cached_chunks_.lower_bound(table_key); it != end_it; ++it) {
+    chunk_keys.emplace_back(it->first);
+  }
+  for (const auto& chunk_key : chunk_keys) {
+    eraseUnlocked(chunk_key);
+  }
+  size_per_table_.erase(table_key);
+}
+
+void CacheAdmissionPolicy::clear() {
+  std::lock_guard lock(mutex_);
+  sketch_.clear();
+  lru_list_.clear();
+  cached_chunks_.clear();
+  size_per_table_.clear();
+  cached_size_ = 0;
+}
+
+std::vector<ChunkKey> CacheAdmissionPolicy::getOverflowVictims(
+    const std::set<ChunkKey>& excluded_keys) {
+  std::lock_guard lock(mutex_);
+  std::set<ChunkKey> victims;
+  size_t freed_size = 0;
+  if (table_size_limit_ > 0) {
+    for (const auto& [table_key, table_size] : size_per_table_) {
+      if (table_size > table_size_limit_) {
+        freed_size += pickVictims(
+            table_size - table_size_limit_, &table_key, excluded_keys, victims);
+      }
+    }
+  }
+  if (size_limit_ > 0 && cached_size_ - freed_size > size_limit_) {
+    pickVictims(cached_size_ - freed_size - size_limit_, nullptr, excluded_keys, victims);
+  }
+  return {victims.begin(), victims.end()};
+}
+
+size_t CacheAdmissionPolicy::getCachedSize() const {
+  std::lock_guard lock(mutex_);
+  return cached_size_;
+}
+
+size_t CacheAdmissionPolicy::getCachedSizeForTable(const ChunkKey& table_key) const {
+  std::lock_guard lock(mutex_);
+  auto it = size_per_table_.find(table_key);
+  return (it == size_per_table_.end()) ? 0 : it->second;
+}
+
+}  // namespace foreign_storage
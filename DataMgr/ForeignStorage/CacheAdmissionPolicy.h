@@ -0,0 +1,130 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file	CacheAdmissionPolicy.h
+ *
+ * Admission and eviction policy of the disk cache. Chunks are evicted in least recently
+ * used order, but a chunk is only admitted at the expense of cached chunks if it has been
+ * requested more often than all of them (TinyLFU). Request frequencies are tracked in a
+ * small count-min sketch whose counters are halved periodically, so a single large scan
+ * cannot displace chunks that are read over and over. The policy can also cap the space
+ * used by any single table.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "Shared/types.h"
+
+namespace foreign_storage {
+
+/**
+ * Approximate request counts of chunk keys, saturating at 15. All counters are halved
+ * once the number of recorded requests reaches ten times the sketch width, which ages
+ * out frequencies of chunks that stopped being requested.
+ */
+class FrequencySketch {
+ public:
+  FrequencySketch(const size_t width = 1 << 16);
+
+  void increment(const ChunkKey& chunk_key);
+  uint8_t estimate(const ChunkKey& chunk_key) const;
+  void clear();
+
+ private:
+  size_t getIndex(const ChunkKey& chunk_key, const size_t row) const;
+  void halve();
+
+  static constexpr size_t kRows = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  const size_t width_;
+  const size_t sample_size_;
+  size_t num_increments_;
+  std::vector<uint8_t> counters_;
+};
+
+class CacheAdmissionPolicy {
+ public:
+  /**
+   * @param size_limit - maximum total size of cached chunks, 0 if unlimited
+   * @param table_size_limit - maximum size of cached chunks per table, 0 if unlimited
+   */
+  CacheAdmissionPolicy(const size_t size_limit, const size_t table_size_limit);
+
+  // Records a request for the given chunk, whether or not it is cached.
+  void recordAccess(const ChunkKey& chunk_key);
+
+  /**
+   * Decides whether chunks of the given size, requested through chunk_key, should be
+   * cached. On admission, victims is set to the cached chunks which have to be evicted to
+   * make room for them. Keys in excluded_keys are never picked as victims.
+   */
+  bool admit(const ChunkKey& chunk_key,
+             const size_t size,
+             const std::set<ChunkKey>& excluded_keys,
+             std::vector<ChunkKey>& victims);
+
+  // Records a chunk added to the cache (or a size update of a cached chunk).
+  void insert(const ChunkKey& chunk_key, const size_t size);
+
+  void erase(const ChunkKey& chunk_key);
+  void eraseTable(const ChunkKey& table_key);
+  void clear();
+
+  /**
+   * Returns the least recently used chunks which have to be evicted for the cache to fit
+   * within its limits again, e.g. after chunks were cached based on a size estimate.
+   */
+  std::vector<ChunkKey> getOverflowVictims(const std::set<ChunkKey>& excluded_keys);
+
+  size_t getCachedSize() const;
+  size_t getCachedSizeForTable(const ChunkKey& table_key) const;
+  inline bool isSizeLimited() const { return size_limit_ > 0 || table_size_limit_ > 0; }
+
+ private:
+  struct CachedChunk {
+    size_t size;
+    std::list<ChunkKey>::iterator lru_position;
+  };
+
+  // Adds least recently used chunks to victims until space_needed bytes are freed.
+  size_t pickVictims(const size_t space_needed,
+                     const ChunkKey* table_key,
+                     const std::set<ChunkKey>& excluded_keys,
+                     std::set<ChunkKey>& victims) const;
+  void eraseUnlocked(const ChunkKey& chunk_key);
+
+  const size_t size_limit_;
+  const size_t table_size_limit_;
+
+  mutable std::mutex mutex_;
+  FrequencySketch sketch_;
+  // Most recently used chunks first
+  std::list<ChunkKey> lru_list_;
+  std::map<ChunkKey, CachedChunk> cached_chunks_;
+  std::map<ChunkKey, size_t> size_per_table_;
+  size_t cached_size_;
+};
+
+}  // namespace foreign_storage
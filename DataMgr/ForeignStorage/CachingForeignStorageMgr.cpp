@@ -65,8 +65,33 @@ void CachingForeignStorageMgr::fetchBuffer(const ChunkKey& chunk_key,
 
   createOrRecoverDataWrapperIfNotExists(chunk_key);
 
+  // Chunks read alongside an uncached chunk below may be waiting in a temp buffer.
+  if (fetchBufferIfTempBufferMapEntryExists(chunk_key, destination_buffer, num_bytes)) {
+    return;
+  }
+
   // TODO: Populate optional buffers as part of CSV performance improvement
   std::vector<ChunkKey> chunk_keys = get_keys_vec_from_table(chunk_key);
+
+  // Scans marked as one-time and chunks refused by the admission policy are read into
+  // temp buffers, leaving the cache as it is.
+  if (DiskCacheBypassScope::isBypassed()) {
+    disk_cache_->recordCacheBypass(chunk_key, chunk_keys.size());
+    ForeignStorageMgr::fetchBuffer(chunk_key, destination_buffer, num_bytes);
+    return;
+  }
+  if (!disk_cache_->admitChunks(chunk_key, chunk_keys)) {
+    ForeignStorageMgr::fetchBuffer(chunk_key, destination_buffer, num_bytes);
+    return;
+  }
+
+  // Some chunks of the column may still be cached if the others were evicted.
+  for (const auto& key : chunk_keys) {
+    if (key != chunk_key && disk_cache_->getCachedChunkIfExists(key) != nullptr) {
+      disk_cache_->evictThenEraseChunk(key);
+    }
+  }
+
   std::vector<ChunkKey> optional_keys;
   ChunkToBufferMap optional_buffers;
 
@@ -173,6 +198,8 @@ void CachingForeignStorageMgr::refreshAppendTableInCache(
 
   ChunkMetadataVector storage_metadata;
   getChunkMetadataVecForKeyPrefix(storage_metadata, table_key);
+  // The data wrapper falls back to a full scan if previously scanned data changed
+  last_frag_id = std::min(last_frag_id, getFirstChangedFragmentId(table_key));
   try {
     disk_cache_->cacheMetadataWithFragIdGreaterOrEqualTo(storage_metadata, last_frag_id);
     refreshChunksInCacheByFragment(old_chunk_keys, last_frag_id);
@@ -35,10 +35,14 @@
 #include "Utils/DdlUtils.h"
 
 namespace foreign_storage {
-CsvDataWrapper::CsvDataWrapper() : db_id_(-1), foreign_table_(nullptr) {}
+CsvDataWrapper::CsvDataWrapper()
+    : db_id_(-1), foreign_table_(nullptr), first_changed_fragment_id_(0) {}
 
 CsvDataWrapper::CsvDataWrapper(const int db_id, const ForeignTable* foreign_table)
-    : db_id_(db_id), foreign_table_(foreign_table), is_restored_(false) {}
+    : db_id_(db_id)
+    , foreign_table_(foreign_table)
+    , is_restored_(false)
+    , first_changed_fragment_id_(0) {}
 
 void CsvDataWrapper::validateTableOptions(const ForeignTable* foreign_table) const {
   AbstractFileStorageDataWrapper::validateTableOptions(foreign_table);
@@ -789,6 +793,93 @@ void dispatch_metadata_scan_requests(
   multi_threading_params.pending_requests_condition.notify_all();
 }
 
+/**
+ * Blocks are read with positional reads, which are only supported for a single
+ * uncompressed file whose scan has not started.
+ */
+bool can_read_blocks_concurrently(CsvReader& csv_reader,
+                                  const import_export::CopyParams& copy_params,
+                                  const size_t thread_count,
+                                  const size_t buffer_size) {
+  // Remaining size includes a byte reserved for a missing delimiter at the end
+  return csv_reader.isPositionalReadSupported() &&
+         import_export::delimited_parser::can_scan_blocks_concurrently(
+             copy_params, thread_count, csv_reader.getRemainingSize() - 1, buffer_size);
+}
+
+/**
+ * Variant of dispatch_metadata_scan_requests for a single uncompressed file, which is
+ * split into blocks read and scanned for row endings by several threads at once. Blocks
+ * are then assembled into row aligned metadata scan requests in file order, carrying
+ * over the partial row at the end of each block.
+ */
+void dispatch_metadata_scan_requests_from_blocks(
+    const size_t& buffer_size,
+    const size_t thread_count,
+    CsvReader& csv_reader,
+    const import_export::CopyParams& copy_params,
+    MetadataScanMultiThreadingParams& multi_threading_params,
+    size_t& first_row_index_in_buffer,
+    size_t& current_file_offset) {
+  CHECK(csv_reader.isPositionalReadSupported());
+  const auto start_file_offset = current_file_offset;
+  const auto scanned_size = import_export::delimited_parser::scan_blocks_concurrently(
+      csv_reader.getRemainingSize() - 1,
+      buffer_size,
+      thread_count,
+      copy_params,
+      first_row_index_in_buffer,
+      [&csv_reader](char* buffer, size_t offset, size_t max_size) {
+        return csv_reader.readAt(buffer, offset, max_size);
+      },
+      [&](const char* carried_over_row,
+          size_t carried_over_size,
+          const char* rows,
+          size_t rows_size,
+          unsigned int row_count) {
+        const auto size = carried_over_size + rows_size;
+        auto request = get_request_from_pool(multi_threading_params);
+        if (request.buffer_alloc_size < size) {
+          request.buffer = std::make_unique<char[]>(size);
+          request.buffer_alloc_size = size;
+        }
+        if (carried_over_size > 0) {
+          memcpy(request.buffer.get(), carried_over_row, carried_over_size);
+        }
+        memcpy(request.buffer.get() + carried_over_size, rows, rows_size);
+        request.begin_pos = 0;
+        request.end_pos = size;
+        request.buffer_size = size;
+        request.first_row_index = first_row_index_in_buffer;
+        request.file_offset = current_file_offset;
+        request.buffer_row_count = row_count;
+
+        current_file_offset += size;
+        first_row_index_in_buffer += row_count;
+        dispatch_metadata_scan_request(multi_threading_params, request);
+
+        std::lock_guard<std::mutex> pending_requests_lock(
+            multi_threading_params.pending_requests_mutex);
+        return multi_threading_params.continue_processing;
+      });
+  if (scanned_size.has_value()) {
+    // Also counts an extra line delimiter at the end of the file
+    current_file_offset = start_file_offset + scanned_size.value();
+    csv_reader.finishPositionalScan(scanned_size.value());
+  }
+
+  std::unique_lock<std::mutex> pending_requests_queue_lock(
+      multi_threading_params.pending_requests_mutex);
+  multi_threading_params.pending_requests_condition.wait(
+      pending_requests_queue_lock, [&multi_threading_params] {
+        return multi_threading_params.pending_requests.empty() ||
+               (multi_threading_params.continue_processing == false);
+      });
+  multi_threading_params.continue_processing = false;
+  pending_requests_queue_lock.unlock();
+  multi_threading_params.pending_requests_condition.notify_all();
+}
+
 namespace {
 // Create metadata for unscanned columns
 // Any fragments with any updated rows between start_row and num_rows will be updated
@@ -856,7 +947,9 @@ void CsvDataWrapper::populateChunkMetadata(ChunkMetadataVector& chunk_metadata_v
     } else {
       UNREACHABLE();
     }
+    first_changed_fragment_id_ = num_rows_ / foreign_table_->maxFragRows;
   } else {
+    first_changed_fragment_id_ = 0;
     chunk_metadata_map_.clear();
     fragment_id_to_file_regions_map_.clear();
     if (server_options.find(STORAGE_TYPE_KEY)->second == LOCAL_FILE_STORAGE_TYPE) {
@@ -917,13 +1010,24 @@ void CsvDataWrapper::populateChunkMetadata(ChunkMetadataVector& chunk_metadata_v
     }
 
     try {
-      dispatch_metadata_scan_requests(buffer_size,
-                                      file_path,
-                                      (*csv_reader_),
-                                      copy_params,
-                                      multi_threading_params,
-                                      num_rows_,
-                                      append_start_offset_);
+      if (can_read_blocks_concurrently(
+              *csv_reader_, copy_params, thread_count, buffer_size)) {
+        dispatch_metadata_scan_requests_from_blocks(buffer_size,
+                                                    thread_count,
+                                                    (*csv_reader_),
+                                                    copy_params,
+                                                    multi_threading_params,
+                                                    num_rows_,
+                                                    append_start_offset_);
+      } else {
+        dispatch_metadata_scan_requests(buffer_size,
+                                        file_path,
+                                        (*csv_reader_),
+                                        copy_params,
+                                        multi_threading_params,
+                                        num_rows_,
+                                        append_start_offset_);
+      }
     } catch (...) {
       {
         std::unique_lock<std::mutex> pending_requests_lock(
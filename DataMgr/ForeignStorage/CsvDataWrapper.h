@@ -57,6 +57,8 @@ class CsvDataWrapper : public AbstractFileStorageDataWrapper {
     return INTRA_FRAGMENT;
   }
 
+  int getFirstChangedFragmentId() const override { return first_changed_fragment_id_; }
+
  private:
   CsvDataWrapper(const ForeignTable* foreign_table);
 
@@ -97,6 +99,8 @@ class CsvDataWrapper : public AbstractFileStorageDataWrapper {
   size_t append_start_offset_;
   // Is this datawrapper restored from disk
   bool is_restored_;
+  // First fragment with rows added by the last metadata scan
+  int first_changed_fragment_id_;
   static const std::set<std::string_view> csv_table_options_;
 };
 }  // namespace foreign_storage
@@ -15,6 +15,10 @@
  */
 
 #include "DataMgr/ForeignStorage/CsvReader.h"
+
+#include <unistd.h>
+#include <thread>
+
 #include "ForeignDataWrapperShared.h"
 #include "FsiJsonUtils.h"
 
@@ -152,6 +156,48 @@ void SingleFileReader::checkForMoreRows(size_t file_offset,
   }
 }
 
+size_t SingleFileReader::readAt(void* buffer, size_t offset, size_t max_size) {
+  CHECK(isPositionalReadSupported());
+  const auto raw_data_size = getRawDataSize();
+  if (offset >= raw_data_size) {
+    return 0;
+  }
+  const auto size = std::min(max_size, raw_data_size - offset);
+  size_t bytes_read = 0;
+  while (bytes_read < size) {
+    const auto result = pread(fileno(file_),
+                              static_cast<char*>(buffer) + bytes_read,
+                              size - bytes_read,
+                              header_offset_ + offset + bytes_read);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error{"An error occurred when attempting to read offset " +
+                               std::to_string(offset + bytes_read) + " in file: \"" +
+                               file_path_ + "\". " + strerror(errno)};
+    }
+    if (result == 0) {
+      break;
+    }
+    bytes_read += result;
+  }
+  return bytes_read;
+}
+
+void SingleFileReader::finishPositionalScan(size_t scanned_size) {
+  CHECK(isPositionalReadSupported());
+  // Reads include the line delimiter inserted at the end of the file, if any, and
+  // exclude an extra line delimiter removed from the end of the file
+  if (scanned_size + 1 < getRawDataSize() || scanned_size > getRawDataSize() + 1) {
+    throw std::runtime_error{"Scanned " + std::to_string(scanned_size) +
+                             " bytes of the " + std::to_string(getRawDataSize()) +
+                             " bytes of data in file: \"" + file_path_ + "\"."};
+  }
+  total_bytes_read_ = getRawDataSize();
+  scan_finished_ = true;
+}
+
 /**
  * Skip to entry in archive
  */
@@ -197,7 +243,7 @@ char ArchiveWrapper::ArchiveWrapper::peekNextChar() {
 }
 
 void ArchiveWrapper::resetArchive() {
-  arch_.reset(new PosixFileArchive(file_path_, false));
+  arch_.reset(new PosixFileArchive(file_path_, false, thread_count_));
   block_chars_remaining_ = 0;
   // We will increment to 0 when reading first entry
   current_entry_ = -1;
@@ -215,7 +261,9 @@ void ArchiveWrapper::fetchBlock() {
 CompressedFileReader::CompressedFileReader(const std::string& file_path,
                                            const import_export::CopyParams& copy_params)
     : CsvReader(file_path, copy_params)
-    , archive_(file_path)
+    , archive_(file_path,
+               copy_params.threads ? static_cast<size_t>(copy_params.threads)
+                                   : std::thread::hardware_concurrency())
     , initial_scan_(true)
     , scan_finished_(false)
     , current_offset_(0)
@@ -664,6 +712,31 @@ size_t MultiFileReader::read(void* buffer, size_t max_size) {
   return bytes_read;
 }
 
+bool MultiFileReader::isPositionalReadSupported() {
+  return files_.size() == 1 && current_index_ == 0 && current_offset_ == 0 &&
+         files_[0]->isPositionalReadSupported();
+}
+
+size_t MultiFileReader::readAt(void* buffer, size_t offset, size_t max_size) {
+  CHECK(isPositionalReadSupported());
+  auto single_file_reader = dynamic_cast<SingleFileReader*>(files_[0].get());
+  CHECK(single_file_reader);
+  // Leave one extra char in case we need to insert a delimiter
+  size_t bytes_read = single_file_reader->readAt(buffer, offset, max_size - 1);
+  if (offset + bytes_read >= single_file_reader->getRawDataSize()) {
+    adjust_eof(bytes_read, max_size, static_cast<char*>(buffer), copy_params_.line_delim);
+  }
+  return bytes_read;
+}
+
+void MultiFileReader::finishPositionalScan(size_t scanned_size) {
+  CHECK(isPositionalReadSupported());
+  files_[0]->finishPositionalScan(scanned_size);
+  current_offset_ = scanned_size;
+  cumulative_sizes_.push_back(current_offset_);
+  current_index_++;
+}
+
 size_t MultiFileReader::readRegion(void* buffer, size_t offset, size_t size) {
   CHECK(isScanFinished());
   // Get file index
@@ -63,6 +63,36 @@ class CsvReader {
    */
   virtual size_t readRegion(void* buffer, size_t offset, size_t size) = 0;
 
+  /**
+   * @return true if the data left to scan can be read at arbitrary offsets with
+   * readAt(), from several threads at once. This is only the case for a single
+   * uncompressed file whose scan has not started.
+   */
+  virtual bool isPositionalReadSupported() { return false; }
+
+  /**
+   * Read up to max_size bytes of the data left to scan, starting at the given offset,
+   * without moving the scan position. Safe to call from several threads at once.
+   * As with read(), the read that reaches the end of the data is adjusted to end with a
+   * line delimiter.
+   *
+   * @param buffer - buffer to load into
+   * @param offset - starting point into the data left to scan
+   * @param max_size - maximum number of bytes to read into the buffer
+   * @return number of bytes actually read
+   */
+  virtual size_t readAt(void* buffer, size_t offset, size_t max_size) {
+    UNREACHABLE();
+    return 0;
+  }
+
+  /**
+   * Complete a scan done with readAt(), after which readRegion() can be used.
+   *
+   * @param scanned_size - total number of bytes returned by readAt() calls
+   */
+  virtual void finishPositionalScan(size_t scanned_size) { UNREACHABLE(); }
+
   /**
    * @return size of the CSV remaining to be read
    * */
@@ -139,6 +169,17 @@ class SingleFileReader : public CsvReader {
 
   bool isScanFinished() override { return scan_finished_; }
 
+  bool isPositionalReadSupported() override {
+    return !scan_finished_ && total_bytes_read_ == 0;
+  }
+
+  size_t readAt(void* buffer, size_t offset, size_t max_size) override;
+
+  void finishPositionalScan(size_t scanned_size) override;
+
+  // Size of the data in the file, without the byte reserved for a missing delimiter
+  size_t getRawDataSize() const { return data_size_ - 1; }
+
   size_t getRemainingSize() override { return data_size_ - total_bytes_read_; }
 
   bool isRemainingSizeKnown() override { return true; };
@@ -164,11 +205,12 @@ class SingleFileReader : public CsvReader {
 
 class ArchiveWrapper {
  public:
-  ArchiveWrapper(const std::string& file_path)
+  ArchiveWrapper(const std::string& file_path, const size_t thread_count)
       : current_block_(nullptr)
       , block_chars_remaining_(0)
       , current_entry_(-1)
-      , file_path_(file_path) {
+      , file_path_(file_path)
+      , thread_count_(thread_count) {
     resetArchive();
   }
 
@@ -212,6 +254,8 @@ class ArchiveWrapper {
   int current_entry_;
 
   std::string file_path_;
+  // Threads used to decompress BGZF files
+  size_t thread_count_;
 };
 
 // Single archive, does not support random access
@@ -306,6 +350,12 @@ class MultiFileReader : public CsvReader {
 
   bool isScanFinished() override { return (current_index_ >= files_.size()); }
 
+  bool isPositionalReadSupported() override;
+
+  size_t readAt(void* buffer, size_t offset, size_t max_size) override;
+
+  void finishPositionalScan(size_t scanned_size) override;
+
   void serialize(rapidjson::Value& value,
                  rapidjson::Document::AllocatorType& allocator) const override;
 
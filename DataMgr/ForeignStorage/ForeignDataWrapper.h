@@ -18,6 +18,7 @@
 
 #include "DataMgr/ChunkMetadata.h"
 #include "ForeignStorageBuffer.h"
+#include "Shared/sqldefs.h"
 #include "Shared/types.h"
 
 struct ColumnDescriptor;
@@ -27,6 +28,16 @@ struct ForeignTable;
 struct UserMapping;
 using ChunkToBufferMap = std::map<ChunkKey, AbstractBuffer*>;
 
+/**
+ * A comparison of a column against a constant, taken from the simple filters of a query.
+ * Values use the integer representation of the chunk stats of integer and time columns.
+ */
+struct ColumnRangePredicate {
+  int column_id;
+  SQLOps op;
+  int64_t value;
+};
+
 class ForeignDataWrapper {
  public:
   ForeignDataWrapper() = default;
@@ -137,5 +148,25 @@ class ForeignDataWrapper {
    * aware of during data requests.
    */
   virtual ParallelismLevel getNonCachedParallelismLevel() const { return NONE; }
+
+  /**
+   * Checks, using statistics finer grained than the chunk metadata of the fragment,
+   * whether rows of the given fragment may satisfy all of the given predicates. Returning
+   * true is always correct; returning false lets the executor skip the fragment.
+   *
+   * @param fragment_id - fragment to check
+   * @param predicates - predicates which all have to hold for a row to be selected
+   */
+  virtual bool fragmentMayMatch(const int fragment_id,
+                                const std::vector<ColumnRangePredicate>& predicates) const {
+    return true;
+  }
+
+  /**
+   * Gets the first fragment whose chunks may have changed in the last call to
+   * populateChunkMetadata. Append mode scans which only add rows to the last fragment or
+   * add new fragments return the previous last fragment, other scans return 0.
+   */
+  virtual int getFirstChangedFragmentId() const { return 0; }
 };
 }  // namespace foreign_storage
@@ -52,7 +52,9 @@ void set_metadata_for_buffer(AbstractBuffer* buffer, ChunkMetadata* meta) {
 }  // namespace
 
 ForeignStorageCache::ForeignStorageCache(const DiskCacheConfig& config)
-    : num_chunks_added_(0), num_metadata_added_(0) {
+    : admission_policy_(config.size_limit, config.table_size_limit)
+    , num_chunks_added_(0)
+    , num_metadata_added_(0) {
   validatePath(config.path);
   caching_file_mgr_ = std::make_unique<File_Namespace::CachingFileMgr>(
       config.path, config.num_reader_threads);
@@ -65,6 +67,7 @@ void ForeignStorageCache::deleteBufferIfExists(const ChunkKey& chunk_key) {
     caching_file_mgr_->deleteBuffer(chunk_key);
     cached_chunks_.erase(chunk_key);
     cached_metadata_.erase(chunk_key);
+    admission_policy_.erase(chunk_key);
   }
 }
 
@@ -73,12 +76,21 @@ void ForeignStorageCache::cacheChunk(const ChunkKey& chunk_key, AbstractBuffer*
   write_lock chunk_lock(chunks_mutex_);
   // We should only be caching buffers that are in sync with storage.
   CHECK(!buffer->isDirty());
+  std::vector<ChunkKey> victims;
+  if (!admission_policy_.admit(chunk_key, buffer->size(), {chunk_key}, victims)) {
+    getTableCounters(chunk_key).rejections->increment();
+    // a previously cached version of the chunk is out of date once the chunk is reloaded
+    eraseChunk(chunk_key);
+    return;
+  }
+  evictChunksUnlocked(victims);
   buffer->setUpdated();
   num_chunks_added_++;
   caching_file_mgr_->putBuffer(chunk_key, buffer);
   caching_file_mgr_->checkpoint();
   cached_metadata_.emplace(chunk_key);
   cached_chunks_.emplace(chunk_key);
+  admission_policy_.insert(chunk_key, caching_file_mgr_->getBuffer(chunk_key)->size());
   CHECK(!buffer->isDirty());
 }
 
@@ -97,6 +109,12 @@ void ForeignStorageCache::cacheTableChunks(const std::vector<ChunkKey>& chunk_ke
     CHECK(caching_file_mgr_->isBufferOnDevice(chunk_key));
     num_chunks_added_++;
     cached_chunks_.emplace(chunk_key);
+    admission_policy_.insert(chunk_key, caching_file_mgr_->getBuffer(chunk_key)->size());
+  }
+  // Admission was decided on estimated sizes, so the cache may have outgrown its limits.
+  if (admission_policy_.isSizeLimited()) {
+    evictChunksUnlocked(admission_policy_.getOverflowVictims(
+        std::set<ChunkKey>(chunk_keys.begin(), chunk_keys.end())));
   }
   caching_file_mgr_->checkpoint();
 }
@@ -131,6 +149,7 @@ bool ForeignStorageCache::recoverCacheForTable(ChunkMetadataVector& meta_vec,
     // cached.
     if (const auto& buf = caching_file_mgr_->getBuffer(chunk_key); buf->pageCount() > 0) {
       cached_chunks_.emplace(chunk_key);
+      admission_policy_.insert(chunk_key, buf->size());
     }
 
     if (is_varlen_key(chunk_key)) {
@@ -145,9 +164,14 @@ bool ForeignStorageCache::recoverCacheForTable(ChunkMetadataVector& meta_vec,
       if (const auto& buf = caching_file_mgr_->getBuffer(index_chunk_key);
           buf->pageCount() > 0) {
         cached_chunks_.emplace(index_chunk_key);
+        admission_policy_.insert(index_chunk_key, buf->size());
       }
     }
   }
+  // The size limits may have been lowered since the chunks were cached.
+  if (admission_policy_.isSizeLimited()) {
+    evictChunksUnlocked(admission_policy_.getOverflowVictims({}));
+  }
   return (meta_vec.size() > 0);
 }
 
@@ -264,6 +288,7 @@ void ForeignStorageCache::clearForTablePrefix(const ChunkKey& chunk_prefix) {
     for (auto chunk_it = cached_chunks_.lower_bound(chunk_prefix); chunk_it != end_it;) {
       chunk_it = evictChunkByIterator(chunk_it);
     }
+    admission_policy_.eraseTable(chunk_prefix);
   }
   {
     write_lock w_lock(metadata_mutex_);
@@ -284,6 +309,7 @@ void ForeignStorageCache::clear() {
     for (auto chunk_it = cached_chunks_.begin(); chunk_it != cached_chunks_.end();) {
       chunk_it = evictChunkByIterator(chunk_it);
     }
+    admission_policy_.clear();
   }
   {
     write_lock w_lock(metadata_mutex_);
@@ -336,6 +362,25 @@ void ForeignStorageCache::eraseChunk(const ChunkKey& chunk_key) {
       static_cast<File_Namespace::FileBuffer*>(caching_file_mgr_->getBuffer(chunk_key));
   file_buffer->freeChunkPages();
   cached_chunks_.erase(chunk_key);
+  admission_policy_.erase(chunk_key);
+}
+
+void ForeignStorageCache::evictChunksUnlocked(const std::vector<ChunkKey>& chunk_keys) {
+  for (const auto& chunk_key : chunk_keys) {
+    std::vector<ChunkKey> keys_to_evict{chunk_key};
+    // Data and index chunks of variable length columns are evicted together
+    if (is_varlen_key(chunk_key)) {
+      auto sibling_key = chunk_key;
+      sibling_key[4] = is_varlen_data_key(chunk_key) ? 2 : 1;
+      keys_to_evict.emplace_back(sibling_key);
+    }
+    for (const auto& key : keys_to_evict) {
+      if (cached_chunks_.find(key) != cached_chunks_.end()) {
+        eraseChunk(key);
+        getTableCounters(key).evictions->increment();
+      }
+    }
+  }
 }
 
 std::set<ChunkKey>::iterator ForeignStorageCache::evictChunkByIterator(
@@ -343,9 +388,90 @@ std::set<ChunkKey>::iterator ForeignStorageCache::evictChunkByIterator(
   File_Namespace::FileBuffer* file_buffer =
       static_cast<File_Namespace::FileBuffer*>(caching_file_mgr_->getBuffer(*chunk_it));
   file_buffer->freeChunkPages();
+  admission_policy_.erase(*chunk_it);
   return cached_chunks_.erase(chunk_it);
 }
 
+void ForeignStorageCache::recordChunkAccess(const ChunkKey& chunk_key, const bool is_hit) {
+  admission_policy_.recordAccess(chunk_key);
+  const auto& counters = getTableCounters(chunk_key);
+  is_hit ? counters.hits->increment() : counters.misses->increment();
+}
+
+bool ForeignStorageCache::admitChunks(const ChunkKey& chunk_key,
+                                      const std::vector<ChunkKey>& chunk_keys) {
+  if (!admission_policy_.isSizeLimited()) {
+    return true;
+  }
+  write_lock lock(chunks_mutex_);
+  // Buffers of chunks that are not cached yet are sized after their cached metadata.
+  size_t size = 0;
+  for (const auto& key : chunk_keys) {
+    if (caching_file_mgr_->isBufferOnDevice(key)) {
+      size += caching_file_mgr_->getBuffer(key)->size();
+    }
+  }
+  std::vector<ChunkKey> victims;
+  if (!admission_policy_.admit(chunk_key,
+                               size,
+                               std::set<ChunkKey>(chunk_keys.begin(), chunk_keys.end()),
+                               victims)) {
+    getTableCounters(chunk_key).rejections->increment(chunk_keys.size());
+    return false;
+  }
+  evictChunksUnlocked(victims);
+  return true;
+}
+
+void ForeignStorageCache::recordCacheBypass(const ChunkKey& chunk_key,
+                                            const size_t num_chunks) {
+  getTableCounters(chunk_key).bypasses->increment(num_chunks);
+}
+
+TableCacheStats ForeignStorageCache::getTableCacheStats(const ChunkKey& table_key) const {
+  const auto& counters = getTableCounters(table_key);
+  TableCacheStats stats;
+  stats.hits = counters.hits->value();
+  stats.misses = counters.misses->value();
+  stats.bypasses = counters.bypasses->value();
+  stats.rejections = counters.rejections->value();
+  stats.evictions = counters.evictions->value();
+  return stats;
+}
+
+const ForeignStorageCache::TableCacheCounters& ForeignStorageCache::getTableCounters(
+    const ChunkKey& chunk_key) const {
+  const auto table_key = get_table_key(chunk_key);
+  std::lock_guard lock(table_counters_mutex_);
+  auto it = table_counters_.find(table_key);
+  if (it == table_counters_.end()) {
+    auto& registry = metrics::Registry::instance();
+    const metrics::Labels labels{{"db_id", std::to_string(table_key[CHUNK_KEY_DB_IDX])},
+                                 {"table_id",
+                                  std::to_string(table_key[CHUNK_KEY_TABLE_IDX])}};
+    TableCacheCounters counters;
+    counters.hits = &registry.counter("omnisci_disk_cache_hits_total",
+                                      "Chunk requests served from the disk cache.",
+                                      labels);
+    counters.misses = &registry.counter(
+        "omnisci_disk_cache_misses_total",
+        "Chunk requests which had to read the chunk from storage.",
+        labels);
+    counters.bypasses = &registry.counter(
+        "omnisci_disk_cache_bypasses_total",
+        "Chunks read without caching for scans marked as one-time.",
+        labels);
+    counters.rejections =
+        &registry.counter("omnisci_disk_cache_rejections_total",
+                          "Chunks the disk cache admission policy refused to cache.",
+                          labels);
+    counters.evictions = &registry.counter(
+        "omnisci_disk_cache_evictions_total", "Chunks evicted from the disk cache.", labels);
+    it = table_counters_.emplace(table_key, counters).first;
+  }
+  return it->second;
+}
+
 std::string ForeignStorageCache::dumpCachedChunkEntries() const {
   std::string ret_string = "Cached chunks:\n";
   for (const auto& chunk_key : cached_chunks_) {
@@ -26,9 +26,11 @@
 #pragma once
 
 #include "../Shared/mapd_shared_mutex.h"
+#include "CacheAdmissionPolicy.h"
 #include "DataMgr/AbstractBufferMgr.h"
 #include "DataMgr/FileMgr/CachingFileMgr.h"
 #include "ForeignDataWrapper.h"
+#include "Shared/Metrics.h"
 
 class CacheTooSmallException : public std::runtime_error {
  public:
@@ -40,6 +42,9 @@ struct DiskCacheConfig {
   std::string path;
   DiskCacheLevel enabled_level = DiskCacheLevel::none;
   size_t num_reader_threads = 0;
+  // Maximum size of cached chunks in bytes, in total and per table (0 if unlimited)
+  size_t size_limit = 0;
+  size_t table_size_limit = 0;
   inline bool isEnabledForMutableTables() const {
     return enabled_level == DiskCacheLevel::non_fsi ||
            enabled_level == DiskCacheLevel::all;
@@ -56,6 +61,17 @@ namespace foreign_storage {
 
 const std::string wrapper_file_name = "wrapper_metadata.json";
 
+// Cache activity for a table since server start.
+struct TableCacheStats {
+  uint64_t hits{0};
+  uint64_t misses{0};
+  // Chunks read without caching because the scan was marked as one-time
+  uint64_t bypasses{0};
+  // Chunks the admission policy refused to cache
+  uint64_t rejections{0};
+  uint64_t evictions{0};
+};
+
 class ForeignStorageCache {
  public:
   ForeignStorageCache(const DiskCacheConfig& config);
@@ -114,14 +130,42 @@ class ForeignStorageCache {
     return caching_file_mgr_->getSpaceReservedByTable(db_id, tb_id);
   }
 
+  /**
+   * Records a request for a chunk made while executing a query, which feeds the
+   * admission policy and the hit statistics of the table.
+   */
+  void recordChunkAccess(const ChunkKey& chunk_key, const bool is_hit);
+
+  /**
+   * Decides whether the given chunks, fetched on a request for chunk_key, should be
+   * cached, evicting other chunks to make room for them if they are. Chunks that are not
+   * admitted should be read into temporary buffers instead.
+   */
+  bool admitChunks(const ChunkKey& chunk_key, const std::vector<ChunkKey>& chunk_keys);
+
+  void recordCacheBypass(const ChunkKey& chunk_key, const size_t num_chunks);
+
+  TableCacheStats getTableCacheStats(const ChunkKey& table_key) const;
+
+  inline size_t getCachedChunksSize() const { return admission_policy_.getCachedSize(); }
+
  private:
+  struct TableCacheCounters {
+    metrics::Counter* hits;
+    metrics::Counter* misses;
+    metrics::Counter* bypasses;
+    metrics::Counter* rejections;
+    metrics::Counter* evictions;
+  };
   // These methods are private and assume locks are already acquired when called.
   std::set<ChunkKey>::iterator eraseChunk(const std::set<ChunkKey>::iterator&);
   void eraseChunk(const ChunkKey& chunk_key);
   std::set<ChunkKey>::iterator evictChunkByIterator(
       const std::set<ChunkKey>::iterator& chunk_it);
   void evictThenEraseChunkUnlocked(const ChunkKey&);
+  void evictChunksUnlocked(const std::vector<ChunkKey>& chunk_keys);
   void validatePath(const std::string&) const;
+  const TableCacheCounters& getTableCounters(const ChunkKey& chunk_key) const;
 
   // Underlying storage is handled by a CachingFileMgr unique to the cache.
   std::unique_ptr<File_Namespace::CachingFileMgr> caching_file_mgr_;
@@ -130,6 +174,11 @@ class ForeignStorageCache {
   std::set<ChunkKey> cached_chunks_;
   std::set<ChunkKey> cached_metadata_;
 
+  CacheAdmissionPolicy admission_policy_;
+
+  mutable std::mutex table_counters_mutex_;
+  mutable std::map<ChunkKey, TableCacheCounters> table_counters_;
+
   // Keeps tracks of how many times we cache chunks or metadata for testing purposes.
   size_t num_chunks_added_;
   size_t num_metadata_added_;
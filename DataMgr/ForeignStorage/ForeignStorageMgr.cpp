@@ -410,6 +410,63 @@ void ForeignStorageMgr::setParallelismHints(
   parallelism_hints_per_table_ = hints_per_table;
 }
 
+namespace {
+thread_local bool t_disk_cache_bypass{false};
+thread_local std::set<ChunkKey> t_prefetch_excluded_column_keys;
+}  // namespace
+
+DiskCacheBypassScope::DiskCacheBypassScope(const bool bypass)
+    : previous_bypass_(t_disk_cache_bypass) {
+  t_disk_cache_bypass = bypass;
+}
+
+DiskCacheBypassScope::~DiskCacheBypassScope() {
+  t_disk_cache_bypass = previous_bypass_;
+}
+
+bool DiskCacheBypassScope::isBypassed() {
+  return t_disk_cache_bypass;
+}
+
+PrefetchExclusionScope::PrefetchExclusionScope(std::set<ChunkKey> excluded_column_keys)
+    : previous_excluded_column_keys_(std::move(t_prefetch_excluded_column_keys)) {
+  t_prefetch_excluded_column_keys = std::move(excluded_column_keys);
+}
+
+PrefetchExclusionScope::~PrefetchExclusionScope() {
+  t_prefetch_excluded_column_keys = std::move(previous_excluded_column_keys_);
+}
+
+bool PrefetchExclusionScope::isExcluded(const ChunkKey& column_key) {
+  return t_prefetch_excluded_column_keys.find(column_key) !=
+         t_prefetch_excluded_column_keys.end();
+}
+
+int ForeignStorageMgr::getFirstChangedFragmentId(const ChunkKey& table_key) {
+  CHECK(is_table_key(table_key));
+  if (!hasDataWrapperForChunk(table_key)) {
+    return 0;
+  }
+  return getDataWrapper(table_key)->getFirstChangedFragmentId();
+}
+
+bool ForeignStorageMgr::fragmentMayMatch(
+    const ChunkKey& table_key,
+    const int fragment_id,
+    const std::vector<ColumnRangePredicate>& predicates) {
+  CHECK(is_table_key(table_key));
+  std::shared_ptr<ForeignDataWrapper> data_wrapper;
+  {
+    std::shared_lock data_wrapper_lock(data_wrapper_mutex_);
+    auto it = data_wrapper_map_.find(table_key);
+    if (it == data_wrapper_map_.end()) {
+      return true;
+    }
+    data_wrapper = it->second;
+  }
+  return data_wrapper->fragmentMayMatch(fragment_id, predicates);
+}
+
 void ForeignStorageMgr::getOptionalChunkKeySet(
     std::set<ChunkKey>& optional_chunk_keys,
     const ChunkKey& chunk_key,
@@ -423,6 +480,9 @@ void ForeignStorageMgr::getOptionalChunkKeySet(
     const auto& [column_id, fragment_id] = hint;
     ChunkKey optional_chunk_key_key = get_table_key(chunk_key);
     optional_chunk_key_key.push_back(column_id);
+    if (PrefetchExclusionScope::isExcluded(optional_chunk_key_key)) {
+      continue;
+    }
     auto optional_chunk_key = optional_chunk_key_key;
     if (parallelism_level == ForeignDataWrapper::INTRA_FRAGMENT) {
       optional_chunk_key.push_back(chunk_key[CHUNK_KEY_FRAGMENT_IDX]);
@@ -99,6 +99,21 @@ class ForeignStorageMgr : public AbstractBufferMgr {
   void setParallelismHints(
       const std::map<ChunkKey, std::set<ParallelismHint>>& hints_per_table);
 
+  /**
+   * Returns false if the data wrapper of the given table can tell that no row of the
+   * fragment satisfies all of the given predicates. Tables without a data wrapper yet are
+   * never pruned.
+   */
+  bool fragmentMayMatch(const ChunkKey& table_key,
+                        const int fragment_id,
+                        const std::vector<ColumnRangePredicate>& predicates);
+
+  /**
+   * Gets the first fragment of the given table whose chunks may have changed in the last
+   * metadata scan of its data wrapper, 0 if the table has no data wrapper yet.
+   */
+  int getFirstChangedFragmentId(const ChunkKey& table_key);
+
  protected:
   bool createDataWrapperIfNotExists(const ChunkKey& chunk_key);
   std::shared_ptr<ForeignDataWrapper> getDataWrapper(const ChunkKey& chunk_key);
@@ -130,6 +145,39 @@ class ForeignStorageMgr : public AbstractBufferMgr {
   std::map<ChunkKey, std::set<ParallelismHint>> parallelism_hints_per_table_;
 };
 
+/**
+ * Marks the chunk fetches of the calling thread as one-time scans while in scope, in
+ * which case foreign table chunks are read without being added to the disk cache. Set
+ * by queries with the disk_cache_bypass hint around their fetches, so that the hint
+ * only applies to the query carrying it.
+ */
+class DiskCacheBypassScope {
+ public:
+  explicit DiskCacheBypassScope(const bool bypass);
+  ~DiskCacheBypassScope();
+
+  static bool isBypassed();
+
+ private:
+  const bool previous_bypass_;
+};
+
+/**
+ * Keeps the given columns, keyed by {db_id, table_id, column_id}, out of the optional
+ * chunks prefetched alongside the fetches of the calling thread while in scope. Set by
+ * queries that defer loading these columns until after the kernel ran.
+ */
+class PrefetchExclusionScope {
+ public:
+  explicit PrefetchExclusionScope(std::set<ChunkKey> excluded_column_keys);
+  ~PrefetchExclusionScope();
+
+  static bool isExcluded(const ChunkKey& column_key);
+
+ private:
+  std::set<ChunkKey> previous_excluded_column_keys_;
+};
+
 std::vector<ChunkKey> get_keys_vec_from_table(const ChunkKey& destination_chunk_key);
 std::set<ChunkKey> get_keys_set_from_table(const ChunkKey& destination_chunk_key);
 }  // namespace foreign_storage
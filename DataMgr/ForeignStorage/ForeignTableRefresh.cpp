@@ -16,9 +16,52 @@
 
 #include "ForeignTableRefresh.h"
 
+#include <algorithm>
+
 #include "LockMgr/LockMgr.h"
 
 namespace foreign_storage {
+namespace {
+/**
+ * Returns the fragment from which cached in memory chunks of the table can be out of
+ * date after a refresh. Append refreshes only add rows to the last fragment or create new
+ * fragments, so chunks of earlier fragments remain valid.
+ */
+int get_first_refreshed_fragment_id(const TableDescriptor* td,
+                                    const bool evict_cached_entries) {
+  const auto foreign_table = dynamic_cast<const ForeignTable*>(td);
+  if (evict_cached_entries || !foreign_table || !foreign_table->isAppendMode() ||
+      !td->fragmenter) {
+    return 0;
+  }
+  int last_fragment_id = 0;
+  for (const auto& fragment : td->fragmenter->getFragmentsForQuery().fragments) {
+    last_fragment_id = std::max(last_fragment_id, fragment.fragmentId);
+  }
+  return last_fragment_id;
+}
+
+void delete_in_memory_chunks(Catalog_Namespace::Catalog& catalog,
+                             const TableDescriptor* td,
+                             const int first_fragment_id) {
+  auto& data_mgr = catalog.getDataMgr();
+  ChunkKey table_key{catalog.getCurrentDB().dbId, td->tableId};
+  if (first_fragment_id == 0) {
+    data_mgr.deleteChunksWithPrefix(table_key, MemoryLevel::CPU_LEVEL);
+    data_mgr.deleteChunksWithPrefix(table_key, MemoryLevel::GPU_LEVEL);
+    return;
+  }
+  // Fragments after the current last fragment are not loaded yet
+  for (const auto column :
+       catalog.getAllColumnMetadataForTable(td->tableId, true, false, true)) {
+    ChunkKey fragment_key{
+        table_key[CHUNK_KEY_DB_IDX], td->tableId, column->columnId, first_fragment_id};
+    data_mgr.deleteChunksWithPrefix(fragment_key, MemoryLevel::CPU_LEVEL);
+    data_mgr.deleteChunksWithPrefix(fragment_key, MemoryLevel::GPU_LEVEL);
+  }
+}
+}  // namespace
+
 void refresh_foreign_table(Catalog_Namespace::Catalog& catalog,
                            const std::string& table_name,
                            const bool evict_cached_entries) {
@@ -35,18 +78,33 @@ void refresh_foreign_table(Catalog_Namespace::Catalog& catalog,
         " is not a foreign table. Refreshes are applicable to only foreign tables."};
   }
 
+  const auto first_refreshed_fragment_id =
+      get_first_refreshed_fragment_id(td, evict_cached_entries);
   catalog.removeFragmenterForTable(td->tableId);
   ChunkKey table_key{catalog.getCurrentDB().dbId, td->tableId};
-  data_mgr.deleteChunksWithPrefix(table_key, MemoryLevel::CPU_LEVEL);
-  data_mgr.deleteChunksWithPrefix(table_key, MemoryLevel::GPU_LEVEL);
+  delete_in_memory_chunks(catalog, td, first_refreshed_fragment_id);
 
   try {
-    data_mgr.getPersistentStorageMgr()->getForeignStorageMgr()->refreshTable(
-        table_key, evict_cached_entries);
+    auto foreign_storage_mgr = data_mgr.getPersistentStorageMgr()->getForeignStorageMgr();
+    foreign_storage_mgr->refreshTable(table_key, evict_cached_entries);
+    if (first_refreshed_fragment_id > 0) {
+      // Scan the appended data now, since data wrappers fall back to a full scan when
+      // previously scanned data changed, in which case chunks of all fragments are out
+      // of date
+      catalog.getMetadataForTable(td->tableId, true);
+      if (foreign_storage_mgr->getFirstChangedFragmentId(table_key) <
+          first_refreshed_fragment_id) {
+        delete_in_memory_chunks(catalog, td, 0);
+      }
+    }
     catalog.updateForeignTableRefreshTimes(td->tableId);
   } catch (PostEvictionRefreshException& e) {
     catalog.updateForeignTableRefreshTimes(td->tableId);
+    delete_in_memory_chunks(catalog, td, 0);
     throw e.getOriginalException();
+  } catch (...) {
+    delete_in_memory_chunks(catalog, td, 0);
+    throw;
   }
 }
 
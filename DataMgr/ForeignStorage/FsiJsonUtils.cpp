@@ -47,6 +47,17 @@ void get_value(const rapidjson::Value& json_val, int& value) {
   value = json_val.GetInt();
 }
 
+void set_value(rapidjson::Value& json_val,
+               const int64_t& value,
+               rapidjson::Document::AllocatorType& allocator) {
+  json_val.SetInt64(value);
+}
+
+void get_value(const rapidjson::Value& json_val, int64_t& value) {
+  CHECK(json_val.IsInt64());
+  value = json_val.GetInt64();
+}
+
 void set_value(rapidjson::Value& json_val,
                const std::string& value,
                rapidjson::Document::AllocatorType& allocator) {
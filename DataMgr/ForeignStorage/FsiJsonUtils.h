@@ -47,6 +47,11 @@ void set_value(rapidjson::Value& json_val,
                const int& value,
                rapidjson::Document::AllocatorType& allocator);
 void get_value(const rapidjson::Value& json_val, int& value);
+// int64_t
+void set_value(rapidjson::Value& json_val,
+               const int64_t& value,
+               rapidjson::Document::AllocatorType& allocator);
+void get_value(const rapidjson::Value& json_val, int64_t& value);
 // string
 void set_value(rapidjson::Value& json_val,
                const std::string& value,
@@ -21,6 +21,7 @@
 #include <parquet/arrow/reader.h>
 #include <parquet/column_scanner.h>
 #include <parquet/exception.h>
+#include <parquet/metadata.h>
 #include <parquet/platform.h>
 #include <parquet/statistics.h>
 #include <parquet/types.h>
@@ -42,6 +43,67 @@ namespace foreign_storage {
 
 namespace {
 
+/**
+ * A column chunk can be read as dictionary indices only if none of its data pages fell
+ * back to plain encoding, which requires the page encoding stats written by newer
+ * Parquet writers.
+ */
+bool is_dictionary_encoded(const parquet::ColumnChunkMetaData* column_metadata) {
+  if (!column_metadata->has_dictionary_page()) {
+    return false;
+  }
+  const auto& encoding_stats = column_metadata->encoding_stats();
+  if (encoding_stats.empty()) {
+    return false;
+  }
+  for (const auto& page_stats : encoding_stats) {
+    if (page_stats.page_type != parquet::PageType::DICTIONARY_PAGE &&
+        page_stats.encoding != parquet::Encoding::PLAIN_DICTIONARY &&
+        page_stats.encoding != parquet::Encoding::RLE_DICTIONARY) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Reads a dictionary encoded BYTE_ARRAY column chunk as dictionary indices, handing the
+ * dictionary page to the encoder whenever the reader moves on to a new one.
+ */
+void read_dictionary_indices(parquet::ColumnReader* col_reader,
+                             ParquetDictionaryIndexEncoder* encoder,
+                             std::vector<int16_t>& def_levels,
+                             std::vector<int16_t>& rep_levels,
+                             std::vector<int32_t>& indices) {
+  auto byte_array_reader = dynamic_cast<parquet::ByteArrayReader*>(col_reader);
+  CHECK(byte_array_reader);
+  const parquet::ByteArray* current_dictionary{nullptr};
+  while (byte_array_reader->HasNext()) {
+    int64_t indices_read{0};
+    const parquet::ByteArray* dictionary{nullptr};
+    int32_t dictionary_length{0};
+    const auto levels_read = byte_array_reader->ReadBatchWithDictionary(
+        LazyParquetChunkLoader::batch_reader_num_elements,
+        def_levels.data(),
+        rep_levels.data(),
+        indices.data(),
+        &indices_read,
+        &dictionary,
+        &dictionary_length);
+    if (dictionary && dictionary != current_dictionary) {
+      encoder->setDictionary(dictionary, dictionary_length);
+      current_dictionary = dictionary;
+    }
+    CHECK(current_dictionary || indices_read == 0);
+    encoder->appendDictionaryIndices(def_levels.data(),
+                                     rep_levels.data(),
+                                     indices_read,
+                                     levels_read,
+                                     !byte_array_reader->HasNext(),
+                                     indices.data());
+  }
+}
+
 bool is_valid_parquet_string(const parquet::ColumnDescriptor* parquet_column) {
   return (parquet_column->logical_type()->is_none() &&
           parquet_column->physical_type() == parquet::Type::BYTE_ARRAY) ||
@@ -1384,6 +1446,12 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroup
                                         string_dictionary,
                                         chunk_metadata);
   CHECK(encoder.get());
+  auto dictionary_index_encoder =
+      dynamic_cast<ParquetDictionaryIndexEncoder*>(encoder.get());
+  std::vector<int32_t> dictionary_indices;
+  if (dictionary_index_encoder) {
+    dictionary_indices.resize(LazyParquetChunkLoader::batch_reader_num_elements);
+  }
 
   for (const auto& row_group_interval : row_group_intervals) {
     const auto& file_path = row_group_interval.file_path;
@@ -1413,6 +1481,16 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroup
           group_reader->Column(parquet_column_index);
 
       try {
+        if (dictionary_index_encoder &&
+            is_dictionary_encoded(
+                group_reader->metadata()->ColumnChunk(parquet_column_index).get())) {
+          read_dictionary_indices(col_reader.get(),
+                                  dictionary_index_encoder,
+                                  def_levels,
+                                  rep_levels,
+                                  dictionary_indices);
+          continue;
+        }
         while (col_reader->HasNext()) {
           int64_t levels_read =
               parquet::ScanAllValues(LazyParquetChunkLoader::batch_reader_num_elements,
@@ -1507,8 +1585,13 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::loadChunk(
 
 std::list<RowGroupMetadata> LazyParquetChunkLoader::metadataScan(
     const std::set<std::string>& file_paths,
-    const ForeignTableSchema& schema) {
+    const ForeignTableSchema& schema,
+    const std::map<std::string, int>& start_row_groups) {
   auto timer = DEBUG_TIMER(__func__);
+  auto get_start_row_group = [&start_row_groups](const std::string& file_path) {
+    auto it = start_row_groups.find(file_path);
+    return (it == start_row_groups.end()) ? 0 : it->second;
+  };
   auto column_interval =
       Interval<ColumnType>{schema.getLogicalAndPhysicalColumns().front()->columnId,
                            schema.getLogicalAndPhysicalColumns().back()->columnId};
@@ -1523,7 +1606,10 @@ std::list<RowGroupMetadata> LazyParquetChunkLoader::metadataScan(
   auto encoder_map = populate_encoder_map(column_interval, schema, first_reader);
   const auto num_row_groups = get_parquet_table_size(first_reader).first;
   auto row_group_metadata = metadata_scan_rowgroup_interval(
-      encoder_map, {first_path, 0, num_row_groups - 1}, first_reader, schema);
+      encoder_map,
+      {first_path, get_start_row_group(first_path), num_row_groups - 1},
+      first_reader,
+      schema);
 
   // We want each (filepath->FileReader) pair in the cache to be initialized before we
   // multithread so that we are not adding keys in a concurrent environment, so we add
@@ -1550,7 +1636,8 @@ std::list<RowGroupMetadata> LazyParquetChunkLoader::metadataScan(
             validate_equal_schema(first_reader, reader, first_path, path);
             validate_parquet_metadata(reader->parquet_reader()->metadata(), path, schema);
             const auto num_row_groups = get_parquet_table_size(reader).first;
-            const auto interval = RowGroupInterval{path, 0, num_row_groups - 1};
+            const auto interval =
+                RowGroupInterval{path, get_start_row_group(path), num_row_groups - 1};
             reduced_metadata.splice(
                 reduced_metadata.end(),
                 metadata_scan_rowgroup_interval(encoder_map, interval, reader, schema));
@@ -76,11 +76,15 @@ class LazyParquetChunkLoader {
    *
    * @param file_paths -  (ordered) files of the metadata scan
    * @param schema - schema of the foreign table to perform metadata scan for
+   * @param start_row_groups - row group to start the scan of a file at, for files which
+   * were partially scanned before (files without an entry are scanned from the start)
    *
    * @return a list of the row group metadata extracted from `file_paths`
    */
-  std::list<RowGroupMetadata> metadataScan(const std::set<std::string>& file_paths,
-                                           const ForeignTableSchema& schema);
+  std::list<RowGroupMetadata> metadataScan(
+      const std::set<std::string>& file_paths,
+      const ForeignTableSchema& schema,
+      const std::map<std::string, int>& start_row_groups = {});
 
   /**
    * Determine if a Parquet to OmniSci column mapping is supported.
@@ -28,6 +28,7 @@
 #include "LazyParquetChunkLoader.h"
 #include "MetadataPlaceholder.h"
 #include "ParquetShared.h"
+#include "QueryEngine/GroupByAndAggregate.h"
 #include "Utils/DdlUtils.h"
 
 namespace foreign_storage {
@@ -143,6 +144,32 @@ struct ThreadPartitioner {
   };
 };
 
+bool row_group_may_satisfy(const ChunkStats& stats,
+                           const SQLTypeInfo& type,
+                           const ColumnRangePredicate& predicate) {
+  // bounds as compared by the executor's fragment skipping
+  const auto min = extract_min_stat(stats, type);
+  const auto max = extract_max_stat(stats, type);
+  if (min > max) {
+    // no min/max statistics for this row group
+    return true;
+  }
+  switch (predicate.op) {
+    case kGE:
+      return max >= predicate.value;
+    case kGT:
+      return max > predicate.value;
+    case kLE:
+      return min <= predicate.value;
+    case kLT:
+      return min < predicate.value;
+    case kEQ:
+      return min <= predicate.value && predicate.value <= max;
+    default:
+      return true;
+  }
+}
+
 bool is_dict_encoded_data_chunk_key(const ColumnDescriptor* logical_column,
                                     const ChunkKey& chunk_key) {
   if (logical_column->columnType.is_dict_encoded_type()) {
@@ -154,6 +181,11 @@ bool is_dict_encoded_data_chunk_key(const ColumnDescriptor* logical_column,
   return false;
 }
 
+void set_file_stats(ParquetFileState& file_state, const arrow::fs::FileInfo& file_info) {
+  file_state.file_size = std::max<int64_t>(file_info.size(), 0);
+  file_state.modified_time = file_info.mtime().time_since_epoch().count();
+}
+
 }  // namespace
 
 ParquetDataWrapper::ParquetDataWrapper() : db_id_(-1), foreign_table_(nullptr) {}
@@ -162,10 +194,12 @@ ParquetDataWrapper::ParquetDataWrapper(const int db_id, const ForeignTable* fore
     : db_id_(db_id)
     , foreign_table_(foreign_table)
     , last_fragment_index_(0)
+    , first_changed_fragment_id_(0)
     , last_fragment_row_count_(0)
     , total_row_count_(0)
     , last_row_group_(0)
     , is_restored_(false)
+    , row_group_stats_complete_(true)
     , schema_(std::make_unique<ForeignTableSchema>(db_id, foreign_table))
     , file_reader_cache_(std::make_unique<FileReaderMap>()) {
   auto& server_options = foreign_table->foreign_server->options;
@@ -182,9 +216,13 @@ void ParquetDataWrapper::resetParquetMetadata() {
 
   last_row_group_ = 0;
   last_fragment_index_ = 0;
+  first_changed_fragment_id_ = 0;
   last_fragment_row_count_ = 0;
   total_row_count_ = 0;
   file_reader_cache_->clear();
+  row_group_stats_map_.clear();
+  row_group_stats_complete_ = true;
+  file_states_.clear();
 }
 
 std::list<const ColumnDescriptor*> ParquetDataWrapper::getColumnsToInitialize(
@@ -287,7 +325,7 @@ bool ParquetDataWrapper::isNewFile(const std::string& file_path) const {
   }
 }
 
-void ParquetDataWrapper::addNewFile(const std::string& file_path) {
+void ParquetDataWrapper::addNewFile(const std::string& file_path, const int row_group) {
   const auto last_fragment_entry =
       fragment_to_row_group_interval_map_.find(last_fragment_index_);
   CHECK(last_fragment_entry != fragment_to_row_group_interval_map_.end());
@@ -298,23 +336,26 @@ void ParquetDataWrapper::addNewFile(const std::string& file_path) {
   } else {
     last_fragment_entry->second.back().end_index = last_row_group_;
   }
-  last_fragment_entry->second.emplace_back(RowGroupInterval{file_path, 0});
+  last_fragment_entry->second.emplace_back(RowGroupInterval{file_path, row_group});
 }
 
 void ParquetDataWrapper::fetchChunkMetadata() {
   auto catalog = Catalog_Namespace::SysCatalog::instance().getCatalog(db_id_);
   CHECK(catalog);
   std::set<std::string> new_file_paths;
+  std::map<std::string, int> start_row_groups;
   auto processed_file_paths = getProcessedFilePaths();
+  auto all_file_infos = getAllFileInfos();
+  // Appended row groups continue the last fragment, unless the metadata is reset below
+  first_changed_fragment_id_ = last_fragment_index_;
   if (foreign_table_->isAppendMode() && !processed_file_paths.empty()) {
-    auto all_file_paths = getAllFilePaths();
     for (const auto& file_path : processed_file_paths) {
-      if (all_file_paths.find(file_path) == all_file_paths.end()) {
+      if (all_file_infos.find(file_path) == all_file_infos.end()) {
         throw_removed_file_error(file_path);
       }
     }
 
-    for (const auto& file_path : all_file_paths) {
+    for (const auto& [file_path, file_info] : all_file_infos) {
       if (processed_file_paths.find(file_path) == processed_file_paths.end()) {
         new_file_paths.emplace(file_path);
       }
@@ -324,32 +365,63 @@ void ParquetDataWrapper::fetchChunkMetadata() {
     // If an append occurs with multiple files, then we assume any existing files have not
     // been altered.  If an append occurs on a single file, then we check to see if it has
     // changed.
-    if (new_file_paths.empty() && all_file_paths.size() == 1) {
+    if (new_file_paths.empty() && all_file_infos.size() == 1) {
       CHECK_EQ(processed_file_paths.size(), static_cast<size_t>(1));
-      const auto& file_path = *all_file_paths.begin();
+      const auto& [file_path, file_info] = *all_file_infos.begin();
       CHECK_EQ(*processed_file_paths.begin(), file_path);
 
-      // Since an existing file is being appended to we need to update the cached
-      // FileReader as the existing one will be out of date.
-      auto reader = file_reader_cache_->insert(file_path, file_system_);
-      size_t row_count = reader->parquet_reader()->metadata()->num_rows();
-
-      if (row_count < total_row_count_) {
-        throw_removed_row_error(file_path);
-      } else if (row_count > total_row_count_) {
-        new_file_paths = all_file_paths;
-        chunk_metadata_map_.clear();
-        resetParquetMetadata();
+      if (isFileModified(file_path, file_info)) {
+        // Since an existing file is being appended to we need to update the cached
+        // FileReader as the existing one will be out of date.
+        auto reader = file_reader_cache_->insert(file_path, file_system_);
+        if (isAppendedToFile(file_path, reader)) {
+          // Only the new row groups are scanned, and they are added to the last
+          // fragment, so metadata of all other fragments remains valid.
+          const auto& file_state = file_states_.at(file_path);
+          if (get_parquet_table_size(reader).first > file_state.num_row_groups) {
+            new_file_paths.emplace(file_path);
+            start_row_groups[file_path] = file_state.num_row_groups;
+          } else {
+            updateFileStates({file_path}, all_file_infos);
+          }
+        } else {
+          size_t row_count = reader->parquet_reader()->metadata()->num_rows();
+          if (row_count < total_row_count_) {
+            throw_removed_row_error(file_path);
+          } else if (row_count > total_row_count_) {
+            new_file_paths.emplace(file_path);
+            chunk_metadata_map_.clear();
+            resetParquetMetadata();
+          } else {
+            updateFileStates({file_path}, all_file_infos);
+          }
+        }
+      }
+    } else {
+      for (const auto& file_path : processed_file_paths) {
+        const auto& file_info = all_file_infos.at(file_path);
+        auto file_state_it = file_states_.find(file_path);
+        if (file_state_it != file_states_.end() && isFileModified(file_path, file_info)) {
+          LOG(WARNING) << "Ignoring changes to file \"" << file_path
+                       << "\" during append refresh of foreign table \""
+                       << foreign_table_->tableName
+                       << "\". Only new files are scanned for tables with multiple files.";
+          // The scanned row groups are still described by the recorded hash
+          set_file_stats(file_state_it->second, file_info);
+        }
       }
     }
   } else {
-    new_file_paths = getAllFilePaths();
+    for (const auto& [file_path, file_info] : all_file_infos) {
+      new_file_paths.emplace(file_path);
+    }
     chunk_metadata_map_.clear();
     resetParquetMetadata();
   }
 
   if (!new_file_paths.empty()) {
-    metadataScanFiles(new_file_paths);
+    metadataScanFiles(new_file_paths, start_row_groups);
+    updateFileStates(new_file_paths, all_file_infos);
   }
 }
 
@@ -363,9 +435,9 @@ std::set<std::string> ParquetDataWrapper::getProcessedFilePaths() {
   return file_paths;
 }
 
-std::set<std::string> ParquetDataWrapper::getAllFilePaths() {
+std::map<std::string, arrow::fs::FileInfo> ParquetDataWrapper::getAllFileInfos() {
   auto timer = DEBUG_TIMER(__func__);
-  std::set<std::string> file_paths;
+  std::map<std::string, arrow::fs::FileInfo> file_infos;
   arrow::fs::FileSelector file_selector{};
   std::string base_path = getFullFilePath(foreign_table_);
   file_selector.base_dir = base_path;
@@ -374,24 +446,73 @@ std::set<std::string> ParquetDataWrapper::getAllFilePaths() {
   auto file_info_result = file_system_->GetFileInfo(file_selector);
   if (!file_info_result.ok()) {
     // This is expected when `base_path` points to a single file.
-    file_paths.emplace(base_path);
+    auto single_file_info_result = file_system_->GetFileInfo(base_path);
+    if (single_file_info_result.ok()) {
+      file_infos.emplace(base_path, single_file_info_result.ValueOrDie());
+    } else {
+      // Missing files are reported when they are opened
+      arrow::fs::FileInfo file_info;
+      file_info.set_path(base_path);
+      file_infos.emplace(base_path, file_info);
+    }
   } else {
     auto& file_info_vector = file_info_result.ValueOrDie();
     for (const auto& file_info : file_info_vector) {
       if (file_info.type() == arrow::fs::FileType::File) {
-        file_paths.emplace(file_info.path());
+        file_infos.emplace(file_info.path(), file_info);
       }
     }
-    if (file_paths.empty()) {
+    if (file_infos.empty()) {
       throw std::runtime_error{"No file found at given path \"" + base_path + "\"."};
     }
   }
-  return file_paths;
+  return file_infos;
 }
 
-void ParquetDataWrapper::metadataScanFiles(const std::set<std::string>& file_paths) {
+bool ParquetDataWrapper::isFileModified(const std::string& file_path,
+                                        const arrow::fs::FileInfo& file_info) const {
+  auto it = file_states_.find(file_path);
+  // Wrappers restored from internals without file states cannot tell
+  if (it == file_states_.end()) {
+    return true;
+  }
+  const auto& file_state = it->second;
+  return file_info.size() != static_cast<int64_t>(file_state.file_size) ||
+         file_info.mtime().time_since_epoch().count() != file_state.modified_time;
+}
+
+bool ParquetDataWrapper::isAppendedToFile(const std::string& file_path,
+                                          const ReaderPtr& reader) const {
+  auto it = file_states_.find(file_path);
+  if (it == file_states_.end()) {
+    return false;
+  }
+  const auto& file_state = it->second;
+  return get_parquet_table_size(reader).first >= file_state.num_row_groups &&
+         get_row_groups_hash(reader, file_state.num_row_groups) ==
+             file_state.row_groups_hash;
+}
+
+void ParquetDataWrapper::updateFileStates(
+    const std::set<std::string>& file_paths,
+    const std::map<std::string, arrow::fs::FileInfo>& file_infos) {
+  for (const auto& file_path : file_paths) {
+    const auto& file_info = file_infos.at(file_path);
+    auto reader = file_reader_cache_->getOrInsert(file_path, file_system_);
+    const auto num_row_groups = get_parquet_table_size(reader).first;
+    auto& file_state = file_states_[file_path];
+    set_file_stats(file_state, file_info);
+    file_state.num_row_groups = num_row_groups;
+    file_state.row_groups_hash = get_row_groups_hash(reader, num_row_groups);
+  }
+}
+
+void ParquetDataWrapper::metadataScanFiles(
+    const std::set<std::string>& file_paths,
+    const std::map<std::string, int>& start_row_groups) {
   LazyParquetChunkLoader chunk_loader(file_system_, file_reader_cache_.get());
-  auto row_group_metadata = chunk_loader.metadataScan(file_paths, *schema_);
+  auto row_group_metadata =
+      chunk_loader.metadataScan(file_paths, *schema_, start_row_groups);
   auto column_interval =
       Interval<ColumnType>{schema_->getLogicalAndPhysicalColumns().front()->columnId,
                            schema_->getLogicalAndPhysicalColumns().back()->columnId};
@@ -407,8 +528,7 @@ void ParquetDataWrapper::metadataScanFiles(const std::set<std::string>& file_pat
     if (moveToNextFragment(import_row_count)) {
       addNewFragment(row_group, file_path);
     } else if (isNewFile(file_path)) {
-      CHECK_EQ(row_group, 0);
-      addNewFile(file_path);
+      addNewFile(file_path, row_group);
     }
     last_row_group_ = row_group;
 
@@ -425,6 +545,8 @@ void ParquetDataWrapper::metadataScanFiles(const std::set<std::string>& file_pat
         data_chunk_key.emplace_back(1);
       }
       std::shared_ptr<ChunkMetadata> chunk_metadata = *column_chunk_metadata_iter;
+      // copied before the metadata of the first row group is reduced into
+      row_group_stats_map_[data_chunk_key].emplace_back(chunk_metadata->chunkStats);
       if (chunk_metadata_map_.find(data_chunk_key) == chunk_metadata_map_.end()) {
         chunk_metadata_map_[data_chunk_key] = chunk_metadata;
       } else {
@@ -450,6 +572,45 @@ void ParquetDataWrapper::populateChunkMetadata(
   }
 }
 
+int ParquetDataWrapper::getFirstChangedFragmentId() const {
+  return first_changed_fragment_id_;
+}
+
+bool ParquetDataWrapper::fragmentMayMatch(
+    const int fragment_id,
+    const std::vector<ColumnRangePredicate>& predicates) const {
+  if (!row_group_stats_complete_) {
+    return true;
+  }
+  // a fragment can be skipped if every one of its row groups fails some predicate
+  std::vector<bool> row_group_may_match;
+  for (const auto& predicate : predicates) {
+    const auto& type = schema_->getColumnDescriptor(predicate.column_id)->columnType;
+    if (!type.is_integer() && !type.is_time()) {
+      continue;
+    }
+    const auto stats_it = row_group_stats_map_.find(
+        {db_id_, foreign_table_->tableId, predicate.column_id, fragment_id});
+    if (stats_it == row_group_stats_map_.end()) {
+      return true;
+    }
+    const auto& row_group_stats = stats_it->second;
+    if (row_group_may_match.empty()) {
+      row_group_may_match.assign(row_group_stats.size(), true);
+    }
+    CHECK_EQ(row_group_may_match.size(), row_group_stats.size());
+    for (size_t i = 0; i < row_group_stats.size(); ++i) {
+      if (row_group_may_match[i] &&
+          !row_group_may_satisfy(row_group_stats[i], type, predicate)) {
+        row_group_may_match[i] = false;
+      }
+    }
+  }
+  return row_group_may_match.empty() ||
+         std::find(row_group_may_match.begin(), row_group_may_match.end(), true) !=
+             row_group_may_match.end();
+}
+
 void ParquetDataWrapper::loadBuffersUsingLazyParquetChunkLoader(
     const int logical_column_id,
     const int fragment_id,
@@ -591,6 +752,27 @@ void get_value(const rapidjson::Value& json_val, RowGroupInterval& value) {
   json_utils::get_value_from_object(json_val, value.end_index, "end_index");
 }
 
+void set_value(rapidjson::Value& json_val,
+               const ParquetFileState& value,
+               rapidjson::Document::AllocatorType& allocator) {
+  json_val.SetObject();
+  json_utils::add_value_to_object(json_val, value.file_size, "file_size", allocator);
+  json_utils::add_value_to_object(
+      json_val, value.modified_time, "modified_time", allocator);
+  json_utils::add_value_to_object(
+      json_val, value.num_row_groups, "num_row_groups", allocator);
+  json_utils::add_value_to_object(
+      json_val, value.row_groups_hash, "row_groups_hash", allocator);
+}
+
+void get_value(const rapidjson::Value& json_val, ParquetFileState& value) {
+  CHECK(json_val.IsObject());
+  json_utils::get_value_from_object(json_val, value.file_size, "file_size");
+  json_utils::get_value_from_object(json_val, value.modified_time, "modified_time");
+  json_utils::get_value_from_object(json_val, value.num_row_groups, "num_row_groups");
+  json_utils::get_value_from_object(json_val, value.row_groups_hash, "row_groups_hash");
+}
+
 void ParquetDataWrapper::serializeDataWrapperInternals(
     const std::string& file_path) const {
   rapidjson::Document d;
@@ -607,6 +789,7 @@ void ParquetDataWrapper::serializeDataWrapperInternals(
       d, last_fragment_row_count_, "last_fragment_row_count", d.GetAllocator());
   json_utils::add_value_to_object(
       d, total_row_count_, "total_row_count", d.GetAllocator());
+  json_utils::add_value_to_object(d, file_states_, "file_states", d.GetAllocator());
 
   json_utils::write_to_file(d, file_path);
 }
@@ -624,11 +807,16 @@ void ParquetDataWrapper::restoreDataWrapperInternals(
   json_utils::get_value_from_object(
       d, last_fragment_row_count_, "last_fragment_row_count");
   json_utils::get_value_from_object(d, total_row_count_, "total_row_count");
+  // Internals serialized before file states were tracked do not have them
+  if (d.HasMember("file_states")) {
+    json_utils::get_value_from_object(d, file_states_, "file_states");
+  }
 
   CHECK(chunk_metadata_map_.empty());
   for (const auto& [chunk_key, chunk_metadata] : chunk_metadata_vector) {
     chunk_metadata_map_[chunk_key] = chunk_metadata;
   }
+  row_group_stats_complete_ = false;
   is_restored_ = true;
 }
 
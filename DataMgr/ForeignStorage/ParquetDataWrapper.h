@@ -57,6 +57,11 @@ class ParquetDataWrapper : public AbstractFileStorageDataWrapper {
     return INTRA_FRAGMENT;
   }
 
+  bool fragmentMayMatch(const int fragment_id,
+                        const std::vector<ColumnRangePredicate>& predicates) const override;
+
+  int getFirstChangedFragmentId() const override;
+
  private:
   std::list<const ColumnDescriptor*> getColumnsToInitialize(
       const Interval<ColumnType>& column_interval);
@@ -70,7 +75,16 @@ class ParquetDataWrapper : public AbstractFileStorageDataWrapper {
                                               const ChunkToBufferMap& required_buffers);
 
   std::set<std::string> getProcessedFilePaths();
-  std::set<std::string> getAllFilePaths();
+  std::map<std::string, arrow::fs::FileInfo> getAllFileInfos();
+
+  bool isFileModified(const std::string& file_path,
+                      const arrow::fs::FileInfo& file_info) const;
+
+  // Returns true if the file only had row groups added since it was scanned.
+  bool isAppendedToFile(const std::string& file_path, const ReaderPtr& reader) const;
+
+  void updateFileStates(const std::set<std::string>& file_paths,
+                        const std::map<std::string, arrow::fs::FileInfo>& file_infos);
 
   bool moveToNextFragment(size_t new_rows_count) const;
 
@@ -79,21 +93,29 @@ class ParquetDataWrapper : public AbstractFileStorageDataWrapper {
 
   bool isNewFile(const std::string& file_path) const;
 
-  void addNewFile(const std::string& file_path);
+  void addNewFile(const std::string& file_path, const int row_group);
 
   void resetParquetMetadata();
 
-  void metadataScanFiles(const std::set<std::string>& file_paths);
+  void metadataScanFiles(const std::set<std::string>& file_paths,
+                         const std::map<std::string, int>& start_row_groups = {});
 
   std::map<int, std::vector<RowGroupInterval>> fragment_to_row_group_interval_map_;
   std::map<ChunkKey, std::shared_ptr<ChunkMetadata>> chunk_metadata_map_;
+  // stats of each row group making up a data chunk, in row group order
+  std::map<ChunkKey, std::vector<ChunkStats>> row_group_stats_map_;
+  std::map<std::string, ParquetFileState> file_states_;
   const int db_id_;
   const ForeignTable* foreign_table_;
   int last_fragment_index_;
+  int first_changed_fragment_id_;
   size_t last_fragment_row_count_;
   size_t total_row_count_;
   int last_row_group_;
   bool is_restored_;
+  // row group stats are not persisted, so they are incomplete for a restored wrapper
+  // until the next full metadata scan
+  bool row_group_stats_complete_;
   std::unique_ptr<ForeignTableSchema> schema_;
   std::shared_ptr<arrow::fs::FileSystem> file_system_;
   std::unique_ptr<FileReaderMap> file_reader_cache_;
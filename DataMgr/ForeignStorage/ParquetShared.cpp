@@ -16,6 +16,7 @@
 
 #include "ParquetShared.h"
 
+#include <boost/functional/hash.hpp>
 #include <parquet/column_scanner.h>
 #include <parquet/exception.h>
 #include <parquet/platform.h>
@@ -42,6 +43,23 @@ std::pair<int, int> get_parquet_table_size(const ReaderPtr& reader) {
   return std::make_pair(num_row_groups, num_columns);
 }
 
+size_t get_row_groups_hash(const ReaderPtr& reader, const int num_row_groups) {
+  auto file_metadata = reader->parquet_reader()->metadata();
+  CHECK_LE(num_row_groups, file_metadata->num_row_groups());
+  size_t hash = 0;
+  for (int row_group = 0; row_group < num_row_groups; ++row_group) {
+    auto row_group_metadata = file_metadata->RowGroup(row_group);
+    boost::hash_combine(hash, row_group_metadata->num_rows());
+    boost::hash_combine(hash, row_group_metadata->total_byte_size());
+    for (int column = 0; column < row_group_metadata->num_columns(); ++column) {
+      auto column_metadata = row_group_metadata->ColumnChunk(column);
+      boost::hash_combine(hash, column_metadata->file_offset());
+      boost::hash_combine(hash, column_metadata->total_compressed_size());
+    }
+  }
+  return hash;
+}
+
 const parquet::ColumnDescriptor* get_column_descriptor(
     const parquet::arrow::FileReader* reader,
     const int logical_column_index) {
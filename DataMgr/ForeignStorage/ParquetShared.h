@@ -56,6 +56,18 @@ struct RowGroupInterval {
   int start_index{-1}, end_index{-1};
 };
 
+/**
+ * State of a scanned file, used to detect files which have changed since their metadata
+ * scan. The hash covers the footer entries (row counts, sizes and offsets) of the first
+ * `num_row_groups` row groups, so an append which only adds row groups keeps it intact.
+ */
+struct ParquetFileState {
+  size_t file_size{0};
+  int64_t modified_time{0};
+  int num_row_groups{0};
+  size_t row_groups_hash{0};
+};
+
 struct RowGroupMetadata {
   std::string file_path;
   int row_group_index;
@@ -67,6 +79,8 @@ UniqueReaderPtr open_parquet_table(const std::string& file_path,
 
 std::pair<int, int> get_parquet_table_size(const ReaderPtr& reader);
 
+size_t get_row_groups_hash(const ReaderPtr& reader, const int num_row_groups);
+
 const parquet::ColumnDescriptor* get_column_descriptor(
     const parquet::arrow::FileReader* reader,
     const int logical_column_index);
@@ -25,8 +25,29 @@
 
 namespace foreign_storage {
 
+/**
+ * Encoder accepting the dictionary indices of a dictionary encoded Parquet column chunk
+ * in place of materialized values.
+ */
+class ParquetDictionaryIndexEncoder {
+ public:
+  virtual ~ParquetDictionaryIndexEncoder() = default;
+
+  // Sets the dictionary page of the column chunk currently being read.
+  virtual void setDictionary(const parquet::ByteArray* dictionary,
+                             const int32_t dictionary_length) = 0;
+
+  virtual void appendDictionaryIndices(const int16_t* def_levels,
+                                       const int16_t* rep_levels,
+                                       const int64_t indices_read,
+                                       const int64_t levels_read,
+                                       const bool is_last_batch,
+                                       const int32_t* indices) = 0;
+};
+
 template <typename V>
-class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
+class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V>,
+                             public ParquetDictionaryIndexEncoder {
  public:
   ParquetStringEncoder(Data_Namespace::AbstractBuffer* buffer,
                        StringDictionary* string_dictionary,
@@ -53,6 +74,43 @@ class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
                                                  encode_buffer_.data());
   }
 
+  /**
+   * Translates the dictionary page into string dictionary ids once, so that the indices
+   * of the column chunk can be transcoded with a lookup instead of hashing every value.
+   */
+  void setDictionary(const parquet::ByteArray* dictionary,
+                     const int32_t dictionary_length) override {
+    CHECK(string_dictionary_);
+    std::vector<std::string_view> string_views;
+    string_views.reserve(dictionary_length);
+    for (int32_t i = 0; i < dictionary_length; ++i) {
+      string_views.emplace_back(reinterpret_cast<const char*>(dictionary[i].ptr),
+                                dictionary[i].len);
+    }
+    dictionary_ids_.resize(dictionary_length);
+    string_dictionary_->getOrAddBulk(string_views, dictionary_ids_.data());
+  }
+
+  void appendDictionaryIndices(const int16_t* def_levels,
+                               const int16_t* rep_levels,
+                               const int64_t indices_read,
+                               const int64_t levels_read,
+                               const bool is_last_batch,
+                               const int32_t* indices) override {
+    auto omnisci_data_ptr = reinterpret_cast<V*>(encode_buffer_.data());
+    for (int64_t i = 0; i < indices_read; ++i) {
+      CHECK_LT(static_cast<size_t>(indices[i]), dictionary_ids_.size());
+      omnisci_data_ptr[i] = dictionary_ids_[indices[i]];
+    }
+    updateMetadataStats(indices_read, encode_buffer_.data());
+    TypedParquetInPlaceEncoder<V, V>::appendData(def_levels,
+                                                 rep_levels,
+                                                 indices_read,
+                                                 levels_read,
+                                                 is_last_batch,
+                                                 encode_buffer_.data());
+  }
+
   void encodeAndCopyContiguous(const int8_t* parquet_data_bytes,
                                int8_t* omnisci_data_bytes,
                                const size_t num_elements) override {
@@ -104,6 +162,7 @@ class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
   StringDictionary* string_dictionary_;
   std::unique_ptr<ChunkMetadata>& chunk_metadata_;
   std::vector<int8_t> encode_buffer_;
+  std::vector<V> dictionary_ids_;
 
   V min_, max_;
 };
@@ -35,6 +35,43 @@ namespace EmbeddedDatabase {
 
 class DBEngineImpl;
 
+namespace {
+
+/**
+ * Streams a query result as record batches of at most max_batch_rows rows, which are
+ * zero-copy slices of the converted result.
+ */
+class ArrowRecordBatchSliceReader : public arrow::RecordBatchReader {
+ public:
+  ArrowRecordBatchSliceReader(std::shared_ptr<arrow::RecordBatch> record_batch,
+                              const size_t max_batch_rows)
+      : record_batch_(record_batch), max_batch_rows_(max_batch_rows), offset_(0) {
+    CHECK(record_batch_);
+    CHECK_GT(max_batch_rows_, size_t(0));
+  }
+
+  std::shared_ptr<arrow::Schema> schema() const override {
+    return record_batch_->schema();
+  }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    if (offset_ >= static_cast<size_t>(record_batch_->num_rows())) {
+      batch->reset();
+      return arrow::Status::OK();
+    }
+    *batch = record_batch_->Slice(offset_, max_batch_rows_);
+    offset_ += (*batch)->num_rows();
+    return arrow::Status::OK();
+  }
+
+ private:
+  std::shared_ptr<arrow::RecordBatch> record_batch_;
+  const size_t max_batch_rows_;
+  size_t offset_;
+};
+
+}  // namespace
+
 /**
  * Cursor internal implementation
  */
@@ -86,6 +123,21 @@ class CursorImpl : public Cursor {
     return nullptr;
   }
 
+  std::shared_ptr<arrow::RecordBatchReader> getArrowRecordBatchReader(
+      size_t max_batch_rows) {
+    if (!getColCount()) {
+      return nullptr;
+    }
+    if (!record_batch_) {
+      // an empty result still yields its schema
+      auto converter =
+          std::make_unique<ArrowResultSetConverter>(result_set_, col_names_, -1);
+      record_batch_ = converter->convertToArrow();
+    }
+    return std::make_shared<ArrowRecordBatchSliceReader>(
+        record_batch_, max_batch_rows ? max_batch_rows : DEFAULT_FRAGMENT_ROWS);
+  }
+
  private:
   std::shared_ptr<ResultSet> result_set_;
   std::vector<std::string> col_names_;
@@ -217,8 +269,9 @@ class DBEngineImpl : public DBEngine {
 
   void importArrowTable(const std::string& name,
                         std::shared_ptr<arrow::Table>& table,
-                        uint64_t fragment_size) {
-    setArrowTable(name, table);
+                        uint64_t fragment_size,
+                        bool align_fragments_to_batches) {
+    setArrowTable(name, table, align_fragments_to_batches);
     try {
       auto session = db_handler_->get_session_copy(session_id_);
       TableDescriptor td;
@@ -475,9 +528,11 @@ std::shared_ptr<Cursor> DBEngine::executeRA(const std::string& query) {
 
 void DBEngine::importArrowTable(const std::string& name,
                                 std::shared_ptr<arrow::Table>& table,
-                                uint64_t fragment_size) {
+                                uint64_t fragment_size,
+                                bool align_fragments_to_batches) {
   DBEngineImpl* engine = getImpl(this);
-  return engine->importArrowTable(name, table, fragment_size);
+  return engine->importArrowTable(
+      name, table, fragment_size, align_fragments_to_batches);
 }
 
 std::vector<std::string> DBEngine::getTables() {
@@ -538,4 +593,10 @@ std::shared_ptr<arrow::RecordBatch> Cursor::getArrowRecordBatch() {
   CursorImpl* cursor = getImpl(this);
   return cursor->getArrowRecordBatch();
 }
+
+std::shared_ptr<arrow::RecordBatchReader> Cursor::getArrowRecordBatchReader(
+    size_t max_batch_rows) {
+  CursorImpl* cursor = getImpl(this);
+  return cursor->getArrowRecordBatchReader(max_batch_rows);
+}
 }  // namespace EmbeddedDatabase
@@ -29,6 +29,12 @@ class Cursor {
   Row getNextRow();
   ColumnType getColType(uint32_t col_num);
   std::shared_ptr<arrow::RecordBatch> getArrowRecordBatch();
+  /**
+   * Returns a reader over the result in record batches of at most max_batch_rows rows
+   * (the default fragment size if 0), sharing the buffers of the converted result.
+   */
+  std::shared_ptr<arrow::RecordBatchReader> getArrowRecordBatchReader(
+      size_t max_batch_rows = 0);
 
  protected:
   Cursor() {}
@@ -42,9 +48,16 @@ class DBEngine {
   void executeDDL(const std::string& query);
   std::shared_ptr<Cursor> executeDML(const std::string& query);
   std::shared_ptr<Cursor> executeRA(const std::string& query);
+  /**
+   * Registers an arrow table of fragments of at most fragment_size rows (the default
+   * fragment size if 0). If align_fragments_to_batches is set, fragments also end at
+   * record batch boundaries, so that their buffers are adopted rather than copied, which
+   * suits tables of few large batches only.
+   */
   void importArrowTable(const std::string& name,
                         std::shared_ptr<arrow::Table>& table,
-                        uint64_t fragment_size = 0);
+                        uint64_t fragment_size = 0,
+                        bool align_fragments_to_batches = false);
   static std::shared_ptr<DBEngine> create(const std::string& cmd_line);
   std::vector<std::string> getTables();
   std::vector<ColumnDetails> getTableDetails(const std::string& table_name);
@@ -14,20 +14,142 @@
  * limitations under the License.
  */
 
-#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
 #include <boost/program_options.hpp>
 #include <exception>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include "DBEngine.h"
 
 #include <arrow/api.h>
-#include <arrow/csv/reader.h>
-#include <arrow/io/file.h>
+#include "DataMgr/ForeignStorage/ArrowForeignStorage.h"
 #include "Shared/ArrowUtil.h"
 
 using namespace EmbeddedDatabase;
 
+namespace {
+
+std::shared_ptr<DBEngine> g_dbe;
+
+// Returns a chunked BIGINT column of consecutive values starting at 0
+std::shared_ptr<arrow::ChunkedArray> make_chunked_array(
+    const std::vector<int64_t>& chunk_sizes) {
+  arrow::ArrayVector chunks;
+  int64_t value = 0;
+  for (const auto chunk_size : chunk_sizes) {
+    arrow::Int64Builder builder;
+    for (int64_t row = 0; row < chunk_size; ++row) {
+      ARROW_THROW_NOT_OK(builder.Append(value++));
+    }
+    std::shared_ptr<arrow::Array> chunk;
+    ARROW_THROW_NOT_OK(builder.Finish(&chunk));
+    chunks.push_back(chunk);
+  }
+  return std::make_shared<arrow::ChunkedArray>(chunks, arrow::int64());
+}
+
+std::shared_ptr<arrow::Table> make_table(const std::vector<int64_t>& batch_sizes) {
+  return arrow::Table::Make(arrow::schema({arrow::field("i", arrow::int64())}),
+                            {make_chunked_array(batch_sizes)});
+}
+
+int64_t query_int(const std::string& query) {
+  auto cursor = g_dbe->executeDML(query);
+  if (!cursor || cursor->getRowCount() != 1) {
+    throw std::runtime_error("Unexpected result of query: " + query);
+  }
+  return cursor->getNextRow().getInt(0);
+}
+
+}  // namespace
+
+TEST(ArrowFragmentSizes, BatchesCoalescedByDefault) {
+  const auto array = make_chunked_array({10, 10, 10, 10, 10, 10, 10, 10, 10, 10});
+  EXPECT_EQ(calculateFragmentSizes(*array, 32, false),
+            (std::vector<size_t>{32, 32, 32, 4}));
+  EXPECT_EQ(calculateFragmentSizes(*array, 100, false), (std::vector<size_t>{100}));
+}
+
+TEST(ArrowFragmentSizes, BatchesAligned) {
+  const auto array = make_chunked_array({10, 10, 10, 10, 10, 10, 10, 10, 10, 10});
+  EXPECT_EQ(calculateFragmentSizes(*array, 32, true), std::vector<size_t>(10, 10));
+  // batches larger than a fragment are still split
+  EXPECT_EQ(calculateFragmentSizes(*make_chunked_array({50, 20}), 32, true),
+            (std::vector<size_t>{32, 18, 20}));
+}
+
+TEST(ArrowFragmentSizes, BatchFillsFragment) {
+  const auto array = make_chunked_array({32, 32, 5});
+  EXPECT_EQ(calculateFragmentSizes(*array, 32, false), (std::vector<size_t>{32, 32, 5}));
+  EXPECT_EQ(calculateFragmentSizes(*array, 32, true), (std::vector<size_t>{32, 32, 5}));
+}
+
+TEST(ArrowImport, DefaultAndAlignedFragments) {
+  const std::vector<int64_t> batch_sizes{10, 10, 10, 10, 10, 10, 10, 10, 10, 10};
+  auto table = make_table(batch_sizes);
+  g_dbe->importArrowTable("arrow_coalesced", table, 32);
+  g_dbe->importArrowTable("arrow_aligned", table, 32, true);
+  for (const std::string table_name : {"arrow_coalesced", "arrow_aligned"}) {
+    EXPECT_EQ(query_int("SELECT COUNT(*) FROM " + table_name), 100) << table_name;
+    EXPECT_EQ(query_int("SELECT SUM(i) FROM " + table_name), 4950) << table_name;
+    EXPECT_EQ(query_int("SELECT COUNT(*) FROM " + table_name + " WHERE i >= 25"), 75)
+        << table_name;
+  }
+}
+
+TEST(ArrowRecordBatchReader, SlicesResult) {
+  auto table = make_table({100});
+  g_dbe->importArrowTable("arrow_reader", table);
+  auto cursor = g_dbe->executeDML("SELECT i FROM arrow_reader ORDER BY i");
+  ASSERT_TRUE(cursor);
+  auto reader = cursor->getArrowRecordBatchReader(32);
+  ASSERT_TRUE(reader);
+  ASSERT_EQ(reader->schema()->num_fields(), 1);
+
+  std::vector<int64_t> batch_sizes;
+  int64_t expected_value = 0;
+  std::shared_ptr<arrow::RecordBatch> batch;
+  while (true) {
+    ARROW_THROW_NOT_OK(reader->ReadNext(&batch));
+    if (!batch) {
+      break;
+    }
+    EXPECT_TRUE(batch->schema()->Equals(*reader->schema()));
+    batch_sizes.push_back(batch->num_rows());
+    const auto& column = static_cast<const arrow::Int64Array&>(*batch->column(0));
+    for (int64_t row = 0; row < column.length(); ++row) {
+      EXPECT_EQ(column.Value(row), expected_value++);
+    }
+  }
+  EXPECT_EQ(batch_sizes, (std::vector<int64_t>{32, 32, 32, 4}));
+
+  // the whole result fits into a batch of the default size
+  reader = cursor->getArrowRecordBatchReader();
+  ARROW_THROW_NOT_OK(reader->ReadNext(&batch));
+  ASSERT_TRUE(batch);
+  EXPECT_EQ(batch->num_rows(), 100);
+  ARROW_THROW_NOT_OK(reader->ReadNext(&batch));
+  EXPECT_FALSE(batch);
+}
+
+TEST(ArrowRecordBatchReader, EmptyResult) {
+  auto table = make_table({10});
+  g_dbe->importArrowTable("arrow_reader_empty", table);
+  auto cursor = g_dbe->executeDML("SELECT i FROM arrow_reader_empty WHERE i < 0");
+  ASSERT_TRUE(cursor);
+  auto reader = cursor->getArrowRecordBatchReader(32);
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->schema()->num_fields(), 1);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ARROW_THROW_NOT_OK(reader->ReadNext(&batch));
+  EXPECT_FALSE(batch);
+}
+
 int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
   std::string base_path;
   int calcite_port = 5555;
   bool columnar_output = true;
@@ -65,48 +187,22 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  int err{0};
   try {
     auto opt_str = base_path + " --calcite-port " + std::to_string(calcite_port);
     if (columnar_output) {
-      opt_str += "--columnar-output";
+      opt_str += " --enable-columnar-output";
     }
-    auto dbe = DBEngine::create(opt_str);
-    if (dbe) {
-      auto memory_pool = arrow::default_memory_pool();
-      auto arrow_parse_options = arrow::csv::ParseOptions::Defaults();
-      auto arrow_read_options = arrow::csv::ReadOptions::Defaults();
-      auto arrow_convert_options = arrow::csv::ConvertOptions::Defaults();
-      std::shared_ptr<arrow::io::ReadableFile> inp;
-      auto file_result = arrow::io::ReadableFile::Open("/localdisk/artemale/test.csv");
-      ARROW_THROW_NOT_OK(file_result.status());
-      inp = file_result.ValueOrDie();
-      auto table_reader_result = arrow::csv::TableReader::Make(memory_pool,
-                                                               inp,
-                                                               arrow_read_options,
-                                                               arrow_parse_options,
-                                                               arrow_convert_options);
-      ARROW_THROW_NOT_OK(table_reader_result.status());
-      auto table_reader = table_reader_result.ValueOrDie();
-      std::shared_ptr<arrow::Table> arrowTable;
-      auto arrow_table_result = table_reader->Read();
-      ARROW_THROW_NOT_OK(arrow_table_result.status());
-      arrowTable = arrow_table_result.ValueOrDie();
-      dbe->importArrowTable("test", arrowTable);
-
-      auto schema = dbe->getTableDetails("test");
-      for (auto& item : schema) {
-        std::cout << item.col_name << std::endl;
-      }
-      auto cursor = dbe->executeDML("select * from test");
-      if (cursor) {
-        std::cout << cursor->getRowCount() << " rows selected" << std::endl;
-        std::shared_ptr<arrow::RecordBatch> rbatch = cursor->getArrowRecordBatch();
-      } else {
-        std::cerr << "Cursor is NULL" << std::endl;
-      }
+    g_dbe = DBEngine::create(opt_str);
+    if (!g_dbe) {
+      std::cerr << "Failed to create the database engine" << std::endl;
+      return 1;
     }
+    err = RUN_ALL_TESTS();
   } catch (std::exception& e) {
     std::cerr << "Exception: " << e.what() << "\n";
+    err = 1;
   }
-  return 0;
+  g_dbe.reset();
+  return err;
 }
@@ -9,12 +9,16 @@ from libcpp.pair cimport pair
 from libcpp.vector cimport vector
 from cython.operator cimport dereference as deref
 from pyarrow.lib cimport CTable
+from pyarrow.includes.common cimport CStatus
 
 cdef extern from "arrow/api.h" namespace "arrow" nogil:
     cdef cppclass CRecordBatch" arrow::RecordBatch":
         int num_columns()
         int64_t num_rows()
 
+    cdef cppclass CRecordBatchReader" arrow::RecordBatchReader":
+        CStatus ReadNext(shared_ptr[CRecordBatch]* batch)
+
 cdef extern from "DBETypes.h" namespace 'EmbeddedDatabase':
     cdef cppclass ColumnType:
         pass
@@ -47,6 +51,7 @@ cdef extern from "DBEngine.h" namespace 'EmbeddedDatabase':
         Row getNextRow()
         ColumnType getColType(uint32_t nPos)
         shared_ptr[CRecordBatch] getArrowRecordBatch() nogil except +
+        shared_ptr[CRecordBatchReader] getArrowRecordBatchReader(size_t) nogil except +
 
     cdef cppclass DBEngine:
         void executeDDL(string) except +
@@ -54,7 +59,7 @@ cdef extern from "DBEngine.h" namespace 'EmbeddedDatabase':
         shared_ptr[Cursor] executeRA(string) except +
         vector[string] getTables() except +
         vector[ColumnDetails] getTableDetails(string) except +
-        void importArrowTable(string, shared_ptr[CTable]&, uint64_t) except +
+        void importArrowTable(string, shared_ptr[CTable]&, uint64_t, bool) except +
         bool setDatabase(string db_name) except +
         bool login(string db_name, string user_name, string password) except +
         @staticmethod
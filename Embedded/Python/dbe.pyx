@@ -154,6 +154,20 @@ cdef class PyCursor:
             prb = pyarrow_wrap_batch(self.c_batch)
             return prb
 
+    def getArrowRecordBatches(self, size_t max_batch_rows=0):
+        cdef shared_ptr[CRecordBatchReader] c_reader
+        cdef shared_ptr[CRecordBatch] c_batch
+        with nogil:
+            c_reader = self.c_cursor.get().getArrowRecordBatchReader(max_batch_rows)
+        if c_reader.get() is NULL:
+            return
+        while True:
+            with nogil:
+                check_status(c_reader.get().ReadNext(&c_batch))
+            if c_batch.get() is NULL:
+                return
+            yield pyarrow_wrap_batch(c_batch)
+
 ColumnDetailsTp = namedtuple("ColumnDetails", ["name", "type", "nullable",
                                              "precision", "scale",
                                              "comp_param", "encoding",
@@ -201,10 +215,11 @@ cdef class PyDbEngine:
         cdef shared_ptr[CTable] t = pyarrow_unwrap_table(table)
         cdef string n = bytes(name, 'utf-8')
         cdef uint64_t fragment_size = kwargs.get("fragment_size", 0)
+        cdef bool align_fragments_to_batches = kwargs.get("align_fragments_to_batches", False)
         if n.empty() or not t.get():
             raise RuntimeError('Table initialization failed')
         self.check_closed()
-        self.c_dbe.get().importArrowTable(n, t, fragment_size)
+        self.c_dbe.get().importArrowTable(n, t, fragment_size, align_fragments_to_batches)
 
     # TODO: remove this legacy alias.
     def consumeArrowTable(self, name, table, **kwargs):
@@ -65,6 +65,22 @@ def test_zero_division():
         cursor = engine.executeDML("SELECT x / (x - x) FROM test")
     assert "Division by zero" in str(excinfo.value)
 
+#######################Check arrow import and record batch reader
+def test_arrow_record_batches():
+    table = pyarrow.Table.from_batches(
+        [pyarrow.record_batch([pyarrow.array(range(i * 10, i * 10 + 10), pyarrow.int64())], names=['i'])
+         for i in range(10)])
+    engine.importArrowTable("arrow_coalesced", table, fragment_size=32)
+    engine.importArrowTable("arrow_aligned", table, fragment_size=32, align_fragments_to_batches=True)
+    for name in ["arrow_coalesced", "arrow_aligned"]:
+        cursor = engine.executeDML("select i from " + name + " order by i")
+        batches = list(cursor.getArrowRecordBatches(32))
+        assert [batch.num_rows for batch in batches] == [32, 32, 32, 4]
+        values = [value for batch in batches for value in batch.column(0).to_pylist()]
+        assert values == list(range(100))
+    cursor = engine.executeDML("select i from arrow_aligned where i < 0")
+    assert list(cursor.getArrowRecordBatches()) == []
+
 #######################Check double init  exception
 def test_double_init():
     with pytest.raises(RuntimeError) as excinfo:
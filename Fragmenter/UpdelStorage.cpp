@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <boost/variant.hpp>
 #include <boost/variant/get.hpp>
+#include <cstring>
 #include <limits>
 #include <mutex>
 #include <string>
@@ -37,6 +38,8 @@
 extern bool g_enable_experimental_string_functions;
 
 bool g_enable_auto_metadata_update{true};
+bool g_enable_auto_vacuum{false};
+float g_vacuum_min_selectivity{0.1};
 
 namespace Fragmenter_Namespace {
 
@@ -672,20 +675,33 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
   std::vector<std::future<void>> threads;
 
   const auto segsz = (nrow + ncore - 1) / ncore;
-  auto dbuf = chunk->getBuffer();
-  auto dbuf_addr = dbuf->getMemoryPtr();
-  dbuf->setUpdated();
+  // the rows are updated in copies of the pages holding them, published at the end of
+  // the query, and the checkpoint only rewrites the updated ranges
+  const UpdelRoll::StagedChunk* staged_chunk{nullptr};
+  {
+    const auto element_size = get_element_size(cd->columnType);
+    auto sorted_offsets = frag_offsets;
+    std::sort(sorted_offsets.begin(), sorted_offsets.end());
+    std::vector<std::pair<size_t, size_t>> updated_ranges;
+    for (size_t i = 0; i < nrow;) {
+      size_t j = i + 1;
+      while (j < nrow && sorted_offsets[j] <= sorted_offsets[j - 1] + 1) {
+        ++j;
+      }
+      updated_ranges.emplace_back(
+          sorted_offsets[i] * element_size,
+          (sorted_offsets[j - 1] - sorted_offsets[i] + 1) * element_size);
+      i = j;
+    }
+    staged_chunk =
+        &updel_roll.stageChunkRanges(chunk_key, chunk, element_size, updated_ranges);
+  }
   {
     std::lock_guard<std::mutex> lck(updel_roll.mutex);
     if (updel_roll.dirtyChunks.count(chunk.get()) == 0) {
       updel_roll.dirtyChunks.emplace(chunk.get(), chunk);
     }
-
-    ChunkKey chunkey{updel_roll.catalog->getCurrentDB().dbId,
-                     cd->tableId,
-                     cd->columnId,
-                     fragment.fragmentId};
-    updel_roll.dirtyChunkeys.insert(chunkey);
+    updel_roll.dirtyChunkeys.insert(chunk_key);
   }
   for (size_t rbegin = 0, c = 0; rbegin < nrow; ++c, rbegin += segsz) {
     threads.emplace_back(std::async(
@@ -720,7 +736,7 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
 
           for (size_t r = rbegin; r < std::min(rbegin + segsz, nrow); r++) {
             const auto roffs = frag_offsets[r];
-            auto data_ptr = dbuf_addr + roffs * get_element_size(lhs_type);
+            auto data_ptr = staged_chunk->getAddress(roffs * get_element_size(lhs_type));
             auto sv = &rhs_values[1 == n_rhs_values ? 0 : r];
             ScalarTargetValue sv2;
 
@@ -905,6 +921,8 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
   // for unit test
   if (Fragmenter_Namespace::FragmentInfo::unconditionalVacuum_) {
     if (cd->isDeletedCol) {
+      // vacuuming rewrites the chunks in place
+      updel_roll.publishStagedChunk(chunk_key);
       const auto deleted_offsets = getVacuumOffsets(chunk);
       if (deleted_offsets.size() > 0) {
         compactRows(catalog, td, fragment_id, deleted_offsets, memory_level, updel_roll);
@@ -1301,16 +1319,119 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
 
 }  // namespace Fragmenter_Namespace
 
+namespace {
+// Number of elements per staged page of an updated chunk
+constexpr size_t kStagedPageElementCount{1024};
+}  // namespace
+
+int8_t* UpdelRoll::StagedChunk::getAddress(const size_t offset) const {
+  const auto page_it = pages.find(offset / page_size);
+  CHECK(page_it != pages.end());
+  return page_it->second.get() + offset % page_size;
+}
+
+const UpdelRoll::StagedChunk& UpdelRoll::stageChunkRanges(
+    const ChunkKey& chunk_key,
+    std::shared_ptr<Chunk_NS::Chunk> chunk,
+    const size_t element_size,
+    const std::vector<std::pair<size_t, size_t>>& updated_ranges) {
+  std::lock_guard<std::mutex> lck(mutex);
+  auto buffer = chunk->getBuffer();
+  CHECK(buffer);
+  CHECK_EQ(buffer->getType(), Data_Namespace::CPU_LEVEL);
+  auto staged_it = stagedChunks.find(chunk_key);
+  if (staged_it == stagedChunks.end()) {
+    StagedChunk staged_chunk;
+    staged_chunk.chunk = std::move(chunk);
+    staged_chunk.page_size = element_size * kStagedPageElementCount;
+    staged_it = stagedChunks.emplace(chunk_key, std::move(staged_chunk)).first;
+  }
+  auto& staged_chunk = staged_it->second;
+  CHECK_EQ(staged_chunk.page_size, element_size * kStagedPageElementCount);
+  const auto page_size = staged_chunk.page_size;
+  const auto buffer_size = buffer->size();
+  for (const auto& [offset, num_bytes] : updated_ranges) {
+    CHECK_LE(offset + num_bytes, buffer_size);
+    if (num_bytes == 0) {
+      continue;
+    }
+    const auto last_page_index = (offset + num_bytes - 1) / page_size;
+    for (auto page_index = offset / page_size; page_index <= last_page_index;
+         page_index++) {
+      auto& page = staged_chunk.pages[page_index];
+      if (!page) {
+        const auto page_offset = page_index * page_size;
+        const auto page_bytes = std::min(page_size, buffer_size - page_offset);
+        page = std::make_unique<int8_t[]>(page_bytes);
+        std::memcpy(page.get(), buffer->getMemoryPtr() + page_offset, page_bytes);
+      }
+    }
+    staged_chunk.updated_ranges.emplace_back(offset, num_bytes);
+  }
+  return staged_chunk;
+}
+
+void UpdelRoll::publishStagedChunk(const ChunkKey& chunk_key) {
+  std::lock_guard<std::mutex> lck(mutex);
+  auto staged_it = stagedChunks.find(chunk_key);
+  if (staged_it == stagedChunks.end()) {
+    return;
+  }
+  auto& staged_chunk = staged_it->second;
+  auto buffer = staged_chunk.chunk->getBuffer();
+  CHECK(buffer);
+  // rows appended concurrently follow the staged pages and are left as they are
+  auto buffer_addr = buffer->getMemoryPtr();
+  const auto page_size = staged_chunk.page_size;
+  for (const auto& [offset, num_bytes] : staged_chunk.updated_ranges) {
+    CHECK_LE(offset + num_bytes, buffer->size());
+    // ranges may span several staged pages
+    for (size_t range_offset = offset; range_offset < offset + num_bytes;) {
+      const auto page_end = (range_offset / page_size + 1) * page_size;
+      const auto copy_bytes = std::min(page_end, offset + num_bytes) - range_offset;
+      std::memcpy(buffer_addr + range_offset,
+                  staged_chunk.getAddress(range_offset),
+                  copy_bytes);
+      range_offset += copy_bytes;
+    }
+    buffer->setUpdatedRange(offset, num_bytes);
+  }
+  stagedChunks.erase(staged_it);
+}
+
+void UpdelRoll::publishUpdate() {
+  if (nullptr == catalog || is_published) {
+    return;
+  }
+  const auto td = catalog->getMetadataForTable(logicalTableId);
+  CHECK(td);
+  ChunkKey chunk_key{catalog->getDatabaseId(), td->tableId};
+  const auto table_lock = lockmgr::TableDataLockMgr::getWriteLockForTable(chunk_key);
+
+  std::vector<ChunkKey> staged_chunk_keys;
+  for (const auto& staged_chunk : stagedChunks) {
+    staged_chunk_keys.push_back(staged_chunk.first);
+  }
+  for (const auto& staged_chunk_key : staged_chunk_keys) {
+    publishStagedChunk(staged_chunk_key);
+  }
+  updateFragmenter();
+  is_published = true;
+}
+
 bool UpdelRoll::commitUpdate() {
   if (nullptr == catalog) {
     return false;
   }
   const auto td = catalog->getMetadataForTable(logicalTableId);
   CHECK(td);
-  ChunkKey chunk_key{catalog->getDatabaseId(), td->tableId};
-  const auto table_lock = lockmgr::TableDataLockMgr::getWriteLockForTable(chunk_key);
+  publishUpdate();
 
-  // Checkpoint all shards. Otherwise, epochs can go out of sync.
+  // Checkpoint all shards. Otherwise, epochs can go out of sync. The published chunks
+  // stay pinned by `dirtyChunks` until they are written, and queries reading the table
+  // run concurrently with the checkpoint since they see the published data either way.
+  // Callers updating fragments concurrently hold the table's checkpoint lock from
+  // publishing through here, so that a rollback only drops this transaction's changes.
   if (td->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
     auto table_epochs = catalog->getTableEpochs(catalog->getDatabaseId(), logicalTableId);
     try {
@@ -1318,12 +1439,18 @@ bool UpdelRoll::commitUpdate() {
       // `dirtyChunks` has to be cleared before resetting epochs
       catalog->checkpoint(logicalTableId);
     } catch (...) {
-      dirtyChunks.clear();
-      catalog->setTableEpochsLogExceptions(catalog->getDatabaseId(), table_epochs);
+      ChunkKey chunk_key{catalog->getDatabaseId(), td->tableId};
+      const auto table_lock = lockmgr::TableDataLockMgr::getWriteLockForTable(chunk_key);
+      try {
+        rollbackPublishedUpdate(table_epochs);
+      } catch (std::exception& e) {
+        LOG(ERROR) << "An error occurred when rolling back an update of table "
+                   << td->tableName << ": " << e.what();
+      }
       throw;
     }
   }
-  updateFragmenterAndCleanupChunks();
+  dirtyChunks.clear();
   return true;
 }
 
@@ -1336,6 +1463,7 @@ void UpdelRoll::stageUpdate() {
   CHECK_EQ(table_descriptor->persistenceLevel, Data_Namespace::MemoryLevel::DISK_LEVEL);
   const auto table_lock =
       lockmgr::TableDataLockMgr::getWriteLockForTable({db_id, logicalTableId});
+  CHECK(stagedChunks.empty());
   try {
     catalog->getDataMgr().checkpoint(db_id, table_id, memoryLevel);
   } catch (...) {
@@ -1345,12 +1473,41 @@ void UpdelRoll::stageUpdate() {
   updateFragmenterAndCleanupChunks();
 }
 
-void UpdelRoll::updateFragmenterAndCleanupChunks() {
+void UpdelRoll::rollbackPublishedUpdate(
+    const std::vector<Catalog_Namespace::TableEpochInfo>& table_epochs) {
+  const auto db_id = catalog->getDatabaseId();
+  dirtyChunks.clear();
+  if (is_varlen_update) {
+    // varlen updates append rows to the table and hold the locks of all its fragments,
+    // so no other update or delete uses the table while the fragmenter is reloaded
+    catalog->setTableEpochs(db_id, table_epochs);
+    return;
+  }
+  auto& data_mgr = catalog->getDataMgr();
+  for (const auto& chunk_key : dirtyChunkeys) {
+    data_mgr.deleteChunksWithPrefix(chunk_key, Data_Namespace::MemoryLevel::CPU_LEVEL);
+    data_mgr.deleteChunksWithPrefix(chunk_key, Data_Namespace::MemoryLevel::GPU_LEVEL);
+  }
+  catalog->setTableStorageEpochs(db_id, table_epochs);
+  // restore the metadata of the changed fragments from storage
+  for (auto& [key, chunk_metadata_map] : chunkMetadata) {
+    for (auto& [column_id, chunk_metadata] : chunk_metadata_map) {
+      ChunkMetadataVector stored_chunk_metadata;
+      data_mgr.getChunkMetadataVecForKeyPrefix(
+          stored_chunk_metadata,
+          {db_id, key.first->tableId, column_id, key.second->fragmentId});
+      CHECK(!stored_chunk_metadata.empty());
+      chunk_metadata = stored_chunk_metadata.front().second;
+    }
+  }
+  updateFragmenter();
+}
+
+void UpdelRoll::updateFragmenter() {
   // for each dirty fragment
   for (auto& cm : chunkMetadata) {
     cm.first.first->fragmenter->updateMetadata(catalog, cm.first, *this);
   }
-  dirtyChunks.clear();
   // flush gpu dirty chunks if update was not on gpu
   if (memoryLevel != Data_Namespace::MemoryLevel::GPU_LEVEL) {
     for (const auto& chunkey : dirtyChunkeys) {
@@ -1360,6 +1517,11 @@ void UpdelRoll::updateFragmenterAndCleanupChunks() {
   }
 }
 
+void UpdelRoll::updateFragmenterAndCleanupChunks() {
+  updateFragmenter();
+  dirtyChunks.clear();
+}
+
 void UpdelRoll::cancelUpdate() {
   if (nullptr == catalog) {
     return;
@@ -1368,15 +1530,15 @@ void UpdelRoll::cancelUpdate() {
   // TODO: needed?
   ChunkKey chunk_key{catalog->getDatabaseId(), logicalTableId};
   const auto table_lock = lockmgr::TableDataLockMgr::getWriteLockForTable(chunk_key);
-  if (is_varlen_update) {
-    int databaseId = catalog->getDatabaseId();
-    auto table_epochs = catalog->getTableEpochs(databaseId, logicalTableId);
-
-    dirtyChunks.clear();
-    catalog->setTableEpochs(databaseId, table_epochs);
+  stagedChunks.clear();
+  const auto td = catalog->getMetadataForTable(logicalTableId);
+  CHECK(td);
+  if (is_varlen_update ||
+      (is_published && td->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL)) {
+    // the fragmenter has been updated, reload the changes as of the last checkpoint
+    rollbackPublishedUpdate(
+        catalog->getTableEpochs(catalog->getDatabaseId(), logicalTableId));
   } else {
-    const auto td = catalog->getMetadataForTable(logicalTableId);
-    CHECK(td);
     if (td->persistenceLevel != memoryLevel) {
       for (auto dit : dirtyChunks) {
         catalog->getDataMgr().free(dit.first->getBuffer());
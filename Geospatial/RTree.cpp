@@ -0,0 +1,130 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Geospatial/RTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Logger/Logger.h"
+
+namespace Geospatial {
+
+BoundingBox BoundingBox::empty() {
+  constexpr auto max = std::numeric_limits<double>::max();
+  return {max, max, -max, -max};
+}
+
+void BoundingBox::extend(const BoundingBox& other) {
+  min_x = std::min(min_x, other.min_x);
+  min_y = std::min(min_y, other.min_y);
+  max_x = std::max(max_x, other.max_x);
+  max_y = std::max(max_y, other.max_y);
+}
+
+BoundingBox BoundingBox::expand(const double distance) const {
+  if (isEmpty()) {
+    return *this;
+  }
+  return {min_x - distance, min_y - distance, max_x + distance, max_y + distance};
+}
+
+StrRTree::StrRTree(const std::vector<std::pair<BoundingBox, int64_t>>& entries,
+                   const size_t node_capacity)
+    : node_capacity_(node_capacity) {
+  CHECK_GT(node_capacity_, size_t(1));
+  std::vector<Node> level;
+  level.reserve(entries.size());
+  for (const auto& [box, id] : entries) {
+    // Empty boxes can never be returned by a query
+    if (!box.isEmpty()) {
+      level.push_back({box, id, 0});
+    }
+  }
+  if (level.empty()) {
+    return;
+  }
+  while (true) {
+    auto parents = packLevel(level);
+    levels_.emplace_back(std::move(level));
+    if (parents.size() == 1) {
+      levels_.emplace_back(std::move(parents));
+      break;
+    }
+    level = std::move(parents);
+  }
+}
+
+std::vector<StrRTree::Node> StrRTree::packLevel(std::vector<Node>& nodes) const {
+  const size_t num_parents = (nodes.size() + node_capacity_ - 1) / node_capacity_;
+  const size_t num_slices =
+      static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(num_parents))));
+  const size_t slice_size = num_slices * node_capacity_;
+
+  auto center_x = [](const Node& node) { return node.box.min_x + node.box.max_x; };
+  auto center_y = [](const Node& node) { return node.box.min_y + node.box.max_y; };
+  std::sort(nodes.begin(), nodes.end(), [&center_x](const Node& a, const Node& b) {
+    return center_x(a) < center_x(b);
+  });
+
+  std::vector<Node> parents;
+  parents.reserve(num_parents);
+  for (size_t slice_start = 0; slice_start < nodes.size(); slice_start += slice_size) {
+    const auto slice_end = std::min(slice_start + slice_size, nodes.size());
+    std::sort(nodes.begin() + slice_start,
+              nodes.begin() + slice_end,
+              [&center_y](const Node& a, const Node& b) {
+                return center_y(a) < center_y(b);
+              });
+    for (size_t start = slice_start; start < slice_end; start += node_capacity_) {
+      const auto end = std::min(start + node_capacity_, slice_end);
+      Node parent{BoundingBox::empty(), static_cast<int64_t>(start), end - start};
+      for (size_t i = start; i < end; ++i) {
+        parent.box.extend(nodes[i].box);
+      }
+      parents.emplace_back(parent);
+    }
+  }
+  return parents;
+}
+
+std::vector<int64_t> StrRTree::query(const BoundingBox& box) const {
+  std::vector<int64_t> ids;
+  if (levels_.empty() || box.isEmpty()) {
+    return ids;
+  }
+  // Pending (level, node index) pairs
+  std::vector<std::pair<size_t, size_t>> stack{{levels_.size() - 1, 0}};
+  while (!stack.empty()) {
+    const auto [level, index] = stack.back();
+    stack.pop_back();
+    const auto& node = levels_[level][index];
+    if (!node.box.intersects(box)) {
+      continue;
+    }
+    if (level == 0) {
+      ids.emplace_back(node.value);
+      continue;
+    }
+    for (size_t i = 0; i < node.num_children; ++i) {
+      stack.emplace_back(level - 1, node.value + i);
+    }
+  }
+  return ids;
+}
+
+}  // namespace Geospatial
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Geospatial {
+
+struct BoundingBox {
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+
+  // Box which contains nothing and intersects nothing, the identity of extend()
+  static BoundingBox empty();
+
+  bool isEmpty() const { return min_x > max_x || min_y > max_y; }
+
+  bool intersects(const BoundingBox& other) const {
+    return min_x <= other.max_x && other.min_x <= max_x && min_y <= other.max_y &&
+           other.min_y <= max_y;
+  }
+
+  void extend(const BoundingBox& other);
+
+  // Grows the box by the given distance in every direction.
+  BoundingBox expand(const double distance) const;
+};
+
+/**
+ * Static R-tree over bounding boxes, bulk loaded with the Sort-Tile-Recursive algorithm:
+ * entries are sorted into vertical slices by the x coordinate of their centers, each
+ * slice is sorted by y, and runs of `node_capacity` entries are packed into nodes. The
+ * same is repeated on the nodes of each level up to the root, which gives nearly full
+ * nodes with little overlap for mostly static data.
+ */
+class StrRTree {
+ public:
+  StrRTree(const std::vector<std::pair<BoundingBox, int64_t>>& entries,
+           const size_t node_capacity = 16);
+
+  // Returns the ids of the entries whose boxes intersect the given box.
+  std::vector<int64_t> query(const BoundingBox& box) const;
+
+  size_t size() const { return levels_.empty() ? 0 : levels_.front().size(); }
+  size_t height() const { return levels_.size(); }
+
+ private:
+  struct Node {
+    BoundingBox box;
+    // Entry id in leaves, index of the first child in the level below otherwise
+    int64_t value;
+    size_t num_children;
+  };
+
+  // Sorts the nodes of a level in STR order and returns their parent nodes.
+  std::vector<Node> packLevel(std::vector<Node>& nodes) const;
+
+  const size_t node_capacity_;
+  // Leaves first, the last level holds the root
+  std::vector<std::vector<Node>> levels_;
+};
+
+}  // namespace Geospatial
@@ -22,6 +22,10 @@
 
 #include "ImportExport/DelimitedParserUtils.h"
 
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
 #include <string_view>
 
 #include "Logger/Logger.h"
@@ -196,6 +200,303 @@ size_t find_row_end_pos(size_t& alloc_size,
   return end_pos;
 }
 
+namespace {
+/**
+ * Row endings found in a block of data, for one assumption about whether the block
+ * starts inside a quoted field.
+ */
+struct BlockRowEnds {
+  unsigned int row_count{0};
+  // Position following the last row ending, 0 if the block has none
+  size_t row_end_pos{0};
+  bool ends_in_quote{false};
+};
+
+/**
+ * A block of data read at a fixed offset. Since it is not known whether a block
+ * starts inside a quoted field until all previous blocks are scanned, row endings are
+ * found for both cases.
+ */
+struct ScannedBlock {
+  std::unique_ptr<char[]> data;
+  size_t size{0};
+  BlockRowEnds row_ends[2];
+};
+
+BlockRowEnds find_block_row_ends(const char* data,
+                                 const size_t size,
+                                 const import_export::CopyParams& copy_params,
+                                 const bool starts_in_quote) {
+  BlockRowEnds row_ends;
+  row_ends.ends_in_quote = starts_in_quote;
+  try {
+    row_ends.row_end_pos = find_end(
+        data, size, copy_params, row_ends.row_count, 0, row_ends.ends_in_quote, 0);
+  } catch (const InsufficientBufferSizeException&) {
+    // find_end does not count a single row ending at the start of the block
+    row_ends.row_end_pos = row_ends.row_count > 0 ? 1 : 0;
+  }
+  return row_ends;
+}
+
+/**
+ * Returns the position following the first row ending in the block, 0 if it has none.
+ * Blocks are only scanned concurrently when the escape character is the quote
+ * character, so an escaped quote toggles the quote state twice.
+ */
+size_t find_first_row_end_pos(const char* data,
+                              const size_t size,
+                              const import_export::CopyParams& copy_params,
+                              bool in_quote) {
+  for (size_t i = 0; i < size; i++) {
+    if (copy_params.quoted && data[i] == copy_params.quote) {
+      in_quote = !in_quote;
+    } else if (!in_quote && data[i] == copy_params.line_delim) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Error thrown when a row does not fit in the largest buffer the sequential scan would
+ * grow to, with the same message as find_end.
+ */
+std::runtime_error get_row_too_long_error(const char* row,
+                                          const size_t size,
+                                          const size_t row_index) {
+  const size_t excerpt_length = std::min<size_t>(50, size);
+  return std::runtime_error{
+      "Unable to find an end of line character after reading " + std::to_string(size) +
+      " characters. Please ensure that the correct \"line_delimiter\" option is "
+      "specified or update the \"buffer_size\" option appropriately. Row number: " +
+      std::to_string(row_index + 1) +
+      ". First few characters in row: " + std::string{row, row + excerpt_length}};
+}
+
+/**
+ * Blocks of data read concurrently by reader threads and handed out in file order.
+ */
+class ScannedBlockQueue {
+ public:
+  ScannedBlockQueue(const size_t block_count, const size_t max_pending_blocks)
+      : block_count_(block_count)
+      , max_pending_blocks_(max_pending_blocks)
+      , next_block_to_read_(0)
+      , next_block_to_take_(0)
+      , cancelled_(false) {}
+
+  // Returns the index of the next block to read, or an empty optional when done.
+  std::optional<size_t> getBlockToRead() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] {
+      return cancelled_ || next_block_to_read_ >= block_count_ ||
+             next_block_to_read_ < next_block_to_take_ + max_pending_blocks_;
+    });
+    if (cancelled_ || next_block_to_read_ >= block_count_) {
+      return {};
+    }
+    return next_block_to_read_++;
+  }
+
+  void putBlock(const size_t block_index, ScannedBlock block) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      blocks_.emplace(block_index, std::move(block));
+    }
+    condition_.notify_all();
+  }
+
+  // Waits for the next block in file order. Returns an empty optional if cancelled.
+  std::optional<ScannedBlock> takeNextBlock() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(
+        lock, [this] { return cancelled_ || blocks_.count(next_block_to_take_) > 0; });
+    if (cancelled_) {
+      return {};
+    }
+    auto it = blocks_.find(next_block_to_take_);
+    auto block = std::move(it->second);
+    blocks_.erase(it);
+    next_block_to_take_++;
+    lock.unlock();
+    condition_.notify_all();
+    return std::move(block);
+  }
+
+  void cancel() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cancelled_ = true;
+    }
+    condition_.notify_all();
+  }
+
+ private:
+  const size_t block_count_;
+  const size_t max_pending_blocks_;
+  size_t next_block_to_read_;
+  size_t next_block_to_take_;
+  bool cancelled_;
+  std::map<size_t, ScannedBlock> blocks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
+/**
+ * Reads blocks of data with the given reader and finds their row endings.
+ */
+void read_blocks(
+    const std::function<size_t(char* buffer, size_t offset, size_t max_size)>& read_at,
+    const import_export::CopyParams& copy_params,
+    const size_t block_size,
+    ScannedBlockQueue& block_queue) {
+  while (true) {
+    auto block_index = block_queue.getBlockToRead();
+    if (!block_index.has_value()) {
+      break;
+    }
+    ScannedBlock block;
+    // One extra byte in case a delimiter is inserted at the end of the data
+    block.data = std::make_unique<char[]>(block_size + 1);
+    block.size =
+        read_at(block.data.get(), block_index.value() * block_size, block_size + 1);
+    block.row_ends[0] =
+        find_block_row_ends(block.data.get(), block.size, copy_params, false);
+    if (copy_params.quoted) {
+      block.row_ends[1] =
+          find_block_row_ends(block.data.get(), block.size, copy_params, true);
+    }
+    block_queue.putBlock(block_index.value(), std::move(block));
+  }
+}
+}  // namespace
+
+bool can_scan_blocks_concurrently(const CopyParams& copy_params,
+                                  const size_t thread_count,
+                                  const size_t data_size,
+                                  const size_t block_size) {
+  return thread_count > 1 && data_size >= 2 * thread_count * block_size &&
+         (!copy_params.quoted || copy_params.escape == copy_params.quote);
+}
+
+std::optional<size_t> scan_blocks_concurrently(
+    const size_t data_size,
+    const size_t block_size,
+    const size_t thread_count,
+    const CopyParams& copy_params,
+    const size_t first_row_index,
+    const std::function<size_t(char* buffer, size_t offset, size_t max_size)>& read_at,
+    const std::function<bool(const char* carried_over_row,
+                             size_t carried_over_size,
+                             const char* rows,
+                             size_t rows_size,
+                             unsigned int row_count)>& dispatch_rows) {
+  const auto block_count = std::max<size_t>((data_size + block_size - 1) / block_size, 1);
+  ScannedBlockQueue block_queue(block_count, 2 * thread_count);
+
+  std::vector<std::future<void>> reader_futures;
+  for (size_t i = 0; i < std::min(thread_count, block_count); i++) {
+    reader_futures.emplace_back(std::async(std::launch::async, [&] {
+      try {
+        read_blocks(read_at, copy_params, block_size, block_queue);
+      } catch (...) {
+        block_queue.cancel();
+        throw;
+      }
+    }));
+  }
+
+  // Rows passed on at once are bounded by the largest buffer find_row_end_pos grows to
+  // in a sequential read
+  const auto max_request_size = std::max(block_size, get_max_buffer_resize());
+  std::vector<char> residual;
+  bool in_quote{false};
+  bool stopped{false};
+  size_t scanned_size{0};
+  size_t block_index{0};
+  size_t row_index{first_row_index};
+
+  // Passes on the residual partial row followed by the given complete rows of a block
+  auto dispatch = [&](const char* data, const size_t size, const unsigned int row_count) {
+    CHECK_LE(residual.size() + size, max_request_size);
+    stopped = !dispatch_rows(residual.data(), residual.size(), data, size, row_count);
+    residual.clear();
+    row_index += row_count;
+  };
+
+  try {
+    for (; !stopped && block_index < block_count; block_index++) {
+      auto block_opt = block_queue.takeNextBlock();
+      if (!block_opt.has_value()) {
+        break;
+      }
+      auto& block = block_opt.value();
+      const auto block_data = block.data.get();
+      scanned_size += block.size;
+      const auto block_starts_in_quote = in_quote;
+      const auto& row_ends = block.row_ends[in_quote ? 1 : 0];
+      in_quote = row_ends.ends_in_quote;
+      if (row_ends.row_end_pos == 0) {
+        // The row continues past this block
+        if (residual.size() + block.size > max_request_size) {
+          residual.insert(residual.end(),
+                          block_data,
+                          block_data + (max_request_size - residual.size()));
+          throw get_row_too_long_error(residual.data(), residual.size(), row_index);
+        }
+        residual.insert(residual.end(), block_data, block_data + block.size);
+        continue;
+      }
+
+      if (block_index == block_count - 1 && block.size == 1 && residual.empty()) {
+        // Extra line delimiter at the end of the data
+        continue;
+      }
+      if (residual.size() + row_ends.row_end_pos <= max_request_size) {
+        dispatch(block_data, row_ends.row_end_pos, row_ends.row_count);
+      } else {
+        // Too large to pass on at once, pass on the row carried over on its own
+        const auto first_row_end_pos = find_first_row_end_pos(
+            block_data, row_ends.row_end_pos, copy_params, block_starts_in_quote);
+        CHECK_GT(first_row_end_pos, size_t(0));
+        if (residual.size() + first_row_end_pos > max_request_size) {
+          residual.insert(residual.end(),
+                          block_data,
+                          block_data + (max_request_size - residual.size()));
+          throw get_row_too_long_error(residual.data(), residual.size(), row_index);
+        }
+        dispatch(block_data, first_row_end_pos, 1);
+        if (!stopped && first_row_end_pos < row_ends.row_end_pos) {
+          dispatch(block_data + first_row_end_pos,
+                   row_ends.row_end_pos - first_row_end_pos,
+                   row_ends.row_count - 1);
+        }
+      }
+      residual.assign(block_data + row_ends.row_end_pos, block_data + block.size);
+    }
+    if (!stopped && block_index == block_count && !residual.empty()) {
+      throw std::runtime_error{
+          "Unable to find the end of the last row of the file. Row number: " +
+          std::to_string(row_index + 1)};
+    }
+  } catch (...) {
+    block_queue.cancel();
+    for (auto& future : reader_futures) {
+      future.wait();
+    }
+    throw;
+  }
+  block_queue.cancel();
+  for (auto& future : reader_futures) {
+    future.get();
+  }
+  if (stopped || block_index < block_count) {
+    return {};
+  }
+  return scanned_size;
+}
+
 template <typename T>
 const char* get_row(const char* buf,
                     const char* buf_end,
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -53,6 +55,29 @@ size_t find_beginning(const char* buffer,
                       size_t end,
                       const CopyParams& copy_params);
 
+/**
+ * @brief Finds the last row ending in the given buffer, outside of quoted fields.
+ *
+ * @param buffer                 Given buffer which has the rows in csv format. (NOT OWN)
+ * @param size                   Size of the buffer.
+ * @param copy_params            Copy params for the table.
+ * @param num_rows_this_buffer   Incremented by the number of row endings found.
+ * @param buffer_first_row_index Index of first row in the buffer, for error messages.
+ * @param in_quote               Whether scanning starts inside a quoted field. Set to
+ *                               whether it ended inside one.
+ * @param offset                 Position in the buffer to start scanning from.
+ *
+ * @return The position following the last row ending. Throws an
+ * InsufficientBufferSizeException if there is none.
+ */
+size_t find_end(const char* buffer,
+                size_t size,
+                const import_export::CopyParams& copy_params,
+                unsigned int& num_rows_this_buffer,
+                size_t buffer_first_row_index,
+                bool& in_quote,
+                size_t offset);
+
 /**
  * @brief Gets the maximum size to which thread buffers should be automatically resized.
  */
@@ -91,6 +116,63 @@ size_t find_row_end_pos(size_t& alloc_size,
                         FILE* file,
                         foreign_storage::CsvReader* csv_reader = nullptr);
 
+/**
+ * @brief Checks whether data of the given size can be read with
+ * scan_blocks_concurrently(). Reading blocks concurrently pays off once readers can stay
+ * a few blocks ahead of the parsing threads, so smaller data is read sequentially.
+ * Quoted data whose escape character differs from the quote character is read
+ * sequentially as well, since an escape at the end of a block could escape the first
+ * character of the next block.
+ *
+ * @param copy_params          Copy params for the table.
+ * @param thread_count         Number of threads reading blocks.
+ * @param data_size            Size of the data to read.
+ * @param block_size           Size of the blocks read by each thread.
+ *
+ * @return true if the data can be read in blocks.
+ */
+bool can_scan_blocks_concurrently(const CopyParams& copy_params,
+                                  const size_t thread_count,
+                                  const size_t data_size,
+                                  const size_t block_size);
+
+/**
+ * @brief Reads data in fixed-size blocks on several threads and finds the row endings
+ * of each block, once assuming the block starts outside a quoted field and once assuming
+ * it starts inside one. Blocks are then taken in file order, and rows are passed on
+ * aligned to row endings, with the partial row at the end of a block carried over to
+ * the next rows passed on. Rows passed on at once are bounded by get_max_buffer_resize(),
+ * like the buffers of find_row_end_pos().
+ *
+ * @param data_size            Size of the data to read.
+ * @param block_size           Size of the blocks read by each thread.
+ * @param thread_count         Number of threads reading blocks.
+ * @param copy_params          Copy params for the table.
+ * @param first_row_index      Index of the first row in the data, for error messages.
+ * @param read_at              Reads up to max_size - 1 bytes of the data at the given
+ *                             offset into the buffer and returns the number of bytes
+ *                             read. The read that reaches the end of the data must end
+ *                             with a line delimiter, for which the last byte is
+ *                             reserved. Called from several threads at once.
+ * @param dispatch_rows        Called with the partial row carried over from the previous
+ *                             block, the complete rows that follow it and their count.
+ *                             Returns false to stop reading.
+ *
+ * @return The number of bytes read, or an empty optional if reading was stopped.
+ */
+std::optional<size_t> scan_blocks_concurrently(
+    const size_t data_size,
+    const size_t block_size,
+    const size_t thread_count,
+    const CopyParams& copy_params,
+    const size_t first_row_index,
+    const std::function<size_t(char* buffer, size_t offset, size_t max_size)>& read_at,
+    const std::function<bool(const char* carried_over_row,
+                             size_t carried_over_size,
+                             const char* rows,
+                             size_t rows_size,
+                             unsigned int row_count)>& dispatch_rows);
+
 /**
  * @brief Parses the first row in the given buffer and inserts fields into given vector.
  *
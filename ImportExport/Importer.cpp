@@ -64,6 +64,7 @@
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/TypePunning.h"
 #include "Shared/DateTimeParser.h"
+#include "Shared/Metrics.h"
 #include "Shared/SqlTypesLayout.h"
 #include "Shared/import_helpers.h"
 #include "Shared/likely.h"
@@ -2941,6 +2942,11 @@ bool Loader::loadToShard(
       success = false;
     }
   }
+  if (success) {
+    static auto& rows_loaded = metrics::Registry::instance().counter(
+        "omnisci_import_rows_total", "Rows loaded into tables by the importer.");
+    rows_loaded.increment(row_count);
+  }
   return success;
 }
 
@@ -3895,6 +3901,12 @@ void DataStreamSink::import_compressed(
     p_file = 0;
   });
 
+  // threads used to decompress BGZF files, bounded like the import threads
+  const size_t decompression_threads =
+      copy_params.threads
+          ? static_cast<size_t>(copy_params.threads)
+          : std::min(static_cast<size_t>(cpu_threads()), g_max_import_threads);
+
   // create a thread to iterate all files (in all archives) and
   // forward the uncompressed byte stream to fd[1] which is
   // then feed into importDelimited, importParquet, and etc.
@@ -3909,7 +3921,8 @@ void DataStreamSink::import_compressed(
         Archive::parse_url(file_path, url_parts);
         const std::string S3_objkey_url_scheme = "s3ok";
         if ("file" == url_parts[2] || "" == url_parts[2]) {
-          uarch.reset(new PosixFileArchive(file_path, copy_params.plain_text));
+          uarch.reset(new PosixFileArchive(
+              file_path, copy_params.plain_text, decompression_threads));
         } else if ("s3" == url_parts[2]) {
 #ifdef HAVE_AWS_S3
           // new a S3Archive with a shared s3client.
@@ -3939,7 +3952,8 @@ void DataStreamSink::import_compressed(
           if (0 == file_path.size()) {
             throw std::runtime_error(std::string("failed to land s3 object: ") + objkey);
           }
-          uarch.reset(new PosixFileArchive(file_path, copy_params.plain_text));
+          uarch.reset(new PosixFileArchive(
+              file_path, copy_params.plain_text, decompression_threads));
           // file not removed until file closed
           us3arch->vacuum(objkey);
 #else
@@ -4107,7 +4121,92 @@ void DataStreamSink::import_compressed(
   }
 }
 
+namespace {
+
+size_t get_delimited_import_thread_count(const CopyParams& copy_params) {
+  if (copy_params.threads == 0) {
+    return std::min(static_cast<size_t>(sysconf(_SC_NPROCESSORS_CONF)),
+                    g_max_import_threads);
+  }
+  return static_cast<size_t>(copy_params.threads);
+}
+
+// size of the header line, which import_compressed skips in the pipe writer for files
+// it streams
+size_t get_header_size(const std::string& file_path, const CopyParams& copy_params) {
+  if (copy_params.has_header == ImportHeaderRow::NO_HEADER) {
+    return 0;
+  }
+  std::ifstream file{file_path, std::ios::binary};
+  std::string line;
+  std::getline(file, line, copy_params.line_delim);
+  return file.eof() ? line.size() : line.size() + 1;
+}
+
+// reads up to size bytes at the given offset, without moving the file position, so
+// several threads can read the file at once
+size_t read_file_at(FILE* file,
+                    const std::string& file_path,
+                    char* buffer,
+                    const size_t offset,
+                    const size_t size) {
+#ifdef _WIN32
+  // see can_import_delimited_in_blocks
+  UNREACHABLE();
+  return 0;
+#else
+  size_t nread = 0;
+  while (nread < size) {
+    const auto result = pread(fileno(file), buffer + nread, size - nread, offset + nread);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("failed to read file '" + file_path +
+                               "': " + strerror(errno));
+    }
+    if (result == 0) {
+      break;
+    }
+    nread += result;
+  }
+  return nread;
+#endif
+}
+
+// a single local plain text file large enough to keep several threads busy is read
+// directly in blocks instead of being streamed through libarchive and a pipe
+bool can_import_delimited_in_blocks(const std::string& file_path,
+                                    const CopyParams& copy_params) {
+#ifdef _WIN32
+  // blocks are read with pread, see read_file_at
+  return false;
+#else
+  if (copy_params.file_type != FileType::DELIMITED) {
+    return false;
+  }
+  std::map<int, std::string> url_parts;
+  Archive::parse_url(file_path, url_parts);
+  if (!url_parts[2].empty() || !boost::filesystem::is_regular_file(file_path) ||
+      !(copy_params.plain_text || PosixFileArchive::hasPlainTextExtension(file_path))) {
+    return false;
+  }
+  const auto data_size =
+      get_filesize(file_path) - get_header_size(file_path, copy_params);
+  return delimited_parser::can_scan_blocks_concurrently(
+      copy_params,
+      get_delimited_import_thread_count(copy_params),
+      data_size,
+      copy_params.buffer_size);
+#endif
+}
+
+}  // namespace
+
 ImportStatus Importer::import(const Catalog_Namespace::SessionInfo* session_info) {
+  if (can_import_delimited_in_blocks(file_path, copy_params)) {
+    return importDelimited(file_path, false, session_info);
+  }
   return DataStreamSink::archivePlumber(session_info);
 }
 
@@ -4126,23 +4225,29 @@ ImportStatus Importer::importDelimited(
                              "': " + strerror(errno));
   }
 
+  // a file which is not decompressed into the pipe is a plain text file read directly,
+  // in blocks if large enough, so its header is skipped here
+  size_t header_size = 0;
   if (!decompressed) {
     (void)fseek(p_file, 0, SEEK_END);
     file_size = ftell(p_file);
+    header_size = get_header_size(file_path, copy_params);
   }
 
-  if (copy_params.threads == 0) {
-    max_threads = std::min(static_cast<size_t>(sysconf(_SC_NPROCESSORS_CONF)),
-                           g_max_import_threads);
-  } else {
-    max_threads = static_cast<size_t>(copy_params.threads);
-  }
+  max_threads = get_delimited_import_thread_count(copy_params);
   VLOG(1) << "Delimited import # threads: " << max_threads;
 
+  const bool read_in_blocks =
+      !decompressed && delimited_parser::can_scan_blocks_concurrently(
+                           copy_params,
+                           max_threads,
+                           file_size - header_size,
+                           copy_params.buffer_size);
+
   // deal with small files
   size_t alloc_size = copy_params.buffer_size;
-  if (!decompressed && file_size < alloc_size) {
-    alloc_size = file_size;
+  if (!decompressed && file_size - header_size < alloc_size) {
+    alloc_size = file_size - header_size;
   }
 
   for (size_t i = 0; i < max_threads; i++) {
@@ -4153,15 +4258,6 @@ ImportStatus Importer::importDelimited(
     }
   }
 
-  auto scratch_buffer = std::make_unique<char[]>(alloc_size);
-  size_t current_pos = 0;
-  size_t end_pos;
-  size_t begin_pos = 0;
-
-  (void)fseek(p_file, current_pos, SEEK_SET);
-  size_t size =
-      fread(reinterpret_cast<void*>(scratch_buffer.get()), 1, alloc_size, p_file);
-
   // make render group analyzers for each poly column
   ColumnIdToRenderGroupAnalyzerMapType columnIdToRenderGroupAnalyzerMap;
   if (copy_params.geo_assign_render_groups) {
@@ -4192,27 +4288,11 @@ ImportStatus Importer::importDelimited(
     }
     // added for true row index on error
     size_t first_row_index_this_buffer = 0;
+    size_t current_pos = 0;
 
-    while (size > 0) {
-      unsigned int num_rows_this_buffer = 0;
-      CHECK(scratch_buffer);
-      end_pos = delimited_parser::find_row_end_pos(alloc_size,
-                                                   scratch_buffer,
-                                                   size,
-                                                   copy_params,
-                                                   first_row_index_this_buffer,
-                                                   num_rows_this_buffer,
-                                                   p_file);
-
-      // unput residual
-      int nresidual = size - end_pos;
-      std::unique_ptr<char[]> unbuf;
-      if (nresidual > 0) {
-        unbuf = std::make_unique<char[]>(nresidual);
-        memcpy(unbuf.get(), scratch_buffer.get() + end_pos, nresidual);
-      }
-
-      // get a thread_id not in use
+    // import rows of a buffer, aligned to row endings, on a thread_id not in use
+    auto launch_import_thread = [&](std::unique_ptr<char[]> buffer,
+                                    const size_t end_pos) {
       auto thread_id = stack_thread_ids.top();
       stack_thread_ids.pop();
       // LOG(INFO) << " stack_thread_ids.pop " << thread_id << std::endl;
@@ -4221,25 +4301,18 @@ ImportStatus Importer::importDelimited(
                                    import_thread_delimited,
                                    thread_id,
                                    this,
-                                   std::move(scratch_buffer),
-                                   begin_pos,
+                                   std::move(buffer),
+                                   0,
                                    end_pos,
                                    end_pos,
                                    columnIdToRenderGroupAnalyzerMap,
                                    first_row_index_this_buffer,
                                    session_info,
                                    executor));
+    };
 
-      first_row_index_this_buffer += num_rows_this_buffer;
-
-      current_pos += end_pos;
-      scratch_buffer = std::make_unique<char[]>(alloc_size);
-      CHECK(scratch_buffer);
-      memcpy(scratch_buffer.get(), unbuf.get(), nresidual);
-      size = nresidual +
-             fread(scratch_buffer.get() + nresidual, 1, alloc_size - nresidual, p_file);
-
-      begin_pos = 0;
+    // collect finished threads until a thread_id is free, or all threads on eof
+    auto wait_for_threads = [&](const bool eof) {
       while (threads.size() > 0) {
         int nready = 0;
         for (std::list<std::future<ImportStatus>>::iterator it = threads.begin();
@@ -4289,7 +4362,7 @@ ImportStatus Importer::importDelimited(
         }
 
         // on eof, wait all threads to finish
-        if (0 == size) {
+        if (eof) {
           continue;
         }
 
@@ -4303,17 +4376,110 @@ ImportStatus Importer::importDelimited(
           break;
         }
       }
+    };
+
+    // returns false if the load has to stop
+    auto check_load_status = [&]() {
       mapd_unique_lock<mapd_shared_mutex> write_lock(import_mutex_);
       if (import_status_.rows_rejected > copy_params.max_reject) {
         import_status_.load_failed = true;
         // todo use better message
         import_status_.load_msg = "Maximum rows rejected exceeded. Halting load";
         LOG(ERROR) << "Maximum rows rejected exceeded. Halting load";
-        break;
+        return false;
       }
       if (import_status_.load_failed) {
         LOG(ERROR) << "Load failed, the issue was: " + import_status_.load_msg;
-        break;
+        return false;
+      }
+      return true;
+    };
+
+    if (read_in_blocks) {
+      // blocks are read and scanned for row endings on several threads, instead of
+      // reading and scanning the next buffer here while the import threads run
+      const auto read_at = [&](char* buffer, size_t offset, size_t max_size) {
+        const auto data_size = file_size - header_size;
+        // leave one extra char in case we need to insert a delimiter
+        const auto size = std::min(max_size - 1, data_size - std::min(offset, data_size));
+        auto nread = read_file_at(p_file, file_path, buffer, header_size + offset, size);
+        // like import_compressed, terminate a file not ending with a line delim
+        if (offset + nread >= data_size &&
+            (nread == 0 || buffer[nread - 1] != copy_params.line_delim)) {
+          buffer[nread++] = copy_params.line_delim;
+        }
+        return nread;
+      };
+      const auto scanned_size = delimited_parser::scan_blocks_concurrently(
+          file_size - header_size,
+          copy_params.buffer_size,
+          max_threads,
+          copy_params,
+          first_row_index_this_buffer,
+          read_at,
+          [&](const char* carried_over_row,
+              size_t carried_over_size,
+              const char* rows,
+              size_t rows_size,
+              unsigned int row_count) {
+            const auto size = carried_over_size + rows_size;
+            auto buffer = std::make_unique<char[]>(size);
+            if (carried_over_size > 0) {
+              memcpy(buffer.get(), carried_over_row, carried_over_size);
+            }
+            memcpy(buffer.get() + carried_over_size, rows, rows_size);
+            launch_import_thread(std::move(buffer), size);
+            first_row_index_this_buffer += row_count;
+            current_pos += size;
+            wait_for_threads(false);
+            return check_load_status();
+          });
+      if (scanned_size.has_value()) {
+        wait_for_threads(true);
+        check_load_status();
+      }
+    } else {
+      auto scratch_buffer = std::make_unique<char[]>(alloc_size);
+      size_t end_pos;
+
+      (void)fseek(p_file, header_size, SEEK_SET);
+      size_t size =
+          fread(reinterpret_cast<void*>(scratch_buffer.get()), 1, alloc_size, p_file);
+
+      while (size > 0) {
+        unsigned int num_rows_this_buffer = 0;
+        CHECK(scratch_buffer);
+        end_pos = delimited_parser::find_row_end_pos(alloc_size,
+                                                     scratch_buffer,
+                                                     size,
+                                                     copy_params,
+                                                     first_row_index_this_buffer,
+                                                     num_rows_this_buffer,
+                                                     p_file);
+
+        // unput residual
+        int nresidual = size - end_pos;
+        std::unique_ptr<char[]> unbuf;
+        if (nresidual > 0) {
+          unbuf = std::make_unique<char[]>(nresidual);
+          memcpy(unbuf.get(), scratch_buffer.get() + end_pos, nresidual);
+        }
+
+        launch_import_thread(std::move(scratch_buffer), end_pos);
+
+        first_row_index_this_buffer += num_rows_this_buffer;
+
+        current_pos += end_pos;
+        scratch_buffer = std::make_unique<char[]>(alloc_size);
+        CHECK(scratch_buffer);
+        memcpy(scratch_buffer.get(), unbuf.get(), nresidual);
+        size = nresidual +
+               fread(scratch_buffer.get() + nresidual, 1, alloc_size - nresidual, p_file);
+
+        wait_for_threads(0 == size);
+        if (!check_load_status()) {
+          break;
+        }
       }
     }
 
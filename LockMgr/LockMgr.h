@@ -51,6 +51,8 @@ class TableSchemaLockMgr : public TableLockMgrImpl<TableSchemaLockMgr> {
  * To allow concurrent Insert/Select queries, Insert queries only obtain a write lock on
  * table data when checkpointing (flushing chunks to disk). Inserts/Data load will take an
  * exclusive (write) lock to ensure only one insert proceeds on each table at a time.
+ * Updates and deletes take a shared (read) lock, and lock the fragments they change
+ * through the FragmentDataLockMgr.
  */
 class InsertDataLockMgr : public TableLockMgrImpl<InsertDataLockMgr> {
  public:
@@ -82,6 +84,48 @@ class TableDataLockMgr : public TableLockMgrImpl<TableDataLockMgr> {
   TableDataLockMgr() {}
 };
 
+/**
+ * @brief Locks protecting the data of a single fragment of a table, keyed by
+ * {db id, physical table id, fragment id}.
+ * Update and delete queries write lock every fragment they change until they commit,
+ * so that updates of disjoint fragments of the same table run concurrently. Inserts and
+ * DDL still exclude them through the table level locks.
+ */
+class FragmentDataLockMgr : public TableLockMgrImpl<FragmentDataLockMgr> {
+ public:
+  static FragmentDataLockMgr& instance() {
+    static FragmentDataLockMgr fragment_data_lock_mgr;
+    return fragment_data_lock_mgr;
+  }
+
+  static WriteLock getWriteLockForFragment(const int db_id,
+                                           const int table_id,
+                                           const int fragment_id) {
+    return getWriteLockForTable({db_id, table_id, fragment_id});
+  }
+
+ protected:
+  FragmentDataLockMgr() {}
+};
+
+/**
+ * @brief Locks serializing the checkpoint of a table's committed updates and deletes,
+ * keyed by {db id, logical table id}.
+ * Updates and deletes of disjoint fragments publish concurrently, but checkpointing the
+ * table and rolling its epochs back after a failed checkpoint must not interleave with
+ * another writer's checkpoint.
+ */
+class TableCheckpointLockMgr : public TableLockMgrImpl<TableCheckpointLockMgr> {
+ public:
+  static TableCheckpointLockMgr& instance() {
+    static TableCheckpointLockMgr table_checkpoint_lock_mgr;
+    return table_checkpoint_lock_mgr;
+  }
+
+ protected:
+  TableCheckpointLockMgr() {}
+};
+
 class TableLockContainerImpl {
   std::string getTableName() const { return table_name_; }
 
@@ -34,6 +34,8 @@
 #include <thrift/transport/TServerSocket.h>
 
 #include "Logger/Logger.h"
+#include "Shared/MetricsHttpServer.h"
+#include "Shared/SamplingProfiler.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/file_delete.h"
 #include "Shared/mapd_shared_mutex.h"
@@ -58,6 +60,7 @@
 #endif
 #include "DataMgr/ForeignStorage/ForeignTableRefresh.h"
 #include "MapDRelease.h"
+#include "QueryEngine/TableOptimizer.h"
 #include "Shared/Compressor.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/file_delete.h"
@@ -401,6 +404,27 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
     foreign_storage::ForeignTableRefreshScheduler::start(g_running);
   }
 
+  std::unique_ptr<metrics::MetricsHttpServer> metrics_server;
+  if (prog_config_opts.metrics_port > 0) {
+    metrics_server = std::make_unique<metrics::MetricsHttpServer>(
+        prog_config_opts.metrics_listen_address, prog_config_opts.metrics_port);
+    try {
+      metrics_server->start();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << e.what();
+    }
+  }
+
+  if (prog_config_opts.enable_sampling_profiler) {
+    try {
+      profiler::SamplingProfiler::start(
+          prog_config_opts.sampling_profiler_frequency,
+          prog_config_opts.base_path + "/mapd_log/query_profiles");
+    } catch (const std::exception& e) {
+      LOG(ERROR) << e.what();
+    }
+  }
+
   mapd::shared_ptr<TServerSocket> serverSocket;
   mapd::shared_ptr<TServerSocket> httpServerSocket;
   if (!prog_config_opts.system_parameters.ssl_cert_file.empty() &&
@@ -496,10 +520,16 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
   g_running = false;
   file_delete_thread.join();
   heartbeat_thread.join();
+  if (metrics_server) {
+    metrics_server->stop();
+  }
+  profiler::SamplingProfiler::stop();
 
   if (g_enable_fsi) {
     foreign_storage::ForeignTableRefreshScheduler::stop();
   }
+  // let background vacuums finish rewriting fragments before exiting
+  TableOptimizer::waitForAutoVacuums();
 
   int signum = g_saw_signal;
   if (signum <= 0 || signum == SIGTERM) {
@@ -5437,13 +5437,38 @@ void DumpTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   auto& catalog = session.getCatalog();
   const TableDescriptor* td = catalog.getMetadataForTable(*table);
   TableArchiver table_archiver(&catalog);
-  table_archiver.dumpTable(td, *path, compression);
+  table_archiver.dumpTable(td, *path, compression, incremental_since_epoch);
 }
 
 void RestoreTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   auto& catalog = session.getCatalog();
   const TableDescriptor* td = catalog.getMetadataForTable(*table, false);
-  if (td) {
+  if (td && TableArchiver::isIncrementalArchive(*path)) {
+    // apply the next incremental dump of a chain onto the restored table
+    if (!session.checkDBAccessPrivileges(DBObjectType::TableDBObjectType,
+                                         AccessPrivileges::INSERT_INTO_TABLE,
+                                         *table)) {
+      throw std::runtime_error("Table " + *table +
+                               " will not be restored. User has no insert privileges.");
+    }
+    // the restore overwrites the current contents of the table, like TRUNCATE
+    const auto& user = session.get_currentUser();
+    if (!user.isSuper && user.userId != td->userId &&
+        !session.checkDBAccessPrivileges(DBObjectType::TableDBObjectType,
+                                         AccessPrivileges::DELETE_FROM_TABLE,
+                                         *table) &&
+        !session.checkDBAccessPrivileges(DBObjectType::TableDBObjectType,
+                                         AccessPrivileges::TRUNCATE_TABLE,
+                                         *table)) {
+      throw std::runtime_error(
+          "Table " + *table +
+          " will not be restored. User has no delete or truncate privileges.");
+    }
+    TableArchiver table_archiver(&catalog);
+    table_archiver.restoreTable(session, td, *path, compression);
+    // invalidate cached hashtable
+    DeleteTriggeredCacheInvalidator::invalidateCaches();
+  } else if (td) {
     // TODO: v1.0 simply throws to avoid accidentally overwrite target table.
     // Will add a REPLACE TABLE to explictly replace target table.
     // catalog.restoreTable(session, td, *path, compression);
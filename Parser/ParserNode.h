@@ -27,10 +27,10 @@
 #include <cstdint>
 #include <cstring>
 #include <list>
+#include <optional>
 #include <string>
 
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/process/search_path.hpp>
 
 #include "../Analyzer/Analyzer.h"
 #include "../Catalog/Catalog.h"
@@ -1354,6 +1354,7 @@ class AlterTableParamStmt : public DDLStmt {
 /*
  * @type DumpTableStmt
  * @brief DUMP TABLE table TO archive_file_path
+ * [WITH (compression = ..., incremental_since = epoch)]
  */
 class DumpRestoreTableStmtBase : public DDLStmt {
  public:
@@ -1370,60 +1371,61 @@ class DumpRestoreTableStmtBase : public DDLStmt {
     };
     std::unique_ptr<std::list<NameValueAssign*>, decltype(options_deleter)> options_ptr(
         options, options_deleter);
-    std::vector<std::string> allowed_compression_programs{"lz4", "gzip", "none"};
-    // specialize decompressor or break on osx bsdtar...
+    std::vector<std::string> allowed_compression_programs{"lz4", "gzip", "zstd", "none"};
     if (options) {
       for (const auto option : *options) {
         if (boost::iequals(*option->get_name(), "compression")) {
           if (const auto str_literal =
                   dynamic_cast<const StringLiteral*>(option->get_value())) {
-            compression = *str_literal->get_stringval();
-            const std::string lowercase_compression =
-                boost::algorithm::to_lower_copy(compression);
+            compression = boost::algorithm::to_lower_copy(*str_literal->get_stringval());
             if (allowed_compression_programs.end() ==
                 std::find(allowed_compression_programs.begin(),
                           allowed_compression_programs.end(),
-                          lowercase_compression)) {
-              throw std::runtime_error("Compression program " + compression +
+                          compression)) {
+              throw std::runtime_error("Compression program " +
+                                       *str_literal->get_stringval() +
                                        " is not supported.");
             }
           } else {
             throw std::runtime_error("Compression option must be a string.");
           }
+        } else if (!is_restore &&
+                   boost::iequals(*option->get_name(), "incremental_since")) {
+          // archive only the pages written after the given table epoch
+          if (const auto int_literal =
+                  dynamic_cast<const IntLiteral*>(option->get_value())) {
+            incremental_since_epoch = int_literal->get_intval();
+          } else {
+            throw std::runtime_error("Incremental_since option must be an integer.");
+          }
         } else {
           throw std::runtime_error("Invalid WITH option: " + *option->get_name());
         }
       }
     }
-    // default lz4 compression, next gzip, or none.
+    // archives are (de)compressed in process by libarchive, which detects the
+    // compression of an archive on restore. default to gzip compression on dump, which
+    // remains a single stream compressed on one thread for compatibility with archives
+    // read by older servers; zstd compresses on multiple threads.
     if (compression.empty()) {
-      if (boost::process::search_path(compression = "gzip").string().empty()) {
-        if (boost::process::search_path(compression = "lz4").string().empty()) {
-          compression = "none";
-        }
-      }
+      compression = "gzip";
     }
-    if (boost::iequals(compression, "none")) {
+    if (compression == "none") {
       compression.clear();
-    } else {
-      std::map<std::string, std::string> decompression{{"lz4", "unlz4"},
-                                                       {"gzip", "gunzip"}};
-      const auto use_program = is_restore ? decompression[compression] : compression;
-      const auto prog_path = boost::process::search_path(use_program);
-      if (prog_path.string().empty()) {
-        throw std::runtime_error("Compression program " + use_program + " is not found.");
-      }
-      compression = "--use-compress-program=" + use_program;
     }
   }
   const std::string* getTable() const { return table.get(); }
   const std::string* getPath() const { return path.get(); }
   const std::string getCompression() const { return compression; }
+  const std::optional<int32_t> getIncrementalSinceEpoch() const {
+    return incremental_since_epoch;
+  }
 
  protected:
   std::unique_ptr<std::string> table;
   std::unique_ptr<std::string> path;  // dump TO file path
   std::string compression;
+  std::optional<int32_t> incremental_since_epoch;
 };
 
 class DumpTableStmt : public DumpRestoreTableStmtBase {
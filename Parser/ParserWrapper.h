@@ -33,12 +33,16 @@ struct ExplainInfo {
   bool explain_optimized;
   bool explain_plan;
   bool calcite_explain;
+  bool explain_analyze;
 
-  static ExplainInfo defaults() { return ExplainInfo{false, false, false, false}; }
+  static ExplainInfo defaults() { return ExplainInfo{false, false, false, false, false}; }
 
   bool justExplain() const { return explain || explain_plan || explain_optimized; }
 
   bool justCalciteExplain() const { return calcite_explain; }
+
+  // EXPLAIN ANALYZE runs the query and returns its profile instead of the result
+  bool analyzeExplain() const { return explain_analyze; }
 };
 
 class ParserWrapper {
@@ -46,7 +50,15 @@ class ParserWrapper {
   // HACK:  This needs to go away as calcite takes over parsing
   enum class DMLType : int { Insert = 0, Delete, Update, Upsert, NotDML };
 
-  enum class ExplainType { None, IR, OptimizedIR, Calcite, ExecutionPlan, Other };
+  enum class ExplainType {
+    None,
+    IR,
+    OptimizedIR,
+    Calcite,
+    ExecutionPlan,
+    Analyze,
+    Other
+  };
 
   enum class QueryType { Unknown, Read, Write, SchemaRead, SchemaWrite };
 
@@ -86,10 +98,13 @@ class ParserWrapper {
 
   bool isPlanExplain() const { return explain_type_ == ExplainType::ExecutionPlan; }
 
+  bool isAnalyzeExplain() const { return explain_type_ == ExplainType::Analyze; }
+
   bool isSelectExplain() const {
     return explain_type_ == ExplainType::Calcite || explain_type_ == ExplainType::IR ||
            explain_type_ == ExplainType::OptimizedIR ||
-           explain_type_ == ExplainType::ExecutionPlan;
+           explain_type_ == ExplainType::ExecutionPlan ||
+           explain_type_ == ExplainType::Analyze;
   }
 
   bool isIRExplain() const {
@@ -136,6 +151,7 @@ class ParserWrapper {
   static const std::string calcite_explain_str;
   static const std::string optimized_explain_str;
   static const std::string plan_explain_str;
+  static const std::string analyze_explain_str;
   static const std::string optimize_str;
   static const std::string validate_str;
 
@@ -223,14 +223,26 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
     if (is_varlen) {
       varlen_chunk_lock.reset(new std::lock_guard<std::mutex>(varlen_chunk_mutex));
     }
-    chunk = Chunk_NS::Chunk::getChunk(
-        cd,
-        &cat.getDataMgr(),
-        chunk_key,
-        memory_level,
-        memory_level == Data_Namespace::CPU_LEVEL ? 0 : device_id,
-        chunk_meta_it->second->numBytes,
-        chunk_meta_it->second->numElements);
+    const int chunk_device_id = memory_level == Data_Namespace::CPU_LEVEL ? 0 : device_id;
+    auto step_counters = executor_->getExecutionStepCounters();
+    if (step_counters) {
+      // the data buffer of a varlen chunk lives under an extra key component
+      auto data_key = chunk_key;
+      if (is_varlen) {
+        data_key.push_back(1);
+      }
+      step_counters->addFetchedBytes(
+          memory_level,
+          chunk_meta_it->second->numBytes,
+          cat.getDataMgr().isBufferOnDevice(data_key, memory_level, chunk_device_id));
+    }
+    chunk = Chunk_NS::Chunk::getChunk(cd,
+                                      &cat.getDataMgr(),
+                                      chunk_key,
+                                      memory_level,
+                                      chunk_device_id,
+                                      chunk_meta_it->second->numBytes,
+                                      chunk_meta_it->second->numElements);
     std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex);
     chunk_holder.push_back(chunk);
   }
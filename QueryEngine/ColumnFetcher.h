@@ -38,10 +38,21 @@ struct hash<std::pair<int, int>> {
 
 }  // namespace std
 
+// A lazily fetched column fragment of a foreign table, loaded only once the kernel has
+// selected rows from it. Its entry in FetchResult::col_buffers stays null until then.
+struct DeferredColumnFragment {
+  size_t frag_pos;  // index of the fragment combination in col_buffers
+  size_t local_col_id;
+  int table_id;
+  int frag_id;
+  int col_id;
+};
+
 struct FetchResult {
   std::vector<std::vector<const int8_t*>> col_buffers;
   std::vector<std::vector<int64_t>> num_rows;
   std::vector<std::vector<uint64_t>> frag_offsets;
+  std::vector<DeferredColumnFragment> deferred_fragments;
 };
 
 class ColumnFetcher {
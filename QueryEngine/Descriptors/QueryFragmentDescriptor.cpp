@@ -19,6 +19,7 @@
 #include "Catalog/ColumnDescriptor.h"
 #include "Catalog/TableDescriptor.h"
 #include "DataMgr/DataMgr.h"
+#include "QueryEngine/FragmentSpatialIndex.h"
 #include "QueryEngine/Execute.h"
 #include "Shared/misc.h"
 
@@ -140,6 +141,13 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     return fragment.getNumTuples();
   };
 
+  // The quals of a UNION do not refer to its inputs by range table index
+  const auto spatial_candidates =
+      is_temporary_table || table_desc_offset
+          ? std::nullopt
+          : FragmentSpatialIndex::getCandidateFragments(
+                *executor->getCatalog(), ra_exe_unit, table_desc.getTableId(), *fragments);
+
   for (size_t i = 0; i < fragments->size(); i++) {
     if (!allowed_outer_fragment_indices_.empty()) {
       if (std::find(allowed_outer_fragment_indices_.begin(),
@@ -150,8 +158,16 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     }
 
     const auto& fragment = (*fragments)[i];
-    const auto skip_frag = executor->skipFragment(
+    auto skip_frag = executor->skipFragment(
         table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
+    if (!skip_frag.first && spatial_candidates &&
+        !spatial_candidates->count(fragment.fragmentId)) {
+      skip_frag = {true, -1};
+    }
+    if (auto step_counters = executor->getExecutionStepCounters()) {
+      step_counters->fragments_total++;
+      step_counters->fragments_skipped += skip_frag.first ? 1 : 0;
+    }
     if (skip_frag.first) {
       continue;
     }
@@ -352,6 +368,8 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
   outer_fragments_size_ = outer_fragments->size();
 
   const auto inner_table_id_to_join_condition = executor->getInnerTabIdToJoinCond();
+  const auto spatial_candidates = FragmentSpatialIndex::getCandidateFragments(
+      *executor->getCatalog(), ra_exe_unit, outer_table_id, *outer_fragments);
 
   for (size_t outer_frag_id = 0; outer_frag_id < outer_fragments->size();
        ++outer_frag_id) {
@@ -374,6 +392,14 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
       skip_frag = executor->skipFragmentInnerJoins(
           outer_table_desc, ra_exe_unit, fragment, frag_offsets, outer_frag_id);
     }
+    if (!skip_frag.first && spatial_candidates &&
+        !spatial_candidates->count(fragment.fragmentId)) {
+      skip_frag = {true, -1};
+    }
+    if (auto step_counters = executor->getExecutionStepCounters()) {
+      step_counters->fragments_total++;
+      step_counters->fragments_skipped += skip_frag.first ? 1 : 0;
+    }
     if (skip_frag.first) {
       continue;
     }
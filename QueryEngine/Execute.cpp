@@ -44,8 +44,11 @@
 
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
+#include "DataMgr/ForeignStorage/ForeignStorageMgr.h"
 #include "Parser/ParserNode.h"
 #include "Shared/SystemParameters.h"
+#include "Shared/Metrics.h"
+#include "Shared/SamplingProfiler.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/measure.h"
@@ -94,6 +97,7 @@ bool g_enable_columnar_output{false};
 bool g_optimize_row_initialization{true};
 bool g_enable_overlaps_hashjoin{true};
 bool g_enable_hashjoin_many_to_many{false};
+bool g_enable_spatial_fragment_skipping{false};
 size_t g_overlaps_max_table_size_bytes{1024 * 1024 * 1024};
 double g_overlaps_target_entries_per_bin{1.3};
 bool g_strip_join_covered_quals{false};
@@ -1449,6 +1453,8 @@ ResultSetPtr Executor::executeWorkUnitImpl(
         std::lock_guard<std::mutex> compilation_lock(compilation_mutex_);
         compilation_queue_time_ms_ += timer_stop(clock_begin);
 
+        profiler::PhaseScope profiler_phase_scope(profiler::Phase::kCodegen);
+        auto codegen_clock_begin = timer_start();
         query_mem_desc_owned =
             query_comp_desc_owned->compile(max_groups_buffer_entry_guess,
                                            crt_min_byte_width,
@@ -1469,6 +1475,14 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                                            render_info,
                                            this);
         CHECK(query_mem_desc_owned);
+        static auto& compilation_seconds = metrics::Registry::instance().histogram(
+            "omnisci_query_compilation_seconds",
+            "Time spent generating and compiling the code of a query step, including "
+            "code cache lookups.");
+        compilation_seconds.observeSince(codegen_clock_begin);
+        if (execution_step_counters_) {
+          execution_step_counters_->codegen_ms += timer_stop(codegen_clock_begin);
+        }
         crt_min_byte_width = query_comp_desc_owned->getMinByteWidth();
       } catch (CompilationRetryNoCompaction&) {
         crt_min_byte_width = MAX_BYTE_WIDTH_SUPPORTED;
@@ -1564,11 +1578,17 @@ ResultSetPtr Executor::executeWorkUnitImpl(
         }
       }
       try {
-        return collectAllDeviceResults(shared_context,
-                                       ra_exe_unit,
-                                       *query_mem_desc_owned,
-                                       query_comp_desc_owned->getDeviceType(),
-                                       row_set_mem_owner);
+        profiler::PhaseScope profiler_phase_scope(profiler::Phase::kReduce);
+        auto reduction_clock_begin = timer_start();
+        auto result = collectAllDeviceResults(shared_context,
+                                              ra_exe_unit,
+                                              *query_mem_desc_owned,
+                                              query_comp_desc_owned->getDeviceType(),
+                                              row_set_mem_owner);
+        if (execution_step_counters_) {
+          execution_step_counters_->reduction_ms += timer_stop(reduction_clock_begin);
+        }
+        return result;
       } catch (ReductionRanOutOfSlots&) {
         throw QueryExecutionError(ERR_OUT_OF_SLOTS);
       } catch (OverflowOrUnderflow&) {
@@ -1580,7 +1600,13 @@ ResultSetPtr Executor::executeWorkUnitImpl(
         throw QueryExecutionError(e.getErrorCode());
       }
     }
-    return resultsUnion(shared_context, ra_exe_unit);
+    profiler::PhaseScope profiler_phase_scope(profiler::Phase::kReduce);
+    auto reduction_clock_begin = timer_start();
+    auto result = resultsUnion(shared_context, ra_exe_unit);
+    if (execution_step_counters_) {
+      execution_step_counters_->reduction_ms += timer_stop(reduction_clock_begin);
+    }
+    return result;
 
   } while (static_cast<size_t>(crt_min_byte_width) <= sizeof(int64_t));
 
@@ -2161,19 +2187,27 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
 template <typename THREAD_POOL>
 void Executor::launchKernels(SharedKernelContext& shared_context,
                              std::vector<std::unique_ptr<ExecutionKernel>>&& kernels) {
+  static auto& kernel_queue_seconds = metrics::Registry::instance().histogram(
+      "omnisci_kernel_queue_seconds",
+      "Time a query step waited for the executor to launch its kernels.");
   auto clock_begin = timer_start();
   std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
   kernel_queue_time_ms_ += timer_stop(clock_begin);
+  kernel_queue_seconds.observeSince(clock_begin);
 
   THREAD_POOL thread_pool;
   VLOG(1) << "Launching " << kernels.size() << " kernels for query.";
   size_t kernel_idx = 1;
   for (auto& kernel : kernels) {
     thread_pool.spawn(
-        [this, &shared_context, parent_thread_id = logger::thread_id()](
-            ExecutionKernel* kernel, const size_t crt_kernel_idx) {
+        [this,
+         &shared_context,
+         parent_thread_id = logger::thread_id(),
+         profiler_tag = profiler::current_tag()](ExecutionKernel* kernel,
+                                                 const size_t crt_kernel_idx) {
           CHECK(kernel);
           DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+          profiler::ThreadTagScope profiler_tag_scope(profiler_tag);
           const size_t thread_idx = crt_kernel_idx % cpu_threads();
           kernel->run(this, thread_idx, shared_context);
         },
@@ -2414,10 +2448,29 @@ FetchResult Executor::fetchChunks(
     std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
     DeviceAllocator* device_allocator,
     const size_t thread_idx,
-    const bool allow_runtime_interrupt) {
+    const bool allow_runtime_interrupt,
+    const bool defer_lazy_foreign_columns) {
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(fetchChunks);
+  foreign_storage::DiskCacheBypassScope disk_cache_bypass_scope(
+      ra_exe_unit.query_hint.isHintRegistered("disk_cache_bypass"));
   const auto& col_global_ids = ra_exe_unit.input_col_descs;
+  // deferred columns must not be prefetched along with the filter columns of their
+  // fragment, otherwise they are decoded for fragments without matching rows
+  std::set<ChunkKey> deferred_column_keys;
+  if (defer_lazy_foreign_columns) {
+    for (const auto& col_id : col_global_ids) {
+      CHECK(col_id);
+      const int table_id = col_id->getScanDesc().getTableId();
+      if (col_id->getScanDesc().getSourceType() == InputSourceType::TABLE &&
+          isDeferrableLazyFetchColumn(table_id, col_id->getColId(), cat)) {
+        deferred_column_keys.insert(
+            {cat.getCurrentDB().dbId, table_id, col_id->getColId()});
+      }
+    }
+  }
+  foreign_storage::PrefetchExclusionScope prefetch_exclusion_scope(
+      std::move(deferred_column_keys));
   std::vector<std::vector<size_t>> selected_fragments_crossjoin;
   std::vector<size_t> local_col_to_frag_pos;
   buildSelectedFragsMapping(selected_fragments_crossjoin,
@@ -2432,6 +2485,7 @@ FetchResult Executor::fetchChunks(
   std::vector<std::vector<const int8_t*>> all_frag_col_buffers;
   std::vector<std::vector<int64_t>> all_num_rows;
   std::vector<std::vector<uint64_t>> all_frag_offsets;
+  std::vector<DeferredColumnFragment> deferred_fragments;
   for (const auto& selected_frag_ids : frag_ids_crossjoin) {
     std::vector<const int8_t*> frag_col_buffers(
         plan_state_->global_to_local_col_ids_.size());
@@ -2512,6 +2566,15 @@ FetchResult Executor::fetchChunks(
                                                           device_allocator,
                                                           thread_idx);
           }
+        } else if (defer_lazy_foreign_columns &&
+                   isDeferrableLazyFetchColumn(table_id, col_id->getColId(), cat)) {
+          // decoding a foreign table chunk is costly, and the kernel only records row
+          // positions for this column
+          deferred_fragments.push_back({all_frag_col_buffers.size(),
+                                        static_cast<size_t>(it->second),
+                                        table_id,
+                                        static_cast<int>(frag_id),
+                                        col_id->getColId()});
         } else {
           frag_col_buffers[it->second] =
               column_fetcher.getOneTableColumnFragment(table_id,
@@ -2530,7 +2593,22 @@ FetchResult Executor::fetchChunks(
   }
   std::tie(all_num_rows, all_frag_offsets) = getRowCountAndOffsetForAllFrags(
       ra_exe_unit, frag_ids_crossjoin, ra_exe_unit.input_descs, all_tables_fragments);
-  return {all_frag_col_buffers, all_num_rows, all_frag_offsets};
+  return {all_frag_col_buffers, all_num_rows, all_frag_offsets, deferred_fragments};
+}
+
+bool Executor::isDeferrableLazyFetchColumn(const int table_id,
+                                           const int col_id,
+                                           const Catalog_Namespace::Catalog& cat) const {
+  const auto col_key = std::make_pair(table_id, col_id);
+  if (plan_state_->columns_to_fetch_.count(col_key) ||
+      !plan_state_->columns_to_not_fetch_.count(col_key)) {
+    return false;
+  }
+  if (table_id <= 0) {
+    return false;
+  }
+  const auto td = cat.getMetadataForTable(table_id, false);
+  return td && td->isForeignTable();
 }
 
 // fetchChunks() is written under the assumption that multiple inputs implies a JOIN.
@@ -2550,6 +2628,8 @@ FetchResult Executor::fetchUnionChunks(
     const bool allow_runtime_interrupt) {
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(fetchUnionChunks);
+  foreign_storage::DiskCacheBypassScope disk_cache_bypass_scope(
+      ra_exe_unit.query_hint.isHintRegistered("disk_cache_bypass"));
 
   std::vector<std::vector<const int8_t*>> all_frag_col_buffers;
   std::vector<std::vector<int64_t>> all_num_rows;
@@ -3535,6 +3615,8 @@ std::pair<bool, int64_t> Executor::skipFragment(
     return {true, -1};
   }
 
+  // simple quals on uncast columns, handed to the data wrapper of foreign tables
+  std::vector<foreign_storage::ColumnRangePredicate> foreign_table_predicates;
   for (const auto& simple_qual : simple_quals) {
     const auto comp_expr =
         std::dynamic_pointer_cast<const Analyzer::BinOper>(simple_qual);
@@ -3626,6 +3708,12 @@ std::pair<bool, int64_t> Executor::skipFragment(
 
     const auto rhs_val =
         CodeGenerator::codegenIntConst(rhs_const, &local_cgen_state)->getSExtValue();
+    if (lhs == lhs_col && !is_rowid &&
+        chunk_meta_it != fragment.getChunkMetadataMap().end() &&
+        lhs_col->get_type_info().get_dimension() ==
+            rhs_const->get_type_info().get_dimension()) {
+      foreign_table_predicates.push_back({col_id, comp_expr->get_optype(), rhs_val});
+    }
 
     switch (comp_expr->get_optype()) {
       case kGE:
@@ -3659,6 +3747,22 @@ std::pair<bool, int64_t> Executor::skipFragment(
         break;
     }
   }
+  if (!foreign_table_predicates.empty() && table_id > 0) {
+    const auto td = catalog_->getMetadataForTable(table_id, false);
+    if (td && td->isForeignTable()) {
+      auto foreign_storage_mgr =
+          catalog_->getDataMgr().getPersistentStorageMgr()->getForeignStorageMgr();
+      CHECK(foreign_storage_mgr);
+      if (!foreign_storage_mgr->fragmentMayMatch({catalog_->getDatabaseId(), table_id},
+                                                 fragment.fragmentId,
+                                                 foreign_table_predicates)) {
+        VLOG(2) << "Skipping foreign table fragment with table id: " << table_id
+                << ", fragment id: " << frag_idx
+                << ", no row group satisfies the filters";
+        return {true, -1};
+      }
+    }
+  }
   return {false, -1};
 }
 
@@ -30,6 +30,7 @@
 #include "LoopControlFlow/JoinLoop.h"
 #include "NvidiaKernel.h"
 #include "PlanState.h"
+#include "QueryProfile.h"
 #include "RelAlgExecutionUnit.h"
 #include "RelAlgTranslator.h"
 #include "StringDictionaryGenerations.h"
@@ -336,6 +337,13 @@ class UpdateLogForFragment : public RowDataProvider {
   using Callback =
       std::function<void(const UpdateLogForFragment&, ColumnToFragmentsMap&)>;
 
+  // Locks the fragments of the updated table: `lock` is called before a fragment is
+  // scanned, `unlock` once the scan found no row to update. Either may be empty.
+  struct FragmentLocker {
+    std::function<void(const FragmentInfoType&)> lock;
+    std::function<void(const FragmentInfoType&)> unlock;
+  };
+
   auto getResultSet() const { return rs_; }
 
  private:
@@ -389,6 +397,14 @@ class Executor {
    */
   const TemporaryTables* getTemporaryTables() { return temporary_tables_; }
 
+  /**
+   * Returns the profiling counters of the step currently executed under EXPLAIN ANALYZE,
+   * or nullptr when the query is not being profiled.
+   */
+  ExecutionStepCounters* getExecutionStepCounters() const {
+    return execution_step_counters_;
+  }
+
   /**
    * Returns a string dictionary proxy using the currently active row set memory owner.
    */
@@ -463,14 +479,20 @@ class Executor {
                                const bool has_cardinality_estimation,
                                ColumnCacheMap& column_cache);
 
-  void executeUpdate(const RelAlgExecutionUnit& ra_exe_unit,
-                     const std::vector<InputTableInfo>& table_infos,
-                     const CompilationOptions& co,
-                     const ExecutionOptions& eo,
-                     const Catalog_Namespace::Catalog& cat,
-                     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
-                     const UpdateLogForFragment::Callback& cb,
-                     const bool is_agg);
+  /**
+   * Runs the update or delete callback on every fragment of the table and returns the
+   * fragments whose chunk metadata should be recomputed once the update is published.
+   */
+  ColumnToFragmentsMap executeUpdate(const RelAlgExecutionUnit& ra_exe_unit,
+                                     const std::vector<InputTableInfo>& table_infos,
+                                     const CompilationOptions& co,
+                                     const ExecutionOptions& eo,
+                                     const Catalog_Namespace::Catalog& cat,
+                                     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+                                     const UpdateLogForFragment::Callback& cb,
+                                     const bool is_agg,
+                                     const UpdateLogForFragment::FragmentLocker&
+                                         fragment_locker = {});
 
  private:
   void clearMetaInfoCache();
@@ -522,6 +544,10 @@ class Executor {
                              const RelAlgExecutionUnit& ra_exe_unit,
                              const FragmentsList& selected_fragments) const;
 
+  bool isDeferrableLazyFetchColumn(const int table_id,
+                                   const int col_id,
+                                   const Catalog_Namespace::Catalog& cat) const;
+
   bool needLinearizeAllFragments(const ColumnDescriptor* cd,
                                  const InputColDescriptor& inner_col_desc,
                                  const RelAlgExecutionUnit& ra_exe_unit,
@@ -628,7 +654,8 @@ class Executor {
                           std::list<std::shared_ptr<Chunk_NS::Chunk>>&,
                           DeviceAllocator* device_allocator,
                           const size_t thread_idx,
-                          const bool allow_runtime_interrupt);
+                          const bool allow_runtime_interrupt,
+                          const bool defer_lazy_foreign_columns = false);
 
   FetchResult fetchUnionChunks(const ColumnFetcher&,
                                const RelAlgExecutionUnit& ra_exe_unit,
@@ -1038,6 +1065,7 @@ class Executor {
   const ExecutorId executor_id_;
   const Catalog_Namespace::Catalog* catalog_;
   const TemporaryTables* temporary_tables_;
+  ExecutionStepCounters* execution_step_counters_{nullptr};
 
   int64_t kernel_queue_time_ms_ = 0;
   int64_t compilation_queue_time_ms_ = 0;
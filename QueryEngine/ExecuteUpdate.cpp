@@ -21,9 +21,6 @@
 #include "QueryEngine/Descriptors/QueryFragmentDescriptor.h"
 #include "QueryEngine/ExecutionKernel.h"
 #include "QueryEngine/RelAlgExecutor.h"
-#include "QueryEngine/TableOptimizer.h"
-
-extern bool g_enable_auto_metadata_update;
 
 UpdateLogForFragment::UpdateLogForFragment(FragmentInfoType const& fragment_info,
                                            size_t const fragment_index,
@@ -62,14 +59,16 @@ SQLTypeInfo UpdateLogForFragment::getColumnType(const size_t col_idx) const {
   return rs_->getColType(col_idx);
 }
 
-void Executor::executeUpdate(const RelAlgExecutionUnit& ra_exe_unit_in,
-                             const std::vector<InputTableInfo>& table_infos,
-                             const CompilationOptions& co,
-                             const ExecutionOptions& eo,
-                             const Catalog_Namespace::Catalog& cat,
-                             std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
-                             const UpdateLogForFragment::Callback& cb,
-                             const bool is_agg) {
+ColumnToFragmentsMap Executor::executeUpdate(
+    const RelAlgExecutionUnit& ra_exe_unit_in,
+    const std::vector<InputTableInfo>& table_infos,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const Catalog_Namespace::Catalog& cat,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
+    const UpdateLogForFragment::Callback& cb,
+    const bool is_agg,
+    const UpdateLogForFragment::FragmentLocker& fragment_locker) {
   CHECK(cb);
   VLOG(1) << "Executor " << executor_id_
           << " is executing update/delete work unit:" << ra_exe_unit_in;
@@ -80,7 +79,10 @@ void Executor::executeUpdate(const RelAlgExecutionUnit& ra_exe_unit_in,
   ColumnFetcher column_fetcher(this, column_cache);
   CHECK_GT(ra_exe_unit.input_descs.size(), size_t(0));
   const auto table_id = ra_exe_unit.input_descs[0].getTableId();
-  const auto& outer_fragments = table_infos.front().info.fragments;
+  // the outer fragments are re-read from the fragmenter once they are locked, since
+  // other updates may have changed them after `table_infos` was collected
+  auto locked_table_infos = table_infos;
+  auto& outer_fragments = locked_table_infos.front().info.fragments;
 
   std::vector<FragmentsPerTable> fragments = {{0, {0}}};
   for (size_t tab_idx = 1; tab_idx < ra_exe_unit.input_descs.size(); tab_idx++) {
@@ -95,7 +97,7 @@ void Executor::executeUpdate(const RelAlgExecutionUnit& ra_exe_unit_in,
   }
 
   if (outer_fragments.empty()) {
-    return;
+    return {};
   }
 
   const auto max_tuple_count_fragment_it = std::max_element(
@@ -132,27 +134,53 @@ void Executor::executeUpdate(const RelAlgExecutionUnit& ra_exe_unit_in,
   CHECK(query_mem_desc);
 
   ColumnToFragmentsMap optimize_candidates;
-  for (size_t fragment_index = 0; fragment_index < outer_fragments.size();
-       ++fragment_index) {
-    const int64_t crt_fragment_tuple_count =
-        outer_fragments[fragment_index].getNumTuples();
-    if (crt_fragment_tuple_count == 0) {
+  auto skip_fragment = [&](const Fragmenter_Namespace::FragmentInfo& fragment_info,
+                           const size_t fragment_index) {
+    if (fragment_info.getNumTuples() == 0) {
       // nothing to update
-      continue;
+      return true;
     }
-    SharedKernelContext shared_context(table_infos);
+    SharedKernelContext shared_context(locked_table_infos);
     const auto& frag_offsets = shared_context.getFragOffsets();
     auto skip_frag = skipFragment(ra_exe_unit.input_descs[0],
-                                  outer_fragments[fragment_index],
+                                  fragment_info,
                                   ra_exe_unit.simple_quals,
                                   frag_offsets,
                                   fragment_index);
     if (skip_frag.first) {
       VLOG(2) << "Update/delete skipping fragment with table id: "
-              << outer_fragments[fragment_index].physicalTableId
-              << ", fragment id: " << fragment_index;
+              << fragment_info.physicalTableId << ", fragment id: " << fragment_index;
+      return true;
+    }
+    return false;
+  };
+  for (size_t fragment_index = 0; fragment_index < outer_fragments.size();
+       ++fragment_index) {
+    auto& fragment_info = outer_fragments[fragment_index];
+    if (skip_fragment(fragment_info, fragment_index)) {
       continue;
     }
+
+    // the fragment is locked before it is scanned, so that no other update changes it
+    // until this one commits, and its info is re-read since a concurrent update may
+    // have changed it after the snapshot was taken
+    if (fragment_locker.lock) {
+      fragment_locker.lock(fragment_info);
+      const auto td = cat.getMetadataForTable(fragment_info.physicalTableId);
+      CHECK(td);
+      CHECK(td->fragmenter);
+      fragment_info = *td->fragmenter->getFragmentInfo(fragment_info.fragmentId);
+    }
+    auto unlock_fragment = [&fragment_locker, &fragment_info]() {
+      if (fragment_locker.unlock) {
+        fragment_locker.unlock(fragment_info);
+      }
+    };
+    if (fragment_locker.lock && skip_fragment(fragment_info, fragment_index)) {
+      unlock_fragment();
+      continue;
+    }
+    SharedKernelContext shared_context(locked_table_infos);
     fragments[0] = {table_id, {fragment_index}};
 
     {
@@ -176,18 +204,16 @@ void Executor::executeUpdate(const RelAlgExecutionUnit& ra_exe_unit_in,
     }
     const auto& proj_fragment_results = shared_context.getFragmentResults();
     if (proj_fragment_results.empty()) {
+      unlock_fragment();
       continue;
     }
     const auto& proj_fragment_result = proj_fragment_results[0];
     const auto proj_result_set = proj_fragment_result.first;
     CHECK(proj_result_set);
-    cb({outer_fragments[fragment_index], fragment_index, proj_result_set},
-       optimize_candidates);
-  }
-
-  if (g_enable_auto_metadata_update) {
-    auto td = cat.getMetadataForTable(table_id);
-    TableOptimizer table_optimizer{td, this, cat};
-    table_optimizer.recomputeMetadataUnlocked(optimize_candidates);
+    cb({fragment_info, fragment_index, proj_result_set}, optimize_candidates);
+    if (proj_result_set->rowCount() == 0) {
+      unlock_fragment();
+    }
   }
+  return optimize_candidates;
 }
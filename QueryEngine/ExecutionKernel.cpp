@@ -25,6 +25,7 @@
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExternalExecutor.h"
 #include "QueryEngine/SerializeToSql.h"
+#include "Shared/SamplingProfiler.h"
 
 namespace {
 
@@ -150,9 +151,18 @@ void ExecutionKernel::runImpl(Executor* executor,
     device_allocator =
         std::make_unique<CudaAllocator>(&catalog->getDataMgr(), chosen_device_id);
   }
+  auto step_counters = executor->getExecutionStepCounters();
   FetchResult fetch_result;
+  std::map<int, const TableFragments*> all_tables_fragments;
+  // Lazily fetched columns of foreign tables are only loaded once the kernel found
+  // matching rows, see below. Projections count their rows without reading any column.
+  const bool defer_lazy_foreign_columns =
+      eo.executor_type == ExecutorType::Native &&
+      query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection &&
+      !(render_info_ && render_info_->isPotentialInSituRender());
   try {
-    std::map<int, const TableFragments*> all_tables_fragments;
+    profiler::PhaseScope profiler_phase_scope(profiler::Phase::kFetch);
+    auto fetch_clock_begin = timer_start();
     QueryFragmentDescriptor::computeAllTablesFragments(
         all_tables_fragments, ra_exe_unit_, shared_context.getQueryInfos());
 
@@ -180,7 +190,17 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                chunks,
                                                device_allocator.get(),
                                                thread_idx,
-                                               eo.allow_runtime_query_interrupt);
+                                               eo.allow_runtime_query_interrupt,
+                                               defer_lazy_foreign_columns);
+    if (step_counters) {
+      step_counters->fetch_ms += timer_stop(fetch_clock_begin);
+      step_counters->kernel_count++;
+      for (const auto& frag_row_counts : fetch_result.num_rows) {
+        if (!frag_row_counts.empty()) {
+          step_counters->rows_in += frag_row_counts.front();
+        }
+      }
+    }
     if (fetch_result.num_rows.empty()) {
       return;
     }
@@ -286,6 +306,8 @@ void ExecutionKernel::runImpl(Executor* executor,
     }
   }
 
+  profiler::PhaseScope profiler_phase_scope(profiler::Phase::kKernel);
+  auto kernel_clock_begin = timer_start();
   if (ra_exe_unit_.groupby_exprs.empty()) {
     err = executor->executePlanWithoutGroupBy(ra_exe_unit_,
                                               compilation_result,
@@ -327,6 +349,33 @@ void ExecutionKernel::runImpl(Executor* executor,
                                            eo.allow_runtime_query_interrupt,
                                            do_render ? render_info_ : nullptr);
   }
+  if (step_counters) {
+    step_counters->kernel_ms += timer_stop(kernel_clock_begin);
+  }
+  if (!err && device_results_ && !fetch_result.deferred_fragments.empty() &&
+      device_results_->rowCount() > 0) {
+    profiler::PhaseScope profiler_phase_scope(profiler::Phase::kFetch);
+    auto fetch_clock_begin = timer_start();
+    for (const auto& deferred : fetch_result.deferred_fragments) {
+      const auto col_buffer =
+          column_fetcher.getOneTableColumnFragment(deferred.table_id,
+                                                   deferred.frag_id,
+                                                   deferred.col_id,
+                                                   all_tables_fragments,
+                                                   chunks,
+                                                   *chunk_iterators_ptr,
+                                                   Data_Namespace::CPU_LEVEL,
+                                                   chosen_device_id,
+                                                   device_allocator.get());
+      CHECK_LT(deferred.frag_pos, fetch_result.col_buffers.size());
+      fetch_result.col_buffers[deferred.frag_pos][deferred.local_col_id] = col_buffer;
+      device_results_->setLazyFetchColumnBuffer(
+          deferred.frag_pos, deferred.local_col_id, col_buffer);
+    }
+    if (step_counters) {
+      step_counters->fetch_ms += timer_stop(fetch_clock_begin);
+    }
+  }
   if (device_results_) {
     std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_to_hold;
     for (const auto& chunk : chunks) {
@@ -26,6 +26,7 @@
 #include "WindowExpressionRewrite.h"
 
 #include <boost/locale/conversion.hpp>
+#include <optional>
 #include <unordered_set>
 
 namespace {
@@ -752,10 +753,124 @@ static const std::unordered_set<std::string> requires_many_to_many = {
     "ST_Intersects_MultiPolygon_MultiPolygon",
     "ST_Intersects_MultiPolygon_Polygon"};
 
+std::optional<int32_t> get_int_literal(const Analyzer::Expr* expr) {
+  const auto literal = dynamic_cast<const Analyzer::Constant*>(expr);
+  if (!literal || literal->get_is_null() || literal->get_type_info().get_type() != kINT) {
+    return std::nullopt;
+  }
+  return literal->get_constval().intval;
+}
+
+/**
+ * Rewrites a distance join between two point columns with a constant distance, i.e.
+ *   ST_DWithin(a.pt, b.pt, d) or ST_Distance(a.pt, b.pt) <= d (or < d),
+ * to `a.pt OVERLAPS ST_Buffer(b.pt, d)` with b the inner table. The overlaps hash table
+ * is built over the bounds of the inner points grown by d (in meters for geographies) and
+ * the original qual is kept to compute the exact distance of the candidate pairs.
+ */
+boost::optional<OverlapsJoinConjunction> rewrite_distance_join(
+    const std::shared_ptr<Analyzer::Expr> expr) {
+  const Analyzer::FunctionOper* distance_oper{nullptr};
+  std::shared_ptr<Analyzer::Expr> distance_expr;
+  size_t expected_arity{0};
+  if (const auto func_oper = dynamic_cast<const Analyzer::FunctionOper*>(expr.get())) {
+    if (func_oper->getName() != "ST_DWithin_Point_Point"sv) {
+      return boost::none;
+    }
+    // pt0, pt1, ic0, isr0, ic1, isr1, osr, distance
+    expected_arity = 8;
+    if (func_oper->getArity() != expected_arity) {
+      return boost::none;
+    }
+    distance_oper = func_oper;
+    distance_expr = func_oper->getOwnArg(expected_arity - 1);
+  } else if (const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(expr.get())) {
+    if (bin_oper->get_optype() != kLE && bin_oper->get_optype() != kLT) {
+      return boost::none;
+    }
+    const auto func_oper =
+        dynamic_cast<const Analyzer::FunctionOper*>(bin_oper->get_left_operand());
+    if (!func_oper || (func_oper->getName() != "ST_Distance_Point_Point"sv &&
+                       func_oper->getName() != "ST_Distance_Point_Point_Geodesic"sv)) {
+      return boost::none;
+    }
+    // pt0, pt1, ic0, isr0, ic1, isr1, osr
+    expected_arity = 7;
+    if (func_oper->getArity() != expected_arity) {
+      return boost::none;
+    }
+    distance_oper = func_oper;
+    distance_expr = bin_oper->get_own_right_operand();
+  } else {
+    return boost::none;
+  }
+
+  const auto pt0 = dynamic_cast<const Analyzer::ColumnVar*>(distance_oper->getArg(0));
+  const auto pt1 = dynamic_cast<const Analyzer::ColumnVar*>(distance_oper->getArg(1));
+  if (!pt0 || !pt1 || pt0->get_type_info().get_type() != kPOINT ||
+      pt1->get_type_info().get_type() != kPOINT ||
+      pt0->get_rte_idx() == pt1->get_rte_idx()) {
+    return boost::none;
+  }
+  const bool is_geodesic = pt0->get_type_info().get_subtype() == kGEOGRAPHY;
+  if (is_geodesic != (distance_oper->getName() == "ST_Distance_Point_Point_Geodesic"sv)) {
+    // geographies in a projected srid, or a geometry distance on geographies
+    return boost::none;
+  }
+  // The bounds are computed from the stored coordinates, the inputs cannot be transformed
+  const auto isr0 = get_int_literal(distance_oper->getArg(3));
+  const auto isr1 = get_int_literal(distance_oper->getArg(5));
+  const auto osr = get_int_literal(distance_oper->getArg(6));
+  if (!isr0 || !isr1 || !osr || *isr0 != *osr || *isr1 != *osr) {
+    return boost::none;
+  }
+
+  auto distance = fold_expr(distance_expr.get());
+  if (distance->get_type_info().get_type() != kDOUBLE) {
+    distance = fold_expr(distance->add_cast(SQLTypeInfo(kDOUBLE, false)).get());
+  }
+  const auto distance_literal = std::dynamic_pointer_cast<Analyzer::Constant>(distance);
+  if (!distance_literal || distance_literal->get_is_null() ||
+      !(distance_literal->get_constval().doubleval >= 0)) {
+    VLOG(1) << "Unable to rewrite " << expr->toString()
+            << " to overlaps join, the distance is not a non-negative constant";
+    return boost::none;
+  }
+
+  const auto outer_pt = pt0->get_rte_idx() < pt1->get_rte_idx() ? pt0 : pt1;
+  const auto inner_pt = outer_pt == pt0 ? pt1 : pt0;
+  DeepCopyVisitor deep_copy_visitor;
+  auto rewritten_lhs = deep_copy_visitor.visit(outer_pt);
+  auto inner_pt_copy = deep_copy_visitor.visit(inner_pt);
+  CHECK(rewritten_lhs && inner_pt_copy);
+  auto buffer_ti = inner_pt->get_type_info();
+  buffer_ti.set_type(kMULTIPOLYGON);
+  buffer_ti.set_compression(kENCODING_NONE);
+  buffer_ti.set_comp_param(0);
+  auto rewritten_rhs =
+      makeExpr<Analyzer::GeoBinOper>(Geospatial::GeoBase::GeoOp::kBUFFER,
+                                     buffer_ti,
+                                     inner_pt->get_type_info(),
+                                     SQLTypeInfo(kDOUBLE, false),
+                                     std::vector<std::shared_ptr<Analyzer::Expr>>{
+                                         inner_pt_copy},
+                                     std::vector<std::shared_ptr<Analyzer::Expr>>{
+                                         distance_literal});
+
+  auto overlaps_oper = makeExpr<Analyzer::BinOper>(
+      kBOOLEAN, kOVERLAPS, kONE, rewritten_lhs, rewritten_rhs);
+  VLOG(1) << "Rewritten distance join to overlaps join with lhs as "
+          << rewritten_lhs->toString() << " and rhs as " << rewritten_rhs->toString();
+  return OverlapsJoinConjunction{{expr}, {overlaps_oper}};
+}
+
 }  // namespace
 
 boost::optional<OverlapsJoinConjunction> rewrite_overlaps_conjunction(
     const std::shared_ptr<Analyzer::Expr> expr) {
+  if (auto distance_join = rewrite_distance_join(expr)) {
+    return distance_join;
+  }
   auto func_oper = dynamic_cast<Analyzer::FunctionOper*>(expr.get());
   if (func_oper) {
     const auto needs_many_many = [func_oper]() {
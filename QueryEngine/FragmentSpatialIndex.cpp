@@ -0,0 +1,408 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/FragmentSpatialIndex.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <cmath>
+#include <limits>
+
+#include "Analyzer/Analyzer.h"
+#include "DataMgr/Chunk/Chunk.h"
+#include "Geospatial/Compression.h"
+#include "Geospatial/CompressionRuntime.h"
+#include "Shared/InlineNullValues.h"
+
+extern bool g_enable_spatial_fragment_skipping;
+
+std::mutex FragmentSpatialIndex::cache_mutex_;
+std::map<ChunkKey, FragmentSpatialIndex::ColumnIndex>
+    FragmentSpatialIndex::column_indexes_;
+
+namespace {
+
+// Literals are compressed like the columns they are compared to, which moves their
+// vertices by up to one compression unit away from the exact literal bounds.
+constexpr double kLiteralBoundsTolerance = 1e-6;
+
+struct SpatialFilter {
+  const ColumnDescriptor* geo_column;
+  Geospatial::BoundingBox box;
+};
+
+// Box which intersects everything, used for fragments whose bounds are unknown
+Geospatial::BoundingBox unbounded_box() {
+  constexpr auto max = std::numeric_limits<double>::max();
+  return {-max, -max, max, max};
+}
+
+std::optional<int32_t> get_int_constant(const Analyzer::Expr* expr) {
+  const auto constant = dynamic_cast<const Analyzer::Constant*>(expr);
+  if (!constant || constant->get_is_null() ||
+      constant->get_type_info().get_type() != kINT) {
+    return std::nullopt;
+  }
+  return constant->get_constval().intval;
+}
+
+/**
+ * Geo runtime functions take the compression and input SRID of both arguments followed
+ * by the output SRID, with the arguments at [srid_args_end - 5, srid_args_end). Returns
+ * true if none of the arguments is transformed, i.e. the constant geometry is expressed
+ * in the coordinates stored in the column.
+ */
+bool has_no_transforms(const Analyzer::FunctionOper* func, const size_t srid_args_end) {
+  if (srid_args_end < 5 || srid_args_end > func->getArity()) {
+    return false;
+  }
+  const auto input_srid0 = get_int_constant(func->getArg(srid_args_end - 4));
+  const auto input_srid1 = get_int_constant(func->getArg(srid_args_end - 2));
+  const auto output_srid = get_int_constant(func->getArg(srid_args_end - 1));
+  return input_srid0 && input_srid1 && output_srid && *input_srid0 == *output_srid &&
+         *input_srid1 == *output_srid;
+}
+
+std::optional<Geospatial::BoundingBox> get_literal_bounds(
+    const Analyzer::Constant* bounds_literal) {
+  const auto& values = bounds_literal->get_value_list();
+  if (values.size() != 4) {
+    return std::nullopt;
+  }
+  std::vector<double> bounds;
+  for (const auto& value : values) {
+    const auto constant = std::dynamic_pointer_cast<const Analyzer::Constant>(value);
+    if (!constant || constant->get_is_null()) {
+      return std::nullopt;
+    }
+    bounds.push_back(constant->get_constval().doubleval);
+  }
+  return Geospatial::BoundingBox{bounds[0], bounds[1], bounds[2], bounds[3]};
+}
+
+// Bounds of the coords of a literal without bounds, i.e. a point.
+std::optional<Geospatial::BoundingBox> get_literal_coords_bounds(
+    const Analyzer::Constant* coords_literal) {
+  std::vector<int8_t> compressed_coords;
+  for (const auto& value : coords_literal->get_value_list()) {
+    const auto constant = std::dynamic_pointer_cast<const Analyzer::Constant>(value);
+    if (!constant || constant->get_is_null()) {
+      return std::nullopt;
+    }
+    compressed_coords.push_back(constant->get_constval().tinyintval);
+  }
+  const auto coords = Geospatial::decompress_coords<double, SQLTypeInfo>(
+      coords_literal->get_type_info(), compressed_coords.data(), compressed_coords.size());
+  if (coords->empty() || coords->size() % 2) {
+    return std::nullopt;
+  }
+  auto box = Geospatial::BoundingBox::empty();
+  for (size_t i = 0; i < coords->size(); i += 2) {
+    box.extend({(*coords)[i], (*coords)[i + 1], (*coords)[i], (*coords)[i + 1]});
+  }
+  return box;
+}
+
+/**
+ * Matches spatial predicates between a geo column of the given table and a constant
+ * geometry. Rows can only pass ST_Contains (either way) and ST_Intersects if their
+ * bounding box intersects the one of the constant, and ST_DWithin if it intersects the
+ * box of the constant grown by the distance.
+ */
+std::optional<SpatialFilter> get_spatial_filter(const Analyzer::Expr* qual,
+                                                const int table_id,
+                                                const Catalog_Namespace::Catalog& catalog) {
+  const auto func = dynamic_cast<const Analyzer::FunctionOper*>(qual);
+  if (!func) {
+    return std::nullopt;
+  }
+  const auto name = func->getName();
+  const bool is_dwithin = boost::starts_with(name, "ST_DWithin_");
+  if (!is_dwithin && !boost::starts_with(name, "ST_Contains_") &&
+      !boost::starts_with(name, "ST_cContains_") &&
+      !boost::starts_with(name, "ST_Intersects_")) {
+    return std::nullopt;
+  }
+  // ST_DWithin takes the distance after the SRIDs
+  const size_t srid_args_end = is_dwithin ? func->getArity() - 1 : func->getArity();
+  if (!has_no_transforms(func, srid_args_end)) {
+    return std::nullopt;
+  }
+
+  // Geo columns are passed as the logical column, followed by its bounds if needed
+  const Analyzer::ColumnVar* geo_col_var{nullptr};
+  const Analyzer::Constant* bounds_literal{nullptr};
+  const Analyzer::Constant* coords_literal{nullptr};
+  for (size_t i = 0; i < func->getArity(); ++i) {
+    const auto arg = func->getArg(i);
+    if (const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(arg)) {
+      if (col_var->get_table_id() != table_id || col_var->get_rte_idx() != 0) {
+        return std::nullopt;
+      }
+      if (col_var->get_type_info().is_geometry()) {
+        if (geo_col_var) {
+          return std::nullopt;
+        }
+        geo_col_var = col_var;
+      }
+    } else if (const auto constant = dynamic_cast<const Analyzer::Constant*>(arg)) {
+      const auto& ti = constant->get_type_info();
+      if (!ti.is_array()) {
+        continue;
+      }
+      if (ti.get_subtype() == kDOUBLE) {
+        bounds_literal = constant;
+      } else if (ti.get_subtype() == kTINYINT) {
+        coords_literal = constant;
+      }
+    } else {
+      // e.g. geo functions of columns
+      return std::nullopt;
+    }
+  }
+  if (!geo_col_var || (!bounds_literal && !coords_literal)) {
+    return std::nullopt;
+  }
+
+  const auto geo_column =
+      catalog.getMetadataForColumn(table_id, geo_col_var->get_column_id());
+  if (!geo_column || !geo_column->columnType.is_geometry()) {
+    return std::nullopt;
+  }
+  auto box = bounds_literal ? get_literal_bounds(bounds_literal)
+                            : get_literal_coords_bounds(coords_literal);
+  if (!box) {
+    return std::nullopt;
+  }
+  double distance = kLiteralBoundsTolerance;
+  if (is_dwithin) {
+    // Distances between geographies are in meters
+    if (geo_column->columnType.get_subtype() == kGEOGRAPHY) {
+      return std::nullopt;
+    }
+    const auto distance_literal =
+        dynamic_cast<const Analyzer::Constant*>(func->getArg(func->getArity() - 1));
+    if (!distance_literal || distance_literal->get_is_null() ||
+        distance_literal->get_type_info().get_type() != kDOUBLE) {
+      return std::nullopt;
+    }
+    distance += std::max(distance_literal->get_constval().doubleval, 0.0);
+  }
+  return SpatialFilter{geo_column, box->expand(distance)};
+}
+
+// Column the bounds of a geo column are computed from
+const ColumnDescriptor* get_bounds_source_column(
+    const Catalog_Namespace::Catalog& catalog,
+    const ColumnDescriptor* geo_column) {
+  if (geo_column->columnType.get_type() == kPOINT) {
+    return catalog.getMetadataForColumn(geo_column->tableId, geo_column->columnId + 1);
+  }
+  return catalog.getMetadataForColumn(geo_column->tableId,
+                                      geo_column->columnName + "_bounds");
+}
+
+Geospatial::BoundingBox compute_fragment_bounds(
+    const Catalog_Namespace::Catalog& catalog,
+    const ColumnDescriptor* geo_column,
+    const ColumnDescriptor* source_column,
+    const int fragment_id,
+    const ChunkMetadata& chunk_metadata) {
+  auto box = Geospatial::BoundingBox::empty();
+  if (chunk_metadata.numElements == 0) {
+    return box;
+  }
+  const size_t element_size = source_column->columnType.get_size();
+  if (element_size == 0 ||
+      chunk_metadata.numBytes < chunk_metadata.numElements * element_size) {
+    return unbounded_box();
+  }
+  const ChunkKey chunk_key{catalog.getCurrentDB().dbId,
+                           source_column->tableId,
+                           source_column->columnId,
+                           fragment_id};
+  const auto chunk = Chunk_NS::Chunk::getChunk(source_column,
+                                               &catalog.getDataMgr(),
+                                               chunk_key,
+                                               Data_Namespace::CPU_LEVEL,
+                                               0,
+                                               chunk_metadata.numBytes,
+                                               chunk_metadata.numElements);
+  CHECK(chunk);
+  const auto data = chunk->getBuffer()->getMemoryPtr();
+  const auto& geo_ti = geo_column->columnType;
+  const bool is_compressed = geo_ti.get_compression() == kENCODING_GEOINT;
+  for (size_t i = 0; i < chunk_metadata.numElements; ++i) {
+    const auto element = data + i * element_size;
+    if (geo_ti.get_type() == kPOINT) {
+      if (Geospatial::is_null_point(geo_ti, element, element_size)) {
+        continue;
+      }
+      double x, y;
+      if (is_compressed) {
+        const auto coords = reinterpret_cast<const int32_t*>(element);
+        x = Geospatial::decompress_longitude_coord_geoint32(coords[0]);
+        y = Geospatial::decompress_lattitude_coord_geoint32(coords[1]);
+      } else {
+        const auto coords = reinterpret_cast<const double*>(element);
+        x = coords[0];
+        y = coords[1];
+      }
+      box.extend({x, y, x, y});
+    } else {
+      // min x, min y, max x, max y
+      const auto bounds = reinterpret_cast<const double*>(element);
+      if (bounds[0] == NULL_DOUBLE || bounds[0] == NULL_ARRAY_DOUBLE ||
+          std::isnan(bounds[0])) {
+        continue;
+      }
+      box.extend({bounds[0], bounds[1], bounds[2], bounds[3]});
+    }
+  }
+  return box;
+}
+
+}  // namespace
+
+std::optional<std::unordered_set<int>> FragmentSpatialIndex::getCandidateFragments(
+    const Catalog_Namespace::Catalog& catalog,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const int table_id,
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments) {
+  if (!g_enable_spatial_fragment_skipping || table_id <= 0) {
+    return std::nullopt;
+  }
+  const auto td = catalog.getMetadataForTable(table_id, false);
+  // Foreign tables can change on refresh without changing fragment sizes
+  if (!td || td->isForeignTable()) {
+    return std::nullopt;
+  }
+
+  std::optional<std::unordered_set<int>> candidates;
+  for (const auto& qual : ra_exe_unit.quals) {
+    const auto filter = get_spatial_filter(qual.get(), table_id, catalog);
+    if (!filter) {
+      continue;
+    }
+    const auto rtree = getRTree(catalog, filter->geo_column, fragments);
+    std::unordered_set<int> filter_candidates;
+    for (const auto fragment_id : rtree->query(filter->box)) {
+      if (!candidates || candidates->count(fragment_id)) {
+        filter_candidates.emplace(fragment_id);
+      }
+    }
+    candidates = std::move(filter_candidates);
+  }
+  if (candidates) {
+    VLOG(1) << "Spatial filters on table " << table_id << " select " << candidates->size()
+            << " of " << fragments.size() << " fragments";
+  }
+  return candidates;
+}
+
+std::shared_ptr<const Geospatial::StrRTree> FragmentSpatialIndex::getRTree(
+    const Catalog_Namespace::Catalog& catalog,
+    const ColumnDescriptor* geo_column,
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments) {
+  const ChunkKey column_key{
+      catalog.getCurrentDB().dbId, geo_column->tableId, geo_column->columnId};
+  const auto source_column = get_bounds_source_column(catalog, geo_column);
+  CHECK(source_column);
+
+  // Bounds are computed outside of the lock, since it reads chunks
+  std::vector<std::pair<const Fragmenter_Namespace::FragmentInfo*,
+                        std::shared_ptr<ChunkMetadata>>>
+      outdated_fragments;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto& column_index = column_indexes_[column_key];
+    for (const auto& fragment : fragments) {
+      const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+      auto chunk_metadata_it = chunk_metadata_map.find(source_column->columnId);
+      const auto chunk_metadata = chunk_metadata_it == chunk_metadata_map.end()
+                                      ? nullptr
+                                      : chunk_metadata_it->second;
+      auto bounds_it = column_index.fragment_bounds.find(fragment.fragmentId);
+      if (!chunk_metadata || bounds_it == column_index.fragment_bounds.end() ||
+          bounds_it->second.num_elements != chunk_metadata->numElements ||
+          bounds_it->second.num_bytes != chunk_metadata->numBytes) {
+        outdated_fragments.emplace_back(&fragment, chunk_metadata);
+      }
+    }
+    if (outdated_fragments.empty() && column_index.rtree &&
+        column_index.fragment_bounds.size() == fragments.size()) {
+      return column_index.rtree;
+    }
+  }
+
+  std::vector<std::pair<int, FragmentBounds>> updated_bounds;
+  for (const auto& [fragment, chunk_metadata] : outdated_fragments) {
+    if (!chunk_metadata) {
+      updated_bounds.emplace_back(fragment->fragmentId,
+                                  FragmentBounds{0, 0, unbounded_box()});
+      continue;
+    }
+    updated_bounds.emplace_back(
+        fragment->fragmentId,
+        FragmentBounds{chunk_metadata->numElements,
+                       chunk_metadata->numBytes,
+                       compute_fragment_bounds(catalog,
+                                               geo_column,
+                                               source_column,
+                                               fragment->fragmentId,
+                                               *chunk_metadata)});
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto& column_index = column_indexes_[column_key];
+  for (auto& [fragment_id, bounds] : updated_bounds) {
+    column_index.fragment_bounds[fragment_id] = bounds;
+  }
+  // Drop fragments which no longer exist
+  std::unordered_set<int> fragment_ids;
+  for (const auto& fragment : fragments) {
+    fragment_ids.emplace(fragment.fragmentId);
+  }
+  for (auto it = column_index.fragment_bounds.begin();
+       it != column_index.fragment_bounds.end();) {
+    it = fragment_ids.count(it->first) ? std::next(it)
+                                       : column_index.fragment_bounds.erase(it);
+  }
+  std::vector<std::pair<Geospatial::BoundingBox, int64_t>> entries;
+  for (const auto& [fragment_id, bounds] : column_index.fragment_bounds) {
+    entries.emplace_back(bounds.box, fragment_id);
+  }
+  column_index.rtree = std::make_shared<const Geospatial::StrRTree>(entries);
+  return column_index.rtree;
+}
+
+void FragmentSpatialIndex::invalidateTable(const int db_id, const int table_id) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  const ChunkKey table_key{db_id, table_id};
+  auto it = column_indexes_.lower_bound(table_key);
+  while (it != column_indexes_.end() && it->first[CHUNK_KEY_DB_IDX] == db_id &&
+         it->first[CHUNK_KEY_TABLE_IDX] == table_id) {
+    it = column_indexes_.erase(it);
+  }
+}
+
+size_t FragmentSpatialIndex::getNumCachedFragmentBounds() {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  size_t num_fragment_bounds = 0;
+  for (const auto& [column_key, column_index] : column_indexes_) {
+    num_fragment_bounds += column_index.fragment_bounds.size();
+  }
+  return num_fragment_bounds;
+}
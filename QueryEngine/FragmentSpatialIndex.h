@@ -0,0 +1,103 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    FragmentSpatialIndex.h
+ * @brief   Fragment skipping for filters against constant geometries.
+ *
+ * The bounding box of the geometries of every fragment of a geo column is computed from
+ * its coords (points) or bounds (other geometries) chunk the first time a query filters
+ * the column against a constant geometry, e.g.
+ *   ST_Contains(ST_GeomFromText('POLYGON(...)'), pt)
+ *   ST_DWithin(pt, ST_GeomFromText('POINT(...)'), 0.1)
+ * The boxes are kept in an STR-packed R-tree per column, and fragments whose box does
+ * not intersect the box of the constant (grown by the distance for ST_DWithin) are not
+ * dispatched. A box is recomputed when the size of its fragment changes; updates and
+ * deletes invalidate all boxes, and the catalog drops the boxes of a table when it is
+ * truncated, dropped or rolled back.
+ *
+ * The index is not persisted: it lives in memory only and is rebuilt from the chunks
+ * after a restart. It is only used to skip fragments for such filters, joins are not
+ * planned against it.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include "Catalog/Catalog.h"
+#include "Fragmenter/Fragmenter.h"
+#include "Geospatial/RTree.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+
+class FragmentSpatialIndex {
+ public:
+  /**
+   * Returns the ids of the fragments of the given table which may have rows passing the
+   * spatial filters in the quals of the execution unit, or std::nullopt if there is no
+   * such filter on the table.
+   */
+  static std::optional<std::unordered_set<int>> getCandidateFragments(
+      const Catalog_Namespace::Catalog& catalog,
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const int table_id,
+      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments);
+
+  static auto getCacheInvalidator() -> std::function<void()> {
+    return []() -> void {
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      column_indexes_.clear();
+    };
+  }
+
+  /**
+   * Drops the bounds of all columns of the given table, whose fragments can be replaced
+   * by ones of the same sizes, e.g. on TRUNCATE.
+   */
+  static void invalidateTable(const int db_id, const int table_id);
+
+  // for unit tests
+  static size_t getNumCachedFragmentBounds();
+
+ private:
+  struct FragmentBounds {
+    // Size of the chunk the box was computed from
+    size_t num_elements;
+    size_t num_bytes;
+    Geospatial::BoundingBox box;
+  };
+
+  struct ColumnIndex {
+    std::map<int, FragmentBounds> fragment_bounds;
+    // Built over fragment_bounds, reset when they change
+    std::shared_ptr<const Geospatial::StrRTree> rtree;
+  };
+
+  static std::shared_ptr<const Geospatial::StrRTree> getRTree(
+      const Catalog_Namespace::Catalog& catalog,
+      const ColumnDescriptor* geo_column,
+      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments);
+
+  static std::mutex cache_mutex_;
+  // Keyed by {db id, table id, logical geo column id}
+  static std::map<ChunkKey, ColumnIndex> column_indexes_;
+};
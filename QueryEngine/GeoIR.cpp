@@ -17,6 +17,13 @@
 #include "Geospatial/Compression.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/Execute.h"
+#ifdef ENABLE_GEOS
+#include "QueryEngine/GeosRuntime.h"
+#endif
+
+#include <array>
+#include <cstring>
+#include <vector>
 
 std::vector<llvm::Value*> CodeGenerator::codegenGeoUOper(
     const Analyzer::GeoUOper* geo_expr,
@@ -371,3 +378,109 @@ std::vector<llvm::Value*> CodeGenerator::codegenGeosConstructorCall(
           cgen_state_->ir_builder_.CreatePointerCast(buf3, pi32_type),
           buf3s};
 }
+
+#ifdef ENABLE_GEOS
+
+namespace {
+
+struct GeosThreadState {
+  struct CachedGeometry {
+    int type{0};
+    int32_t ic{0};
+    std::vector<int8_t> coords;
+    std::vector<int32_t> meta1;
+    std::vector<int32_t> meta2;
+    void* geometry{nullptr};
+  };
+
+  ~GeosThreadState() {
+    for (auto& cached_geometry : cached_geometries) {
+      if (cached_geometry.geometry) {
+        destroy_geometry(context, cached_geometry.geometry);
+      }
+    }
+    if (context) {
+      finish_context(context);
+    }
+  }
+
+  void* context{nullptr};
+  // GEOS API functions, which unlike the jitted runtime functions outlive the queries
+  void (*finish_context)(void*){nullptr};
+  void (*destroy_geometry)(void*, void*){nullptr};
+  std::array<CachedGeometry, kGeosCachedGeometrySlots> cached_geometries;
+};
+
+thread_local GeosThreadState geos_thread_state;
+
+template <typename T>
+bool equals(const std::vector<T>& cached, const T* values, const int64_t size) {
+  return cached.size() == static_cast<size_t>(size) &&
+         (size == 0 || std::memcmp(cached.data(), values, size * sizeof(T)) == 0);
+}
+
+}  // namespace
+
+extern "C" RUNTIME_EXPORT void* Geos_getThreadContext() {
+  return geos_thread_state.context;
+}
+
+extern "C" RUNTIME_EXPORT void Geos_setThreadContext(
+    void* context,
+    void (*finish_context)(void*),
+    void (*destroy_geometry)(void*, void*)) {
+  CHECK(!geos_thread_state.context);
+  CHECK(context && finish_context && destroy_geometry);
+  geos_thread_state.context = context;
+  geos_thread_state.finish_context = finish_context;
+  geos_thread_state.destroy_geometry = destroy_geometry;
+}
+
+extern "C" RUNTIME_EXPORT void* Geos_getCachedGeometry(int32_t slot,
+                                                       int type,
+                                                       int8_t* coords,
+                                                       int64_t coords_size,
+                                                       int32_t* meta1,
+                                                       int64_t meta1_size,
+                                                       int32_t* meta2,
+                                                       int64_t meta2_size,
+                                                       int32_t ic) {
+  CHECK_GE(slot, 0);
+  CHECK_LT(slot, kGeosCachedGeometrySlots);
+  const auto& cached_geometry = geos_thread_state.cached_geometries[slot];
+  if (!cached_geometry.geometry || cached_geometry.type != type ||
+      cached_geometry.ic != ic || !equals(cached_geometry.meta1, meta1, meta1_size) ||
+      !equals(cached_geometry.meta2, meta2, meta2_size) ||
+      !equals(cached_geometry.coords, coords, coords_size)) {
+    return nullptr;
+  }
+  return cached_geometry.geometry;
+}
+
+extern "C" RUNTIME_EXPORT void Geos_setCachedGeometry(int32_t slot,
+                                                      int type,
+                                                      int8_t* coords,
+                                                      int64_t coords_size,
+                                                      int32_t* meta1,
+                                                      int64_t meta1_size,
+                                                      int32_t* meta2,
+                                                      int64_t meta2_size,
+                                                      int32_t ic,
+                                                      void* geometry) {
+  CHECK_GE(slot, 0);
+  CHECK_LT(slot, kGeosCachedGeometrySlots);
+  CHECK(geos_thread_state.context);
+  auto& cached_geometry = geos_thread_state.cached_geometries[slot];
+  if (cached_geometry.geometry) {
+    geos_thread_state.destroy_geometry(geos_thread_state.context,
+                                       cached_geometry.geometry);
+  }
+  cached_geometry.type = type;
+  cached_geometry.ic = ic;
+  cached_geometry.coords.assign(coords, coords + coords_size);
+  cached_geometry.meta1.assign(meta1, meta1 + meta1_size);
+  cached_geometry.meta2.assign(meta2, meta2 + meta2_size);
+  cached_geometry.geometry = geometry;
+}
+
+#endif
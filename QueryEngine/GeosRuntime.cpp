@@ -18,10 +18,13 @@
 
 #ifndef __CUDACC__
 
+#include <algorithm>
 #include <cstdarg>
+#include <limits>
 #include <mutex>
 
 #include "Geospatial/Compression.h"
+#include "Geospatial/RTree.h"
 #include "Geospatial/Types.h"
 #include "QueryEngine/GeosRuntime.h"
 #include "Shared/checked_alloc.h"
@@ -88,6 +91,221 @@ void destroy_context(GEOSContextHandle_t context) {
 #endif
 }
 
+#if GEOS_VERSION_MAJOR == 3 && GEOS_VERSION_MINOR < 5
+// The message handlers of a context cannot be changed, and are functions of the query
+// module, so contexts and geometries are not reused across calls
+#define GEOS_REUSE_CONTEXT 0
+#else
+#define GEOS_REUSE_CONTEXT 1
+#endif
+
+// Returns the context of the calling thread, see Geos_getThreadContext()
+GEOSContextHandle_t acquire_context() {
+#if GEOS_REUSE_CONTEXT
+  auto context = reinterpret_cast<GEOSContextHandle_t>(Geos_getThreadContext());
+  if (!context) {
+    context = GEOS_init_r();
+    CHECK(context);
+    Geos_setThreadContext(context,
+                          reinterpret_cast<void (*)(void*)>(&GEOS_finish_r),
+                          reinterpret_cast<void (*)(void*, void*)>(&GEOSGeom_destroy_r));
+  }
+  // The handlers of the query module which last used the context may have been released
+  GEOSContext_setNoticeHandler_r(context, geos_notice_handler);
+  GEOSContext_setErrorHandler_r(context, geos_error_handler);
+  return context;
+#else
+  return create_context();
+#endif
+}
+
+void release_context(GEOSContextHandle_t context) {
+#if !GEOS_REUSE_CONTEXT
+  destroy_context(context);
+#endif
+}
+
+// Internal encoding of GEOMETRYCOLLECTION EMPTY, see toWkb()
+const std::vector<double> empty_geometry_coords = {0.0,
+                                                   0.0,
+                                                   0.00000012345,
+                                                   0.0,
+                                                   0.0,
+                                                   0.00000012345};
+
+bool is_empty_geometry(int type,
+                       const std::vector<double>& coords,
+                       int64_t meta1_size,
+                       int64_t meta2_size) {
+  return static_cast<SQLTypes>(type) == kMULTIPOLYGON && meta1_size == 1 &&
+         meta2_size == 1 && coords == empty_geometry_coords;
+}
+
+BoundingBox get_bounds(const std::vector<double>& coords) {
+  BoundingBox box{std::numeric_limits<double>::max(),
+                  std::numeric_limits<double>::max(),
+                  std::numeric_limits<double>::lowest(),
+                  std::numeric_limits<double>::lowest()};
+  for (size_t i = 0; i + 1 < coords.size(); i += 2) {
+    box.min_x = std::min(box.min_x, coords[i]);
+    box.min_y = std::min(box.min_y, coords[i + 1]);
+    box.max_x = std::max(box.max_x, coords[i]);
+    box.max_y = std::max(box.max_y, coords[i + 1]);
+  }
+  return box;
+}
+
+GEOSCoordSequence* make_coord_seq(GEOSContextHandle_t context,
+                                  const double* coords,
+                                  const size_t num_points,
+                                  const bool close) {
+  auto seq = GEOSCoordSeq_create_r(context, num_points + (close ? 1 : 0), 2);
+  if (!seq) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < num_points; ++i) {
+    GEOSCoordSeq_setX_r(context, seq, i, coords[2 * i]);
+    GEOSCoordSeq_setY_r(context, seq, i, coords[2 * i + 1]);
+  }
+  if (close) {
+    GEOSCoordSeq_setX_r(context, seq, num_points, coords[0]);
+    GEOSCoordSeq_setY_r(context, seq, num_points, coords[1]);
+  }
+  return seq;
+}
+
+// Builds a polygon from `num_rings` open rings starting at coords, advancing coords
+GEOSGeometry* make_polygon(GEOSContextHandle_t context,
+                           const double*& coords,
+                           const int32_t* ring_sizes,
+                           const int32_t num_rings) {
+  if (num_rings < 1) {
+    return nullptr;
+  }
+  std::vector<GEOSGeometry*> rings;
+  rings.reserve(num_rings);
+  for (int32_t r = 0; r < num_rings; ++r) {
+    auto seq = make_coord_seq(context, coords, ring_sizes[r], true);
+    auto ring = seq ? GEOSGeom_createLinearRing_r(context, seq) : nullptr;
+    if (!ring) {
+      for (auto built_ring : rings) {
+        GEOSGeom_destroy_r(context, built_ring);
+      }
+      return nullptr;
+    }
+    rings.push_back(ring);
+    coords += 2 * ring_sizes[r];
+  }
+  return GEOSGeom_createPolygon_r(context, rings[0], rings.data() + 1, num_rings - 1);
+}
+
+// Builds the GEOS geometry of a geo argument directly from its coords, which skips the
+// conversions to GDAL geometries and WKB done by toWkb()
+GEOSGeometry* make_geometry(GEOSContextHandle_t context,
+                            int type,
+                            const std::vector<double>& coords,
+                            int32_t* meta1,
+                            int64_t meta1_size,
+                            int32_t* meta2,
+                            int64_t meta2_size) {
+  const size_t num_points = coords.size() / 2;
+  const double* coords_ptr = coords.data();
+  switch (static_cast<SQLTypes>(type)) {
+    case kPOINT: {
+      if (num_points != 1) {
+        return nullptr;
+      }
+      auto seq = make_coord_seq(context, coords_ptr, 1, false);
+      return seq ? GEOSGeom_createPoint_r(context, seq) : nullptr;
+    }
+    case kLINESTRING: {
+      auto seq = make_coord_seq(context, coords_ptr, num_points, false);
+      return seq ? GEOSGeom_createLineString_r(context, seq) : nullptr;
+    }
+    case kPOLYGON: {
+      int64_t ring_points = 0;
+      for (int64_t r = 0; r < meta1_size; ++r) {
+        ring_points += meta1[r];
+      }
+      if (ring_points != static_cast<int64_t>(num_points)) {
+        return nullptr;
+      }
+      return make_polygon(context, coords_ptr, meta1, meta1_size);
+    }
+    case kMULTIPOLYGON: {
+      if (is_empty_geometry(type, coords, meta1_size, meta2_size)) {
+        return GEOSGeom_createEmptyCollection_r(context, GEOS_GEOMETRYCOLLECTION);
+      }
+      int64_t total_rings = 0;
+      for (int64_t p = 0; p < meta2_size; ++p) {
+        total_rings += meta2[p];
+      }
+      int64_t ring_points = 0;
+      for (int64_t r = 0; r < meta1_size; ++r) {
+        ring_points += meta1[r];
+      }
+      if (total_rings != meta1_size || ring_points != static_cast<int64_t>(num_points)) {
+        return nullptr;
+      }
+      std::vector<GEOSGeometry*> polys;
+      polys.reserve(meta2_size);
+      const int32_t* ring_sizes = meta1;
+      for (int64_t p = 0; p < meta2_size; ++p) {
+        auto poly = make_polygon(context, coords_ptr, ring_sizes, meta2[p]);
+        if (!poly) {
+          for (auto built_poly : polys) {
+            GEOSGeom_destroy_r(context, built_poly);
+          }
+          return nullptr;
+        }
+        polys.push_back(poly);
+        ring_sizes += meta2[p];
+      }
+      return GEOSGeom_createCollection_r(
+          context, GEOS_MULTIPOLYGON, polys.data(), polys.size());
+    }
+    default:
+      return nullptr;
+  }
+}
+
+/**
+ * Returns the GEOS geometry of an argument in the given slot. The geometry of the
+ * previous call is reused when the argument is the same, e.g. a literal or the outer row
+ * of a join, and the geometries are owned by the thread state unless `owned` is set.
+ */
+GEOSGeometry* get_geometry(GEOSContextHandle_t context,
+                           int32_t slot,
+                           int type,
+                           int8_t* coords,
+                           int64_t coords_size,
+                           int32_t* meta1,
+                           int64_t meta1_size,
+                           int32_t* meta2,
+                           int64_t meta2_size,
+                           int32_t ic,
+                           const std::vector<double>& decompressed_coords,
+                           bool* owned) {
+#if GEOS_REUSE_CONTEXT
+  *owned = false;
+  if (auto cached = Geos_getCachedGeometry(
+          slot, type, coords, coords_size, meta1, meta1_size, meta2, meta2_size, ic)) {
+    return reinterpret_cast<GEOSGeometry*>(cached);
+  }
+  auto g = make_geometry(
+      context, type, decompressed_coords, meta1, meta1_size, meta2, meta2_size);
+  if (g) {
+    Geos_setCachedGeometry(
+        slot, type, coords, coords_size, meta1, meta1_size, meta2, meta2_size, ic, g);
+  }
+  return g;
+#else
+  *owned = true;
+  return make_geometry(
+      context, type, decompressed_coords, meta1, meta1_size, meta2, meta2_size);
+#endif
+}
+
 bool toWkb(WKB& wkb,
            int type,  // internal geometry type
            int8_t* coords,
@@ -142,12 +360,9 @@ bool toWkb(WKB& wkb,
     // Recognize GEOMETRYCOLLECTION EMPTY encoding
     // MULTIPOLYGON (((0 0,0.00000012345 0.0,0.0 0.00000012345,0 0)))
     // Used to pass along EMPTY from ST_Intersection to ST_IsEmpty for example
-    if (meta1_size == 1 && meta2_size == 1) {
-      const std::vector<double> ecv = {0.0, 0.0, 0.00000012345, 0.0, 0.0, 0.00000012345};
-      if (*cv == ecv) {
-        GeoGeometryCollection empty("GEOMETRYCOLLECTION EMPTY");
-        return empty.getWkb(wkb);
-      }
+    if (is_empty_geometry(type, *cv, meta1_size, meta2_size)) {
+      GeoGeometryCollection empty("GEOMETRYCOLLECTION EMPTY");
+      return empty.getWkb(wkb);
     }
     GeoMultiPolygon mpoly(*cv, meta1v, meta2v);
     if (best_planar_srid_ptr) {
@@ -163,6 +378,72 @@ bool toWkb(WKB& wkb,
   return false;
 }
 
+// Copies the result columns to buffers which are malloced for the caller to free
+bool copy_result_columns(const std::vector<double>& coords,
+                         const std::vector<int32_t>& ring_sizes,
+                         const std::vector<int32_t>& poly_rings,
+                         int* result_type,
+                         int8_t** result_coords,
+                         int64_t* result_coords_size,
+                         int32_t** result_meta1,
+                         int64_t* result_meta1_size,
+                         int32_t** result_meta2,
+                         int64_t* result_meta2_size) {
+  // TODO: consider using a single buffer to hold all components,
+  // instead of allocating and registering each component buffer separately
+
+  *result_type = static_cast<int>(kMULTIPOLYGON);
+
+  *result_coords = nullptr;
+  int64_t size = coords.size() * sizeof(double);
+  if (size > 0) {
+    auto buf = checked_malloc(size);
+    std::memcpy(buf, coords.data(), size);
+    *result_coords = reinterpret_cast<int8_t*>(buf);
+  }
+  *result_coords_size = size;
+
+  *result_meta1 = nullptr;
+  size = ring_sizes.size() * sizeof(int32_t);
+  if (size > 0) {
+    auto buf = checked_malloc(size);
+    std::memcpy(buf, ring_sizes.data(), size);
+    *result_meta1 = reinterpret_cast<int32_t*>(buf);
+  }
+  *result_meta1_size = ring_sizes.size();
+
+  *result_meta2 = nullptr;
+  size = poly_rings.size() * sizeof(int32_t);
+  if (size > 0) {
+    auto buf = checked_malloc(size);
+    std::memcpy(buf, poly_rings.data(), size);
+    *result_meta2 = reinterpret_cast<int32_t*>(buf);
+  }
+  *result_meta2_size = poly_rings.size();
+
+  return true;
+}
+
+bool copy_empty_result(int* result_type,
+                       int8_t** result_coords,
+                       int64_t* result_coords_size,
+                       int32_t** result_meta1,
+                       int64_t* result_meta1_size,
+                       int32_t** result_meta2,
+                       int64_t* result_meta2_size) {
+  // Tiny polygon around POINT(0 0) which simulates an empty result, see fromWkb()
+  return copy_result_columns(empty_geometry_coords,
+                             {3},
+                             {1},
+                             result_type,
+                             result_coords,
+                             result_coords_size,
+                             result_meta1,
+                             result_meta1_size,
+                             result_meta2,
+                             result_meta2_size);
+}
+
 // Conversion form wkb to internal vector representation.
 // Each vector components is malloced, caller is reponsible for freeing.
 bool fromWkb(WKB& wkb,
@@ -194,7 +475,7 @@ bool fromWkb(WKB& wkb,
     // Generate a tiny polygon around POINT(0 0), make it a multipolygon
     // MULTIPOLYGON (((0 0,0.00000012345 0.0,0.0 0.00000012345,0 0)))
     // to simulate an empty result
-    coords = {0.0, 0.0, 0.00000012345, 0.0, 0.0, 0.00000012345};
+    coords = empty_geometry_coords;
     ring_sizes.push_back(3);
     poly_rings.push_back(1);
   } else if (auto result_point = dynamic_cast<GeoPoint*>(result.get())) {
@@ -216,41 +497,165 @@ bool fromWkb(WKB& wkb,
     return false;
   }
 
-  // TODO: consider using a single buffer to hold all components,
-  // instead of allocating and registering each component buffer separately
-
-  *result_type = static_cast<int>(kMULTIPOLYGON);
+  return copy_result_columns(coords,
+                             ring_sizes,
+                             poly_rings,
+                             result_type,
+                             result_coords,
+                             result_coords_size,
+                             result_meta1,
+                             result_meta1_size,
+                             result_meta2,
+                             result_meta2_size);
+}
 
-  *result_coords = nullptr;
-  int64_t size = coords.size() * sizeof(double);
-  if (size > 0) {
-    auto buf = checked_malloc(size);
-    std::memcpy(buf, coords.data(), size);
-    *result_coords = reinterpret_cast<int8_t*>(buf);
+// Appends a ring of a GEOS result as an open ring wound the way GeoPolygon stores them:
+// exterior rings CCW, interior rings CW
+bool append_ring(GEOSContextHandle_t context,
+                 const GEOSGeometry* ring,
+                 const bool exterior,
+                 std::vector<double>& coords,
+                 std::vector<int32_t>& ring_sizes) {
+  auto seq = ring ? GEOSGeom_getCoordSeq_r(context, ring) : nullptr;
+  unsigned int num_points = 0;
+  if (!seq || !GEOSCoordSeq_getSize_r(context, seq, &num_points)) {
+    return false;
   }
-  *result_coords_size = size;
-
-  *result_meta1 = nullptr;
-  size = ring_sizes.size() * sizeof(int32_t);
-  if (size > 0) {
-    auto buf = checked_malloc(size);
-    std::memcpy(buf, ring_sizes.data(), size);
-    *result_meta1 = reinterpret_cast<int32_t*>(buf);
+  std::vector<double> ring_coords(2 * num_points);
+  for (unsigned int i = 0; i < num_points; ++i) {
+    if (!GEOSCoordSeq_getX_r(context, seq, i, &ring_coords[2 * i]) ||
+        !GEOSCoordSeq_getY_r(context, seq, i, &ring_coords[2 * i + 1])) {
+      return false;
+    }
   }
-  *result_meta1_size = ring_sizes.size();
-
-  *result_meta2 = nullptr;
-  size = poly_rings.size() * sizeof(int32_t);
-  if (size > 0) {
-    auto buf = checked_malloc(size);
-    std::memcpy(buf, poly_rings.data(), size);
-    *result_meta2 = reinterpret_cast<int32_t*>(buf);
+  double twice_area = 0.0;
+  for (unsigned int i = 0; i + 1 < num_points; ++i) {
+    twice_area += ring_coords[2 * i] * ring_coords[2 * i + 3] -
+                  ring_coords[2 * i + 2] * ring_coords[2 * i + 1];
   }
-  *result_meta2_size = poly_rings.size();
+  const bool clockwise = twice_area < 0.0;
+  if (clockwise == exterior && num_points > 1) {
+    // Reverse the closed ring, which keeps the first point in place
+    for (unsigned int i = 1, j = num_points - 2; i < j; ++i, --j) {
+      std::swap(ring_coords[2 * i], ring_coords[2 * j]);
+      std::swap(ring_coords[2 * i + 1], ring_coords[2 * j + 1]);
+    }
+  }
+  // Store rings as open rings
+  if (num_points > 1 && ring_coords[0] == ring_coords[2 * num_points - 2] &&
+      ring_coords[1] == ring_coords[2 * num_points - 1]) {
+    --num_points;
+  }
+  if (num_points < 3) {
+    return false;
+  }
+  coords.insert(coords.end(), ring_coords.begin(), ring_coords.begin() + 2 * num_points);
+  ring_sizes.push_back(num_points);
+  return true;
+}
 
+bool append_polygon(GEOSContextHandle_t context,
+                    const GEOSGeometry* poly,
+                    std::vector<double>& coords,
+                    std::vector<int32_t>& ring_sizes,
+                    std::vector<int32_t>& poly_rings) {
+  if (!append_ring(
+          context, GEOSGetExteriorRing_r(context, poly), true, coords, ring_sizes)) {
+    return false;
+  }
+  const auto num_interior_rings = GEOSGetNumInteriorRings_r(context, poly);
+  if (num_interior_rings < 0) {
+    return false;
+  }
+  for (int r = 0; r < num_interior_rings; ++r) {
+    if (!append_ring(context,
+                     GEOSGetInteriorRingN_r(context, poly, r),
+                     false,
+                     coords,
+                     ring_sizes)) {
+      return false;
+    }
+  }
+  poly_rings.push_back(num_interior_rings + 1);
   return true;
 }
 
+// Converts a GEOS result to the internal MULTIPOLYGON columns without going through WKB
+// and GDAL geometries, see fromWkb() for the representation of points and empties.
+// Each vector components is malloced, caller is reponsible for freeing.
+bool fromGeos(GEOSContextHandle_t context,
+              const GEOSGeometry* g,
+              int* result_type,
+              int8_t** result_coords,
+              int64_t* result_coords_size,
+              int32_t** result_meta1,
+              int64_t* result_meta1_size,
+              int32_t** result_meta2,
+              int64_t* result_meta2_size) {
+  const auto is_empty = GEOSisEmpty_r(context, g);
+  if (is_empty == 2) {
+    return false;
+  }
+  if (is_empty) {
+    return copy_empty_result(result_type,
+                             result_coords,
+                             result_coords_size,
+                             result_meta1,
+                             result_meta1_size,
+                             result_meta2,
+                             result_meta2_size);
+  }
+  std::vector<double> coords{};
+  std::vector<int32_t> ring_sizes{};
+  std::vector<int32_t> poly_rings{};
+  switch (GEOSGeomTypeId_r(context, g)) {
+    case GEOS_POINT: {
+      double x, y;
+      if (!GEOSGeomGetX_r(context, g, &x) || !GEOSGeomGetY_r(context, g, &y)) {
+        return false;
+      }
+      // Generate a tiny polygon around the point, make it a multipolygon
+      coords = {x, y, x + 0.0000001, y, x, y + 0.0000001};
+      ring_sizes.push_back(3);
+      poly_rings.push_back(1);
+      break;
+    }
+    case GEOS_POLYGON:
+      if (!append_polygon(context, g, coords, ring_sizes, poly_rings)) {
+        return false;
+      }
+      break;
+    case GEOS_MULTIPOLYGON: {
+      const auto num_polys = GEOSGetNumGeometries_r(context, g);
+      for (int p = 0; p < num_polys; ++p) {
+        auto poly = GEOSGetGeometryN_r(context, g, p);
+        if (!poly || GEOSisEmpty_r(context, poly)) {
+          continue;
+        }
+        if (!append_polygon(context, poly, coords, ring_sizes, poly_rings)) {
+          return false;
+        }
+      }
+      if (poly_rings.empty()) {
+        return false;
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+  return copy_result_columns(coords,
+                             ring_sizes,
+                             poly_rings,
+                             result_type,
+                             result_coords,
+                             result_coords_size,
+                             result_meta1,
+                             result_meta1_size,
+                             result_meta2,
+                             result_meta2_size);
+}
+
 GEOSGeometry* postprocess(GEOSContextHandle_t context, GEOSGeometry* g) {
   if (g && GEOSisEmpty_r(context, g) == 0) {
     auto type = GEOSGeomTypeId_r(context, g);
@@ -304,73 +709,86 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb_Wkb(
   // What if intersection is empty? Return null buffer pointers? Return false?
   // What if geos fails?
 
-  WKB wkb1{};
-  if (!toWkb(wkb1,
-             arg1_type,
-             arg1_coords,
-             arg1_coords_size,
-             arg1_meta1,
-             arg1_meta1_size,
-             arg1_meta2,
-             arg1_meta2_size,
-             arg1_ic,
-             nullptr)) {
-    return false;
-  }
-  WKB wkb2{};
-  if (!toWkb(wkb2,
-             arg2_type,
-             arg2_coords,
-             arg2_coords_size,
-             arg2_meta1,
-             arg2_meta1_size,
-             arg2_meta2,
-             arg2_meta2_size,
-             arg2_ic,
-             nullptr)) {
-    return false;
+  const auto geo_op = static_cast<GeoBase::GeoOp>(op);
+  auto cv1 = Geospatial::decompress_coords<double, int32_t>(
+      arg1_ic, arg1_coords, arg1_coords_size);
+  auto cv2 = Geospatial::decompress_coords<double, int32_t>(
+      arg2_ic, arg2_coords, arg2_coords_size);
+  if (geo_op == GeoBase::GeoOp::kINTERSECTION &&
+      !get_bounds(*cv1).intersects(get_bounds(*cv2))) {
+    // Geometries with disjoint bounding boxes have an empty intersection
+    return copy_empty_result(result_type,
+                             result_coords,
+                             result_coords_size,
+                             result_meta1,
+                             result_meta1_size,
+                             result_meta2,
+                             result_meta2_size);
   }
+
   auto status = false;
-  auto context = create_context();
+  auto context = acquire_context();
   if (!context) {
     return status;
   }
-  auto* g1 = GEOSGeomFromWKB_buf_r(context, wkb1.data(), wkb1.size());
+  bool owned1 = false;
+  auto* g1 = get_geometry(context,
+                          0,
+                          arg1_type,
+                          arg1_coords,
+                          arg1_coords_size,
+                          arg1_meta1,
+                          arg1_meta1_size,
+                          arg1_meta2,
+                          arg1_meta2_size,
+                          arg1_ic,
+                          *cv1,
+                          &owned1);
   if (g1) {
-    auto* g2 = GEOSGeomFromWKB_buf_r(context, wkb2.data(), wkb2.size());
+    bool owned2 = false;
+    auto* g2 = get_geometry(context,
+                            1,
+                            arg2_type,
+                            arg2_coords,
+                            arg2_coords_size,
+                            arg2_meta1,
+                            arg2_meta1_size,
+                            arg2_meta2,
+                            arg2_meta2_size,
+                            arg2_ic,
+                            *cv2,
+                            &owned2);
     if (g2) {
       GEOSGeometry* g = nullptr;
-      if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kINTERSECTION) {
+      if (geo_op == GeoBase::GeoOp::kINTERSECTION) {
         g = GEOSIntersection_r(context, g1, g2);
-      } else if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kDIFFERENCE) {
+      } else if (geo_op == GeoBase::GeoOp::kDIFFERENCE) {
         g = GEOSDifference_r(context, g1, g2);
-      } else if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kUNION) {
+      } else if (geo_op == GeoBase::GeoOp::kUNION) {
         g = GEOSUnion_r(context, g1, g2);
       }
       g = postprocess(context, g);
       if (g) {
-        size_t wkb_size = 0ULL;
-        auto wkb_buf = GEOSGeomToWKB_buf_r(context, g, &wkb_size);
-        if (wkb_buf && wkb_size > 0ULL) {
-          WKB wkb(wkb_buf, wkb_buf + wkb_size);
-          free(wkb_buf);
-          status = fromWkb(wkb,
-                           result_type,
-                           result_coords,
-                           result_coords_size,
-                           result_meta1,
-                           result_meta1_size,
-                           result_meta2,
-                           result_meta2_size,
-                           nullptr);
-        }
+        status = fromGeos(context,
+                          g,
+                          result_type,
+                          result_coords,
+                          result_coords_size,
+                          result_meta1,
+                          result_meta1_size,
+                          result_meta2,
+                          result_meta2_size);
         GEOSGeom_destroy_r(context, g);
       }
-      GEOSGeom_destroy_r(context, g2);
+      if (owned2) {
+        GEOSGeom_destroy_r(context, g2);
+      }
+    }
+    if (owned1) {
+      GEOSGeom_destroy_r(context, g1);
     }
-    GEOSGeom_destroy_r(context, g1);
   }
-  destroy_context(context);
+  release_context(context);
   return status;
 #else
   return false;
@@ -422,7 +840,7 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb_double(
   }
 
   auto status = false;
-  auto context = create_context();
+  auto context = acquire_context();
   if (!context) {
     return status;
   }
@@ -455,7 +873,7 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb_double(
     }
     GEOSGeom_destroy_r(context, g1);
   }
-  destroy_context(context);
+  release_context(context);
   return status;
 #else
   return false;
@@ -476,37 +894,45 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb(
     int32_t arg_srid,
     bool* result) {
 #ifndef __CUDACC__
-  WKB wkb1{};
-  if (!result || !toWkb(wkb1,
-                        arg_type,
-                        arg_coords,
-                        arg_coords_size,
-                        arg_meta1,
-                        arg_meta1_size,
-                        arg_meta2,
-                        arg_meta2_size,
-                        arg_ic,
-                        nullptr)) {
+  if (!result) {
     return false;
   }
+  auto cv = Geospatial::decompress_coords<double, int32_t>(
+      arg_ic, arg_coords, arg_coords_size);
+  if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kISEMPTY) {
+    // Stored geometries are never empty, only the EMPTY encoding of geos results is
+    *result = is_empty_geometry(arg_type, *cv, arg_meta1_size, arg_meta2_size);
+    return true;
+  }
 
   auto status = false;
-  auto context = create_context();
+  auto context = acquire_context();
   if (!context) {
     return status;
   }
-  auto* g1 = GEOSGeomFromWKB_buf_r(context, wkb1.data(), wkb1.size());
+  bool owned = false;
+  auto* g1 = get_geometry(context,
+                          0,
+                          arg_type,
+                          arg_coords,
+                          arg_coords_size,
+                          arg_meta1,
+                          arg_meta1_size,
+                          arg_meta2,
+                          arg_meta2_size,
+                          arg_ic,
+                          *cv,
+                          &owned);
   if (g1) {
-    if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kISEMPTY) {
-      *result = GEOSisEmpty_r(context, g1);
-      status = true;
-    } else if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kISVALID) {
+    if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kISVALID) {
       *result = GEOSisValid_r(context, g1);
       status = true;
     }
-    GEOSGeom_destroy_r(context, g1);
+    if (owned) {
+      GEOSGeom_destroy_r(context, g1);
+    }
   }
-  destroy_context(context);
+  release_context(context);
   return status;
 #else
   return false;
@@ -75,4 +75,37 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb(int op,
                                         int32_t arg_srid,
                                         bool* result);
 
+// GEOS state of the calling thread, kept by the server since the runtime functions above
+// are linked into every query module. The context and the geometries of the last
+// arguments are reused across rows and queries, and released when the thread exits.
+constexpr int32_t kGeosCachedGeometrySlots = 2;
+
+extern "C" RUNTIME_EXPORT void* Geos_getThreadContext();
+
+extern "C" RUNTIME_EXPORT void Geos_setThreadContext(
+    void* context,
+    void (*finish_context)(void*),
+    void (*destroy_geometry)(void*, void*));
+
+extern "C" RUNTIME_EXPORT void* Geos_getCachedGeometry(int32_t slot,
+                                                       int type,
+                                                       int8_t* coords,
+                                                       int64_t coords_size,
+                                                       int32_t* meta1,
+                                                       int64_t meta1_size,
+                                                       int32_t* meta2,
+                                                       int64_t meta2_size,
+                                                       int32_t ic);
+
+extern "C" RUNTIME_EXPORT void Geos_setCachedGeometry(int32_t slot,
+                                                      int type,
+                                                      int8_t* coords,
+                                                      int64_t coords_size,
+                                                      int32_t* meta1,
+                                                      int64_t meta1_size,
+                                                      int32_t* meta2,
+                                                      int64_t meta2_size,
+                                                      int32_t ic,
+                                                      void* geometry);
+
 #endif  // QUERYENGINE_RUNTIMEFUNCTIONSGEOS_H
@@ -572,6 +572,17 @@ InnerOuter normalize_column_pair(const Analyzer::Expr* lhs,
                                  const Catalog_Namespace::Catalog& cat,
                                  const TemporaryTables* temporary_tables,
                                  const bool is_overlaps_join) {
+  // Distance joins build the hash table over the buffered inner points, see
+  // rewrite_overlaps_conjunction()
+  const auto buffer_oper =
+      is_overlaps_join ? dynamic_cast<const Analyzer::GeoBinOper*>(rhs) : nullptr;
+  if (buffer_oper) {
+    if (buffer_oper->getOp() != Geospatial::GeoBase::GeoOp::kBUFFER ||
+        buffer_oper->getArgs0().size() != 1) {
+      throw HashJoinFail("Cannot use hash join for given expression");
+    }
+    rhs = buffer_oper->getArgs0().front().get();
+  }
   const auto& lhs_ti = lhs->get_type_info();
   const auto& rhs_ti = rhs->get_type_info();
   if (!is_overlaps_join) {
@@ -658,7 +669,12 @@ InnerOuter normalize_column_pair(const Analyzer::Expr* lhs,
       (lhs_cast || rhs_cast)) {
     throw HashJoinFail("Cannot use hash join for given expression");
   }
-  if (is_overlaps_join) {
+  if (is_overlaps_join && buffer_oper) {
+    if (inner_col != rhs || inner_col_real_ti.get_type() != kPOINT ||
+        outer_col_ti.get_type() != kPOINT) {
+      throw HashJoinFail("Overlaps distance join only supported between point columns");
+    }
+  } else if (is_overlaps_join) {
     if (!inner_col_real_ti.is_array()) {
       throw HashJoinFail(
           "Overlaps join only supported for inner columns with array type");
@@ -16,6 +16,10 @@
 
 #include "QueryEngine/JoinHashTable/OverlapsJoinHashTable.h"
 
+#include <cmath>
+
+#include "Geospatial/Compression.h"
+#include "Geospatial/CompressionRuntime.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExpressionRewrite.h"
@@ -24,6 +28,7 @@
 #include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinKeyHandlers.h"
 #include "QueryEngine/JoinHashTable/Runtime/JoinHashTableGpuUtils.h"
+#include "Shared/checked_alloc.h"
 
 std::unique_ptr<OverlapsHashTableCache<OverlapsHashTableCacheKey,
                                        OverlapsJoinHashTable::HashTableCacheValue>>
@@ -505,6 +510,53 @@ std::ostream& operator<<(std::ostream& os, const BucketSizeTuner& tuner) {
   return os;
 }
 
+// Radius of the sphere used by the geodesic distance runtime functions, in meters
+constexpr double kEarthRadiusInMeters = 6372797.560856;
+
+// Absorbs rounding in the bounds arithmetic so that points at exactly the join distance
+// still fall in the buffered bounds
+constexpr double kBufferedBoundsTolerance = 1e-9;
+
+// Writes the bounds (min x, min y, max x, max y) of all the points within the given
+// distance of the point (x, y). The distance is in meters for geodesic distances on
+// longitude / latitude coordinates.
+void buffered_point_bounds(double* bounds,
+                           const double x,
+                           const double y,
+                           const double distance,
+                           const bool is_geodesic) {
+  if (!is_geodesic) {
+    const double delta = distance * (1 + kBufferedBoundsTolerance) +
+                         kBufferedBoundsTolerance;
+    bounds[0] = x - delta;
+    bounds[1] = y - delta;
+    bounds[2] = x + delta;
+    bounds[3] = y + delta;
+    return;
+  }
+  // The points within the distance form a spherical cap of angular radius `angle`. Its
+  // latitudes are within `angle` of the center, and its longitudes are within
+  // asin(sin(angle) / cos(y)) if the cap does not contain a pole.
+  const double angle = distance * (1 + kBufferedBoundsTolerance) / kEarthRadiusInMeters;
+  const double lat_delta = angle * 180.0 / M_PI + kBufferedBoundsTolerance;
+  double min_x = -180.0;
+  double max_x = 180.0;
+  if (std::abs(y) + lat_delta < 90.0) {
+    const double lon_delta =
+        std::asin(std::sin(angle) / std::cos(y * M_PI / 180.0)) * 180.0 / M_PI +
+        kBufferedBoundsTolerance;
+    // Caps across the antimeridian are given the full longitude range
+    if (x - lon_delta >= -180.0 && x + lon_delta <= 180.0) {
+      min_x = x - lon_delta;
+      max_x = x + lon_delta;
+    }
+  }
+  bounds[0] = min_x;
+  bounds[1] = std::max(y - lat_delta, -90.0);
+  bounds[2] = max_x;
+  bounds[3] = std::min(y + lat_delta, 90.0);
+}
+
 }  // namespace
 
 void OverlapsJoinHashTable::reifyWithLayout(const HashType layout) {
@@ -630,7 +682,8 @@ void OverlapsJoinHashTable::reifyWithLayout(const HashType layout) {
               << overlaps_bucket_threshold;
       auto inverse_bucket_sizes = cached_bucket_threshold_opt->second;
 
-      OverlapsHashTableCacheKey hash_table_cache_key(cache_key, inverse_bucket_sizes);
+      OverlapsHashTableCacheKey hash_table_cache_key(
+          cache_key, inverse_bucket_sizes, distance_.value_or(0));
       if (auto hash_table_cache_opt =
               hash_table_cache_->getWithKey(hash_table_cache_key)) {
         // if we already have a built hash table, we can skip the scans required for
@@ -785,15 +838,25 @@ ColumnsForDevice OverlapsJoinHashTable::fetchColumnsForDevice(
     if (inner_cd && inner_cd->isVirtualCol) {
       throw FailedToJoinOnVirtualColumn();
     }
-    join_columns.emplace_back(fetchJoinColumn(inner_col,
-                                              fragments,
-                                              effective_memory_level,
-                                              device_id,
-                                              chunks_owner,
-                                              dev_buff_owner,
-                                              malloc_owner,
-                                              executor_,
-                                              &column_cache_));
+    if (distance_) {
+      join_columns.emplace_back(fetchBufferedPointsColumn(points_col_,
+                                                          fragments,
+                                                          effective_memory_level,
+                                                          device_id,
+                                                          chunks_owner,
+                                                          dev_buff_owner,
+                                                          malloc_owner));
+    } else {
+      join_columns.emplace_back(fetchJoinColumn(inner_col,
+                                                fragments,
+                                                effective_memory_level,
+                                                device_id,
+                                                chunks_owner,
+                                                dev_buff_owner,
+                                                malloc_owner,
+                                                executor_,
+                                                &column_cache_));
+    }
     const auto& ti = inner_col->get_type_info();
     join_column_types.emplace_back(JoinColumnTypeInfo{static_cast<size_t>(ti.get_size()),
                                                       0,
@@ -807,6 +870,122 @@ ColumnsForDevice OverlapsJoinHashTable::fetchColumnsForDevice(
   return {join_columns, join_column_types, chunks_owner, {}, malloc_owner};
 }
 
+void OverlapsJoinHashTable::initDistanceJoin() {
+  const auto buffer_oper =
+      dynamic_cast<const Analyzer::GeoBinOper*>(condition_->get_right_operand());
+  if (!buffer_oper) {
+    return;
+  }
+  CHECK(buffer_oper->getOp() == Geospatial::GeoBase::GeoOp::kBUFFER);
+  CHECK_EQ(buffer_oper->getArgs1().size(), size_t(1));
+  const auto distance =
+      dynamic_cast<const Analyzer::Constant*>(buffer_oper->getArgs1().front().get());
+  CHECK(distance && distance->get_type_info().get_type() == kDOUBLE);
+  CHECK_EQ(inner_outer_pairs_.size(), size_t(1));
+  points_col_ = inner_outer_pairs_.front().first;
+  CHECK_EQ(points_col_->get_type_info().get_type(), kPOINT);
+  distance_ = distance->get_constval().doubleval;
+  is_geodesic_distance_ = points_col_->get_type_info().get_subtype() == kGEOGRAPHY;
+  // The buffered points have the layout of a bounds column, which lets the bucket
+  // computations and key handlers of bounds joins work on them unchanged
+  SQLTypeInfo bounds_ti(kARRAY, false);
+  bounds_ti.set_subtype(kDOUBLE);
+  bounds_ti.set_size(4 * sizeof(double));
+  buffered_points_col_ =
+      std::make_shared<Analyzer::ColumnVar>(bounds_ti,
+                                            points_col_->get_table_id(),
+                                            points_col_->get_column_id(),
+                                            points_col_->get_rte_idx());
+  inner_outer_pairs_.front().first = buffered_points_col_.get();
+  VLOG(1) << "Overlaps distance join over " << points_col_->toString()
+          << " with distance " << *distance_;
+}
+
+JoinColumn OverlapsJoinHashTable::fetchBufferedPointsColumn(
+    const Analyzer::ColumnVar* points_col,
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
+    const Data_Namespace::MemoryLevel effective_memory_level,
+    const int device_id,
+    std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner,
+    DeviceAllocator* dev_buff_owner,
+    std::vector<std::shared_ptr<void>>& malloc_owner) {
+  CHECK(distance_);
+  const auto& catalog = *executor_->getCatalog();
+  const auto points_cd = get_column_descriptor(
+      points_col->get_column_id(), points_col->get_table_id(), catalog);
+  const auto& points_ti = points_cd->columnType;
+  // The coords are stored in the physical column following the logical point column
+  const auto coords_cd = get_column_descriptor(
+      points_col->get_column_id() + 1, points_col->get_table_id(), catalog);
+  Analyzer::ColumnVar coords_col(coords_cd->columnType,
+                                 coords_cd->tableId,
+                                 coords_cd->columnId,
+                                 points_col->get_rte_idx());
+  // The points are buffered on the CPU
+  const auto coords_column = fetchJoinColumn(&coords_col,
+                                             fragments,
+                                             Data_Namespace::CPU_LEVEL,
+                                             device_id,
+                                             chunks_owner,
+                                             dev_buff_owner,
+                                             malloc_owner,
+                                             executor_,
+                                             &column_cache_);
+
+  constexpr size_t bounds_size = 4 * sizeof(double);
+  const size_t buffer_size = std::max(coords_column.num_elems, size_t(1)) * bounds_size;
+  auto bounds_buff = reinterpret_cast<double*>(
+      malloc_owner.emplace_back(checked_malloc(buffer_size), free).get());
+  const bool is_compressed = points_ti.get_compression() == kENCODING_GEOINT;
+  const auto coords_chunks =
+      reinterpret_cast<const JoinChunk*>(coords_column.col_chunks_buff);
+  size_t row = 0;
+  for (size_t chunk_idx = 0; chunk_idx < coords_column.num_chunks; ++chunk_idx) {
+    const auto& chunk = coords_chunks[chunk_idx];
+    for (size_t i = 0; i < chunk.num_elems; ++i, ++row) {
+      const auto coords = chunk.col_buff + i * coords_column.elem_sz;
+      auto bounds = bounds_buff + 4 * row;
+      if (Geospatial::is_null_point(points_ti, coords, coords_column.elem_sz)) {
+        // An empty box does not emit any key
+        bounds[0] = bounds[1] = 1;
+        bounds[2] = bounds[3] = -1;
+        continue;
+      }
+      double x, y;
+      if (is_compressed) {
+        const auto compressed_coords = reinterpret_cast<const int32_t*>(coords);
+        x = Geospatial::decompress_longitude_coord_geoint32(compressed_coords[0]);
+        y = Geospatial::decompress_lattitude_coord_geoint32(compressed_coords[1]);
+      } else {
+        const auto double_coords = reinterpret_cast<const double*>(coords);
+        x = double_coords[0];
+        y = double_coords[1];
+      }
+      buffered_point_bounds(bounds, x, y, *distance_, is_geodesic_distance_);
+    }
+  }
+  CHECK_EQ(row, coords_column.num_elems);
+
+  JoinChunk bounds_chunk{reinterpret_cast<const int8_t*>(bounds_buff), row};
+  if (effective_memory_level == Data_Namespace::GPU_LEVEL) {
+    CHECK(dev_buff_owner);
+    auto device_bounds_buff = dev_buff_owner->alloc(buffer_size);
+    dev_buff_owner->copyToDevice(
+        device_bounds_buff, reinterpret_cast<const int8_t*>(bounds_buff), buffer_size);
+    bounds_chunk.col_buff = device_bounds_buff;
+  }
+  auto chunks_buff = reinterpret_cast<int8_t*>(
+      malloc_owner.emplace_back(checked_malloc(sizeof(JoinChunk)), free).get());
+  memcpy(chunks_buff, &bounds_chunk, sizeof(JoinChunk));
+  JoinColumn bounds_column{chunks_buff, sizeof(JoinChunk), 1, row, bounds_size};
+  if (effective_memory_level == Data_Namespace::GPU_LEVEL) {
+    auto device_chunks_buff = dev_buff_owner->alloc(sizeof(JoinChunk));
+    dev_buff_owner->copyToDevice(device_chunks_buff, chunks_buff, sizeof(JoinChunk));
+    bounds_column.col_chunks_buff = device_chunks_buff;
+  }
+  return bounds_column;
+}
+
 std::pair<size_t, size_t> OverlapsJoinHashTable::computeHashTableCounts(
     const size_t shard_count,
     const std::vector<double>& inverse_bucket_sizes_for_dimension,
@@ -862,7 +1041,8 @@ std::pair<size_t, size_t> OverlapsJoinHashTable::approximateTupleCount(
         columns_per_device.front().join_columns.front().num_elems,
         composite_key_info.cache_key_chunks,
         condition_->get_optype(),
-        inverse_bucket_sizes_for_dimension};
+        inverse_bucket_sizes_for_dimension,
+        distance_.value_or(0)};
     const auto cached_count_info = getApproximateTupleCountFromCache(cache_key);
     if (cached_count_info) {
       VLOG(1) << "Using a cached tuple count: " << cached_count_info->first
@@ -1137,7 +1317,8 @@ std::shared_ptr<BaselineHashTable> OverlapsJoinHashTable::initHashTableOnCpu(
   OverlapsHashTableCacheKey cache_key{join_columns.front().num_elems,
                                       composite_key_info.cache_key_chunks,
                                       condition_->get_optype(),
-                                      inverse_bucket_sizes_for_dimension_};
+                                      inverse_bucket_sizes_for_dimension_,
+                                      distance_.value_or(0)};
 
   std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
   if (auto generic_hash_table = initHashTableOnCpuFromCache(cache_key)) {
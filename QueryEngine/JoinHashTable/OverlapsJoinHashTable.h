@@ -26,6 +26,8 @@ struct OverlapsHashTableCacheKey {
   const std::vector<ChunkKey> chunk_keys;
   const SQLOps optype;
   const std::vector<double> inverse_bucket_sizes;
+  // Radius the inner points are grown by for distance joins, 0 otherwise
+  const double distance;
 
   bool operator==(const struct OverlapsHashTableCacheKey& that) const {
     if (inverse_bucket_sizes.size() != that.inverse_bucket_sizes.size()) {
@@ -38,25 +40,29 @@ struct OverlapsHashTableCacheKey {
       }
     }
     return num_elements == that.num_elements && chunk_keys == that.chunk_keys &&
-           optype == that.optype;
+           optype == that.optype && distance == that.distance;
   }
 
   OverlapsHashTableCacheKey(const size_t num_elements,
                             const std::vector<ChunkKey>& chunk_keys,
                             const SQLOps& optype,
-                            const std::vector<double> inverse_bucket_sizes)
+                            const std::vector<double> inverse_bucket_sizes,
+                            const double distance = 0)
       : num_elements(num_elements)
       , chunk_keys(chunk_keys)
       , optype(optype)
-      , inverse_bucket_sizes(inverse_bucket_sizes) {}
+      , inverse_bucket_sizes(inverse_bucket_sizes)
+      , distance(distance) {}
 
   // "copy" constructor
   OverlapsHashTableCacheKey(const HashTableCacheKey& that,
-                            const std::vector<double>& inverse_bucket_sizes)
+                            const std::vector<double>& inverse_bucket_sizes,
+                            const double distance = 0)
       : num_elements(that.num_elements)
       , chunk_keys(that.chunk_keys)
       , optype(that.optype)
-      , inverse_bucket_sizes(inverse_bucket_sizes) {}
+      , inverse_bucket_sizes(inverse_bucket_sizes)
+      , distance(distance) {}
 };
 
 template <class K, class V>
@@ -92,6 +98,7 @@ class OverlapsJoinHashTable : public HashJoin {
     CHECK_GT(device_count_, 0);
     hash_tables_for_device_.resize(std::max(device_count_, 1));
     query_hint_ = QueryHint::defaults();
+    initDistanceJoin();
   }
 
   virtual ~OverlapsJoinHashTable() {}
@@ -311,6 +318,19 @@ class OverlapsJoinHashTable : public HashJoin {
   void putHashTableOnCpuToCache(const OverlapsHashTableCacheKey& key,
                                 std::shared_ptr<HashTable> hash_table);
 
+  // Sets up a distance join, i.e. an overlaps condition against ST_Buffer(inner points,
+  // distance). The hash table is then built over the bounds of the buffered points.
+  void initDistanceJoin();
+
+  JoinColumn fetchBufferedPointsColumn(
+      const Analyzer::ColumnVar* points_col,
+      const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments,
+      const Data_Namespace::MemoryLevel effective_memory_level,
+      const int device_id,
+      std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner,
+      DeviceAllocator* dev_buff_owner,
+      std::vector<std::shared_ptr<void>>& malloc_owner);
+
   llvm::Value* codegenKey(const CompilationOptions&);
   std::vector<llvm::Value*> codegenManyKey(const CompilationOptions&);
 
@@ -324,6 +344,14 @@ class OverlapsJoinHashTable : public HashJoin {
   std::vector<InnerOuter> inner_outer_pairs_;
   const int device_count_;
 
+  // Set for distance joins, in meters for geographies
+  std::optional<double> distance_;
+  bool is_geodesic_distance_{false};
+  // Bounds of the buffered inner points, replaces the points column in
+  // inner_outer_pairs_ for distance joins
+  std::shared_ptr<Analyzer::ColumnVar> buffered_points_col_;
+  const Analyzer::ColumnVar* points_col_{nullptr};
+
   std::vector<double> inverse_bucket_sizes_for_dimension_;
 
   std::optional<HashType>
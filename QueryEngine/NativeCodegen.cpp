@@ -21,11 +21,14 @@
 #include "LLVMFunctionAttributesUtil.h"
 #include "OutputBufferInitialization.h"
 #include "QueryTemplateGenerator.h"
+#include "ScalarExprVisitor.h"
 
 #include "CudaMgr/CudaMgr.h"
 #include "OSDependent/omnisci_path.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
+#include "Shared/Metrics.h"
+#include "Shared/SamplingProfiler.h"
 #include "StreamingTopN.h"
 
 #if LLVM_VERSION_MAJOR < 9
@@ -34,6 +37,7 @@ static_assert(false, "LLVM Version >= 9 is required.");
 
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/ExecutionEngine/JITEventListener.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/GlobalValue.h>
@@ -44,6 +48,7 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Linker/Linker.h>
+#include <llvm/Object/SymbolSize.h>
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/FormattedStream.h>
@@ -327,6 +332,44 @@ void optimize_ir(llvm::Function* query_func,
 }
 #endif
 
+// Publishes the address ranges of generated functions to the sampling profiler, so
+// samples taken in JIT code are attributed to the query function instead of a bare pc.
+class ProfilerJITEventListener : public llvm::JITEventListener {
+ public:
+  void notifyObjectLoaded(ObjectKey key,
+                          const llvm::object::ObjectFile& obj,
+                          const llvm::RuntimeDyld::LoadedObjectInfo& info) override {
+    // the debug object has its section addresses set to the load addresses
+    const auto debug_obj = info.getObjectForDebug(obj);
+    const auto& loaded_obj = debug_obj.getBinary() ? *debug_obj.getBinary() : obj;
+    for (const auto& [symbol, size] : llvm::object::computeSymbolSizes(loaded_obj)) {
+      auto type = symbol.getType();
+      if (!type) {
+        llvm::consumeError(type.takeError());
+        continue;
+      }
+      if (*type != llvm::object::SymbolRef::ST_Function) {
+        continue;
+      }
+      auto name = symbol.getName();
+      auto address = symbol.getAddress();
+      if (!name || !address) {
+        llvm::consumeError(name.takeError());
+        llvm::consumeError(address.takeError());
+        continue;
+      }
+      profiler::register_jit_function(key, *address, size, name->str());
+    }
+  }
+
+  void notifyFreeingObject(ObjectKey key) override {
+    profiler::unregister_jit_object(key);
+  }
+};
+
+// Stateless, shared by all execution engines so it outlives every one of them.
+ProfilerJITEventListener profiler_jit_listener;
+
 }  // namespace
 
 ExecutionEngineWrapper::ExecutionEngineWrapper() {}
@@ -349,6 +392,9 @@ ExecutionEngineWrapper::ExecutionEngineWrapper(llvm::ExecutionEngine* execution_
                       "listener configuration parameter.";
 #endif  // ENABLE_INTEL_JIT_LISTENER
     }
+    if (profiler::SamplingProfiler::isRunning()) {
+      execution_engine_->RegisterJITEventListener(&profiler_jit_listener);
+    }
   }
 }
 
@@ -373,7 +419,20 @@ void verify_function_ir(const llvm::Function* func) {
 
 std::shared_ptr<CompilationContext> Executor::getCodeFromCache(const CodeCacheKey& key,
                                                                const CodeCache& cache) {
+  static auto& registry = metrics::Registry::instance();
+  static auto& cpu_hits = registry.counter(
+      "omnisci_code_cache_hits_total", "Code cache hits.", {{"device", "cpu"}});
+  static auto& gpu_hits = registry.counter(
+      "omnisci_code_cache_hits_total", "Code cache hits.", {{"device", "gpu"}});
+  static auto& cpu_misses = registry.counter(
+      "omnisci_code_cache_misses_total", "Code cache misses.", {{"device", "cpu"}});
+  static auto& gpu_misses = registry.counter(
+      "omnisci_code_cache_misses_total", "Code cache misses.", {{"device", "gpu"}});
+  const bool is_cpu_cache = &cache == &cpu_code_cache_;
   auto it = cache.find(key);
+  (it != cache.cend() ? (is_cpu_cache ? cpu_hits : gpu_hits)
+                      : (is_cpu_cache ? cpu_misses : gpu_misses))
+      .increment();
   if (it != cache.cend()) {
     delete cgen_state_->module_;
     cgen_state_->module_ = it->second.second;
@@ -431,6 +490,15 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
   llvm::InitializeNativeTargetAsmPrinter();
   llvm::InitializeNativeTargetAsmParser();
 
+  if (profiler::SamplingProfiler::isRunning()) {
+    // lets the profiler walk the stack through the generated functions
+    for (auto& function : *module) {
+      if (!function.isDeclaration()) {
+        function.addFnAttr("frame-pointer", "all");
+      }
+    }
+  }
+
   std::string err_str;
   std::unique_ptr<llvm::Module> owner(module);
   llvm::EngineBuilder eb(std::move(owner));
@@ -500,6 +568,12 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
   auto cpu_compilation_context =
       std::make_shared<CpuCompilationContext>(std::move(execution_engine));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+  if (profiler::SamplingProfiler::isRunning()) {
+    std::ostringstream cache_key_hash;
+    cache_key_hash << std::hex << boost::hash<CodeCacheKey>()(key);
+    profiler::label_jit_object(cpu_compilation_context->func(),
+                               "cpu_code_cache:" + cache_key_hash.str());
+  }
   addCodeToCache(key, cpu_compilation_context, module, cpu_code_cache_);
   return cpu_compilation_context;
 }
@@ -2462,6 +2536,39 @@ std::string serialize_llvm_metadata_footnotes(llvm::Function* query_func,
 }
 #endif  // NDEBUG
 
+class UdfCallVisitor : public ScalarExprVisitor<bool> {
+ protected:
+  bool visitFunctionOper(const Analyzer::FunctionOper* func_oper) const override {
+    if (ExtensionFunctionsWhitelist::get_udf(func_oper->getName())) {
+      return true;
+    }
+    return ScalarExprVisitor::visitFunctionOper(func_oper);
+  }
+
+  bool aggregateResult(const bool& aggregate, const bool& next_result) const override {
+    return aggregate || next_result;
+  }
+};
+
+// Returns true iff the execution unit calls a function of the UDF module compiled at
+// server start. The module is linked into the queries which do only.
+bool calls_udf(const RelAlgExecutionUnit& ra_exe_unit) {
+  UdfCallVisitor visitor;
+  const auto calls_udf_in = [&visitor](const auto& exprs) {
+    return std::any_of(exprs.begin(), exprs.end(), [&visitor](const auto& expr) {
+      return expr && visitor.visit(&*expr);
+    });
+  };
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    if (calls_udf_in(join_condition.quals)) {
+      return true;
+    }
+  }
+  return calls_udf_in(ra_exe_unit.simple_quals) || calls_udf_in(ra_exe_unit.quals) ||
+         calls_udf_in(ra_exe_unit.groupby_exprs) ||
+         calls_udf_in(ra_exe_unit.target_exprs);
+}
+
 }  // namespace
 
 std::tuple<CompilationResult, std::unique_ptr<QueryMemoryDescriptor>>
@@ -2569,8 +2676,9 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
                 func->getLinkage() == llvm::GlobalValue::LinkageTypes::InternalLinkage ||
                 CodeGenerator::alwaysCloneRuntimeFunction(func));
       });
+  const bool udf_module_needed = calls_udf(ra_exe_unit);
   if (co.device_type == ExecutorDeviceType::CPU) {
-    if (is_udf_module_present(true)) {
+    if (udf_module_needed && is_udf_module_present(true)) {
       CodeGenerator::link_udf_module(udf_cpu_module, *rt_module_copy, cgen_state_.get());
     }
     if (is_rt_udf_module_present(true)) {
@@ -2580,7 +2688,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
   } else {
     rt_module_copy->setDataLayout(get_gpu_data_layout());
     rt_module_copy->setTargetTriple(get_gpu_target_triple_string());
-    if (is_udf_module_present()) {
+    if (udf_module_needed && is_udf_module_present()) {
       CodeGenerator::link_udf_module(udf_gpu_module, *rt_module_copy, cgen_state_.get());
     }
     if (is_rt_udf_module_present()) {
@@ -25,10 +25,19 @@
 
 #define EXTENSION_INLINE extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE
 #define EXTENSION_NOINLINE extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE
+#define EXTENSION_NOINLINE_HOST extern "C" RUNTIME_EXPORT NEVER_INLINE HOST
 
 EXTENSION_NOINLINE int8_t* allocate_varlen_buffer(int64_t element_count,
                                                   int64_t element_size);
 
+/*
+  Allocates the output columns of a table function sized by
+  TableFunctionSpecifiedParameter with the given number of rows. Must
+  be called exactly once by the table function, before writing to its
+  output columns.
+*/
+EXTENSION_NOINLINE_HOST void set_output_row_size(int64_t num_rows);
+
 template <typename T>
 struct Array {
   T* ptr;
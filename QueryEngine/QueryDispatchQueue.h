@@ -16,12 +16,15 @@
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <future>
 #include <mutex>
 #include <queue>
 #include <thread>
 
+#include "Shared/Metrics.h"
+
 /**
  * QueryDispatchQueue maintains a list of pending queries and dispatches those queries as
  * Executors become available
@@ -30,7 +33,13 @@ class QueryDispatchQueue {
  public:
   using Task = std::packaged_task<void(size_t)>;
 
-  QueryDispatchQueue(const size_t parallel_executors_max) {
+  QueryDispatchQueue(const size_t parallel_executors_max)
+      : queue_depth_(metrics::Registry::instance().gauge(
+            "omnisci_dispatch_queue_depth",
+            "Queries waiting in the dispatch queue for an executor."))
+      , queue_wait_seconds_(metrics::Registry::instance().histogram(
+            "omnisci_dispatch_queue_wait_seconds",
+            "Time queries spent in the dispatch queue before running.")) {
     workers_.resize(parallel_executors_max);
     for (size_t i = 0; i < workers_.size(); i++) {
       // worker IDs are 1-indexed, leaving Executor 0 for non-dispatch queue worker tasks
@@ -59,7 +68,8 @@ class QueryDispatchQueue {
     std::unique_lock<decltype(queue_mutex_)> lock(queue_mutex_);
 
     LOG(INFO) << "Dispatching query with " << queue_.size() << " queries in the queue.";
-    queue_.push(task);
+    queue_.push({task, std::chrono::steady_clock::now()});
+    queue_depth_.add(1);
     lock.unlock();
     cv_.notify_all();
   }
@@ -86,8 +96,10 @@ class QueryDispatchQueue {
       }
 
       if (!queue_.empty()) {
-        auto task = queue_.front();
+        auto [task, enqueue_time] = queue_.front();
         queue_.pop();
+        queue_depth_.sub(1);
+        queue_wait_seconds_.observeSince(enqueue_time);
 
         LOG(INFO) << "Worker " << worker_idx
                   << " running query and returning control. There are now "
@@ -107,7 +119,15 @@ class QueryDispatchQueue {
 
   std::mutex update_delete_mutex_;
 
+  struct QueuedTask {
+    std::shared_ptr<Task> task;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
   bool threads_should_exit_{false};
-  std::queue<std::shared_ptr<Task>> queue_;
+  std::queue<QueuedTask> queue_;
   std::vector<std::thread> workers_;
+
+  metrics::Gauge& queue_depth_;
+  metrics::Histogram& queue_wait_seconds_;
 };
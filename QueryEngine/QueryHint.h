@@ -37,6 +37,7 @@ struct QueryHint {
     overlaps_bucket_threshold = other.overlaps_bucket_threshold;
     overlaps_max_size = other.overlaps_max_size;
     overlaps_allow_gpu_build = other.overlaps_allow_gpu_build;
+    disk_cache_bypass = other.disk_cache_bypass;
     registered_hint = other.registered_hint;
     return *this;
   }
@@ -46,6 +47,7 @@ struct QueryHint {
     overlaps_bucket_threshold = other.overlaps_bucket_threshold;
     overlaps_max_size = other.overlaps_max_size;
     overlaps_allow_gpu_build = other.overlaps_allow_gpu_build;
+    disk_cache_bypass = other.disk_cache_bypass;
     registered_hint = other.registered_hint;
   }
 
@@ -57,11 +59,15 @@ struct QueryHint {
   size_t overlaps_max_size;
   bool overlaps_allow_gpu_build;
 
+  // foreign table scans
+  bool disk_cache_bypass;
+
   std::unordered_map<std::string, size_t> OMNISCI_SUPPORTED_HINT_CLASS = {
       {"cpu_mode", 0},
       {"overlaps_bucket_threshold", 1},
       {"overlaps_max_size", 2},
-      {"overlaps_allow_gpu_build", 3}};
+      {"overlaps_allow_gpu_build", 3},
+      {"disk_cache_bypass", 4}};
 
   std::vector<bool> registered_hint;
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryProfile.h"
+
+#include <boost/core/demangle.hpp>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/RelAlgDagBuilder.h"
+
+ExecutionStepCounters& QueryProfile::beginStep(const RelAlgNode* node) {
+  CHECK(node);
+  StepProfile step;
+  step.node_id = node->getId();
+  step.node_type = boost::core::demangle(typeid(*node).name());
+  step.node_desc = node->toString();
+  for (size_t i = 0; i < node->inputCount(); ++i) {
+    step.input_ids.push_back(node->getInput(i)->getId());
+  }
+  step.counters = std::make_unique<ExecutionStepCounters>();
+  steps_.emplace_back(std::move(step));
+  return *steps_.back().counters;
+}
+
+void QueryProfile::endStep(const int64_t total_ms, const size_t rows_out) {
+  CHECK(!steps_.empty());
+  auto& step = steps_.back();
+  step.total_ms = total_ms;
+  step.rows_out = rows_out;
+}
+
+namespace {
+
+template <typename WRITER>
+void write_bytes_moved(WRITER& writer,
+                       const char* level,
+                       const size_t bytes_fetched,
+                       const size_t bytes_moved) {
+  writer.Key(level);
+  writer.StartObject();
+  writer.Key("fetched");
+  writer.Uint64(bytes_fetched);
+  writer.Key("moved");
+  writer.Uint64(bytes_moved);
+  writer.EndObject();
+}
+
+}  // namespace
+
+std::string QueryProfile::toJson() const {
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("total_ms");
+  writer.Int64(total_ms_);
+  writer.Key("steps");
+  writer.StartArray();
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    const auto& step = steps_[i];
+    const auto& counters = *step.counters;
+    writer.StartObject();
+    writer.Key("step");
+    writer.Uint64(i);
+    writer.Key("node_id");
+    writer.Uint(step.node_id);
+    writer.Key("node");
+    writer.String(step.node_type.c_str());
+    writer.Key("inputs");
+    writer.StartArray();
+    for (const auto input_id : step.input_ids) {
+      writer.Uint(input_id);
+    }
+    writer.EndArray();
+    writer.Key("description");
+    writer.String(step.node_desc.c_str());
+    writer.Key("total_ms");
+    writer.Int64(step.total_ms);
+    writer.Key("preflight_count_ms");
+    writer.Int64(counters.preflight_count_ms);
+    writer.Key("codegen_ms");
+    writer.Int64(counters.codegen_ms);
+    writer.Key("fetch_ms");
+    writer.Int64(counters.fetch_ms);
+    writer.Key("kernel_ms");
+    writer.Int64(counters.kernel_ms);
+    writer.Key("reduction_ms");
+    writer.Int64(counters.reduction_ms);
+    writer.Key("kernels");
+    writer.Uint64(counters.kernel_count);
+    writer.Key("rows_in");
+    writer.Uint64(counters.rows_in);
+    writer.Key("rows_out");
+    writer.Uint64(step.rows_out);
+    writer.Key("fragments");
+    writer.StartObject();
+    writer.Key("total");
+    writer.Uint64(counters.fragments_total);
+    writer.Key("skipped");
+    writer.Uint64(counters.fragments_skipped);
+    writer.EndObject();
+    writer.Key("bytes");
+    writer.StartObject();
+    write_bytes_moved(writer, "cpu", counters.cpu_bytes_fetched, counters.cpu_bytes_moved);
+    write_bytes_moved(writer, "gpu", counters.gpu_bytes_fetched, counters.gpu_bytes_moved);
+    writer.EndObject();
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return buffer.GetString();
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DataMgr/MemoryLevel.h"
+
+class RelAlgNode;
+
+/**
+ * Counters for a single step of the execution sequence, filled in by the executor while
+ * a query runs under EXPLAIN ANALYZE. Execution kernels update them concurrently, so the
+ * fetch and kernel times are summed over all kernels of the step. Work done by the
+ * pre-flight filtered count of a projection only shows up in preflight_count_ms.
+ */
+struct ExecutionStepCounters {
+  std::atomic<int64_t> preflight_count_ms{0};
+  std::atomic<int64_t> codegen_ms{0};
+  std::atomic<int64_t> fetch_ms{0};
+  std::atomic<int64_t> kernel_ms{0};
+  std::atomic<int64_t> reduction_ms{0};
+  std::atomic<size_t> kernel_count{0};
+  std::atomic<size_t> fragments_total{0};
+  std::atomic<size_t> fragments_skipped{0};
+  std::atomic<size_t> rows_in{0};
+  // Bytes of input chunks read at the CPU and GPU memory levels, and the part of those
+  // which was not resident at that level and had to be moved in from the level below.
+  std::atomic<size_t> cpu_bytes_fetched{0};
+  std::atomic<size_t> cpu_bytes_moved{0};
+  std::atomic<size_t> gpu_bytes_fetched{0};
+  std::atomic<size_t> gpu_bytes_moved{0};
+
+  void addFetchedBytes(const Data_Namespace::MemoryLevel memory_level,
+                       const size_t num_bytes,
+                       const bool was_resident) {
+    if (memory_level == Data_Namespace::GPU_LEVEL) {
+      gpu_bytes_fetched += num_bytes;
+      gpu_bytes_moved += was_resident ? 0 : num_bytes;
+    } else {
+      cpu_bytes_fetched += num_bytes;
+      cpu_bytes_moved += was_resident ? 0 : num_bytes;
+    }
+  }
+};
+
+/**
+ * Operator level profile of a query, one entry per executed node of the relational
+ * algebra DAG. Produced by RelAlgExecutor when profiling is enabled and serialized to
+ * JSON as the result of EXPLAIN ANALYZE.
+ */
+class QueryProfile {
+ public:
+  /**
+   * Starts a new step for the given node. The returned counters stay valid for the
+   * lifetime of the profile.
+   */
+  ExecutionStepCounters& beginStep(const RelAlgNode* node);
+
+  void endStep(const int64_t total_ms, const size_t rows_out);
+
+  void setTotalTime(const int64_t total_ms) { total_ms_ = total_ms; }
+
+  std::string toJson() const;
+
+ private:
+  struct StepProfile {
+    unsigned node_id;
+    std::string node_type;
+    std::string node_desc;
+    std::vector<unsigned> input_ids;
+    int64_t total_ms{0};
+    size_t rows_out{0};
+    std::unique_ptr<ExecutionStepCounters> counters;
+  };
+
+  std::vector<StepProfile> steps_;
+  int64_t total_ms_{0};
+};
@@ -1900,6 +1900,12 @@ class RelAlgDagBuilder : public boost::noncopyable {
             VLOG(1) << "Allowing GPU hash table build for overlaps join.";
             break;
           }
+          case 4: {  // disk_cache_bypass
+            query_hint_.registerHint(kv.first);
+            query_hint_.disk_cache_bypass = true;
+            VLOG(1) << "Reading foreign tables of the query without disk caching.";
+            break;
+          }
           default:
             break;
         }
@@ -16,6 +16,7 @@
 
 #include "RelAlgExecutor.h"
 #include "DataMgr/ForeignStorage/ForeignStorageException.h"
+#include "DataMgr/ForeignStorage/ForeignStorageMgr.h"
 #include "DataMgr/ForeignStorage/MetadataPlaceholder.h"
 #include "Parser/ParserNode.h"
 #include "QueryEngine/CalciteDeserializerUtils.h"
@@ -33,7 +34,9 @@
 #include "QueryEngine/RelAlgTranslator.h"
 #include "QueryEngine/ResultSetBuilder.h"
 #include "QueryEngine/RexVisitor.h"
+#include "QueryEngine/TableOptimizer.h"
 #include "QueryEngine/WindowContext.h"
+#include "Shared/SamplingProfiler.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/measure.h"
 #include "Shared/misc.h"
@@ -43,6 +46,7 @@
 #include <boost/range/adaptor/reversed.hpp>
 
 #include <algorithm>
+#include <exception>
 #include <functional>
 #include <numeric>
 
@@ -51,6 +55,7 @@ bool g_enable_interop{false};
 bool g_enable_union{false};
 
 extern bool g_enable_bump_allocator;
+extern bool g_enable_auto_vacuum;
 
 namespace {
 
@@ -238,10 +243,24 @@ ExecutionResult RelAlgExecutor::executeRelAlgQuery(const CompilationOptions& co,
   CHECK(query_dag_);
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(executeRelAlgQuery);
+  // covers the entry points which do not tag their query, e.g. rendering and leaf
+  // execution in distributed mode
+  std::optional<profiler::ExecutionScope> profiler_execution_scope;
+  if (query_state_) {
+    profiler_execution_scope.emplace(query_state_->getId());
+  }
 
   auto run_query = [&](const CompilationOptions& co_in) {
+    auto clock_begin = timer_start();
+    if (query_profile_) {
+      // a retry on CPU starts the profile over
+      query_profile_ = std::make_unique<QueryProfile>();
+    }
     auto execution_result =
         executeRelAlgQueryNoRetry(co_in, eo, just_explain_plan, render_info);
+    if (query_profile_) {
+      query_profile_->setTotalTime(timer_stop(clock_begin));
+    }
     if (post_execution_callback_) {
       VLOG(1) << "Running post execution callback.";
       (*post_execution_callback_)();
@@ -377,6 +396,9 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
 
   // Notify foreign tables to load prior to caching
   prepare_foreign_table_for_execution(ra, cat_);
+  // covers fetches on this thread, kernels set the hint again where they fetch chunks
+  foreign_storage::DiskCacheBypassScope disk_cache_bypass_scope(
+      query_dag_ && query_dag_->getQueryHints().isHintRegistered("disk_cache_bypass"));
 
   int64_t queue_time_ms = timer_stop(clock_begin);
   ScopeGuard row_set_holder = [this] { cleanupPostExecution(); };
@@ -681,6 +703,22 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
     handleNop(exec_desc);
     return;
   }
+  ExecutionStepCounters* step_counters{nullptr};
+  auto step_clock_begin = timer_start();
+  if (query_profile_) {
+    step_counters = &query_profile_->beginStep(body);
+    executor_->execution_step_counters_ = step_counters;
+  }
+  ScopeGuard end_step_profile = [this, &exec_desc, step_counters, step_clock_begin] {
+    if (step_counters) {
+      executor_->execution_step_counters_ = nullptr;
+      if (std::uncaught_exceptions() == 0) {
+        const auto& rows = exec_desc.getResult().getRows();
+        query_profile_->endStep(timer_stop(step_clock_begin),
+                                rows ? rows->rowCount() : 0);
+      }
+    }
+  };
   const ExecutionOptions eo_work_unit{
       eo.output_columnar_hint,
       eo.allow_multifrag,
@@ -702,6 +740,8 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
 
   // Notify foreign tables to load prior to execution
   prepare_foreign_table_for_execution(*body, cat_);
+  foreign_storage::DiskCacheBypassScope disk_cache_bypass_scope(
+      query_dag_ && query_dag_->getQueryHints().isHintRegistered("disk_cache_bypass"));
 
   const auto compound = dynamic_cast<const RelCompound*>(body);
   if (compound) {
@@ -1475,6 +1515,47 @@ std::vector<TargetMetaInfo> get_targets_meta(
   return {};
 }
 
+// Write locks the fragments of the table changed by an update or delete until the
+// transaction is finalized. Fragments whose scan found no row to change are unlocked
+// right away, so that statements changing disjoint fragments run concurrently. Varlen
+// updates append the new rows to the last fragments, hence they lock all fragments.
+UpdateLogForFragment::FragmentLocker make_dml_fragment_locker(
+    StorageIOFacility::TransactionParameters& dml_params,
+    const Catalog_Namespace::Catalog& cat,
+    const InputTableInfo& outer_table_info,
+    const bool is_varlen_update) {
+  const auto db_id = cat.getDatabaseId();
+  if (is_varlen_update) {
+    for (const auto& fragment : outer_table_info.info.fragments) {
+      dml_params.lockFragment(db_id, fragment);
+    }
+    return {};
+  }
+  return {[&dml_params, db_id](const Fragmenter_Namespace::FragmentInfo& fragment) {
+            dml_params.lockFragment(db_id, fragment);
+          },
+          [&dml_params, db_id](const Fragmenter_Namespace::FragmentInfo& fragment) {
+            dml_params.unlockFragment(db_id, fragment);
+          }};
+}
+
+// Makes the rows changed by an update or delete visible to other queries, then narrows
+// the metadata of the updated chunks, which is computed from the published data.
+// Queries reading the table while the update ran may have cached results computed from
+// the previous data, hence the caches are invalidated again.
+void publish_dml_changes(StorageIOFacility::TransactionParameters& dml_params,
+                         Executor* executor,
+                         const Catalog_Namespace::Catalog& cat,
+                         const ColumnToFragmentsMap& optimize_candidates) {
+  dml_params.lockTableCheckpoint(cat.getDatabaseId());
+  dml_params.getTransactionTracker().publishUpdate();
+  UpdateTriggeredCacheInvalidator::invalidateCaches();
+  if (g_enable_auto_metadata_update) {
+    TableOptimizer table_optimizer{dml_params.getTableDescriptor(), executor, cat};
+    table_optimizer.recomputeMetadataUnlocked(optimize_candidates);
+  }
+}
+
 }  // namespace
 
 void RelAlgExecutor::executeUpdate(const RelAlgNode* node,
@@ -1518,14 +1599,24 @@ void RelAlgExecutor::executeUpdate(const RelAlgNode* node,
           dynamic_cast<UpdateTransactionParameters*>(dml_transaction_parameters_.get());
       CHECK(update_transaction_parameters);
       auto update_callback = yieldUpdateCallback(*update_transaction_parameters);
-      executor_->executeUpdate(ra_exe_unit,
-                               table_infos,
-                               co_project,
-                               eo,
-                               cat_,
-                               executor_->row_set_mem_owner_,
-                               update_callback,
-                               is_aggregate);
+      CHECK(!table_infos.empty());
+      const auto fragment_locker = make_dml_fragment_locker(
+          *update_transaction_parameters,
+          cat_,
+          table_infos.front(),
+          update_transaction_parameters->isVarlenUpdateRequired());
+      const auto optimize_candidates =
+          executor_->executeUpdate(ra_exe_unit,
+                                   table_infos,
+                                   co_project,
+                                   eo,
+                                   cat_,
+                                   executor_->row_set_mem_owner_,
+                                   update_callback,
+                                   is_aggregate,
+                                   fragment_locker);
+      publish_dml_changes(
+          *dml_transaction_parameters_, executor_, cat_, optimize_candidates);
       post_execution_callback_ = [this]() {
         dml_transaction_parameters_->finalizeTransaction(cat_);
       };
@@ -1631,16 +1722,29 @@ void RelAlgExecutor::executeDelete(const RelAlgNode* node,
             CHECK_EQ(exe_unit.target_exprs.size(), size_t(1));
           }
 
-          executor_->executeUpdate(exe_unit,
-                                   table_infos,
-                                   co_delete,
-                                   eo,
-                                   cat_,
-                                   executor_->row_set_mem_owner_,
-                                   delete_callback,
-                                   is_aggregate);
-          post_execution_callback_ = [this]() {
+          CHECK(!table_infos.empty());
+          const auto fragment_locker = make_dml_fragment_locker(
+              *delete_params, cat_, table_infos.front(), /*is_varlen_update=*/false);
+          const auto optimize_candidates =
+              executor_->executeUpdate(exe_unit,
+                                       table_infos,
+                                       co_delete,
+                                       eo,
+                                       cat_,
+                                       executor_->row_set_mem_owner_,
+                                       delete_callback,
+                                       is_aggregate,
+                                       fragment_locker);
+          publish_dml_changes(
+              *dml_transaction_parameters_, executor_, cat_, optimize_candidates);
+          post_execution_callback_ = [this, table_descriptor]() {
             dml_transaction_parameters_->finalizeTransaction(cat_);
+            if (g_enable_auto_vacuum && !table_is_temporary(table_descriptor)) {
+              // Rewrite fragments which crossed the delete ratio threshold so that
+              // subsequent scans do not keep paying for the deleted rows. This runs in
+              // the background once the delete has released its table locks.
+              TableOptimizer::scheduleAutoVacuum(cat_, table_descriptor->tableId);
+            }
           };
         };
 
@@ -3007,6 +3111,16 @@ std::optional<size_t> RelAlgExecutor::getFilteredCountAll(const WorkUnit& work_u
                                   nullptr);
   const auto count_all_exe_unit =
       create_count_all_execution_unit(work_unit.exe_unit, count);
+  // keep the pre-flight count out of the row and fragment counters of the profiled step
+  auto step_counters = executor_->execution_step_counters_;
+  executor_->execution_step_counters_ = nullptr;
+  auto clock_begin = timer_start();
+  ScopeGuard restore_step_counters = [this, step_counters, clock_begin] {
+    executor_->execution_step_counters_ = step_counters;
+    if (step_counters) {
+      step_counters->preflight_count_ms += timer_stop(clock_begin);
+    }
+  };
   size_t one{1};
   ResultSetPtr count_all_result;
   try {
@@ -4028,6 +4142,9 @@ RelAlgExecutor::TableFunctionWorkUnit RelAlgExecutor::createTableFunctionWorkUni
     output_row_sizing_param = static_cast<size_t>(literal_val);
   } else if (table_function_impl.hasNonUserSpecifiedOutputSizeConstant()) {
     output_row_sizing_param = table_function_impl.getOutputRowSizeParameter();
+  } else if (table_function_impl.hasTableFunctionSpecifiedParameter()) {
+    // the output size is set by the table function while it runs
+    output_row_sizing_param = 0;
   } else {
     UNREACHABLE();
   }
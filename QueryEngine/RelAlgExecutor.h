@@ -153,6 +153,13 @@ class RelAlgExecutor : private StorageIOFacility {
 
   void executePostExecutionCallback();
 
+  /**
+   * Collects an operator level profile of the next query execution, see QueryProfile.
+   */
+  void enableQueryProfile() { query_profile_ = std::make_unique<QueryProfile>(); }
+
+  const QueryProfile* getQueryProfile() const { return query_profile_.get(); }
+
  private:
   ExecutionResult executeRelAlgQueryNoRetry(const CompilationOptions& co,
                                             const ExecutionOptions& eo,
@@ -371,6 +378,7 @@ class RelAlgExecutor : private StorageIOFacility {
 
   std::unique_ptr<TransactionParameters> dml_transaction_parameters_;
   std::optional<std::function<void()>> post_execution_callback_;
+  std::unique_ptr<QueryProfile> query_profile_;
 
   friend class PendingExecutionClosure;
 };
@@ -1160,6 +1160,15 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateTernaryGeoFunction(
       throw QueryNotSupported(rex_function->getName() + " cannot accept different SRIDs");
     }
 
+    if (arg0_ti.get_subtype() == kGEOGRAPHY && arg0_ti.get_output_srid() == 4326 &&
+        arg0_ti.get_type() == kPOINT && arg1_ti.get_type() == kPOINT) {
+      // The ST_DWithin runtime functions are cartesian, compare the geodesic distance in
+      // meters instead
+      const auto geo_distance = translateBinaryGeoFunction(rex_function);
+      return makeExpr<Analyzer::BinOper>(
+          kBOOLEAN, kLE, kONE, geo_distance, distance_expr);
+    }
+
     if ((arg1_ti.get_type() == kPOINT && arg0_ti.get_type() != kPOINT) ||
         (arg1_ti.get_type() == kLINESTRING && arg0_ti.get_type() == kPOLYGON) ||
         (arg1_ti.get_type() == kPOLYGON && arg0_ti.get_type() == kMULTIPOLYGON)) {
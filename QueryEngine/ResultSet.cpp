@@ -394,6 +394,17 @@ size_t ResultSet::parallelRowCount() const {
   return get_truncated_row_count(row_count, getLimit(), drop_first_);
 }
 
+void ResultSet::setLazyFetchColumnBuffer(const size_t frag_pos,
+                                         const size_t local_col_id,
+                                         const int8_t* col_buffer) {
+  if (col_buffers_.empty()) {
+    return;
+  }
+  CHECK_LT(frag_pos, col_buffers_.front().size());
+  CHECK_LT(local_col_id, col_buffers_.front()[frag_pos].size());
+  col_buffers_.front()[frag_pos][local_col_id] = col_buffer;
+}
+
 bool ResultSet::definitelyHasNoRows() const {
   return !storage_ && !estimator_ && !just_explain_;
 }
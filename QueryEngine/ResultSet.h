@@ -346,6 +346,11 @@ class ResultSet {
   void holdChunkIterators(const std::shared_ptr<std::list<ChunkIter>> chunk_iters) {
     chunk_iters_.push_back(chunk_iters);
   }
+  // Fills in the buffer of a lazily fetched column which was only loaded after the
+  // kernel found matching rows in the fragment.
+  void setLazyFetchColumnBuffer(const size_t frag_pos,
+                                const size_t local_col_id,
+                                const int8_t* col_buffer);
   void holdLiterals(std::vector<int8_t>& literal_buff) {
     literal_buffers_.push_back(std::move(literal_buff));
   }
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <future>
+#include <map>
+#include <optional>
 
 #include "Fragmenter/InsertOrderFragmenter.h"
 #include "LockMgr/LockMgr.h"
@@ -130,6 +132,7 @@ class StorageIOFacility {
       return transaction_tracker_;
     }
     void finalizeTransaction(const Catalog_Namespace::Catalog& catalog) {
+      lockTableCheckpoint(catalog.getDatabaseId());
       auto update_occurred = transaction_tracker_.commitUpdate();
       if (!update_occurred && table_descriptor_->persistenceLevel ==
                                   Data_Namespace::MemoryLevel::DISK_LEVEL) {
@@ -137,6 +140,37 @@ class StorageIOFacility {
         // to ensure that epochs are uniformly incremented in distributed mode.
         catalog.checkpoint(table_descriptor_->tableId);
       }
+      checkpoint_lock_.reset();
+      fragment_locks_.clear();
+    }
+
+    // Serializes publishing and checkpointing the changes with the other updates and
+    // deletes of the table, until the transaction is finalized. A failed checkpoint rolls
+    // the table epochs back, which must not drop changes committed by another
+    // transaction in between.
+    void lockTableCheckpoint(const int db_id) {
+      if (!checkpoint_lock_) {
+        checkpoint_lock_ = lockmgr::TableCheckpointLockMgr::getWriteLockForTable(
+            {db_id, table_descriptor_->tableId});
+      }
+    }
+
+    // Write locks a fragment of the table until the transaction is finalized.
+    void lockFragment(const int db_id,
+                      const Fragmenter_Namespace::FragmentInfo& fragment) {
+      ChunkKey fragment_key{db_id, fragment.physicalTableId, fragment.fragmentId};
+      if (fragment_locks_.count(fragment_key) == 0) {
+        fragment_locks_.emplace(
+            fragment_key,
+            lockmgr::FragmentDataLockMgr::getWriteLockForFragment(
+                db_id, fragment.physicalTableId, fragment.fragmentId));
+      }
+    }
+
+    void unlockFragment(const int db_id,
+                        const Fragmenter_Namespace::FragmentInfo& fragment) {
+      ChunkKey fragment_key{db_id, fragment.physicalTableId, fragment.fragmentId};
+      fragment_locks_.erase(fragment_key);
     }
 
     auto tableIsTemporary() const { return table_is_temporary_; }
@@ -144,6 +178,10 @@ class StorageIOFacility {
     auto const* getTableDescriptor() const { return table_descriptor_; }
 
    private:
+    // Declared first so that the locks are released after a failed transaction is rolled
+    // back by the destructor of the tracker.
+    std::map<ChunkKey, lockmgr::WriteLock> fragment_locks_;
+    std::optional<lockmgr::WriteLock> checkpoint_lock_;
     typename StorageIOFacility::TransactionLog transaction_tracker_;
     TableDescriptorType const* table_descriptor_;
     bool table_is_temporary_;
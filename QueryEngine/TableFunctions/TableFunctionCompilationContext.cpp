@@ -338,6 +338,25 @@ void TableFunctionCompilationContext::generateEntryPoint(
     CHECK(!ti.is_column());       // UDTF output column type is its data type
     CHECK(!ti.is_column_list());  // TODO: when UDTF outputs column_list, convert it to
                                   // output columns
+    if (exe_unit.table_func.hasTableFunctionSpecifiedParameter()) {
+      // The output columns are allocated by set_output_row_size while the table
+      // function runs, pass the addresses of the Column instances it has to update in
+      // place of the output buffers.
+      CHECK(!pass_column_by_value);
+      auto col = alloc_column(std::string("output_col.") + std::to_string(i),
+                              ti,
+                              nullptr,
+                              nullptr,
+                              ctx,
+                              cgen_state_->ir_builder_,
+                              /*byval=*/false);
+      cgen_state->ir_builder_.CreateStore(
+          cgen_state->ir_builder_.CreateBitCast(
+              col, llvm::PointerType::get(get_int_type(64, ctx), 0)),
+          cgen_state->ir_builder_.CreateGEP(output_buffers_arg, cgen_state_->llInt(i)));
+      func_args.push_back(col);
+      continue;
+    }
     auto col = alloc_column(std::string("output_col.") + std::to_string(i),
                             ti,
                             output_load,
@@ -16,11 +16,18 @@
 
 #include "QueryEngine/TableFunctions/TableFunctionExecutionContext.h"
 
+#include <functional>
+#include <future>
+#include <optional>
+
 #include "Analyzer/Analyzer.h"
 #include "Logger/Logger.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/GpuMemUtils.h"
+#include "QueryEngine/OmniSciTypes.h"
 #include "QueryEngine/TableFunctions/TableFunctionCompilationContext.h"
+#include "Shared/scope.h"
+#include "Shared/thread_count.h"
 
 namespace {
 
@@ -69,8 +76,225 @@ size_t get_output_row_count(const TableFunctionExecutionUnit& exe_unit,
   return allocated_output_row_count;
 }
 
+// Smallest number of input rows worth running a row parallel table function on a thread
+constexpr size_t kMinRowParallelRangeSize = 1 << 16;
+
+// Returns the number of ranges the input rows of a table function are split into, 1 if
+// the function runs on all rows at once.
+size_t get_row_parallel_range_count(const TableFunctionExecutionUnit& exe_unit,
+                                    const std::vector<int64_t>& col_sizes,
+                                    const size_t elem_count) {
+  if (!exe_unit.table_func.isRowParallel()) {
+    return 1;
+  }
+  CHECK(exe_unit.table_func.hasUserSpecifiedOutputSizeMultiplier());
+  for (const auto col_size : col_sizes) {
+    // literals have no size, the rows of all columns have to line up
+    if (col_size != 0 && static_cast<size_t>(col_size) != elem_count) {
+      return 1;
+    }
+  }
+  return std::max(size_t(1),
+                  std::min(static_cast<size_t>(cpu_threads()),
+                           elem_count / kMinRowParallelRangeSize));
+}
+
+// Runs a row parallel table function on contiguous ranges of its input rows across the
+// CPU threads. Every range writes its output rows to its own share of the output
+// columns, sized by the row multiplier, and the outputs of the ranges are then moved
+// next to each other in every column. Returns the number of output rows.
+int64_t execute_row_parallel(const TableFunctionExecutionUnit& exe_unit,
+                             const TableFunctionCompilationContext* compilation_context,
+                             const std::vector<const int8_t*>& col_buf_ptrs,
+                             const std::vector<int64_t>& col_sizes,
+                             const size_t elem_count,
+                             const size_t range_count,
+                             int8_t* output_buffers_ptr,
+                             const size_t allocated_output_row_count) {
+  const auto num_out_columns = exe_unit.target_exprs.size();
+  const size_t row_multiplier = exe_unit.output_buffer_size_param;
+  CHECK_EQ(allocated_output_row_count, row_multiplier * elem_count);
+  const size_t range_size = (elem_count + range_count - 1) / range_count;
+
+  std::vector<std::future<std::pair<int32_t, int64_t>>> range_threads;
+  for (size_t range_start = 0; range_start < elem_count; range_start += range_size) {
+    const size_t range_rows = std::min(range_size, elem_count - range_start);
+    range_threads.push_back(std::async(
+        std::launch::async,
+        [&exe_unit,
+         compilation_context,
+         &col_buf_ptrs,
+         &col_sizes,
+         output_buffers_ptr,
+         allocated_output_row_count,
+         row_multiplier,
+         num_out_columns](const size_t range_start, const size_t range_rows) {
+          std::vector<const int8_t*> range_col_buf_ptrs;
+          std::vector<std::vector<const int8_t*>> range_col_list_bufs;
+          range_col_list_bufs.reserve(col_buf_ptrs.size());
+          std::vector<int64_t> range_col_sizes;
+          for (size_t i = 0; i < col_buf_ptrs.size(); i++) {
+            if (col_sizes[i] == 0) {
+              // literal
+              range_col_buf_ptrs.push_back(col_buf_ptrs[i]);
+              range_col_sizes.push_back(0);
+              continue;
+            }
+            const auto& ti = exe_unit.input_exprs[i]->get_type_info();
+            const auto elem_size = ti.get_elem_type().get_size();
+            CHECK_GT(elem_size, 0);
+            if (ti.is_column_list()) {
+              // the buffer holds the pointers to the columns of the list
+              const auto col_list_ptrs =
+                  reinterpret_cast<const int8_t* const*>(col_buf_ptrs[i]);
+              auto& range_col_list = range_col_list_bufs.emplace_back();
+              for (int j = 0; j < ti.get_dimension(); j++) {
+                range_col_list.push_back(col_list_ptrs[j] + range_start * elem_size);
+              }
+              range_col_buf_ptrs.push_back(
+                  reinterpret_cast<const int8_t*>(range_col_list.data()));
+            } else {
+              range_col_buf_ptrs.push_back(col_buf_ptrs[i] + range_start * elem_size);
+            }
+            range_col_sizes.push_back(range_rows);
+          }
+          const auto range_output_offset = range_start * row_multiplier;
+          std::vector<int64_t*> range_output_col_buf_ptrs;
+          for (size_t i = 0; i < num_out_columns; i++) {
+            range_output_col_buf_ptrs.push_back(
+                reinterpret_cast<int64_t*>(output_buffers_ptr) +
+                i * allocated_output_row_count + range_output_offset);
+          }
+          const int64_t range_allocated_row_count = range_rows * row_multiplier;
+          int64_t range_output_row_count = range_allocated_row_count;
+          const auto err = compilation_context->getFuncPtr()(
+              reinterpret_cast<const int8_t**>(range_col_buf_ptrs.data()),
+              range_col_sizes.data(),
+              range_output_col_buf_ptrs.data(),
+              &range_output_row_count);
+          if (range_output_row_count < 0 ||
+              range_output_row_count > range_allocated_row_count) {
+            range_output_row_count = range_allocated_row_count;
+          }
+          return std::make_pair(err, range_output_row_count);
+        },
+        range_start,
+        range_rows));
+  }
+  std::vector<int64_t> range_output_row_counts;
+  int32_t err = 0;
+  for (auto& range_thread : range_threads) {
+    const auto [range_err, range_output_row_count] = range_thread.get();
+    if (range_err && !err) {
+      err = range_err;
+    }
+    range_output_row_counts.push_back(range_output_row_count);
+  }
+  if (err) {
+    throw std::runtime_error("Error executing table function: " + std::to_string(err));
+  }
+
+  // move the outputs of the ranges to the start of every column, the output of a range
+  // never moves past the output of the next one
+  int64_t output_row_count = 0;
+  for (size_t i = 0; i < num_out_columns; i++) {
+    auto column_ptr =
+        output_buffers_ptr + i * allocated_output_row_count * sizeof(int64_t);
+    output_row_count = 0;
+    for (size_t range_idx = 0; range_idx < range_output_row_counts.size(); range_idx++) {
+      const auto src_offset = range_idx * range_size * row_multiplier;
+      if (static_cast<size_t>(output_row_count) != src_offset) {
+        std::memmove(column_ptr + output_row_count * sizeof(int64_t),
+                     column_ptr + src_offset * sizeof(int64_t),
+                     range_output_row_counts[range_idx] * sizeof(int64_t));
+      }
+      output_row_count += range_output_row_counts[range_idx];
+    }
+  }
+  return output_row_count;
+}
+
+// The output of a table function sized by TableFunctionSpecifiedParameter, allocated by
+// set_output_row_size while the function runs on the current thread
+struct TableFunctionSpecifiedOutput {
+  const std::function<int64_t*(const size_t)>& allocate;
+  // addresses of the Column instances passed to the table function
+  int64_t** output_columns;
+  const size_t num_out_columns;
+  std::optional<int64_t> output_row_count;
+  std::string error;
+};
+
+thread_local TableFunctionSpecifiedOutput* table_function_specified_output{nullptr};
+
+// Runs a table function sized by TableFunctionSpecifiedParameter. The output buffers are
+// allocated by the allocate callback when the function calls set_output_row_size.
+// Returns the number of output rows.
+int64_t execute_table_function_specified_output(
+    const TableFunctionExecutionUnit& exe_unit,
+    const TableFunctionCompilationContext* compilation_context,
+    const int8_t** byte_stream_ptr,
+    const std::vector<int64_t>& col_sizes,
+    const std::function<int64_t*(const size_t)>& allocate) {
+  const auto num_out_columns = exe_unit.target_exprs.size();
+  std::vector<int64_t*> output_columns(num_out_columns, nullptr);
+  TableFunctionSpecifiedOutput output{
+      allocate, output_columns.data(), num_out_columns, std::nullopt, ""};
+  CHECK(!table_function_specified_output);
+  table_function_specified_output = &output;
+  // output lives on this stack frame, reset even if the table function throws
+  ScopeGuard reset_specified_output = [] { table_function_specified_output = nullptr; };
+  int64_t output_row_count = -1;
+  const auto err = compilation_context->getFuncPtr()(
+      byte_stream_ptr, col_sizes.data(), output_columns.data(), &output_row_count);
+  if (!output.error.empty()) {
+    throw std::runtime_error("Error executing table function " +
+                             exe_unit.table_func.getName() + ": " + output.error);
+  }
+  if (err) {
+    throw std::runtime_error("Error executing table function: " + std::to_string(err));
+  }
+  if (!output.output_row_count) {
+    throw std::runtime_error("Table function " + exe_unit.table_func.getName() +
+                             " did not call set_output_row_size");
+  }
+  return output_row_count;
+}
+
 }  // namespace
 
+extern "C" RUNTIME_EXPORT void set_output_row_size(int64_t num_rows) {
+  auto output = table_function_specified_output;
+  if (!output) {
+    LOG(ERROR) << "set_output_row_size called outside of a table function sized by "
+                  "TableFunctionSpecifiedParameter";
+    return;
+  }
+  if (output->output_row_count) {
+    // the function may hold on to the columns allocated by the first call
+    output->error = "set_output_row_size must be called only once";
+    return;
+  }
+  if (num_rows < 0) {
+    output->error = "invalid output row size " + std::to_string(num_rows);
+    return;
+  }
+  int64_t* output_buffers_ptr{nullptr};
+  try {
+    output_buffers_ptr = output->allocate(num_rows);
+  } catch (const std::exception& e) {
+    output->error = e.what();
+    return;
+  }
+  output->output_row_count = num_rows;
+  for (size_t i = 0; i < output->num_out_columns; i++) {
+    auto column = reinterpret_cast<Column<int64_t>*>(output->output_columns[i]);
+    CHECK(column);
+    column->ptr = output_buffers_ptr + i * num_rows;
+    column->sz = num_rows;
+  }
+}
+
 ResultSetPtr TableFunctionExecutionContext::execute(
     const TableFunctionExecutionUnit& exe_unit,
     const std::vector<InputTableInfo>& table_infos,
@@ -79,6 +303,11 @@ ResultSetPtr TableFunctionExecutionContext::execute(
     const ExecutorDeviceType device_type,
     Executor* executor) {
   CHECK(compilation_context);
+  if (device_type == ExecutorDeviceType::GPU &&
+      exe_unit.table_func.hasTableFunctionSpecifiedParameter()) {
+    throw std::runtime_error("Table function " + exe_unit.table_func.getName() +
+                             " sets its output row size and cannot run on GPU");
+  }
   std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
   std::vector<std::unique_ptr<char[]>> literals_owner;
 
@@ -246,41 +475,79 @@ ResultSetPtr TableFunctionExecutionContext::launchCpuCode(
     query_mem_desc.addColSlotInfo({std::make_tuple(8, 8)});
   }
 
-  const auto allocated_output_row_count = get_output_row_count(exe_unit, elem_count);
-  auto query_buffers = std::make_unique<QueryMemoryInitializer>(
-      exe_unit,
-      query_mem_desc,
-      /*device_id=*/0,
-      ExecutorDeviceType::CPU,
-      allocated_output_row_count,
-      std::vector<std::vector<const int8_t*>>{col_buf_ptrs},
-      std::vector<std::vector<uint64_t>>{{0}},  // frag offsets
-      row_set_mem_owner_,
-      nullptr,
-      executor);
-
-  // setup the output
-  int64_t output_row_count = allocated_output_row_count;
-  auto group_by_buffers_ptr = query_buffers->getGroupByBuffersPtr();
-  CHECK(group_by_buffers_ptr);
-
-  auto output_buffers_ptr = reinterpret_cast<int64_t*>(group_by_buffers_ptr[0]);
-  std::vector<int64_t*> output_col_buf_ptrs;
-  for (size_t i = 0; i < num_out_columns; i++) {
-    output_col_buf_ptrs.emplace_back(output_buffers_ptr + i * allocated_output_row_count);
-  }
+  std::unique_ptr<QueryMemoryInitializer> query_buffers;
+  size_t allocated_output_row_count = 0;
+  int64_t* output_buffers_ptr{nullptr};
+  const std::function<int64_t*(const size_t)> allocate_output_buffers =
+      [&](const size_t output_row_count) {
+        query_buffers = std::make_unique<QueryMemoryInitializer>(
+            exe_unit,
+            query_mem_desc,
+            /*device_id=*/0,
+            ExecutorDeviceType::CPU,
+            output_row_count,
+            std::vector<std::vector<const int8_t*>>{col_buf_ptrs},
+            std::vector<std::vector<uint64_t>>{{0}},  // frag offsets
+            row_set_mem_owner_,
+            nullptr,
+            executor);
+        allocated_output_row_count = output_row_count;
+        auto group_by_buffers_ptr = query_buffers->getGroupByBuffersPtr();
+        CHECK(group_by_buffers_ptr);
+        output_buffers_ptr = reinterpret_cast<int64_t*>(group_by_buffers_ptr[0]);
+        return output_buffers_ptr;
+      };
+
+  int64_t output_row_count{0};
+  if (exe_unit.table_func.hasTableFunctionSpecifiedParameter()) {
+    // the output buffers are allocated once the table function knows their size
+    output_row_count = execute_table_function_specified_output(exe_unit,
+                                                               compilation_context,
+                                                               byte_stream_ptr,
+                                                               col_sizes,
+                                                               allocate_output_buffers);
+    CHECK(query_buffers);
+  } else {
+    allocate_output_buffers(get_output_row_count(exe_unit, elem_count));
+    if (allocated_output_row_count == 0) {
+      // don't bother executing the UDTF when the row count is zero
+      query_buffers->getResultSet(0)->updateStorageEntryCount(0);
+      return query_buffers->getResultSetOwned(0);
+    }
 
-  if (allocated_output_row_count == 0) {
-    // don't bother executing the UDTF when the row count is zero
-    query_buffers->getResultSet(0)->updateStorageEntryCount(0);
-    return query_buffers->getResultSetOwned(0);
-  }
+    // setup the output
+    output_row_count = allocated_output_row_count;
+    std::vector<int64_t*> output_col_buf_ptrs;
+    for (size_t i = 0; i < num_out_columns; i++) {
+      output_col_buf_ptrs.emplace_back(output_buffers_ptr +
+                                       i * allocated_output_row_count);
+    }
 
-  // execute
-  const auto err = compilation_context->getFuncPtr()(
-      byte_stream_ptr, col_sizes.data(), output_col_buf_ptrs.data(), &output_row_count);
-  if (err) {
-    throw std::runtime_error("Error executing table function: " + std::to_string(err));
+    // execute
+    const auto range_count =
+        get_row_parallel_range_count(exe_unit, col_sizes, elem_count);
+    if (range_count > 1) {
+      VLOG(1) << "Running row parallel table function " << exe_unit.table_func.getName()
+              << " on " << range_count << " ranges of " << elem_count << " rows";
+      output_row_count =
+          execute_row_parallel(exe_unit,
+                               compilation_context,
+                               col_buf_ptrs,
+                               col_sizes,
+                               elem_count,
+                               range_count,
+                               reinterpret_cast<int8_t*>(output_buffers_ptr),
+                               allocated_output_row_count);
+    } else {
+      const auto err = compilation_context->getFuncPtr()(byte_stream_ptr,
+                                                         col_sizes.data(),
+                                                         output_col_buf_ptrs.data(),
+                                                         &output_row_count);
+      if (err) {
+        throw std::runtime_error("Error executing table function: " +
+                                 std::to_string(err));
+      }
+    }
   }
   if (exe_unit.table_func.hasNonUserSpecifiedOutputSizeConstant()) {
     if (static_cast<size_t>(output_row_count) != allocated_output_row_count) {
@@ -144,7 +144,8 @@ void TableFunctionsFactory::add(const std::string& name,
                                 const std::vector<ExtArgumentType>& input_args,
                                 const std::vector<ExtArgumentType>& output_args,
                                 const std::vector<ExtArgumentType>& sql_args,
-                                bool is_runtime) {
+                                bool is_runtime,
+                                bool is_row_parallel) {
   for (auto it = functions_.begin(); it != functions_.end();) {
     if (it->second.getName() == name) {
       if (it->second.isRuntime()) {
@@ -159,7 +160,20 @@ void TableFunctionsFactory::add(const std::string& name,
       ++it;
     }
   }
-  auto tf = TableFunction(name, sizer, input_args, output_args, sql_args, is_runtime);
+  if (is_row_parallel &&
+      sizer.type != OutputBufferSizeType::kUserSpecifiedRowMultiplier) {
+    throw std::runtime_error("Row parallel table function " + name +
+                             " must be sized by a row multiplier");
+  }
+  if (is_runtime &&
+      sizer.type == OutputBufferSizeType::kTableFunctionSpecifiedParameter) {
+    // run-time functions get their output columns by value, so their size cannot be
+    // set while they run
+    throw std::runtime_error("Run-time table function " + name +
+                             " cannot set its output row size");
+  }
+  auto tf = TableFunction(
+      name, sizer, input_args, output_args, sql_args, is_runtime, is_row_parallel);
   functions_.emplace(name, tf);
 }
 
@@ -62,6 +62,15 @@
     + Constant - the allocated output column size will be <sizer>. The
       table function
 
+    + TableFunctionSpecifiedParameter - the output columns are
+      allocated when the table function implementation calls
+
+        set_output_row_size(<output column size>)
+
+      exactly once, before writing to the output columns. This allows
+      functions with a data dependent output size, such as filters,
+      to allocate no more than their actual output. CPU only.
+
     The actual size of the output column is returned by the table
     function implementation that must be equal or smaller to the
     allocated output column size.
@@ -79,6 +88,12 @@
     run-time function. Run-time functions can be overwitten or removed
     by users. Load-time functions cannot be redefined in run-time.
 
+  - a boolean flag specifying the table function is row parallel: the
+    output rows computed from a range of input rows depend on these
+    rows only. Such functions run on ranges of the input rows across
+    the CPU threads, and the outputs of the ranges are concatenated in
+    the order of the input rows. Requires a row multiplier sizer.
+
   Future notes:
 
   - introduce a list of output column names. Currently, the names of
@@ -106,6 +121,8 @@ struct TableFunctionOutputRowSizer {
         return "kUserSpecifiedRowMultiplier[" + std::to_string(val) + "]";
       case OutputBufferSizeType::kConstant:
         return "kConstant[" + std::to_string(val) + "]";
+      case OutputBufferSizeType::kTableFunctionSpecifiedParameter:
+        return "kTableFunctionSpecifiedParameter[" + std::to_string(val) + "]";
     }
     return "";
   }
@@ -161,13 +178,15 @@ class TableFunction {
                 const std::vector<ExtArgumentType>& input_args,
                 const std::vector<ExtArgumentType>& output_args,
                 const std::vector<ExtArgumentType>& sql_args,
-                bool is_runtime)
+                bool is_runtime,
+                bool is_row_parallel = false)
       : name_(name)
       , output_sizer_(output_sizer)
       , input_args_(input_args)
       , output_args_(output_args)
       , sql_args_(sql_args)
-      , is_runtime_(is_runtime) {}
+      , is_runtime_(is_runtime)
+      , is_row_parallel_(is_row_parallel) {}
 
   std::vector<ExtArgumentType> getArgs(const bool ensure_column = false) const {
     std::vector<ExtArgumentType> args;
@@ -207,6 +226,10 @@ class TableFunction {
     return output_sizer_.type == OutputBufferSizeType::kUserSpecifiedRowMultiplier;
   }
 
+  bool hasTableFunctionSpecifiedParameter() const {
+    return output_sizer_.type == OutputBufferSizeType::kTableFunctionSpecifiedParameter;
+  }
+
   OutputBufferSizeType getOutputRowSizeType() const { return output_sizer_.type; }
 
   size_t getOutputRowSizeParameter() const { return output_sizer_.val; }
@@ -234,6 +257,8 @@ class TableFunction {
 
   bool isRuntime() const { return is_runtime_; }
 
+  bool isRowParallel() const { return is_row_parallel_; }
+
   inline bool isGPU() const {
     return (name_.find("_cpu_", name_.find("__")) == std::string::npos);
   }
@@ -250,6 +275,7 @@ class TableFunction {
     result += "], [";
     result += ExtensionFunctionsWhitelist::toString(sql_args_);
     result += "], is_runtime=" + std::string((is_runtime_ ? "true" : "false"));
+    result += ", is_row_parallel=" + std::string((is_row_parallel_ ? "true" : "false"));
     result += ", sizer=" + ::toString(output_sizer_);
     result += ")";
     return result;
@@ -271,6 +297,7 @@ class TableFunction {
   const std::vector<ExtArgumentType> output_args_;
   const std::vector<ExtArgumentType> sql_args_;
   const bool is_runtime_;
+  const bool is_row_parallel_;
 };
 
 class TableFunctionsFactory {
@@ -280,7 +307,8 @@ class TableFunctionsFactory {
                   const std::vector<ExtArgumentType>& input_args,
                   const std::vector<ExtArgumentType>& output_args,
                   const std::vector<ExtArgumentType>& sql_args,
-                  bool is_runtime = false);
+                  bool is_runtime = false,
+                  bool is_row_parallel = false);
 
   static std::vector<TableFunction> get_table_funcs(const std::string& name,
                                                     const bool is_gpu);
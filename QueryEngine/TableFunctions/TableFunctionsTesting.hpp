@@ -268,3 +268,60 @@ EXTENSION_NOINLINE int32_t ct_binding_udtf3__cpu_25(const Column<int32_t>& input
   out[0] = 1000 + 169;
   return 1;
 }
+
+// clang-format off
+/*
+  UDTF: ct_row_parallel_copier__cpu_(Cursor<int64_t>, RowMultiplier) -> Column<int64_t> | row_parallel
+*/
+// clang-format on
+EXTENSION_NOINLINE int32_t ct_row_parallel_copier__cpu_(const Column<int64_t>& input,
+                                                        const int32_t copy_multiplier,
+                                                        Column<int64_t>& out) {
+  for (int64_t i = 0; i < input.getSize(); i++) {
+    for (int32_t c = 0; c < copy_multiplier; c++) {
+      out[i * copy_multiplier + c] = input[i];
+    }
+  }
+  return input.getSize() * copy_multiplier;
+}
+
+#ifndef __CUDACC__
+
+// clang-format off
+/*
+  UDTF: ct_positive_filter__cpu_(Cursor<int64_t>, TableFunctionSpecifiedParameter) -> Column<int64_t>
+*/
+// clang-format on
+EXTENSION_NOINLINE int32_t ct_positive_filter__cpu_(const Column<int64_t>& input,
+                                                    Column<int64_t>& out) {
+  int64_t output_row_count = 0;
+  for (int64_t i = 0; i < input.getSize(); i++) {
+    if (!input.isNull(i) && input[i] > 0) {
+      output_row_count++;
+    }
+  }
+  set_output_row_size(output_row_count);
+  if (out.getSize() != output_row_count) {
+    return -1;
+  }
+  int64_t output_row = 0;
+  for (int64_t i = 0; i < input.getSize(); i++) {
+    if (!input.isNull(i) && input[i] > 0) {
+      out[output_row++] = input[i];
+    }
+  }
+  return output_row_count;
+}
+
+// clang-format off
+/*
+  UDTF: ct_missing_output_size__cpu_(Cursor<int64_t>, TableFunctionSpecifiedParameter) -> Column<int64_t>
+*/
+// clang-format on
+EXTENSION_NOINLINE int32_t ct_missing_output_size__cpu_(const Column<int64_t>& input,
+                                                        Column<int64_t>& out) {
+  // never calls set_output_row_size, so no output is allocated
+  return 0;
+}
+
+#endif  // #ifndef __CUDACC__
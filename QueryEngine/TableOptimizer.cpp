@@ -22,6 +22,11 @@
 #include "QueryEngine/Execute.h"
 #include "Shared/scope.h"
 
+#include <condition_variable>
+#include <thread>
+
+extern float g_vacuum_min_selectivity;
+
 TableOptimizer::TableOptimizer(const TableDescriptor* td,
                                Executor* executor,
                                const Catalog_Namespace::Catalog& cat)
@@ -398,3 +403,93 @@ void TableOptimizer::vacuumDeletedRows() const {
                                                            shard->tableId);
   }
 }
+
+bool TableOptimizer::vacuumFragmentsAboveMinSelectivity() const {
+  const auto table_id = td_->tableId;
+  const auto db_id = cat_.getDatabaseId();
+  const auto table_epochs = cat_.getTableEpochs(db_id, table_id);
+  bool vacuumed = false;
+  try {
+    vacuumed = cat_.vacuumDeletedRows(table_id, g_vacuum_min_selectivity);
+    if (vacuumed) {
+      cat_.checkpoint(table_id);
+    }
+  } catch (...) {
+    cat_.setTableEpochsLogExceptions(db_id, table_epochs);
+    throw;
+  }
+  if (vacuumed) {
+    executor_->clearMetaInfoCache();
+  }
+  return vacuumed;
+}
+
+namespace {
+
+std::mutex auto_vacuum_mutex;
+std::condition_variable auto_vacuum_condition;
+// Tables with a scheduled vacuum, mapped to whether another pass was requested while
+// the vacuum was running
+std::map<ChunkKey, bool> auto_vacuum_tables;
+
+void run_auto_vacuum(const Catalog_Namespace::Catalog& cat, const ChunkKey& table_key) {
+  const auto schema_lock = lockmgr::TableSchemaLockMgr::getReadLockForTable(table_key);
+  const auto insert_data_lock =
+      lockmgr::InsertDataLockMgr::getWriteLockForTable(table_key);
+  // compaction rewrites chunk buffers and fragment metadata that queries may be scanning
+  const auto table_data_lock = lockmgr::TableDataLockMgr::getWriteLockForTable(table_key);
+  const auto td = cat.getMetadataForTable(table_key[CHUNK_KEY_TABLE_IDX], false);
+  if (!td) {
+    // Dropped before the vacuum got to run
+    return;
+  }
+  auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+  const TableOptimizer table_optimizer{td, executor.get(), cat};
+  if (table_optimizer.vacuumFragmentsAboveMinSelectivity()) {
+    VLOG(1) << "Automatically vacuumed table " << td->tableName;
+  }
+}
+
+}  // namespace
+
+void TableOptimizer::scheduleAutoVacuum(const Catalog_Namespace::Catalog& cat,
+                                        const int table_id) {
+  const ChunkKey table_key{cat.getDatabaseId(), table_id};
+  {
+    std::lock_guard<std::mutex> auto_vacuum_lock(auto_vacuum_mutex);
+    auto [it, inserted] = auto_vacuum_tables.emplace(table_key, false);
+    if (!inserted) {
+      it->second = true;
+      return;
+    }
+  }
+  // Keep the catalog alive for the duration of the vacuum
+  auto catalog = Catalog_Namespace::SysCatalog::instance().getCatalog(cat.getDatabaseId());
+  CHECK(catalog);
+  std::thread([catalog, table_key] {
+    while (true) {
+      try {
+        run_auto_vacuum(*catalog, table_key);
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Automatic vacuum of table " << table_key[CHUNK_KEY_TABLE_IDX]
+                     << " failed: " << e.what();
+      }
+      std::lock_guard<std::mutex> auto_vacuum_lock(auto_vacuum_mutex);
+      auto it = auto_vacuum_tables.find(table_key);
+      CHECK(it != auto_vacuum_tables.end());
+      if (it->second) {
+        it->second = false;
+        continue;
+      }
+      auto_vacuum_tables.erase(it);
+      auto_vacuum_condition.notify_all();
+      break;
+    }
+  }).detach();
+}
+
+void TableOptimizer::waitForAutoVacuums() {
+  std::unique_lock<std::mutex> auto_vacuum_lock(auto_vacuum_mutex);
+  auto_vacuum_condition.wait(auto_vacuum_lock,
+                             [] { return auto_vacuum_tables.empty(); });
+}
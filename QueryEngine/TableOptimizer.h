@@ -58,6 +58,31 @@ class TableOptimizer {
    */
   void vacuumDeletedRows() const;
 
+  /**
+   * @brief Compacts only the fragments whose fraction of deleted rows is at least
+   * `g_vacuum_min_selectivity`. Used to vacuum automatically after a delete without
+   * rewriting fragments that only contain a handful of deleted rows. Returns true if any
+   * fragment was compacted. Scans keep filtering on the delete column until no fragment
+   * of the table has deleted rows left.
+   */
+  bool vacuumFragmentsAboveMinSelectivity() const;
+
+  /**
+   * @brief Runs vacuumFragmentsAboveMinSelectivity for the given table on a background
+   * thread, so that the delete which triggered it does not wait for the fragments to be
+   * rewritten. The vacuum holds the table's insert data write lock, which excludes other
+   * DML on the table, and its table data write lock, which excludes queries scanning the
+   * chunks being compacted. If a vacuum of the table is already pending, another pass is
+   * run after it instead of starting a new thread.
+   */
+  static void scheduleAutoVacuum(const Catalog_Namespace::Catalog& cat,
+                                 const int table_id);
+
+  /**
+   * @brief Blocks until all scheduled automatic vacuums have completed.
+   */
+  static void waitForAutoVacuums();
+
  private:
   void recomputeDeletedColumnMetadata(
       const TableDescriptor* td,
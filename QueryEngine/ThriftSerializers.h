@@ -587,6 +587,8 @@ inline table_functions::OutputBufferSizeType from_thrift(
       return table_functions::OutputBufferSizeType::kUserSpecifiedConstantParameter;
     case TOutputBufferSizeType::kUserSpecifiedRowMultiplier:
       return table_functions::OutputBufferSizeType::kUserSpecifiedRowMultiplier;
+    case TOutputBufferSizeType::kTableFunctionSpecifiedParameter:
+      return table_functions::OutputBufferSizeType::kTableFunctionSpecifiedParameter;
   }
   UNREACHABLE();
   return table_functions::OutputBufferSizeType{};
@@ -601,6 +603,8 @@ inline TOutputBufferSizeType::type to_thrift(
       return TOutputBufferSizeType::kUserSpecifiedConstantParameter;
     case table_functions::OutputBufferSizeType::kUserSpecifiedRowMultiplier:
       return TOutputBufferSizeType::kUserSpecifiedRowMultiplier;
+    case table_functions::OutputBufferSizeType::kTableFunctionSpecifiedParameter:
+      return TOutputBufferSizeType::kTableFunctionSpecifiedParameter;
   }
   UNREACHABLE();
   return TOutputBufferSizeType::type{};
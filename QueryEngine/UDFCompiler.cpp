@@ -20,6 +20,7 @@
 #include <clang/AST/AST.h>
 #include <clang/AST/ASTConsumer.h>
 #include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/Basic/Version.h>
 #include <clang/Driver/Compilation.h>
 #include <clang/Driver/Driver.h>
 #include <clang/Frontend/CompilerInstance.h>
@@ -31,8 +32,15 @@
 #include <llvm/Support/Program.h>
 #include <llvm/Support/raw_ostream.h>
 #include <boost/process/search_path.hpp>
+#if BOOST_VERSION >= 106600
+#include <boost/uuid/detail/sha1.hpp>
+#else
+#include <boost/uuid/sha1.hpp>
+#endif
+#include <fstream>
 #include <iterator>
 #include <memory>
+#include <sstream>
 
 #if LLVM_VERSION_MAJOR >= 11
 #include <llvm/Support/Host.h>
@@ -40,6 +48,7 @@
 
 #include "Execute.h"
 #include "Logger/Logger.h"
+#include "MapDRelease.h"
 
 using namespace clang;
 using namespace clang::tooling;
@@ -159,6 +168,25 @@ class ToolFactory : public FrontendActionFactory {
 const char* convert(const std::string& s) {
   return s.c_str();
 }
+
+std::string read_file(const std::string& file_name) {
+  std::ifstream file(file_name, std::ios::binary);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+std::string calculate_sha1(const std::string& data) {
+  boost::uuids::detail::sha1 sha1;
+  unsigned int digest[5];
+  sha1.process_bytes(data.c_str(), data.length());
+  sha1.get_digest(digest);
+  std::stringstream ss;
+  for (size_t i = 0; i < 5; i++) {
+    ss << std::hex << digest[i];
+  }
+  return ss.str();
+}
 }  // namespace
 
 UdfClangDriver::UdfClangDriver(const std::string& clang_path)
@@ -351,6 +379,49 @@ const std::string& UdfCompiler::getAstFileName() const {
   return udf_ast_file_name_;
 }
 
+std::string UdfCompiler::getCacheKeyFileName() const {
+  std::string key_file_name(udf_file_name_);
+  key_file_name += ".key";
+  return key_file_name;
+}
+
+/*
+  The AST and bitcode files compiled from the UDF file are reused at server start as
+  long as the source, the compiler, its options, the GPU architecture and the server
+  release they were compiled with are unchanged. Headers included by the UDF file are
+  not tracked, except for the ones shipped with the server.
+ */
+std::string UdfCompiler::getCacheKey() const {
+  std::string cache_key = "source: " + calculate_sha1(read_file(udf_file_name_)) + "\n";
+  cache_key += "compiler: " + clang_path_ + " " +
+               std::to_string(boost::filesystem::last_write_time(clang_path_)) + " " +
+               clang::getClangFullVersion() + "\n";
+  cache_key += "options:";
+  for (const auto& option : clang_options_) {
+    cache_key += " " + option;
+  }
+  cache_key += "\n";
+#ifdef HAVE_CUDA
+  cache_key += "gpu: " + CudaMgr_Namespace::CudaMgr::deviceArchToSM(target_arch_) + "\n";
+#endif
+  cache_key += "release: " + MAPD_RELEASE + "\n";
+  return cache_key;
+}
+
+bool UdfCompiler::isCompiled(const std::string& cache_key) {
+  if (!boost::filesystem::exists(getCacheKeyFileName()) ||
+      !boost::filesystem::exists(udf_ast_file_name_) ||
+      !boost::filesystem::exists(genCpuIrFilename(udf_file_name_.c_str()))) {
+    return false;
+  }
+#ifdef HAVE_CUDA
+  if (!boost::filesystem::exists(genGpuIrFilename(udf_file_name_.c_str()))) {
+    return false;
+  }
+#endif
+  return read_file(getCacheKeyFileName()) == cache_key;
+}
+
 void UdfCompiler::init(const std::string& clang_path) {
   replaceExtn(udf_ast_file_name_, "ast");
 
@@ -445,6 +516,18 @@ int UdfCompiler::compileUdf() {
     return 1;
   }
 
+  const auto cache_key = getCacheKey();
+  if (isCompiled(cache_key)) {
+    LOG(INFO) << "UDFCompiler reusing the files compiled from " << udf_file_name_;
+    readCpuCompiledModule();
+#ifdef HAVE_CUDA
+    readGpuCompiledModule();
+#endif
+    return 0;
+  }
+  // the outputs of a previous compilation are overwritten below
+  boost::filesystem::remove(getCacheKeyFileName());
+
   auto ast_result = parseToAst(udf_file_name_.c_str());
 
   if (ast_result == 0) {
@@ -475,5 +558,12 @@ int UdfCompiler::compileUdf() {
     return 1;
   }
 
+  std::ofstream key_file(getCacheKeyFileName(), std::ios::binary);
+  key_file << cache_key;
+  if (!key_file) {
+    LOG(WARNING) << "Unable to write " << getCacheKeyFileName()
+                 << ", the UDF file will be compiled again at the next start";
+  }
+
   return 0;
 }
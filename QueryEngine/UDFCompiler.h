@@ -58,6 +58,7 @@ class UdfCompiler {
               const std::vector<std::string> clang_options);
   int compileUdf();
   const std::string& getAstFileName() const;
+  std::string getCacheKeyFileName() const;
 
  private:
   void init(const std::string& clang_path);
@@ -74,6 +75,8 @@ class UdfCompiler {
   void readGpuCompiledModule();
   void readCpuCompiledModule();
   int compileForGpu();
+  std::string getCacheKey() const;
+  bool isCompiled(const std::string& cache_key);
 
  private:
   std::string udf_file_name_;
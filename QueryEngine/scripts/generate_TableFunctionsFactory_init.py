@@ -29,7 +29,21 @@ In addition, the following equivalents are suppored:
   float == Float, double == Double, bool == Bool
   T == ColumnT for output column types
   RowMultiplier == RowMultiplier<i> where i is the one-based position of the sizer argument
+  TableFunctionSpecifiedParameter == TableFunctionSpecifiedParameter<0>, the table function
+  allocates its output by calling set_output_row_size, no argument is consumed
   when no sizer argument is provided, Constant<1> is assumed
+
+The output column types can be followed by annotations of the function:
+
+  UDTF: function_name(<arguments>) -> <output column types> | <annotation>
+
+where the supported annotations are:
+
+- row_parallel: the output rows computed from a range of input rows
+  depend on these rows only, hence the function may run on ranges of
+  the input rows in parallel, the outputs of the ranges being
+  concatenated in the order of the input rows. Requires a RowMultiplier
+  sizer.
 """
 # Author: Pearu Peterson
 # Created: January 2021
@@ -48,7 +62,7 @@ TextEncodingDict32, ColumnListInt8, ColumnListInt16, ColumnListInt32, ColumnList
 ColumnListFloat, ColumnListDouble, ColumnListBool '''.strip().replace(' ', '').split(',')
 
 OutputBufferSizeTypes = '''
-kConstant, kUserSpecifiedConstantParameter, kUserSpecifiedRowMultiplier
+kConstant, kUserSpecifiedConstantParameter, kUserSpecifiedRowMultiplier, kTableFunctionSpecifiedParameter
 '''.strip().replace(' ', '').split(',')
 
 translate_map = dict(
@@ -57,6 +71,7 @@ translate_map = dict(
     RowMultiplier = 'kUserSpecifiedRowMultiplier',
     UserSpecifiedConstantParameter = 'kUserSpecifiedConstantParameter',
     UserSpecifiedRowMultiplier = 'kUserSpecifiedRowMultiplier',
+    TableFunctionSpecifiedParameter = 'kTableFunctionSpecifiedParameter',
     short = 'Int16',
     int = 'Int32',
     long = 'Int64',
@@ -136,6 +151,13 @@ for input_file in sys.argv[1:-1]:
         name = line[:i]
         args_line = line[i+1:j]
         outputs = line[j+1:]
+        annotations = []
+        if '|' in outputs:
+            outputs, annotations = outputs.split('|', 1)
+            annotations = annotations.split('|')
+        for a in annotations:
+            if a not in ['row_parallel']:
+                raise ValueError('`%s`: unknown annotation `%s`' % (line, a))
         if outputs.startswith('->'):
             outputs = outputs[2:]
         outputs = outputs.split(',')
@@ -177,9 +199,11 @@ for input_file in sys.argv[1:-1]:
             else:
                 n, t = r
                 if n in OutputBufferSizeTypes:
-                    if n != 'kConstant':
+                    if n not in ['kConstant', 'kTableFunctionSpecifiedParameter']:
                         input_types.append('ExtArgumentType::Int32')
                         sql_types.append('ExtArgumentType::Int32')
+                    if n == 'kTableFunctionSpecifiedParameter' and not t:
+                        t = '0'
                     if n == 'kUserSpecifiedRowMultiplier':
                         if not t:
                             t = str(consumed_nargs + 1)
@@ -207,10 +231,17 @@ for input_file in sys.argv[1:-1]:
         if sizer is None:
             sizer = 'TableFunctionOutputRowSizer{OutputBufferSizeType::kConstant, 1}'
 
+        is_row_parallel = 'row_parallel' in annotations
+        if is_row_parallel:
+            assert 'kUserSpecifiedRowMultiplier' in sizer, '`%s`: row_parallel requires a RowMultiplier sizer' % (line)
+
         input_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(input_types))
         output_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(output_types))
         sql_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(sql_types)) 
-        add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s);' % (name, sizer, input_types, output_types, sql_types)
+        if is_row_parallel:
+            add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s, /*is_runtime=*/false, /*is_row_parallel=*/true);' % (name, sizer, input_types, output_types, sql_types)
+        else:
+            add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s);' % (name, sizer, input_types, output_types, sql_types)
         add_stmts.append(add)
 
 content = '''
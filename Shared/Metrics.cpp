@@ -0,0 +1,214 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/Metrics.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace metrics {
+
+Histogram::Histogram(std::vector<double> bucket_bounds)
+    : bucket_bounds_(std::move(bucket_bounds))
+    , bucket_counts_(new std::atomic<uint64_t>[bucket_bounds_.size() + 1]) {
+  if (!std::is_sorted(bucket_bounds_.begin(), bucket_bounds_.end())) {
+    throw std::runtime_error("Histogram bucket bounds must be sorted.");
+  }
+  for (size_t i = 0; i <= bucket_bounds_.size(); ++i) {
+    bucket_counts_[i] = 0;
+  }
+}
+
+void Histogram::observe(const double value) {
+  const auto bucket_idx =
+      std::lower_bound(bucket_bounds_.begin(), bucket_bounds_.end(), value) -
+      bucket_bounds_.begin();
+  bucket_counts_[bucket_idx].fetch_add(1, std::memory_order_relaxed);
+  auto sum = sum_.load(std::memory_order_relaxed);
+  while (!sum_.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<uint64_t> Histogram::getCumulativeCounts() const {
+  std::vector<uint64_t> counts(bucket_bounds_.size() + 1);
+  uint64_t total{0};
+  for (size_t i = 0; i < counts.size(); ++i) {
+    total += bucket_counts_[i].load(std::memory_order_relaxed);
+    counts[i] = total;
+  }
+  return counts;
+}
+
+const std::vector<double>& default_latency_buckets() {
+  static const std::vector<double> buckets{
+      0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 300};
+  return buckets;
+}
+
+namespace {
+
+std::string escape_label_value(const std::string& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (const auto c : value) {
+    switch (c) {
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+std::string render_labels(const Labels& labels) {
+  if (labels.empty()) {
+    return {};
+  }
+  std::string rendered{"{"};
+  for (const auto& [key, value] : labels) {
+    if (rendered.size() > 1) {
+      rendered += ",";
+    }
+    rendered += key + "=\"" + escape_label_value(value) + "\"";
+  }
+  return rendered + "}";
+}
+
+// Adds the "le" label of a histogram bucket to an already rendered label set.
+std::string add_bucket_label(const std::string& rendered_labels,
+                             const std::string& bound) {
+  const std::string le_label{"le=\"" + bound + "\"}"};
+  if (rendered_labels.empty()) {
+    return "{" + le_label;
+  }
+  return rendered_labels.substr(0, rendered_labels.size() - 1) + "," + le_label;
+}
+
+std::string format_double(const double value, const int precision) {
+  std::ostringstream oss;
+  oss << std::setprecision(precision) << value;
+  return oss.str();
+}
+
+}  // namespace
+
+Registry& Registry::instance() {
+  static Registry registry;
+  return registry;
+}
+
+Registry::Family& Registry::getFamily(const std::string& name,
+                                      const std::string& help,
+                                      const MetricType type) {
+  auto it = families_.find(name);
+  if (it == families_.end()) {
+    it = families_.emplace(name, Family{type, help, {}, {}, {}}).first;
+  }
+  if (it->second.type != type) {
+    throw std::runtime_error("Metric " + name +
+                             " is already registered with a different type.");
+  }
+  return it->second;
+}
+
+Counter& Registry::counter(const std::string& name,
+                           const std::string& help,
+                           const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric =
+      getFamily(name, help, MetricType::Counter).counters[render_labels(labels)];
+  if (!metric) {
+    metric = std::make_unique<Counter>();
+  }
+  return *metric;
+}
+
+Gauge& Registry::gauge(const std::string& name,
+                       const std::string& help,
+                       const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric = getFamily(name, help, MetricType::Gauge).gauges[render_labels(labels)];
+  if (!metric) {
+    metric = std::make_unique<Gauge>();
+  }
+  return *metric;
+}
+
+Histogram& Registry::histogram(const std::string& name,
+                               const std::string& help,
+                               const Labels& labels,
+                               const std::vector<double>& bucket_bounds) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric =
+      getFamily(name, help, MetricType::Histogram).histograms[render_labels(labels)];
+  if (!metric) {
+    metric = std::make_unique<Histogram>(bucket_bounds);
+  }
+  return *metric;
+}
+
+std::string Registry::toPrometheusText() const {
+  std::ostringstream oss;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [name, family] : families_) {
+    oss << "# HELP " << name << " " << family.help << "\n";
+    switch (family.type) {
+      case MetricType::Counter:
+        oss << "# TYPE " << name << " counter\n";
+        for (const auto& [labels, counter] : family.counters) {
+          oss << name << labels << " " << counter->value() << "\n";
+        }
+        break;
+      case MetricType::Gauge:
+        oss << "# TYPE " << name << " gauge\n";
+        for (const auto& [labels, gauge] : family.gauges) {
+          oss << name << labels << " " << gauge->value() << "\n";
+        }
+        break;
+      case MetricType::Histogram:
+        oss << "# TYPE " << name << " histogram\n";
+        for (const auto& [labels, histogram] : family.histograms) {
+          const auto& bounds = histogram->getBucketBounds();
+          const auto counts = histogram->getCumulativeCounts();
+          for (size_t i = 0; i < counts.size(); ++i) {
+            const auto bound =
+                i < bounds.size() ? format_double(bounds[i], 6) : std::string("+Inf");
+            oss << name << "_bucket" << add_bucket_label(labels, bound) << " "
+                << counts[i] << "\n";
+          }
+          const auto sum =
+              format_double(histogram->getSum(), std::numeric_limits<double>::max_digits10);
+          oss << name << "_sum" << labels << " " << sum << "\n";
+          oss << name << "_count" << labels << " " << counts.back() << "\n";
+        }
+        break;
+    }
+  }
+  return oss.str();
+}
+
+}  // namespace metrics
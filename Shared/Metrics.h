@@ -0,0 +1,146 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    Metrics.h
+ * @brief   Process wide registry of counters, gauges and histograms, serialized in the
+ *          Prometheus text exposition format.
+ *
+ * Metrics are registered once, usually into a function local static reference, and
+ * updated with relaxed atomics afterwards, so instrumenting a hot path costs a single
+ * atomic add:
+ *
+ *   static auto& hits = metrics::Registry::instance().counter(
+ *       "omnisci_buffer_pool_hits_total", "Buffer pool hits.", {{"level", "cpu"}});
+ *   hits.increment();
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace metrics {
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+class Counter {
+ public:
+  void increment(const uint64_t value = 1) {
+    value_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+class Gauge {
+ public:
+  void set(const int64_t value) { value_.store(value, std::memory_order_relaxed); }
+
+  void add(const int64_t value) { value_.fetch_add(value, std::memory_order_relaxed); }
+
+  void sub(const int64_t value) { value_.fetch_sub(value, std::memory_order_relaxed); }
+
+  int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+class Histogram {
+ public:
+  explicit Histogram(std::vector<double> bucket_bounds);
+
+  void observe(const double value);
+
+  // Observes the time elapsed since clock_begin, in seconds.
+  void observeSince(const std::chrono::steady_clock::time_point clock_begin) {
+    observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - clock_begin)
+                .count());
+  }
+
+  const std::vector<double>& getBucketBounds() const { return bucket_bounds_; }
+
+  // Returns the cumulative count of each bucket, the last entry being the +Inf bucket.
+  std::vector<uint64_t> getCumulativeCounts() const;
+
+  double getSum() const { return sum_.load(std::memory_order_relaxed); }
+
+ private:
+  const std::vector<double> bucket_bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> bucket_counts_;
+  std::atomic<double> sum_{0};
+};
+
+// Bucket bounds, in seconds, for latencies ranging from a millisecond to a few minutes.
+const std::vector<double>& default_latency_buckets();
+
+class Registry {
+ public:
+  static Registry& instance();
+
+  /**
+   * Each of the accessors below returns the metric of the given name and labels,
+   * creating it on first use. The returned reference stays valid for the lifetime of the
+   * process. Registering the same name with a different metric type throws.
+   */
+  Counter& counter(const std::string& name,
+                   const std::string& help,
+                   const Labels& labels = {});
+
+  Gauge& gauge(const std::string& name, const std::string& help, const Labels& labels = {});
+
+  Histogram& histogram(const std::string& name,
+                       const std::string& help,
+                       const Labels& labels = {},
+                       const std::vector<double>& bucket_bounds = default_latency_buckets());
+
+  // Serializes all metrics in the Prometheus text exposition format, version 0.0.4.
+  std::string toPrometheusText() const;
+
+ private:
+  Registry() = default;
+
+  enum class MetricType { Counter, Gauge, Histogram };
+
+  struct Family {
+    MetricType type;
+    std::string help;
+    // keyed by the rendered label set, e.g. {level="cpu"}
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+  };
+
+  Family& getFamily(const std::string& name,
+                    const std::string& help,
+                    const MetricType type);
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Family> families_;
+};
+
+}  // namespace metrics
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/MetricsHttpServer.h"
+
+#include <stdexcept>
+
+#include "Logger/Logger.h"
+#include "Shared/Metrics.h"
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace metrics {
+
+MetricsHttpServer::MetricsHttpServer(const std::string& listen_address, const int port)
+    : listen_address_(listen_address), port_(port) {}
+
+MetricsHttpServer::~MetricsHttpServer() {
+  stop();
+}
+
+#ifdef _WIN32
+
+void MetricsHttpServer::start() {
+  throw std::runtime_error("The metrics endpoint is not supported on Windows.");
+}
+
+void MetricsHttpServer::stop() {}
+
+void MetricsHttpServer::serve() {}
+
+void MetricsHttpServer::handleConnection(const int connection_fd) {}
+
+#else
+
+namespace {
+
+constexpr int kPollTimeoutMs{500};
+constexpr size_t kMaxRequestSize{8192};
+
+void send_all(const int fd, const std::string& data) {
+  size_t sent{0};
+  while (sent < data.size()) {
+    const auto ret = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      VLOG(1) << "Failed to write metrics response: " << std::strerror(errno);
+      return;
+    }
+    sent += ret;
+  }
+}
+
+std::string make_response(const std::string& status,
+                          const std::string& content_type,
+                          const std::string& body) {
+  return "HTTP/1.0 " + status + "\r\nContent-Type: " + content_type +
+         "\r\nContent-Length: " + std::to_string(body.size()) +
+         "\r\nConnection: close\r\n\r\n" + body;
+}
+
+}  // namespace
+
+void MetricsHttpServer::start() {
+  CHECK(!running_);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port_);
+  if (::inet_pton(AF_INET, listen_address_.c_str(), &address.sin_addr) != 1) {
+    throw std::runtime_error("Invalid metrics listen address: " + listen_address_);
+  }
+  listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    throw std::runtime_error("Failed to create metrics socket: " +
+                             std::string(std::strerror(errno)));
+  }
+  const int reuse{1};
+  ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+      ::listen(listen_fd_, SOMAXCONN) < 0) {
+    const std::string error{std::strerror(errno)};
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    throw std::runtime_error("Failed to listen on " + listen_address_ + ":" +
+                             std::to_string(port_) + " for metrics: " + error);
+  }
+  running_ = true;
+  server_thread_ = std::thread(&MetricsHttpServer::serve, this);
+  LOG(INFO) << "Serving metrics at http://" << listen_address_ << ":" << port_
+            << "/metrics";
+}
+
+void MetricsHttpServer::stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  if (server_thread_.joinable()) {
+    server_thread_.join();
+  }
+  ::close(listen_fd_);
+  listen_fd_ = -1;
+}
+
+void MetricsHttpServer::serve() {
+  pollfd listen_poll_fd{listen_fd_, POLLIN, 0};
+  while (running_) {
+    // Wake up periodically to notice a stop request.
+    const auto ret = ::poll(&listen_poll_fd, 1, kPollTimeoutMs);
+    if (ret <= 0) {
+      continue;
+    }
+    const auto connection_fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (connection_fd < 0) {
+      continue;
+    }
+    handleConnection(connection_fd);
+    ::close(connection_fd);
+  }
+}
+
+void MetricsHttpServer::handleConnection(const int connection_fd) {
+  // Only the request line matters, read until its end or until the client stops sending.
+  std::string request;
+  char buffer[1024];
+  pollfd connection_poll_fd{connection_fd, POLLIN, 0};
+  while (request.find("\r\n") == std::string::npos && request.size() < kMaxRequestSize) {
+    if (::poll(&connection_poll_fd, 1, kPollTimeoutMs) <= 0) {
+      break;
+    }
+    const auto num_read = ::recv(connection_fd, buffer, sizeof(buffer), 0);
+    if (num_read <= 0) {
+      break;
+    }
+    request.append(buffer, num_read);
+  }
+  const auto request_line = request.substr(0, request.find("\r\n"));
+  if (request_line.rfind("GET /metrics ", 0) == 0 || request_line == "GET /metrics") {
+    send_all(connection_fd,
+             make_response("200 OK",
+                           "text/plain; version=0.0.4",
+                           Registry::instance().toPrometheusText()));
+  } else {
+    send_all(connection_fd, make_response("404 Not Found", "text/plain", "Not Found\n"));
+  }
+}
+
+#endif
+
+}  // namespace metrics
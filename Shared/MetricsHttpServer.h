@@ -0,0 +1,56 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    MetricsHttpServer.h
+ * @brief   Minimal HTTP/1.0 listener serving the metrics registry at GET /metrics.
+ *
+ * Requests are served one at a time on a single background thread. The endpoint is meant
+ * to be scraped by a local Prometheus agent and binds to the loopback address by default.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace metrics {
+
+class MetricsHttpServer {
+ public:
+  MetricsHttpServer(const std::string& listen_address, const int port);
+
+  ~MetricsHttpServer();
+
+  // Binds the listening socket and starts serving. Throws if the socket cannot be bound.
+  void start();
+
+  void stop();
+
+ private:
+  void serve();
+
+  void handleConnection(const int connection_fd);
+
+  const std::string listen_address_;
+  const int port_;
+  int listen_fd_{-1};
+  std::atomic<bool> running_{false};
+  std::thread server_thread_;
+};
+
+}  // namespace metrics
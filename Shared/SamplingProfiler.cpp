@@ -0,0 +1,576 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/SamplingProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "Logger/Logger.h"
+#include "Shared/Metrics.h"
+#include "Shared/boost_stacktrace.hpp"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace profiler {
+
+namespace {
+
+#ifdef _WIN32
+thread_local QueryTag t_query_tag;
+#else
+// Read from the signal handler, hence plain PODs with initial-exec TLS.
+thread_local QueryTag t_query_tag __attribute__((tls_model("initial-exec")));
+
+struct StackBounds {
+  uintptr_t low{0};
+  uintptr_t high{0};
+};
+
+// Bounds of the calling thread's stack, which limit the frame pointer walk of the signal
+// handler to memory that can be read. Looked up when the thread is first tagged, since
+// pthread_getattr_np is not async-signal-safe.
+thread_local StackBounds t_stack_bounds __attribute__((tls_model("initial-exec")));
+#endif
+
+void init_stack_bounds() {
+#ifndef _WIN32
+  if (t_stack_bounds.high != 0) {
+    return;
+  }
+  pthread_attr_t attr;
+  if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+    return;
+  }
+  void* stack_addr{nullptr};
+  size_t stack_size{0};
+  if (pthread_attr_getstack(&attr, &stack_addr, &stack_size) == 0) {
+    t_stack_bounds.low = reinterpret_cast<uintptr_t>(stack_addr);
+    t_stack_bounds.high = t_stack_bounds.low + stack_size;
+  }
+  pthread_attr_destroy(&attr);
+#endif
+}
+
+}  // namespace
+
+const char* to_string(const Phase phase) {
+  switch (phase) {
+    case Phase::kNone:
+      return "none";
+    case Phase::kParse:
+      return "parse";
+    case Phase::kPlan:
+      return "plan";
+    case Phase::kCodegen:
+      return "codegen";
+    case Phase::kFetch:
+      return "fetch";
+    case Phase::kKernel:
+      return "kernel";
+    case Phase::kReduce:
+      return "reduce";
+    case Phase::kSerialize:
+      return "serialize";
+  }
+  return "unknown";
+}
+
+QueryTag current_tag() {
+  return t_query_tag;
+}
+
+QueryScope::QueryScope(const uint64_t query_id) : previous_tag_(t_query_tag) {
+  init_stack_bounds();
+  t_query_tag = QueryTag{query_id, Phase::kNone};
+}
+
+QueryScope::~QueryScope() {
+  t_query_tag = previous_tag_;
+}
+
+PhaseScope::PhaseScope(const Phase phase) : previous_phase_(t_query_tag.phase) {
+  t_query_tag.phase = phase;
+}
+
+PhaseScope::~PhaseScope() {
+  t_query_tag.phase = previous_phase_;
+}
+
+ThreadTagScope::ThreadTagScope(const QueryTag tag) : previous_tag_(t_query_tag) {
+  init_stack_bounds();
+  t_query_tag = tag;
+}
+
+ThreadTagScope::~ThreadTagScope() {
+  t_query_tag = previous_tag_;
+}
+
+ExecutionScope::ExecutionScope(const uint64_t query_id)
+    : owns_query_(current_tag().query_id == 0) {
+  if (owns_query_) {
+    query_scope_.emplace(query_id);
+    query_id_ = query_id;
+  }
+}
+
+ExecutionScope::~ExecutionScope() {
+  if (owns_query_) {
+    query_scope_.reset();
+    SamplingProfiler::flushQuery(query_id_);
+  }
+}
+
+namespace {
+
+struct JitFunction {
+  uintptr_t end;
+  uint64_t object_id;
+  std::string name;
+};
+
+std::mutex jit_registry_mutex;
+// function start address -> function
+std::map<uintptr_t, JitFunction> jit_functions;
+std::unordered_map<uint64_t, std::string> jit_object_labels;
+
+// Returns the label of the generated function containing pc, or an empty string.
+std::string find_jit_function(const uintptr_t pc) {
+  std::lock_guard<std::mutex> lock(jit_registry_mutex);
+  auto it = jit_functions.upper_bound(pc);
+  if (it == jit_functions.begin()) {
+    return {};
+  }
+  --it;
+  if (pc >= it->second.end) {
+    return {};
+  }
+  const auto label_it = jit_object_labels.find(it->second.object_id);
+  const std::string label =
+      label_it == jit_object_labels.end() ? "[jit]" : "[jit " + label_it->second + "]";
+  return label + " " + it->second.name;
+}
+
+}  // namespace
+
+void register_jit_function(const uint64_t object_id,
+                           const uintptr_t address,
+                           const size_t size,
+                           const std::string& name) {
+  std::lock_guard<std::mutex> lock(jit_registry_mutex);
+  jit_functions[address] = JitFunction{address + size, object_id, name};
+}
+
+void unregister_jit_object(const uint64_t object_id) {
+  std::lock_guard<std::mutex> lock(jit_registry_mutex);
+  for (auto it = jit_functions.begin(); it != jit_functions.end();) {
+    if (it->second.object_id == object_id) {
+      it = jit_functions.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  jit_object_labels.erase(object_id);
+}
+
+void label_jit_object(const void* address, const std::string& label) {
+  const auto pc = reinterpret_cast<uintptr_t>(address);
+  std::lock_guard<std::mutex> lock(jit_registry_mutex);
+  auto it = jit_functions.upper_bound(pc);
+  if (it == jit_functions.begin()) {
+    return;
+  }
+  --it;
+  if (pc < it->second.end) {
+    jit_object_labels[it->second.object_id] = label;
+  }
+}
+
+#ifndef _WIN32
+
+namespace {
+
+constexpr size_t kMaxStackDepth{64};
+constexpr size_t kRingSize{4096};
+
+struct Sample {
+  // 0 while being written, the ring position plus one once complete
+  std::atomic<uint64_t> stamp{0};
+  QueryTag tag;
+  int depth;
+  void* pcs[kMaxStackDepth];
+};
+
+Sample sample_ring[kRingSize];
+std::atomic<uint64_t> ring_write_pos{0};
+uint64_t ring_read_pos{0};
+std::atomic<uint64_t> untagged_samples{0};
+
+std::atomic<bool> profiler_running{false};
+std::string profiles_dir;
+std::thread drain_thread;
+
+// Samples of flushed queries arriving later, e.g. from threads still tagged with the
+// query, are dropped for this long before the query id is forgotten.
+constexpr std::chrono::seconds kFlushedQueryRetention{60};
+// Samples of queries which are never flushed, e.g. because they are only tagged with a
+// QueryScope, are dropped once the query has not been sampled for this long.
+constexpr std::chrono::minutes kStaleQueryTimeout{10};
+
+using Clock = std::chrono::steady_clock;
+
+struct QuerySamples {
+  // folded stack -> sample count
+  std::map<std::string, uint64_t> stacks;
+  Clock::time_point last_sample_time;
+};
+
+// Serializes draining the ring between the drain thread and getFoldedStacks.
+std::mutex drain_mutex;
+std::mutex samples_mutex;
+std::unordered_map<uint64_t, QuerySamples> query_samples;
+// Queries handed over by flushQuery, written out by the drain thread.
+std::vector<uint64_t> pending_flushes;
+// query id -> time its samples were written out
+std::unordered_map<uint64_t, Clock::time_point> flushed_queries;
+std::unordered_map<void*, std::string> symbol_cache;
+
+// Walks the frame pointer chain of the interrupted context. Unlike backtrace(), which
+// may allocate or take the loader lock, this only reads the thread's own stack, so it
+// is async-signal-safe. Frames compiled without frame pointers end the walk early, see
+// the ENABLE_FRAME_POINTERS build option.
+int walk_stack(const void* ucontext, void** pcs, const int max_depth) {
+  const auto context = static_cast<const ucontext_t*>(ucontext);
+  uintptr_t pc{0};
+  uintptr_t fp{0};
+#if defined(__x86_64__)
+  pc = context->uc_mcontext.gregs[REG_RIP];
+  fp = context->uc_mcontext.gregs[REG_RBP];
+#elif defined(__aarch64__)
+  pc = context->uc_mcontext.pc;
+  fp = context->uc_mcontext.regs[29];
+#else
+  return 0;
+#endif
+  int depth = 0;
+  pcs[depth++] = reinterpret_cast<void*>(pc);
+  const auto bounds = t_stack_bounds;
+  // a frame record is the caller's frame pointer followed by the return address
+  while (depth < max_depth && fp % sizeof(uintptr_t) == 0 && fp >= bounds.low &&
+         fp + 2 * sizeof(uintptr_t) <= bounds.high) {
+    const auto frame = reinterpret_cast<const uintptr_t*>(fp);
+    const auto caller_fp = frame[0];
+    const auto return_address = frame[1];
+    if (return_address == 0) {
+      break;
+    }
+    pcs[depth++] = reinterpret_cast<void*>(return_address);
+    // the stack grows down, hence callers' frames are at higher addresses
+    if (caller_fp <= fp) {
+      break;
+    }
+    fp = caller_fp;
+  }
+  return depth;
+}
+
+void sigprof_handler(int, siginfo_t*, void* ucontext) {
+  const auto tag = t_query_tag;
+  if (tag.query_id == 0) {
+    untagged_samples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  const auto saved_errno = errno;
+  const auto pos = ring_write_pos.fetch_add(1, std::memory_order_relaxed);
+  auto& sample = sample_ring[pos % kRingSize];
+  sample.stamp.store(0, std::memory_order_relaxed);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  sample.tag = tag;
+  sample.depth = walk_stack(ucontext, sample.pcs, kMaxStackDepth);
+  sample.stamp.store(pos + 1, std::memory_order_release);
+  errno = saved_errno;
+}
+
+std::string symbolize(void* pc) {
+  auto name = find_jit_function(reinterpret_cast<uintptr_t>(pc));
+  if (!name.empty()) {
+    // JIT address ranges get reused by later modules, so they are never cached.
+    return name;
+  }
+  auto it = symbol_cache.find(pc);
+  if (it != symbol_cache.end()) {
+    return it->second;
+  }
+  name = boost::stacktrace::frame(pc).name();
+  // trim to plain function or template name, as in getCurrentStackTrace
+  const auto open_paren_or_angle = name.find_first_of("(<");
+  if (open_paren_or_angle != std::string::npos && open_paren_or_angle > 0) {
+    name.erase(open_paren_or_angle);
+  }
+  if (name.empty()) {
+    std::ostringstream oss;
+    oss << pc;
+    name = oss.str();
+  }
+  // ';' separates frames in the folded format
+  std::replace(name.begin(), name.end(), ';', ':');
+  symbol_cache.emplace(pc, name);
+  return name;
+}
+
+// Moves the completed samples out of the ring into the per query aggregates.
+void drain_ring() {
+  static auto& overrun_samples = metrics::Registry::instance().counter(
+      "omnisci_profiler_overrun_samples_total",
+      "Profiler samples overwritten before being aggregated.");
+  static auto& late_samples = metrics::Registry::instance().counter(
+      "omnisci_profiler_late_samples_total",
+      "Profiler samples dropped because their query was already written out.");
+  std::lock_guard<std::mutex> drain_lock(drain_mutex);
+  const auto write_pos = ring_write_pos.load(std::memory_order_acquire);
+  if (write_pos - ring_read_pos > kRingSize) {
+    overrun_samples.increment(write_pos - ring_read_pos - kRingSize);
+    ring_read_pos = write_pos - kRingSize;
+  }
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> samples_lock(samples_mutex);
+  for (; ring_read_pos < write_pos; ++ring_read_pos) {
+    auto& sample = sample_ring[ring_read_pos % kRingSize];
+    const auto stamp = sample.stamp.load(std::memory_order_acquire);
+    if (stamp == 0) {
+      // still being written, picked up by the next drain
+      break;
+    }
+    if (stamp != ring_read_pos + 1) {
+      overrun_samples.increment();
+      continue;
+    }
+    const auto tag = sample.tag;
+    if (flushed_queries.count(tag.query_id)) {
+      late_samples.increment();
+      continue;
+    }
+    const auto depth = sample.depth;
+    void* pcs[kMaxStackDepth];
+    std::copy(sample.pcs, sample.pcs + depth, pcs);
+    if (sample.stamp.load(std::memory_order_acquire) != ring_read_pos + 1) {
+      overrun_samples.increment();
+      continue;
+    }
+    std::string folded{to_string(tag.phase)};
+    for (int i = depth - 1; i >= 0; --i) {
+      folded += ";" + symbolize(pcs[i]);
+    }
+    auto& samples = query_samples[tag.query_id];
+    ++samples.stacks[folded];
+    samples.last_sample_time = now;
+  }
+}
+
+std::string to_folded_stacks(const QuerySamples& samples) {
+  std::ostringstream oss;
+  for (const auto& [stack, count] : samples.stacks) {
+    oss << stack << " " << count << "\n";
+  }
+  return oss.str();
+}
+
+void write_query_profile(const uint64_t query_id, const QuerySamples& samples) {
+  if (samples.stacks.empty()) {
+    // the query was shorter than the sampling interval
+    return;
+  }
+  const auto path = boost::filesystem::path(profiles_dir) /
+                    ("query_" + std::to_string(query_id) + ".folded");
+  std::ofstream profile_file(path.string());
+  if (!profile_file) {
+    LOG(WARNING) << "Failed to write the query profile " << path.string();
+    return;
+  }
+  profile_file << to_folded_stacks(samples);
+}
+
+/**
+ * Runs on the drain thread, so that query threads neither symbolize stacks nor write
+ * files. Writes out the queries flushed so far, after draining the samples they
+ * recorded before being flushed, and drops the samples of stale queries.
+ */
+void collect() {
+  static auto& expired_queries = metrics::Registry::instance().counter(
+      "omnisci_profiler_expired_queries_total",
+      "Queries whose profiler samples were dropped without being written out.");
+  std::vector<uint64_t> flushes;
+  {
+    std::lock_guard<std::mutex> lock(samples_mutex);
+    flushes.swap(pending_flushes);
+  }
+  drain_ring();
+
+  const auto now = Clock::now();
+  std::vector<std::pair<uint64_t, QuerySamples>> profiles;
+  {
+    std::lock_guard<std::mutex> lock(samples_mutex);
+    for (const auto query_id : flushes) {
+      flushed_queries[query_id] = now;
+      auto it = query_samples.find(query_id);
+      if (it != query_samples.end()) {
+        profiles.emplace_back(query_id, std::move(it->second));
+        query_samples.erase(it);
+      }
+    }
+    for (auto it = flushed_queries.begin(); it != flushed_queries.end();) {
+      if (now - it->second > kFlushedQueryRetention) {
+        it = flushed_queries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    for (auto it = query_samples.begin(); it != query_samples.end();) {
+      if (now - it->second.last_sample_time > kStaleQueryTimeout) {
+        expired_queries.increment();
+        it = query_samples.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (const auto& [query_id, samples] : profiles) {
+    write_query_profile(query_id, samples);
+  }
+}
+
+}  // namespace
+
+void SamplingProfiler::start(const int frequency_hz, const std::string& output_dir) {
+  if (frequency_hz <= 0) {
+    throw std::runtime_error("Invalid sampling profiler frequency " +
+                             std::to_string(frequency_hz) + " Hz.");
+  }
+  if (profiler_running) {
+    return;
+  }
+  boost::filesystem::create_directories(output_dir);
+  profiles_dir = output_dir;
+
+  struct sigaction action {};
+  action.sa_sigaction = sigprof_handler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, nullptr) != 0) {
+    throw std::runtime_error("Failed to install the SIGPROF handler: " +
+                             std::string(strerror(errno)));
+  }
+  profiler_running = true;
+  drain_thread = std::thread([] {
+    while (profiler_running) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      collect();
+    }
+  });
+
+  const auto interval_us = std::max(1000000 / frequency_hz, 1);
+  struct itimerval timer {};
+  timer.it_interval.tv_sec = interval_us / 1000000;
+  timer.it_interval.tv_usec = interval_us % 1000000;
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    const std::string error{strerror(errno)};
+    stop();
+    throw std::runtime_error("Failed to start the profiling timer: " + error);
+  }
+  LOG(INFO) << "Sampling profiler started at " << frequency_hz
+            << " Hz, writing query profiles to " << output_dir;
+}
+
+void SamplingProfiler::stop() {
+  if (!profiler_running) {
+    return;
+  }
+  struct itimerval timer {};
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  signal(SIGPROF, SIG_IGN);
+  profiler_running = false;
+  if (drain_thread.joinable()) {
+    drain_thread.join();
+  }
+  // writes out the queries flushed after the last pass of the drain thread
+  collect();
+  LOG(INFO) << "Sampling profiler stopped, "
+            << untagged_samples.load(std::memory_order_relaxed)
+            << " samples outside of queries were dropped";
+}
+
+bool SamplingProfiler::isRunning() {
+  return profiler_running;
+}
+
+std::string SamplingProfiler::getFoldedStacks(const uint64_t query_id) {
+  drain_ring();
+  std::lock_guard<std::mutex> lock(samples_mutex);
+  const auto it = query_samples.find(query_id);
+  if (it == query_samples.end()) {
+    return {};
+  }
+  return to_folded_stacks(it->second);
+}
+
+void SamplingProfiler::flushQuery(const uint64_t query_id) {
+  if (!profiler_running) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(samples_mutex);
+  pending_flushes.push_back(query_id);
+}
+
+#else
+
+void SamplingProfiler::start(const int, const std::string&) {
+  LOG(WARNING) << "The sampling profiler is not supported on Windows.";
+}
+
+void SamplingProfiler::stop() {}
+
+bool SamplingProfiler::isRunning() {
+  return false;
+}
+
+std::string SamplingProfiler::getFoldedStacks(const uint64_t) {
+  return {};
+}
+
+void SamplingProfiler::flushQuery(const uint64_t) {}
+
+#endif  // _WIN32
+
+}  // namespace profiler
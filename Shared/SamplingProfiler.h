@@ -0,0 +1,150 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    SamplingProfiler.h
+ * @brief   SIGPROF based sampling profiler attributing CPU time to queries and phases.
+ *
+ * Threads working on a query carry a thread local tag made of the query id and the
+ * current execution phase, set with QueryScope (or ExecutionScope at query entry points)
+ * and PhaseScope. Threads spawned for a
+ * query adopt the tag of their parent with ThreadTagScope. While the profiler runs, each
+ * SIGPROF tick records the stack of the interrupted thread together with its tag, and
+ * samples are aggregated per query into folded stacks, the input format of flame graph
+ * tools:
+ *
+ *   kernel;execute_rel_alg;...;[jit 3f2a] multifrag_query 42
+ *
+ * Setting tags is a couple of thread local stores, so the scopes stay in place when the
+ * profiler is not running.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace profiler {
+
+enum class Phase : uint8_t {
+  kNone,
+  kParse,
+  kPlan,
+  kCodegen,
+  kFetch,
+  kKernel,
+  kReduce,
+  kSerialize
+};
+
+const char* to_string(const Phase phase);
+
+struct QueryTag {
+  uint64_t query_id{0};
+  Phase phase{Phase::kNone};
+};
+
+QueryTag current_tag();
+
+// Tags the calling thread with the given query, restoring the previous tag on exit.
+class QueryScope {
+ public:
+  explicit QueryScope(const uint64_t query_id);
+  ~QueryScope();
+
+ private:
+  QueryTag previous_tag_;
+};
+
+// Sets the execution phase of the calling thread, restoring the previous one on exit.
+class PhaseScope {
+ public:
+  explicit PhaseScope(const Phase phase);
+  ~PhaseScope();
+
+ private:
+  Phase previous_phase_;
+};
+
+// Adopts the tag of the thread which spawned the calling thread.
+class ThreadTagScope {
+ public:
+  explicit ThreadTagScope(const QueryTag tag);
+  ~ThreadTagScope();
+
+ private:
+  QueryTag previous_tag_;
+};
+
+/**
+ * Tags the calling thread with the given query at a query execution entry point, unless
+ * an outer entry point already did, and flushes the profile of the query on exit if it
+ * set the tag.
+ */
+class ExecutionScope {
+ public:
+  explicit ExecutionScope(const uint64_t query_id);
+  ~ExecutionScope();
+
+ private:
+  const bool owns_query_;
+  uint64_t query_id_{0};
+  std::optional<QueryScope> query_scope_;
+};
+
+/**
+ * Registers the address range of a function generated by the JIT, so samples landing in
+ * generated code are labeled with the function name. object_id groups the functions of
+ * one compiled module, which can then be labeled after its code cache entry.
+ */
+void register_jit_function(const uint64_t object_id,
+                           const uintptr_t address,
+                           const size_t size,
+                           const std::string& name);
+
+void unregister_jit_object(const uint64_t object_id);
+
+// Labels the compiled module containing the given address, e.g. with its code cache key.
+void label_jit_object(const void* address, const std::string& label);
+
+class SamplingProfiler {
+ public:
+  /**
+   * Starts sampling all threads of the process at the given frequency. Folded stacks of
+   * each query are written to <output_dir>/query_<id>.folded by the collector thread
+   * once flushQuery was called.
+   */
+  static void start(const int frequency_hz, const std::string& output_dir);
+
+  // Stops sampling, after writing out the queries flushed so far.
+  static void stop();
+
+  static bool isRunning();
+
+  // Returns the folded stacks aggregated so far for the given query. Symbolizes the
+  // pending samples on the calling thread, hence meant for inspection and tests.
+  static std::string getFoldedStacks(const uint64_t query_id);
+
+  /**
+   * Hands the samples of a finished query over to the collector thread, which writes
+   * them out and drops them. Samples of the query arriving later are dropped.
+   */
+  static void flushQuery(const uint64_t query_id);
+};
+
+}  // namespace profiler
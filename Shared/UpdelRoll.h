@@ -17,9 +17,12 @@
 #define UPDELROLL_H
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "DataMgr/Chunk/Chunk.h"
 #include "DataMgr/ChunkMetadata.h"
@@ -32,7 +35,8 @@ class FragmentInfo;
 
 namespace Catalog_Namespace {
 class Catalog;
-}
+struct TableEpochInfo;
+}  // namespace Catalog_Namespace
 
 struct TableDescriptor;
 
@@ -52,6 +56,26 @@ struct UpdelRoll {
   std::map<Chunk_NS::Chunk*, std::shared_ptr<Chunk_NS::Chunk>> dirtyChunks;
   std::set<ChunkKey> dirtyChunkeys;
 
+  // Copies of the pages of a chunk holding the rows updated in place by this query
+  struct StagedChunk {
+    std::shared_ptr<Chunk_NS::Chunk> chunk;
+    // a multiple of the element size, so that elements do not straddle pages
+    size_t page_size{0};
+    // staged pages by page index, the last page of the chunk may be partial
+    std::unordered_map<size_t, std::unique_ptr<int8_t[]>> pages;
+    // byte ranges (offset, size) of data which were updated
+    std::vector<std::pair<size_t, size_t>> updated_ranges;
+
+    // Returns the staged address of the chunk data at the given offset, which has to be
+    // in a staged page.
+    int8_t* getAddress(const size_t offset) const;
+  };
+
+  // Fixed length updates are written to copies of the updated pages of the chunks, which
+  // are copied back to the chunk buffers by publishUpdate(). Until then concurrent
+  // queries keep reading the table as of the last update.
+  std::map<ChunkKey, StagedChunk> stagedChunks;
+
   // new FragmentInfo.numTuples
   std::map<MetaDataKey, size_t> numTuples;
 
@@ -65,12 +89,29 @@ struct UpdelRoll {
   Data_Namespace::MemoryLevel memoryLevel{Data_Namespace::MemoryLevel::CPU_LEVEL};
 
   bool is_varlen_update = false;
+  bool is_published = false;
   const TableDescriptor* table_descriptor{nullptr};
 
+  // Stages copies of the pages of a chunk covering the given byte ranges (offset, size),
+  // which are recorded as updated. Pages staged by earlier calls keep their updates.
+  const StagedChunk& stageChunkRanges(
+      const ChunkKey& chunk_key,
+      std::shared_ptr<Chunk_NS::Chunk> chunk,
+      const size_t element_size,
+      const std::vector<std::pair<size_t, size_t>>& updated_ranges);
+
+  // Copies the staged data of a chunk back to the chunk buffer.
+  void publishStagedChunk(const ChunkKey& chunk_key);
+
+  // Makes the data and metadata updates visible to other queries. Queries reading the
+  // table are only blocked while the staged data is copied, not for the whole update.
+  void publishUpdate();
+
   void cancelUpdate();
 
-  // Commits/checkpoints data and metadata updates. A boolean that indicates whether or
-  // not data update actually occurred is returned.
+  // Commits/checkpoints data and metadata updates, publishing them first if needed. The
+  // checkpoint does not block queries reading the table. A boolean that indicates
+  // whether or not data update actually occurred is returned.
   bool commitUpdate();
 
   // Writes chunks at the CPU memory level to storage without checkpointing at the storage
@@ -78,7 +119,14 @@ struct UpdelRoll {
   void stageUpdate();
 
  private:
+  void updateFragmenter();
   void updateFragmenterAndCleanupChunks();
+
+  // Rolls back published changes by resetting the table to the given epochs. Concurrent
+  // updates and deletes of other fragments keep their cached and staged chunks, only
+  // the chunks and fragment metadata changed by this query are reloaded.
+  void rollbackPublishedUpdate(
+      const std::vector<Catalog_Namespace::TableEpochInfo>& table_epochs);
 };
 
 #endif
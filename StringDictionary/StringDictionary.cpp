@@ -34,6 +34,7 @@
 
 #include "Logger/Logger.h"
 #include "OSDependent/omnisci_fs.h"
+#include "Shared/Metrics.h"
 #include "Shared/sqltypes.h"
 #include "Shared/thread_count.h"
 #include "StringDictionaryClient.h"
@@ -85,6 +86,31 @@ string_dict_hash_t hash_string(const std::string_view& str) {
   }
   return str_hash;
 }
+
+// Number of entries held by the pattern caches, summed over all dictionaries.
+metrics::Gauge& like_cache_entries() {
+  static auto& gauge = metrics::Registry::instance().gauge(
+      "omnisci_string_dictionary_cache_entries",
+      "Entries in the string dictionary pattern caches.",
+      {{"cache", "like"}});
+  return gauge;
+}
+
+metrics::Gauge& regex_cache_entries() {
+  static auto& gauge = metrics::Registry::instance().gauge(
+      "omnisci_string_dictionary_cache_entries",
+      "Entries in the string dictionary pattern caches.",
+      {{"cache", "regex"}});
+  return gauge;
+}
+
+metrics::Gauge& equal_cache_entries() {
+  static auto& gauge = metrics::Registry::instance().gauge(
+      "omnisci_string_dictionary_cache_entries",
+      "Entries in the string dictionary pattern caches.",
+      {{"cache", "equal"}});
+  return gauge;
+}
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
@@ -270,6 +296,9 @@ StringDictionary::StringDictionary(const LeafHostInfo& host, const DictRef dict_
 
 StringDictionary::~StringDictionary() noexcept {
   free(CANARY_BUFFER);
+  like_cache_entries().sub(like_cache_.size());
+  regex_cache_entries().sub(regex_cache_.size());
+  equal_cache_entries().sub(equal_cache_.size());
   if (client_) {
     return;
   }
@@ -680,6 +709,7 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
   const auto it_ok = like_cache_.insert(std::make_pair(cache_key, result));
 
   CHECK(it_ok.second);
+  like_cache_entries().add(1);
 
   return result;
 }
@@ -730,6 +760,7 @@ std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
     if (result.size() > 0) {
       const auto it_ok = equal_cache_.insert(std::make_pair(pattern, result[0]));
       CHECK(it_ok.second);
+      equal_cache_entries().add(1);
       eq_id = result[0];
     }
     if (comp_operator == "<>") {
@@ -948,6 +979,7 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   }
   const auto it_ok = regex_cache_.insert(std::make_pair(cache_key, result));
   CHECK(it_ok.second);
+  regex_cache_entries().add(1);
 
   return result;
 }
@@ -1372,12 +1404,15 @@ void* StringDictionary::addMemoryCapacity(void* addr,
 
 void StringDictionary::invalidateInvertedIndex() noexcept {
   if (!like_cache_.empty()) {
+    like_cache_entries().sub(like_cache_.size());
     decltype(like_cache_)().swap(like_cache_);
   }
   if (!regex_cache_.empty()) {
+    regex_cache_entries().sub(regex_cache_.size());
     decltype(regex_cache_)().swap(regex_cache_);
   }
   if (!equal_cache_.empty()) {
+    equal_cache_entries().sub(equal_cache_.size());
     decltype(equal_cache_)().swap(equal_cache_);
   }
   compare_cache_.invalidateInvertedIndex();
@@ -16,17 +16,21 @@
 
 #include "TableArchiver/TableArchiver.h"
 
+#include <archive.h>
+#include <archive_entry.h>
+
 #include <algorithm>
 #include <boost/filesystem.hpp>
-#include <boost/process.hpp>
 #include <boost/range/combine.hpp>
 #include <boost/version.hpp>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
 #include <exception>
+#include <future>
 #include <list>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -48,6 +52,10 @@ bool g_test_rollback_dump_restore{false};
 constexpr static char const* table_schema_filename = "_table.sql";
 constexpr static char const* table_oldinfo_filename = "_table.oldinfo";
 constexpr static char const* table_epoch_filename = "_table.epoch";
+constexpr static char const* table_incremental_filename = "_table.incremental";
+constexpr static char const* table_info_filename_prefix = "_table.";
+// suffix of archived page deltas of table data files in incremental archives
+constexpr static char const* data_file_pages_suffix = ".pages";
 
 #if BOOST_VERSION < 107300
 namespace std {
@@ -64,186 +72,627 @@ struct tuple_element<I, boost::tuples::cons<T, U>>
 
 namespace {
 
+// size of the blocks streamed between table files and an archive
+constexpr size_t archive_io_block_size{8 * 1024 * 1024};
+
 inline auto simple_file_closer = [](FILE* f) { std::fclose(f); };
 
+using ArchiveReadPtr = std::unique_ptr<archive, decltype(&archive_read_free)>;
+using ArchiveWritePtr = std::unique_ptr<archive, decltype(&archive_write_free)>;
+using ArchiveEntryPtr = std::unique_ptr<archive_entry, decltype(&archive_entry_free)>;
+
 inline std::string abs_path(const File_Namespace::GlobalFileMgr* global_file_mgr) {
   return boost::filesystem::canonical(global_file_mgr->getBasePath()).string();
 }
 
-inline std::string run(const std::string& cmd, const std::string& chdir = "") {
-  VLOG(3) << "running cmd: " << cmd;
-  int rcode;
-  std::error_code ec;
-  std::string output, errors;
-  const auto time_ms = measure<>::execution([&]() {
-    using namespace boost::process;
-    ipstream stdout, stderr;
-    if (!chdir.empty()) {
-      rcode = system(cmd, std_out > stdout, std_err > stderr, ec, start_dir = chdir);
-    } else {
-      rcode = system(cmd, std_out > stdout, std_err > stderr, ec);
-    }
-    std::ostringstream ss_output, ss_errors;
-    stdout >> ss_output.rdbuf();
-    stderr >> ss_errors.rdbuf();
-    output = ss_output.str();
-    errors = ss_errors.str();
-  });
-  if (rcode || ec) {
-    LOG(ERROR) << "failed cmd: " << cmd;
-    LOG(ERROR) << "exit code: " << rcode;
-    LOG(ERROR) << "error code: " << ec.value() << " - " << ec.message();
-    LOG(ERROR) << "stdout: " << output;
-    LOG(ERROR) << "stderr: " << errors;
-#if defined(__APPLE__)
-    // osx bsdtar options "--use-compress-program" and "--fast-read" together
-    // run into pipe write error after tar extracts the first occurrence of a
-    // file and closes the read end while the decompression program still writes
-    // to the pipe. bsdtar doesn't handle this situation well like gnu tar does.
-    if (1 == rcode && cmd.find("--fast-read") &&
-        (errors.find("cannot write decoded block") != std::string::npos ||
-         errors.find("Broken pipe") != std::string::npos)) {
-      // ignore this error, or lose speed advantage of "--fast-read" on osx.
-      LOG(ERROR) << "tar error ignored on osx for --fast-read";
-    } else
-#endif
-        // circumvent tar warning on reading file that is "changed as we read it".
-        // this warning results from reading a table file under concurrent inserts
-        if (1 == rcode && errors.find("changed as we read") != std::string::npos) {
-      LOG(ERROR) << "tar error ignored under concurrent inserts";
-    } else {
-      throw std::runtime_error("Failed to run command: " + cmd +
-                               "\nexit code: " + std::to_string(rcode) + "\nerrors:\n" +
-                               (rcode ? errors : ec.message()));
+inline void check_archive_status(archive* ar,
+                                 const int status,
+                                 const std::string& action) {
+  if (status >= ARCHIVE_OK) {
+    return;
+  }
+  const auto error_string = archive_error_string(ar);
+  const std::string message =
+      "Failed to " + action + ": " + (error_string ? error_string : "unknown error");
+  if (status == ARCHIVE_WARN) {
+    LOG(WARNING) << message;
+    return;
+  }
+  throw std::runtime_error(message);
+}
+
+// compression is one of the program names accepted by DUMP/RESTORE TABLE, empty for none
+void add_compression_filter(archive* ar, const std::string& compression) {
+  if (compression.empty()) {
+    return;
+  }
+  if (compression == "gzip") {
+    check_archive_status(ar, archive_write_add_filter_gzip(ar), "add gzip filter");
+  } else if (compression == "lz4") {
+    check_archive_status(ar, archive_write_add_filter_lz4(ar), "add lz4 filter");
+  } else if (compression == "zstd") {
+#if ARCHIVE_VERSION_NUMBER >= 3003003
+    check_archive_status(ar, archive_write_add_filter_zstd(ar), "add zstd filter");
+    // zstd compresses independent blocks on a pool of workers when supported by the
+    // libarchive build; fall back to a single thread otherwise.
+    const auto threads_option = "zstd:threads=" + std::to_string(cpu_threads());
+    if (archive_write_set_options(ar, threads_option.c_str()) < ARCHIVE_WARN) {
+      VLOG(1) << "Multithreaded zstd compression not supported by libarchive: "
+              << archive_error_string(ar);
     }
+#else
+    throw std::runtime_error(
+        "Compression program zstd requires libarchive 3.3.3 or later, this server was "
+        "built with libarchive " ARCHIVE_VERSION_ONLY_STRING ".");
+#endif
   } else {
-    VLOG(3) << "finished cmd: " << cmd;
-    VLOG(3) << "time: " << time_ms << " ms";
-    VLOG(3) << "stdout: " << output;
+    throw std::runtime_error("Compression program " + compression + " is not supported.");
   }
-  return output;
 }
 
-inline std::string simple_file_cat(const std::string& archive_path,
-                                   const std::string& file_name,
-                                   const std::string& compression) {
+ArchiveReadPtr open_archive_for_read(const std::string& archive_path) {
+  ArchiveReadPtr ar(archive_read_new(), archive_read_free);
+  if (!ar) {
+    throw std::runtime_error("archive_read_new failed!");
+  }
+  archive_read_support_format_tar(ar.get());
+  archive_read_support_filter_all(ar.get());
+  check_archive_status(
+      ar.get(),
+      archive_read_open_filename(ar.get(), archive_path.c_str(), archive_io_block_size),
+      "open archive " + archive_path);
+  return ar;
+}
+
+// Reads up to num_bytes of the current entry, returning less only at the end of entry.
+size_t read_entry_data(archive* ar, int8_t* buffer, const size_t num_bytes) {
+  size_t bytes_read = 0;
+  while (bytes_read < num_bytes) {
+    const auto ret = archive_read_data(ar, buffer + bytes_read, num_bytes - bytes_read);
+    if (ret < 0) {
+      check_archive_status(ar, static_cast<int>(ret), "read entry");
+      continue;
+    }
+    if (ret == 0) {
+      break;
+    }
+    bytes_read += ret;
+  }
+  return bytes_read;
+}
+
+// Returns the content of a table info file in an archive, or nullopt if not found.
+std::optional<std::string> find_archive_info_file(const std::string& archive_path,
+                                                  const std::string& file_name) {
   ddl_utils::validate_allowed_file_path(archive_path,
                                         ddl_utils::DataTransferType::IMPORT);
-#if defined(__APPLE__)
-  constexpr static auto opt_occurrence = "--fast-read";
-#else
-  constexpr static auto opt_occurrence = "--occurrence=1";
-#endif
-  boost::filesystem::path temp_dir =
-      boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
-  boost::filesystem::create_directories(temp_dir);
-  run("tar " + compression + " -xvf " + get_quoted_string(archive_path) + " " +
-          opt_occurrence + " " + file_name,
-      temp_dir.string());
-  const auto output = run("cat " + (temp_dir / file_name).string());
-  boost::filesystem::remove_all(temp_dir);
-  return output;
+  auto ar = open_archive_for_read(archive_path);
+  archive_entry* entry;
+  int status;
+  while ((status = archive_read_next_header(ar.get(), &entry)) != ARCHIVE_EOF) {
+    check_archive_status(ar.get(), status, "read archive " + archive_path);
+    const std::string entry_name = archive_entry_pathname(entry);
+    // table info files are archived before table data, so stop at the first data file
+    // rather than decompress the whole archive
+    if (!boost::starts_with(entry_name, table_info_filename_prefix)) {
+      break;
+    }
+    if (file_name != entry_name) {
+      continue;
+    }
+    std::string output(archive_entry_size(entry), '\0');
+    const auto bytes_read = read_entry_data(
+        ar.get(), reinterpret_cast<int8_t*>(output.data()), output.size());
+    output.resize(bytes_read);
+    return output;
+  }
+  return std::nullopt;
+}
+
+inline std::string simple_file_cat(const std::string& archive_path,
+                                   const std::string& file_name) {
+  const auto output = find_archive_info_file(archive_path, file_name);
+  if (!output) {
+    throw std::runtime_error("File " + file_name + " not found in archive " +
+                             archive_path);
+  }
+  return *output;
 }
 
 inline std::string get_table_schema(const std::string& archive_path,
-                                    const std::string& table,
-                                    const std::string& compression) {
-  const auto schema_str =
-      simple_file_cat(archive_path, table_schema_filename, compression);
+                                    const std::string& table) {
+  const auto schema_str = simple_file_cat(archive_path, table_schema_filename);
   std::regex regex("@T");
   return std::regex_replace(schema_str, regex, table);
 }
 
-// Adjust column ids in chunk keys in a table's data files under a temp_data_dir,
-// including files of all shards of the table. Can be slow for big files but should
-// be scale faster than refragmentizing. Table altering should be rare for olap.
-void adjust_altered_table_files(const std::string& temp_data_dir,
+// Returns the page size of a table data file, or 0 if the file is not a data file.
+// ref. FileMgr::init for hint of data file name layout
+size_t get_data_file_page_size(const std::string& file_name) {
+  std::vector<std::string> tokens;
+  boost::split(tokens, file_name, boost::is_any_of("."));
+  if (tokens.size() == 3 && MAPD_FILE_EXT == "." + tokens[2]) {
+    return boost::lexical_cast<size_t>(tokens[1]);
+  }
+  return 0;
+}
+
+// Adjust column ids in the chunk headers of the pages in buffer, which starts at a page
+// boundary of a table data file.
+// ref. FileInfo::openExistingFile for hint of chunk header layout
+void adjust_altered_table_pages(int8_t* buffer,
+                                const size_t num_bytes,
+                                const size_t page_size,
                                 const std::unordered_map<int, int>& column_ids_map) {
-  boost::filesystem::path base_path(temp_data_dir);
-  boost::filesystem::recursive_directory_iterator end_it;
-  ThreadController_NS::SimpleThreadController<> thread_controller(cpu_threads());
-  for (boost::filesystem::recursive_directory_iterator fit(base_path); fit != end_it;
-       ++fit) {
-    if (boost::filesystem::is_regular_file(fit->status())) {
-      const std::string file_path = fit->path().string();
-      const std::string file_name = fit->path().filename().string();
-      std::vector<std::string> tokens;
-      boost::split(tokens, file_name, boost::is_any_of("."));
-      // ref. FileMgr::init for hint of data file name layout
-      if (tokens.size() > 2 && MAPD_FILE_EXT == "." + tokens[2]) {
-        thread_controller.startThread([file_name, file_path, tokens, &column_ids_map] {
-          const auto page_size = boost::lexical_cast<int64_t>(tokens[1]);
-          const auto file_size = boost::filesystem::file_size(file_path);
-          std::unique_ptr<FILE, decltype(simple_file_closer)> fp(
-              std::fopen(file_path.c_str(), "r+"), simple_file_closer);
-          if (!fp) {
-            throw std::runtime_error("Failed to open " + file_path +
-                                     " for update: " + std::strerror(errno));
-          }
-          // ref. FileInfo::openExistingFile for hint of chunk header layout
-          for (size_t page = 0; page < file_size / page_size; ++page) {
-            int ints[8];
-            if (0 != std::fseek(fp.get(), page * page_size, SEEK_SET)) {
-              throw std::runtime_error("Failed to seek to page# " + std::to_string(page) +
-                                       file_path + " for read: " + std::strerror(errno));
-            }
-            if (1 != fread(ints, sizeof ints, 1, fp.get())) {
-              throw std::runtime_error("Failed to read " + file_path + ": " +
-                                       std::strerror(errno));
-            }
-            if (ints[0] > 0) {  // header size
-              auto cit = column_ids_map.find(ints[3]);
-              CHECK(cit != column_ids_map.end());
-              if (ints[3] != cit->second) {
-                ints[3] = cit->second;
-                if (0 != std::fseek(fp.get(), page * page_size, SEEK_SET)) {
-                  throw std::runtime_error("Failed to seek to page# " +
-                                           std::to_string(page) + file_path +
-                                           " for write: " + std::strerror(errno));
-                }
-                if (1 != fwrite(ints, sizeof ints, 1, fp.get())) {
-                  throw std::runtime_error("Failed to write " + file_path + ": " +
-                                           std::strerror(errno));
-                }
-              }
-            }
-          }
-        });
-        thread_controller.checkThreadsStatus();
+  for (size_t offset = 0; offset + page_size <= num_bytes; offset += page_size) {
+    auto ints = reinterpret_cast<int*>(buffer + offset);
+    if (ints[0] > 0) {  // header size
+      auto cit = column_ids_map.find(ints[3]);
+      CHECK(cit != column_ids_map.end());
+      ints[3] = cit->second;
+    }
+  }
+}
+
+enum class PageDeltaType : int8_t { kFree, kUnchanged, kChanged };
+
+// Classifies a page of a table data file against the epoch of a base dump, given the
+// leading ints of the page header.
+// ref. FileBuffer::writeHeader and FileInfo::openExistingFile for the header layout
+PageDeltaType get_page_delta_type(const int32_t* ints,
+                                  const size_t num_ints,
+                                  const int32_t since_epoch) {
+  if (ints[0] == 0) {  // header size
+    return PageDeltaType::kFree;
+  }
+  if (ints[1] == File_Namespace::DELETE_CONTINGENT ||
+      ints[1] == File_Namespace::ROLLOFF_CONTINGENT) {
+    // a page freed at epoch ints[2], which FileInfo::openExistingFile clears once that
+    // epoch is checkpointed
+    return ints[2] > since_epoch ? PageDeltaType::kChanged : PageDeltaType::kFree;
+  }
+  // version epoch is the last int of the header
+  const size_t epoch_idx = ints[0] / sizeof(int32_t);
+  CHECK_LT(epoch_idx, num_ints);
+  return ints[epoch_idx] > since_epoch ? PageDeltaType::kChanged
+                                       : PageDeltaType::kUnchanged;
+}
+
+void write_entry_header(archive* ar,
+                        const boost::filesystem::path& file_path,
+                        const std::string& entry_name,
+                        const size_t entry_size) {
+  ArchiveEntryPtr entry(archive_entry_new(), archive_entry_free);
+  archive_entry_set_pathname(entry.get(), entry_name.c_str());
+  archive_entry_set_filetype(entry.get(), AE_IFREG);
+  archive_entry_set_perm(entry.get(), 0644);
+  archive_entry_set_size(entry.get(), entry_size);
+  archive_entry_set_mtime(entry.get(), boost::filesystem::last_write_time(file_path), 0);
+  check_archive_status(
+      ar, archive_write_header(ar, entry.get()), "write header of " + entry_name);
+}
+
+void write_entry_data(archive* ar,
+                      const int8_t* buffer,
+                      const size_t num_bytes,
+                      const std::string& entry_name) {
+  if (archive_write_data(ar, buffer, num_bytes) < 0) {
+    check_archive_status(ar, ARCHIVE_FATAL, "write " + entry_name);
+  }
+}
+
+inline std::unique_ptr<FILE, decltype(simple_file_closer)> open_file(
+    const boost::filesystem::path& file_path,
+    const char* mode) {
+  std::unique_ptr<FILE, decltype(simple_file_closer)> fp(
+      std::fopen(file_path.string().c_str(), mode), simple_file_closer);
+  if (!fp) {
+    throw std::runtime_error("Failed to open " + file_path.string() + ": " +
+                             std::strerror(errno));
+  }
+  return fp;
+}
+
+inline void seek_file(FILE* fp,
+                      const boost::filesystem::path& file_path,
+                      const size_t offset) {
+  if (std::fseek(fp, offset, SEEK_SET) != 0) {
+    throw std::runtime_error("Failed to seek in " + file_path.string() + ": " +
+                             std::strerror(errno));
+  }
+}
+
+// Streams a file into the archive. The next block is read from disk while the current
+// one is being compressed.
+void archive_file(archive* ar,
+                  const boost::filesystem::path& file_path,
+                  const std::string& entry_name) {
+  // table files may grow under concurrent inserts, archive what exists at this point
+  const auto file_size = boost::filesystem::file_size(file_path);
+  write_entry_header(ar, file_path, entry_name, file_size);
+
+  auto fp = open_file(file_path, "rb");
+  std::vector<int8_t> buffers[2];
+  auto read_block = [&fp, &buffers](const size_t buffer_idx, const size_t num_bytes) {
+    buffers[buffer_idx].resize(num_bytes);
+    return std::fread(buffers[buffer_idx].data(), 1, num_bytes, fp.get());
+  };
+  size_t bytes_left = file_size;
+  size_t buffer_idx = 0;
+  auto next_block = std::async(std::launch::async,
+                               read_block,
+                               buffer_idx,
+                               std::min(bytes_left, archive_io_block_size));
+  while (bytes_left > 0) {
+    const auto bytes_read = next_block.get();
+    if (bytes_read == 0) {
+      throw std::runtime_error("Failed to read " + file_path.string() + ": " +
+                               std::strerror(errno));
+    }
+    bytes_left -= bytes_read;
+    const auto current_idx = buffer_idx;
+    buffer_idx ^= 1;
+    if (bytes_left > 0) {
+      next_block = std::async(std::launch::async,
+                              read_block,
+                              buffer_idx,
+                              std::min(bytes_left, archive_io_block_size));
+    }
+    write_entry_data(ar, buffers[current_idx].data(), bytes_read, entry_name);
+  }
+}
+
+// Archives the pages of a table data file that changed after since_epoch. The entry
+// holds the number of pages of the file, the PageDeltaType of each page, then the
+// content of the changed pages in page order.
+void archive_file_pages(archive* ar,
+                        const boost::filesystem::path& file_path,
+                        const std::string& entry_name,
+                        const size_t page_size,
+                        const int32_t since_epoch) {
+  auto fp = open_file(file_path, "rb");
+  const uint64_t num_pages = boost::filesystem::file_size(file_path) / page_size;
+  std::vector<PageDeltaType> page_types(num_pages);
+  size_t num_changed_pages = 0;
+  for (size_t page_num = 0; page_num < num_pages; ++page_num) {
+    constexpr size_t MAX_INTS_TO_READ{10};
+    int32_t ints[MAX_INTS_TO_READ];
+    seek_file(fp.get(), file_path, page_num * page_size);
+    if (std::fread(ints, sizeof(int32_t), MAX_INTS_TO_READ, fp.get()) <
+        MAX_INTS_TO_READ) {
+      throw std::runtime_error("Failed to read " + file_path.string() + ": " +
+                               std::strerror(errno));
+    }
+    page_types[page_num] = get_page_delta_type(ints, MAX_INTS_TO_READ, since_epoch);
+    if (page_types[page_num] == PageDeltaType::kChanged) {
+      ++num_changed_pages;
+    }
+  }
+  write_entry_header(ar,
+                     file_path,
+                     entry_name,
+                     sizeof(num_pages) + num_pages * sizeof(PageDeltaType) +
+                         num_changed_pages * page_size);
+  write_entry_data(
+      ar, reinterpret_cast<const int8_t*>(&num_pages), sizeof(num_pages), entry_name);
+  write_entry_data(ar,
+                   reinterpret_cast<const int8_t*>(page_types.data()),
+                   num_pages * sizeof(PageDeltaType),
+                   entry_name);
+  std::vector<int8_t> page(page_size);
+  for (size_t page_num = 0; page_num < num_pages; ++page_num) {
+    if (page_types[page_num] != PageDeltaType::kChanged) {
+      continue;
+    }
+    seek_file(fp.get(), file_path, page_num * page_size);
+    if (std::fread(page.data(), 1, page_size, fp.get()) < page_size) {
+      throw std::runtime_error("Failed to read " + file_path.string() + ": " +
+                               std::strerror(errno));
+    }
+    write_entry_data(ar, page.data(), page_size, entry_name);
+  }
+}
+
+// Archives the given files and directories (relative to base_path) in process. If
+// since_epoch is set, only the pages of table data files that changed after that epoch
+// are archived.
+void write_archive(const std::string& archive_path,
+                   const std::string& base_path,
+                   const std::vector<std::string>& file_paths,
+                   const std::string& compression,
+                   const std::optional<int32_t> since_epoch) {
+  ArchiveWritePtr ar(archive_write_new(), archive_write_free);
+  if (!ar) {
+    throw std::runtime_error("archive_write_new failed!");
+  }
+  check_archive_status(
+      ar.get(), archive_write_set_format_pax_restricted(ar.get()), "set tar format");
+  add_compression_filter(ar.get(), compression);
+  check_archive_status(ar.get(),
+                       archive_write_open_filename(ar.get(), archive_path.c_str()),
+                       "create archive " + archive_path);
+  const boost::filesystem::path base(base_path);
+  for (const auto& file_path : file_paths) {
+    const auto path = base / file_path;
+    if (!boost::filesystem::is_directory(path)) {
+      archive_file(ar.get(), path, file_path);
+      continue;
+    }
+    boost::filesystem::recursive_directory_iterator end_it;
+    for (boost::filesystem::recursive_directory_iterator fit(path); fit != end_it;
+         ++fit) {
+      if (!boost::filesystem::is_regular_file(fit->status())) {
+        continue;
+      }
+      const auto entry_name = boost::filesystem::relative(fit->path(), base).string();
+      const auto page_size =
+          since_epoch ? get_data_file_page_size(fit->path().filename().string()) : 0;
+      if (page_size) {
+        archive_file_pages(ar.get(),
+                           fit->path(),
+                           entry_name + data_file_pages_suffix,
+                           page_size,
+                           *since_epoch);
+      } else {
+        archive_file(ar.get(), fit->path(), entry_name);
       }
     }
   }
-  thread_controller.finish();
+  check_archive_status(ar.get(), archive_write_close(ar.get()), "close " + archive_path);
 }
 
-void rename_table_directories(const File_Namespace::GlobalFileMgr* global_file_mgr,
-                              const std::string& temp_data_dir,
-                              const std::vector<std::string>& target_paths,
-                              const std::string& name_prefix) {
+// Extracts the current archive entry to file_path. The next block is decompressed while
+// the current one is being written to disk. If column_ids_map is not empty, column ids
+// in chunk headers of table data files are remapped on the fly.
+void extract_file(archive* ar,
+                  const boost::filesystem::path& file_path,
+                  const std::unordered_map<int, int>& column_ids_map) {
+  const auto page_size = column_ids_map.empty()
+                             ? 0
+                             : get_data_file_page_size(file_path.filename().string());
+  // blocks must start at page boundaries so that whole headers are seen
+  const auto block_size = page_size ? std::max(page_size,
+                                               archive_io_block_size / page_size *
+                                                   page_size)
+                                    : archive_io_block_size;
+  auto fp = open_file(file_path, "wb");
+  std::vector<int8_t> buffers[2]{std::vector<int8_t>(block_size),
+                                 std::vector<int8_t>(block_size)};
+  auto write_block = [&fp, &buffers, &file_path](const size_t buffer_idx,
+                                                 const size_t num_bytes) {
+    if (std::fwrite(buffers[buffer_idx].data(), 1, num_bytes, fp.get()) < num_bytes) {
+      throw std::runtime_error("Failed to write " + file_path.string() + ": " +
+                               std::strerror(errno));
+    }
+  };
+  std::future<void> pending_write;
+  size_t buffer_idx = 0;
+  while (true) {
+    const auto bytes_read = read_entry_data(ar, buffers[buffer_idx].data(), block_size);
+    if (bytes_read == 0) {
+      break;
+    }
+    if (page_size) {
+      adjust_altered_table_pages(
+          buffers[buffer_idx].data(), bytes_read, page_size, column_ids_map);
+    }
+    if (pending_write.valid()) {
+      pending_write.get();
+    }
+    pending_write =
+        std::async(std::launch::async, write_block, buffer_idx, bytes_read);
+    buffer_idx ^= 1;
+  }
+  if (pending_write.valid()) {
+    pending_write.get();
+  }
+}
+
+// Extracts all files of an archive under dest_dir in process.
+void extract_archive(const std::string& archive_path,
+                     const std::string& dest_dir,
+                     const std::unordered_map<int, int>& column_ids_map) {
+  auto ar = open_archive_for_read(archive_path);
+  const boost::filesystem::path dest(dest_dir);
+  archive_entry* entry;
+  int status;
+  while ((status = archive_read_next_header(ar.get(), &entry)) != ARCHIVE_EOF) {
+    check_archive_status(ar.get(), status, "read archive " + archive_path);
+    const auto entry_path = boost::filesystem::path(archive_entry_pathname(entry));
+    if (entry_path.is_absolute() ||
+        std::find(entry_path.begin(), entry_path.end(), "..") != entry_path.end()) {
+      throw std::runtime_error("Invalid file path " + entry_path.string() +
+                               " in archive " + archive_path);
+    }
+    const auto file_path = dest / entry_path;
+    if (archive_entry_filetype(entry) == AE_IFDIR) {
+      boost::filesystem::create_directories(file_path);
+    } else if (archive_entry_filetype(entry) == AE_IFREG) {
+      boost::filesystem::create_directories(file_path.parent_path());
+      extract_file(ar.get(), file_path, column_ids_map);
+    }
+  }
+}
+
+// Pairs the table directories extracted to temp_data_dir with their target paths.
+std::vector<std::pair<boost::filesystem::path, std::string>> get_table_directory_pairs(
+    const File_Namespace::GlobalFileMgr* global_file_mgr,
+    const std::string& temp_data_dir,
+    const std::vector<std::string>& target_paths,
+    const std::string& name_prefix) {
+  std::vector<std::pair<boost::filesystem::path, std::string>> directory_pairs;
   boost::filesystem::path base_path(temp_data_dir);
   boost::filesystem::directory_iterator end_it;
-  int target_path_index = 0;
   for (boost::filesystem::directory_iterator fit(base_path); fit != end_it; ++fit) {
     if (!boost::filesystem::is_regular_file(fit->status())) {
-      const std::string file_path = fit->path().string();
       const std::string file_name = fit->path().filename().string();
       if (boost::istarts_with(file_name, name_prefix)) {
-        const std::string target_path =
-            abs_path(global_file_mgr) + "/" + target_paths[target_path_index++];
-        if (std::rename(file_path.c_str(), target_path.c_str())) {
-          throw std::runtime_error("Failed to rename file " + file_path + " to " +
-                                   target_path + ": " + std::strerror(errno));
+        CHECK_LT(directory_pairs.size(), target_paths.size());
+        directory_pairs.emplace_back(
+            fit->path(),
+            abs_path(global_file_mgr) + "/" + target_paths[directory_pairs.size()]);
+      }
+    }
+  }
+  return directory_pairs;
+}
+
+void rename_table_directories(const File_Namespace::GlobalFileMgr* global_file_mgr,
+                              const std::string& temp_data_dir,
+                              const std::vector<std::string>& target_paths,
+                              const std::string& name_prefix) {
+  for (const auto& [src_path, target_path] : get_table_directory_pairs(
+           global_file_mgr, temp_data_dir, target_paths, name_prefix)) {
+    const std::string file_path = src_path.string();
+    if (std::rename(file_path.c_str(), target_path.c_str())) {
+      throw std::runtime_error("Failed to rename file " + file_path + " to " +
+                               target_path + ": " + std::strerror(errno));
+    }
+  }
+}
+
+inline std::runtime_error incremental_mismatch_error(const std::string& file_path) {
+  return std::runtime_error("Incremental archive does not match table file " +
+                            file_path + ". Restore the table from a full dump first.");
+}
+
+// Applies the page delta archived by archive_file_pages to a table data file, which may
+// be a hard link to a file of the current table. The link is replaced by a private copy
+// before any page is written.
+void apply_file_pages(const boost::filesystem::path& pages_path,
+                      const boost::filesystem::path& file_path,
+                      const size_t page_size,
+                      const std::unordered_map<int, int>& column_ids_map) {
+  auto pages_fp = open_file(pages_path, "rb");
+  uint64_t num_pages;
+  if (std::fread(&num_pages, sizeof(num_pages), 1, pages_fp.get()) < 1) {
+    throw std::runtime_error("Failed to read " + pages_path.string());
+  }
+  std::vector<PageDeltaType> page_types(num_pages);
+  if (std::fread(page_types.data(), sizeof(PageDeltaType), num_pages, pages_fp.get()) <
+      num_pages) {
+    throw std::runtime_error("Failed to read " + pages_path.string());
+  }
+  // data files only ever grow, by whole pages which are initially free
+  const size_t file_num_pages = boost::filesystem::exists(file_path)
+                                    ? boost::filesystem::file_size(file_path) / page_size
+                                    : 0;
+  if (file_num_pages > num_pages) {
+    throw incremental_mismatch_error(file_path.string());
+  }
+  // validate the delta against the current file and find out whether it changes it
+  std::vector<int32_t> header_sizes(file_num_pages);
+  if (file_num_pages) {
+    auto fp = open_file(file_path, "rb");
+    for (size_t page_num = 0; page_num < file_num_pages; ++page_num) {
+      File_Namespace::read(fp.get(),
+                           page_num * page_size,
+                           sizeof(int32_t),
+                           reinterpret_cast<int8_t*>(&header_sizes[page_num]));
+    }
+  }
+  bool is_file_changed = file_num_pages < num_pages;
+  for (size_t page_num = 0; page_num < num_pages; ++page_num) {
+    const int32_t header_size = page_num < file_num_pages ? header_sizes[page_num] : 0;
+    switch (page_types[page_num]) {
+      case PageDeltaType::kFree:
+        is_file_changed = is_file_changed || header_size;
+        break;
+      case PageDeltaType::kUnchanged:
+        // the page must still be in use since the base dump
+        if (!header_size) {
+          throw incremental_mismatch_error(file_path.string());
         }
+        break;
+      case PageDeltaType::kChanged:
+        is_file_changed = true;
+        break;
+      default:
+        throw std::runtime_error("Invalid page delta in " + pages_path.string());
+    }
+  }
+  if (!is_file_changed) {
+    return;
+  }
+  if (file_num_pages) {
+    const auto copy_path = file_path.string() + ".copy";
+    boost::filesystem::copy_file(file_path, copy_path);
+    boost::filesystem::rename(copy_path, file_path);
+  } else {
+    open_file(file_path, "wb");
+  }
+  boost::filesystem::resize_file(file_path, num_pages * page_size);
+  auto fp = open_file(file_path, "r+b");
+  std::vector<int8_t> page(page_size);
+  for (size_t page_num = 0; page_num < num_pages; ++page_num) {
+    if (page_types[page_num] == PageDeltaType::kFree) {
+      if (page_num < file_num_pages && header_sizes[page_num]) {
+        int32_t zero{0};
+        File_Namespace::write(fp.get(),
+                              page_num * page_size,
+                              sizeof(int32_t),
+                              reinterpret_cast<int8_t*>(&zero));
+      }
+    } else if (page_types[page_num] == PageDeltaType::kChanged) {
+      if (std::fread(page.data(), 1, page_size, pages_fp.get()) < page_size) {
+        throw std::runtime_error("Failed to read " + pages_path.string());
       }
+      if (!column_ids_map.empty()) {
+        adjust_altered_table_pages(page.data(), page_size, page_size, column_ids_map);
+      }
+      File_Namespace::write(fp.get(), page_num * page_size, page_size, page.data());
     }
   }
 }
 
+// Completes a table directory extracted from an incremental archive to src_dir with the
+// current data files of the table in dst_dir. The current files are hard linked and
+// only the ones changed by the page deltas are copied, so the current table stays
+// intact until the directories are swapped.
+void merge_incremental_table_directory(
+    const boost::filesystem::path& src_dir,
+    const boost::filesystem::path& dst_dir,
+    const std::unordered_map<int, int>& column_ids_map) {
+  boost::filesystem::directory_iterator end_it;
+  if (boost::filesystem::is_directory(dst_dir)) {
+    for (boost::filesystem::directory_iterator fit(dst_dir); fit != end_it; ++fit) {
+      const auto file_name = fit->path().filename().string();
+      if (!boost::filesystem::is_regular_file(fit->status()) ||
+          !get_data_file_page_size(file_name)) {
+        continue;
+      }
+      if (!boost::filesystem::exists(src_dir / (file_name + data_file_pages_suffix))) {
+        // the source table no longer has this file, e.g. it was compacted
+        throw incremental_mismatch_error(fit->path().string());
+      }
+      boost::system::error_code ec;
+      boost::filesystem::create_hard_link(fit->path(), src_dir / file_name, ec);
+      if (ec) {
+        boost::filesystem::copy_file(fit->path(), src_dir / file_name);
+      }
+    }
+  }
+  std::vector<boost::filesystem::path> pages_paths;
+  for (boost::filesystem::directory_iterator fit(src_dir); fit != end_it; ++fit) {
+    if (fit->path().extension() == data_file_pages_suffix) {
+      pages_paths.push_back(fit->path());
+    }
+  }
+  for (const auto& pages_path : pages_paths) {
+    const auto file_path = src_dir / pages_path.stem();
+    const auto page_size = get_data_file_page_size(file_path.filename().string());
+    CHECK_GT(page_size, size_t(0));
+    apply_file_pages(pages_path, file_path, page_size, column_ids_map);
+    boost::filesystem::remove(pages_path);
+  }
+}
+
 }  // namespace
 
 void TableArchiver::dumpTable(const TableDescriptor* td,
                               const std::string& archive_path,
-                              const std::string& compression) {
+                              const std::string& compression,
+                              const std::optional<int32_t> incremental_since_epoch) {
   ddl_utils::validate_allowed_file_path(archive_path,
                                         ddl_utils::DataTransferType::EXPORT);
   if (g_cluster) {
@@ -298,18 +747,36 @@ void TableArchiver::dumpTable(const TableDescriptor* td,
     // - gen table epoch
     const auto epoch = cat_->getTableEpoch(cat_->getCurrentDB().dbId, td->tableId);
     file_writer(table_epoch_filename, "table epoch", std::to_string(epoch));
+    // - gen base epoch of an incremental dump
+    if (incremental_since_epoch) {
+      if (*incremental_since_epoch < 0 || *incremental_since_epoch > epoch) {
+        throw std::runtime_error("Incremental dump epoch " +
+                                 std::to_string(*incremental_since_epoch) +
+                                 " is out of range of table epoch " +
+                                 std::to_string(epoch) + ".");
+      }
+      file_writer(table_incremental_filename,
+                  "table incremental epoch",
+                  std::to_string(*incremental_since_epoch));
+    }
     // - collect table data file paths ...
     const auto data_file_dirs = cat_->getTableDataDirectories(td);
     file_paths.insert(file_paths.end(), data_file_dirs.begin(), data_file_dirs.end());
     // - collect table dict file paths ...
     const auto dict_file_dirs = cat_->getTableDictDirectories(td);
     file_paths.insert(file_paths.end(), dict_file_dirs.begin(), dict_file_dirs.end());
-    // tar takes time. release cat lock to yield the cat to concurrent CREATE statements.
+    // archiving takes time. release cat lock to yield the cat to concurrent CREATE
+    // statements.
   }
-  // run tar to archive the files ... this may take a while !!
-  run("tar " + compression + " -cvf " + get_quoted_string(archive_path) + " " +
-          boost::algorithm::join(file_paths, " "),
-      abs_path(global_file_mgr));
+  // archive the files ... this may take a while !!
+  const auto time_ms = measure<>::execution([&]() {
+    write_archive(archive_path,
+                  abs_path(global_file_mgr),
+                  file_paths,
+                  compression,
+                  incremental_since_epoch);
+  });
+  VLOG(3) << "write_archive: " << time_ms << " ms";
 }
 
 // Restore data and dict files of a table from a tgz archive.
@@ -328,10 +795,19 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
   if (td->isView || td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL) {
     throw std::runtime_error("Restoring view or temporary table is not supported.");
   }
-  // Obtain table schema read lock to prevent modification of the schema during
-  // restoration
-  const auto table_read_lock =
-      lockmgr::TableSchemaLockMgr::getReadLockForTable(*cat_, td->tableName);
+  // an incremental archive is applied onto a live table, so it takes the schema write
+  // lock like TRUNCATE. Otherwise obtain the table schema read lock to prevent
+  // modification of the schema during restoration.
+  const auto is_incremental = isIncrementalArchive(archive_path);
+  std::optional<lockmgr::WriteLock> table_write_lock;
+  std::optional<lockmgr::ReadLock> table_read_lock;
+  if (is_incremental) {
+    table_write_lock.emplace(
+        lockmgr::TableSchemaLockMgr::getWriteLockForTable(*cat_, td->tableName));
+  } else {
+    table_read_lock.emplace(
+        lockmgr::TableSchemaLockMgr::getReadLockForTable(*cat_, td->tableName));
+  }
   // prevent concurrent inserts into table during restoration
   const auto insert_data_lock =
       lockmgr::InsertDataLockMgr::getWriteLockForTable(*cat_, td->tableName);
@@ -345,15 +821,20 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
   const auto temp_back_dir = abs_path(global_file_mgr) + "/" + temp_back_basename;
   // clean up tmp dirs and files in any case
   auto tmp_files_cleaner = [&](void*) {
-    run("rm -rf " + temp_data_dir + " " + temp_back_dir);
-    run("rm -f " + abs_path(global_file_mgr) + "/" + table_schema_filename);
-    run("rm -f " + abs_path(global_file_mgr) + "/" + table_oldinfo_filename);
-    run("rm -f " + abs_path(global_file_mgr) + "/" + table_epoch_filename);
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(temp_data_dir, ec);
+    boost::filesystem::remove_all(temp_back_dir, ec);
+    for (const auto file_name : {table_schema_filename,
+                                 table_oldinfo_filename,
+                                 table_epoch_filename,
+                                 table_incremental_filename}) {
+      boost::filesystem::remove(abs_path(global_file_mgr) + "/" + file_name, ec);
+    }
   };
   std::unique_ptr<decltype(tmp_files_cleaner), decltype(tmp_files_cleaner)> tfc(
       &tmp_files_cleaner, tmp_files_cleaner);
   // extract & parse schema
-  const auto schema_str = get_table_schema(archive_path, td->tableName, compression);
+  const auto schema_str = get_table_schema(archive_path, td->tableName);
   const auto create_table_stmt =
       Parser::parseDDL<Parser::CreateTableStmt>("table schema", schema_str);
   // verify compatibility between source and destination schemas
@@ -387,7 +868,7 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
   }
   // extract src table column ids (ALL columns incl. system/virtual/phy geo cols)
   const auto all_src_oldinfo_str =
-      simple_file_cat(archive_path, table_oldinfo_filename, compression);
+      simple_file_cat(archive_path, table_oldinfo_filename);
   std::vector<std::string> src_oldinfo_strs;
   boost::algorithm::split(src_oldinfo_strs,
                           all_src_oldinfo_str,
@@ -440,20 +921,50 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
     was_table_altered = was_table_altered || it.first != it.second;
   });
   VLOG(3) << "was_table_altered = " << was_table_altered;
+  // an incremental archive applies only to the table state it was dumped against
+  const auto incremental_epoch_str =
+      find_archive_info_file(archive_path, table_incremental_filename);
+  if (incremental_epoch_str) {
+    const auto since_epoch = boost::lexical_cast<int32_t>(*incremental_epoch_str);
+    const auto table_epoch = cat_->getTableEpoch(cat_->getCurrentDB().dbId, td->tableId);
+    if (since_epoch != table_epoch) {
+      throw std::runtime_error("Incremental archive " + archive_path +
+                               " applies to table epoch " + std::to_string(since_epoch) +
+                               " but table " + td->tableName + " is at epoch " +
+                               std::to_string(table_epoch) + ".");
+    }
+  }
   // extract all data files to a temp dir. will swap with dst table dir after all set,
   // otherwise will corrupt table in case any bad thing happens in the middle.
-  run("rm -rf " + temp_data_dir);
-  run("mkdir -p " + temp_data_dir);
-  run("tar " + compression + " -xvf " + get_quoted_string(archive_path), temp_data_dir);
-  // if table was ever altered after it was created, update column ids in chunk headers.
-  if (was_table_altered) {
-    const auto time_ms = measure<>::execution(
-        [&]() { adjust_altered_table_files(temp_data_dir, column_ids_map); });
-    VLOG(3) << "adjust_altered_table_files: " << time_ms << " ms";
-  }
+  // if table was ever altered after it was created, column ids in chunk headers are
+  // updated while the data files are extracted.
+  boost::filesystem::remove_all(temp_data_dir);
+  boost::filesystem::create_directories(temp_data_dir);
+  const auto time_ms = measure<>::execution([&]() {
+    extract_archive(archive_path,
+                    temp_data_dir,
+                    was_table_altered ? column_ids_map : std::unordered_map<int, int>{});
+  });
+  VLOG(3) << "extract_archive: " << time_ms << " ms";
+  // keep queries off the table files until they are swapped and reloaded
+  const auto table_data_write_lock =
+      lockmgr::TableDataLockMgr::getWriteLockForTable(*cat_, td->tableName);
   // finally,,, swap table data/dict dirs!
   const auto data_file_dirs = cat_->getTableDataDirectories(td);
   const auto dict_file_dirs = cat_->getTableDictDirectories(td);
+  // complete the page deltas of an incremental archive with current table files
+  if (incremental_epoch_str) {
+    const auto time_ms = measure<>::execution([&]() {
+      for (const auto& [src_path, dst_path] : get_table_directory_pairs(
+               global_file_mgr, temp_data_dir, data_file_dirs, "table_")) {
+        merge_incremental_table_directory(
+            src_path,
+            dst_path,
+            was_table_altered ? column_ids_map : std::unordered_map<int, int>{});
+      }
+    });
+    VLOG(3) << "merge_incremental_table_directory: " << time_ms << " ms";
+  }
   // move current target dirs, if exists, to backup dir
   std::vector<std::string> both_file_dirs;
   std::merge(data_file_dirs.begin(),
@@ -463,12 +974,12 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
              std::back_inserter(both_file_dirs));
   bool backup_completed = false;
   try {
-    run("rm -rf " + temp_back_dir);
-    run("mkdir -p " + temp_back_dir);
+    boost::filesystem::remove_all(temp_back_dir);
+    boost::filesystem::create_directories(temp_back_dir);
     for (const auto& dir : both_file_dirs) {
       const auto dir_full_path = abs_path(global_file_mgr) + "/" + dir;
       if (boost::filesystem::is_directory(dir_full_path)) {
-        run("mv " + dir_full_path + " " + temp_back_dir);
+        boost::filesystem::rename(dir_full_path, temp_back_dir + "/" + dir);
       }
     }
     backup_completed = true;
@@ -480,7 +991,7 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
       if (!dit.first.empty() && !dit.second.empty()) {
         const auto src_dict_path = temp_data_dir + "/" + dit.first;
         const auto dst_dict_path = abs_path(global_file_mgr) + "/" + dit.second;
-        run("mv " + src_dict_path + " " + dst_dict_path);
+        boost::filesystem::rename(src_dict_path, dst_dict_path);
       }
     }
     // throw if sanity test forces a rollback
@@ -491,21 +1002,27 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
     // once backup is completed, whatever in abs_path(global_file_mgr) is the "src"
     // dirs that are to be rolled back and discarded
     if (backup_completed) {
-      run("rm -rf " + boost::algorithm::join(both_file_dirs, " "),
-          abs_path(global_file_mgr));
+      for (const auto& dir : both_file_dirs) {
+        boost::filesystem::remove_all(abs_path(global_file_mgr) + "/" + dir);
+      }
     }
     // complete rollback by recovering original "dst" table dirs from backup dir
     boost::filesystem::path base_path(temp_back_dir);
     boost::filesystem::directory_iterator end_it;
     for (boost::filesystem::directory_iterator fit(base_path); fit != end_it; ++fit) {
-      run("mv " + fit->path().string() + " .", abs_path(global_file_mgr));
+      boost::filesystem::rename(
+          fit->path(), abs_path(global_file_mgr) + "/" + fit->path().filename().string());
     }
     throw;
   }
   // set for reloading table from the restored/migrated files
-  const auto epoch = simple_file_cat(archive_path, table_epoch_filename, compression);
+  const auto epoch = simple_file_cat(archive_path, table_epoch_filename);
   cat_->setTableEpoch(
       cat_->getCurrentDB().dbId, td->tableId, boost::lexical_cast<int>(epoch));
+  // the loaded dictionaries of a live table miss the strings added by the delta
+  if (is_incremental) {
+    cat_->reloadTableDictionaries(td);
+  }
 }
 
 // Migrate a table, which doesn't exist in current db, from a tar ball to the db.
@@ -514,8 +1031,12 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
                                  const std::string& table_name,
                                  const std::string& archive_path,
                                  const std::string& compression) {
+  if (isIncrementalArchive(archive_path)) {
+    throw std::runtime_error("Incremental archive " + archive_path +
+                             " can only be restored into an existing table.");
+  }
   // replace table name and drop foreign dict references
-  const auto schema_str = get_table_schema(archive_path, table_name, compression);
+  const auto schema_str = get_table_schema(archive_path, table_name);
   Parser::parseDDL<Parser::CreateTableStmt>("table schema", schema_str)->execute(session);
   try {
     restoreTable(
@@ -527,3 +1048,10 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
     throw;
   }
 }
+
+bool TableArchiver::isIncrementalArchive(const std::string& archive_path) {
+  if (!boost::filesystem::exists(archive_path)) {
+    throw std::runtime_error("Archive " + archive_path + " does not exist.");
+  }
+  return find_archive_info_file(archive_path, table_incremental_filename).has_value();
+}
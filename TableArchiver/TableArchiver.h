@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "Catalog/Catalog.h"
@@ -25,9 +26,14 @@ class TableArchiver {
  public:
   TableArchiver(Catalog_Namespace::Catalog* cat) : cat_(cat){};
 
+  /**
+   * @brief Dumps a table to an archive. If incremental_since_epoch is set, only the
+   * pages of table data files written after that table epoch are archived.
+   */
   void dumpTable(const TableDescriptor* td,
                  const std::string& archive_path,
-                 const std::string& compression);
+                 const std::string& compression,
+                 const std::optional<int32_t> incremental_since_epoch = std::nullopt);
 
   void restoreTable(const Catalog_Namespace::SessionInfo& session,
                     const TableDescriptor* td,
@@ -39,6 +45,12 @@ class TableArchiver {
                     const std::string& archive_path,
                     const std::string& compression);
 
+  /**
+   * @brief Returns whether an archive was dumped incrementally, in which case it can
+   * only be restored into an existing table that is at the epoch the dump was based on.
+   */
+  static bool isIncrementalArchive(const std::string& archive_path);
+
  private:
   Catalog_Namespace::Catalog* cat_;
 };
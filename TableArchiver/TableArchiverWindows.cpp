@@ -18,7 +18,8 @@
 
 void TableArchiver::dumpTable(const TableDescriptor* td,
                               const std::string& archive_path,
-                              const std::string& compression) {
+                              const std::string& compression,
+                              const std::optional<int32_t> incremental_since_epoch) {
   throw std::runtime_error("Dump/restore table not yet supported on Windows.");
 }
 
@@ -34,4 +35,8 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
                                  const std::string& archive_path,
                                  const std::string& compression) {
   throw std::runtime_error("Dump/restore table not yet supported on Windows.");
-}
\ No newline at end of file
+}
+
+bool TableArchiver::isIncrementalArchive(const std::string& archive_path) {
+  throw std::runtime_error("Dump/restore table not yet supported on Windows.");
+}
@@ -28,6 +28,9 @@
 #define BASE_PATH "./tmp"
 #endif
 
+extern bool g_enable_auto_vacuum;
+extern float g_vacuum_min_selectivity;
+
 namespace {
 
 #define ASSERT_METADATA(type, tag)                                   \
@@ -834,6 +837,65 @@ TEST_F(OptimizeTableVacuumTest, MultiplePagesPerFile) {
   sqlAndCompareResult("select * from test_table;", {{i(25)}});
 }
 
+class AutoVacuumTest : public DBHandlerTestFixture {
+ protected:
+  void SetUp() override {
+    DBHandlerTestFixture::SetUp();
+    g_enable_auto_vacuum = true;
+    g_vacuum_min_selectivity = 0.5;
+    sql("drop table if exists test_table;");
+    sql("create table test_table (i int) with (fragment_size = 4);");
+    for (int value = 1; value <= 8; value++) {
+      sql("insert into test_table values (" + std::to_string(value) + ");");
+    }
+  }
+
+  void TearDown() override {
+    TableOptimizer::waitForAutoVacuums();
+    sql("drop table test_table;");
+    g_enable_auto_vacuum = false;
+    g_vacuum_min_selectivity = 0.1;
+    DBHandlerTestFixture::TearDown();
+  }
+
+  std::vector<size_t> getPhysicalFragmentRowCounts() {
+    const auto td = getCatalog().getMetadataForTable("test_table");
+    CHECK(td);
+    std::vector<size_t> row_counts;
+    run_op_per_fragment(
+        getCatalog(), td, [&row_counts](const Fragmenter_Namespace::FragmentInfo& f) {
+          row_counts.emplace_back(f.getPhysicalNumTuples());
+        });
+    return row_counts;
+  }
+};
+
+TEST_F(AutoVacuumTest, FragmentBelowMinSelectivityNotVacuumed) {
+  sql("delete from test_table where i = 1;");
+  TableOptimizer::waitForAutoVacuums();
+  EXPECT_EQ(std::vector<size_t>({4, 4}), getPhysicalFragmentRowCounts());
+  sqlAndCompareResult("select count(*) from test_table;", {{i(7)}});
+}
+
+TEST_F(AutoVacuumTest, FragmentAboveMinSelectivityVacuumed) {
+  sql("delete from test_table where i = 1 or i >= 6;");
+  TableOptimizer::waitForAutoVacuums();
+  EXPECT_EQ(std::vector<size_t>({4, 1}), getPhysicalFragmentRowCounts());
+  sqlAndCompareResult("select * from test_table order by i;",
+                      {{i(2)}, {i(3)}, {i(4)}, {i(5)}});
+}
+
+TEST_F(AutoVacuumTest, ConsecutiveDeletesVacuumed) {
+  // Deletes do not wait for the vacuum, so a vacuum can still be pending when the next
+  // delete schedules another one
+  sql("delete from test_table where i >= 7;");
+  sql("delete from test_table where i = 1 or i = 2;");
+  TableOptimizer::waitForAutoVacuums();
+  EXPECT_EQ(std::vector<size_t>({2, 2}), getPhysicalFragmentRowCounts());
+  sqlAndCompareResult("select * from test_table order by i;",
+                      {{i(3)}, {i(4)}, {i(5)}, {i(6)}});
+}
+
 class VarLenColumnUpdateTest : public DBHandlerTestFixture {
   void SetUp() override {
     DBHandlerTestFixture::SetUp();
@@ -0,0 +1,471 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    EngineBenchmark.cpp
+ * @brief   In process benchmarks of the engine hot paths on synthetic data.
+ *
+ * All data is generated from fixed seeds, so runs on the same machine are comparable
+ * across commits. Run through the engine_benchmarks target to get the results as JSON,
+ * and compare two result files with ThirdParty/googlebenchmark/tools/compare.py.
+ */
+
+#include "TestHelpers.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <mutex>
+#include <random>
+
+#include "../DataMgr/FileMgr/GlobalFileMgr.h"
+#include "../ImportExport/DelimitedParserUtils.h"
+#include "../ImportExport/Importer.h"
+#include "../Logger/Logger.h"
+#include "../QueryEngine/ArrowResultSet.h"
+#include "../QueryEngine/ExternalCacheInvalidators.h"
+#include "../QueryEngine/ResultSet.h"
+#include "../QueryRunner/QueryRunner.h"
+#include "../StringDictionary/StringDictionary.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+constexpr size_t kFactRows{1000000};
+constexpr size_t kFactFragmentSize{250000};
+constexpr size_t kDimRows{10000};
+constexpr size_t kDistinctStrings{10000};
+constexpr size_t kCsvRows{100000};
+constexpr size_t kFileChunkBytes{64 * 1024 * 1024};
+constexpr uint64_t kSeed{42};
+
+std::once_flag setup_flag;
+
+std::shared_ptr<ResultSet> run_query(const std::string& query_str) {
+  return QR::get()->runSQL(query_str,
+                           ExecutorDeviceType::CPU,
+                           /*hoist_literals=*/true,
+                           /*allow_loop_joins=*/false);
+}
+
+std::string bench_string(const size_t i) {
+  return "str_" + std::to_string(i % kDistinctStrings);
+}
+
+// Loads rows produced by make_row, given as one string per column, through the importer.
+template <typename ROW_GENERATOR>
+void load_rows(const std::string& table_name,
+               const size_t num_rows,
+               ROW_GENERATOR make_row) {
+  auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable(table_name);
+  CHECK(td);
+  auto loader = QR::get()->getLoader(td);
+  CHECK(loader);
+  const auto col_descs = loader->get_column_descs();
+  std::vector<std::unique_ptr<import_export::TypedImportBuffer>> import_buffers;
+  for (const auto cd : col_descs) {
+    import_buffers.push_back(std::make_unique<import_export::TypedImportBuffer>(
+        cd, loader->getStringDict(cd)));
+  }
+  for (size_t i = 0; i < num_rows; ++i) {
+    const auto values = make_row(i);
+    CHECK_EQ(values.size(), col_descs.size());
+    size_t col_idx = 0;
+    for (const auto cd : col_descs) {
+      import_buffers[col_idx]->add_value(
+          cd, values[col_idx], /*is_null=*/false, import_export::CopyParams());
+      ++col_idx;
+    }
+  }
+  CHECK(loader->load(import_buffers, num_rows, nullptr));
+}
+
+std::string csv_path() {
+  return (boost::filesystem::temp_directory_path() / "engine_benchmark.csv").string();
+}
+
+void write_csv(const std::string& path) {
+  std::mt19937_64 gen(kSeed);
+  std::uniform_int_distribution<int64_t> int_dist(0, 1000000000);
+  std::uniform_real_distribution<double> double_dist(0, 1000);
+  std::ofstream csv(path);
+  csv << "x,y,d,str\n";
+  for (size_t i = 0; i < kCsvRows; ++i) {
+    csv << i % 1000 << "," << int_dist(gen) << "," << double_dist(gen) << ",\""
+        << bench_string(i) << "\"\n";
+  }
+}
+
+// Creates the synthetic tables shared by all benchmarks. bench_fact has a low cardinality
+// key x for perfect hash group by, a high cardinality key y which forces baseline hash
+// group by when combined with x, and a join key k into bench_dim.
+void global_setup() {
+  TestHelpers::init_logger_stderr_only();
+  QR::init(BASE_PATH);
+
+  QR::get()->runDDLStatement("DROP TABLE IF EXISTS bench_fact;");
+  QR::get()->runDDLStatement(
+      "CREATE TABLE bench_fact (x INT, y BIGINT, d DOUBLE, k INT, str TEXT ENCODING "
+      "DICT(32)) WITH (FRAGMENT_SIZE=" +
+      std::to_string(kFactFragmentSize) + ");");
+  std::mt19937_64 gen(kSeed);
+  std::uniform_int_distribution<int64_t> int_dist(0, 1000000000);
+  std::uniform_real_distribution<double> double_dist(0, 1000);
+  load_rows("bench_fact", kFactRows, [&](const size_t i) {
+    return std::vector<std::string>{std::to_string(i % 1000),
+                                    std::to_string(int_dist(gen)),
+                                    std::to_string(double_dist(gen)),
+                                    std::to_string(int_dist(gen) % (2 * kDimRows)),
+                                    bench_string(i * 7919)};
+  });
+
+  QR::get()->runDDLStatement("DROP TABLE IF EXISTS bench_dim;");
+  QR::get()->runDDLStatement(
+      "CREATE TABLE bench_dim (k INT, name TEXT ENCODING DICT(32));");
+  load_rows("bench_dim", kDimRows, [](const size_t i) {
+    return std::vector<std::string>{std::to_string(i), bench_string(i)};
+  });
+
+  QR::get()->runDDLStatement("DROP TABLE IF EXISTS bench_import;");
+  QR::get()->runDDLStatement(
+      "CREATE TABLE bench_import (x INT, y BIGINT, d DOUBLE, str TEXT ENCODING "
+      "DICT(32));");
+  write_csv(csv_path());
+
+  // make sure all columns are resident in the CPU buffer pool
+  run_query("SELECT * FROM bench_fact;");
+  run_query("SELECT * FROM bench_dim;");
+}
+
+class EngineFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    std::call_once(setup_flag, global_setup);
+  }
+};
+
+}  // namespace
+
+//! Group by a single low cardinality integer key, which uses a perfect hash layout.
+BENCHMARK_DEFINE_F(EngineFixture, GroupByPerfectHash)(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        run_query("SELECT x, COUNT(*), SUM(d) FROM bench_fact GROUP BY x;"));
+  }
+  state.SetItemsProcessed(state.iterations() * kFactRows);
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, GroupByPerfectHash)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Group by two keys with a large combined range, which uses a baseline hash layout.
+BENCHMARK_DEFINE_F(EngineFixture, GroupByBaselineHash)(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        run_query("SELECT x, y, COUNT(*) FROM bench_fact GROUP BY x, y;"));
+  }
+  state.SetItemsProcessed(state.iterations() * kFactRows);
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, GroupByBaselineHash)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Equi join which builds the join hash table on every iteration.
+BENCHMARK_DEFINE_F(EngineFixture, HashJoinBuildAndProbe)(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    JoinHashTableCacheInvalidator::invalidateCaches();
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        run_query("SELECT COUNT(*) FROM bench_fact f JOIN bench_dim d ON f.k = d.k;"));
+  }
+  state.SetItemsProcessed(state.iterations() * kFactRows);
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, HashJoinBuildAndProbe)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Equi join probing a cached join hash table.
+BENCHMARK_DEFINE_F(EngineFixture, HashJoinProbe)(benchmark::State& state) {
+  const std::string query{
+      "SELECT COUNT(*) FROM bench_fact f JOIN bench_dim d ON f.k = d.k;"};
+  run_query(query);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(run_query(query));
+  }
+  state.SetItemsProcessed(state.iterations() * kFactRows);
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, HashJoinProbe)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Group by on a dictionary encoded key, reducing the per fragment results.
+BENCHMARK_DEFINE_F(EngineFixture, ResultSetReduction)(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        run_query("SELECT str, COUNT(*), AVG(d) FROM bench_fact GROUP BY str;"));
+  }
+  state.SetItemsProcessed(state.iterations() * kFactRows);
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, ResultSetReduction)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Sort of a group by result on an aggregate.
+BENCHMARK_DEFINE_F(EngineFixture, ResultSetSort)(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(run_query(
+        "SELECT str, SUM(d) AS s FROM bench_fact GROUP BY str ORDER BY s DESC;"));
+  }
+  state.SetItemsProcessed(state.iterations() * kFactRows);
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, ResultSetSort)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Top-n sort of a projection.
+BENCHMARK_DEFINE_F(EngineFixture, ProjectionTopN)(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        run_query("SELECT y, d FROM bench_fact ORDER BY d DESC LIMIT 1000;"));
+  }
+  state.SetItemsProcessed(state.iterations() * kFactRows);
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, ProjectionTopN)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Conversion of a projection result set to an Arrow record batch.
+BENCHMARK_DEFINE_F(EngineFixture, ArrowConversion)(benchmark::State& state) {
+  const auto rows = run_query("SELECT x, y, d, str FROM bench_fact;");
+  const std::vector<std::string> col_names{"x", "y", "d", "str"};
+  for (auto _ : state) {
+    ArrowResultSetConverter converter(rows, col_names, -1);
+    benchmark::DoNotOptimize(converter.convertToArrow());
+  }
+  state.SetItemsProcessed(state.iterations() * rows->rowCount());
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, ArrowConversion)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Bulk insertion of new strings into a temporary string dictionary.
+BENCHMARK_DEFINE_F(EngineFixture, StringDictionaryGetOrAdd)(benchmark::State& state) {
+  std::vector<std::string> strings;
+  for (size_t i = 0; i < kFactRows; ++i) {
+    strings.push_back("dict_string_" + std::to_string(i));
+  }
+  std::vector<int32_t> ids(strings.size());
+  for (auto _ : state) {
+    StringDictionary string_dict(BASE_PATH, /*isTemp=*/true, /*recover=*/false);
+    string_dict.getOrAddBulk(strings, ids.data());
+    benchmark::DoNotOptimize(ids.data());
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, StringDictionaryGetOrAdd)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! LIKE over a string dictionary, bypassing its pattern cache.
+BENCHMARK_DEFINE_F(EngineFixture, StringDictionaryLike)(benchmark::State& state) {
+  StringDictionary string_dict(BASE_PATH, /*isTemp=*/true, /*recover=*/false);
+  std::vector<std::string> strings;
+  for (size_t i = 0; i < kFactRows; ++i) {
+    strings.push_back("dict_string_" + std::to_string(i));
+  }
+  std::vector<int32_t> ids(strings.size());
+  string_dict.getOrAddBulk(strings, ids.data());
+  size_t generation = strings.size();
+  for (auto _ : state) {
+    state.PauseTiming();
+    // adding a new string invalidates the pattern caches
+    string_dict.getOrAdd("dict_string_new_" + std::to_string(generation));
+    ++generation;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        string_dict.getLike("%ing_12%", false, true, '\\', generation));
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, StringDictionaryLike)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Splitting CSV rows into fields, without type conversion.
+BENCHMARK_DEFINE_F(EngineFixture, CsvParseRows)(benchmark::State& state) {
+  std::ifstream csv(csv_path());
+  const std::string contents{std::istreambuf_iterator<char>(csv),
+                             std::istreambuf_iterator<char>()};
+  const char* buf = contents.data();
+  const char* buf_end = buf + contents.size();
+  import_export::CopyParams copy_params;
+  const bool is_array[4] = {false, false, false, false};
+  std::vector<std::string_view> row;
+  for (auto _ : state) {
+    size_t num_rows{0};
+    bool try_single_thread{false};
+    for (const char* p = buf; p < buf_end; p++) {
+      row.clear();
+      std::vector<std::unique_ptr<char[]>> tmp_buffers;
+      p = import_export::delimited_parser::get_row(p,
+                                                   buf_end,
+                                                   buf_end,
+                                                   copy_params,
+                                                   is_array,
+                                                   row,
+                                                   tmp_buffers,
+                                                   try_single_thread,
+                                                   true);
+      ++num_rows;
+    }
+    CHECK_EQ(num_rows, kCsvRows + 1);
+  }
+  state.SetItemsProcessed(state.iterations() * kCsvRows);
+  state.SetBytesProcessed(state.iterations() * contents.size());
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, CsvParseRows)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! COPY FROM of a CSV file, including parsing, dictionary encoding and checkpointing.
+BENCHMARK_DEFINE_F(EngineFixture, CsvImport)(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    QR::get()->runDDLStatement("TRUNCATE TABLE bench_import;");
+    state.ResumeTiming();
+    QR::get()->runDDLStatement("COPY bench_import FROM '" + csv_path() +
+                               "' WITH (header='true');");
+  }
+  state.SetItemsProcessed(state.iterations() * kCsvRows);
+}
+
+BENCHMARK_REGISTER_F(EngineFixture, CsvImport)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+namespace {
+
+class FileMgrFixture : public EngineFixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    EngineFixture::SetUp(state);
+    QR::get()->runDDLStatement("DROP TABLE IF EXISTS bench_file;");
+    QR::get()->runDDLStatement("CREATE TABLE bench_file (i INT);");
+    auto cat = QR::get()->getCatalog();
+    const auto td = cat->getMetadataForTable("bench_file");
+    CHECK(td);
+    db_id_ = cat->getCurrentDB().dbId;
+    table_id_ = td->tableId;
+    global_file_mgr_ = cat->getDataMgr().getGlobalFileMgr();
+    CHECK(global_file_mgr_);
+    data_.resize(kFileChunkBytes);
+    std::mt19937_64 gen(kSeed);
+    std::generate(data_.begin(), data_.end(), [&gen] { return gen(); });
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    QR::get()->runDDLStatement("DROP TABLE IF EXISTS bench_file;");
+  }
+
+ protected:
+  // Column ids past the ones of the table, so the benchmark never touches real chunks.
+  ChunkKey chunkKey(const int fragment_id) const {
+    return {db_id_, table_id_, 1000, fragment_id};
+  }
+
+  void writeChunk(const ChunkKey& chunk_key) {
+    auto buffer = global_file_mgr_->createBuffer(
+        chunk_key, global_file_mgr_->getDefaultPageSize(), 0);
+    buffer->append(data_.data(), data_.size());
+    global_file_mgr_->checkpoint(db_id_, table_id_);
+  }
+
+  int db_id_;
+  int table_id_;
+  File_Namespace::GlobalFileMgr* global_file_mgr_;
+  std::vector<int8_t> data_;
+};
+
+}  // namespace
+
+//! Appending a chunk to the file manager and checkpointing it.
+BENCHMARK_DEFINE_F(FileMgrFixture, FileMgrWrite)(benchmark::State& state) {
+  int fragment_id{0};
+  for (auto _ : state) {
+    const auto chunk_key = chunkKey(fragment_id++);
+    writeChunk(chunk_key);
+    state.PauseTiming();
+    global_file_mgr_->deleteBuffer(chunk_key);
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * data_.size());
+}
+
+BENCHMARK_REGISTER_F(FileMgrFixture, FileMgrWrite)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//! Reading a checkpointed chunk back from the file manager.
+BENCHMARK_DEFINE_F(FileMgrFixture, FileMgrRead)(benchmark::State& state) {
+  const auto chunk_key = chunkKey(0);
+  writeChunk(chunk_key);
+  std::vector<int8_t> dest(data_.size());
+  for (auto _ : state) {
+    auto buffer = global_file_mgr_->getBuffer(chunk_key, data_.size());
+    buffer->read(dest.data(), dest.size());
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetBytesProcessed(state.iterations() * data_.size());
+}
+
+BENCHMARK_REGISTER_F(FileMgrFixture, FileMgrRead)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
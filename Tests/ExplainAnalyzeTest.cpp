@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ExplainAnalyzeTest.cpp
+ * @brief Test suite for the operator level query profile returned by EXPLAIN ANALYZE
+ */
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "DBHandlerTestHelpers.h"
+#include "TestHelpers.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+class ExplainAnalyzeTest : public DBHandlerTestFixture {
+ protected:
+  void SetUp() override {
+    DBHandlerTestFixture::SetUp();
+    sql("DROP TABLE IF EXISTS explain_analyze_test;");
+    sql("CREATE TABLE explain_analyze_test (i INTEGER, t TEXT) WITH (fragment_size = "
+        "2);");
+    sql("INSERT INTO explain_analyze_test VALUES (1, 'a');");
+    sql("INSERT INTO explain_analyze_test VALUES (2, 'b');");
+    sql("INSERT INTO explain_analyze_test VALUES (3, 'a');");
+    sql("INSERT INTO explain_analyze_test VALUES (4, 'c');");
+    sql("INSERT INTO explain_analyze_test VALUES (5, 'b');");
+  }
+
+  void TearDown() override {
+    sql("DROP TABLE IF EXISTS explain_analyze_test;");
+    DBHandlerTestFixture::TearDown();
+  }
+
+  rapidjson::Document getProfile(const std::string& query) {
+    TQueryResult result;
+    sql(result, "EXPLAIN ANALYZE " + query);
+    EXPECT_EQ(size_t(1), result.row_set.columns.size());
+    EXPECT_EQ(size_t(1), result.row_set.columns[0].data.str_col.size());
+    rapidjson::Document profile;
+    profile.Parse(result.row_set.columns[0].data.str_col[0].c_str());
+    EXPECT_FALSE(profile.HasParseError());
+    EXPECT_TRUE(profile.IsObject());
+    return profile;
+  }
+};
+
+TEST_F(ExplainAnalyzeTest, ProjectionCountsRows) {
+  auto profile = getProfile("SELECT i FROM explain_analyze_test WHERE i > 0;");
+  ASSERT_TRUE(profile.HasMember("steps"));
+  const auto& steps = profile["steps"];
+  ASSERT_EQ(1u, steps.Size());
+  const auto& step = steps[0];
+  EXPECT_EQ(5u, step["rows_in"].GetUint64());
+  EXPECT_EQ(5u, step["rows_out"].GetUint64());
+  EXPECT_EQ(3u, step["fragments"]["total"].GetUint64());
+  EXPECT_EQ(0u, step["fragments"]["skipped"].GetUint64());
+  EXPECT_GT(step["bytes"]["cpu"]["fetched"].GetUint64(), 0u);
+}
+
+TEST_F(ExplainAnalyzeTest, SkippedFragments) {
+  auto profile = getProfile("SELECT i FROM explain_analyze_test WHERE i > 4;");
+  const auto& step = profile["steps"][0];
+  EXPECT_EQ(1u, step["rows_out"].GetUint64());
+  EXPECT_EQ(3u, step["fragments"]["total"].GetUint64());
+  EXPECT_EQ(2u, step["fragments"]["skipped"].GetUint64());
+}
+
+TEST_F(ExplainAnalyzeTest, GroupBy) {
+  auto profile = getProfile(
+      "SELECT t, COUNT(*) AS n FROM explain_analyze_test GROUP BY t ORDER BY n DESC;");
+  const auto& steps = profile["steps"];
+  ASSERT_GE(steps.Size(), 1u);
+  EXPECT_EQ(5u, steps[0]["rows_in"].GetUint64());
+  EXPECT_EQ(3u, steps[steps.Size() - 1]["rows_out"].GetUint64());
+  EXPECT_GE(profile["total_ms"].GetInt64(), steps[0]["total_ms"].GetInt64());
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  DBHandlerTestFixture::initTestArgs(argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -267,6 +267,36 @@ TEST_F(FileMgrTest, put_checkpoint_get_double_write) {
   compareBuffersAndMetadata(source_buffer, file_buffer);
 }
 
+TEST_F(FileMgrTest, put_checkpoint_get_updated_range) {
+  AbstractBuffer* source_buffer =
+      dm->getChunkBuffer(chunk_key, Data_Namespace::MemoryLevel::CPU_LEVEL);
+  std::vector<int32_t> data_v1 = {1, 2, 3, 5, 7};
+  appendData(source_buffer, data_v1);
+  File_Namespace::FileMgr* file_mgr = dynamic_cast<File_Namespace::FileMgr*>(
+      dm->getGlobalFileMgr()->getFileMgr(file_mgr_key.first, file_mgr_key.second));
+  file_mgr->putBuffer(chunk_key, source_buffer, 24);
+  file_mgr->checkpoint();
+  ASSERT_EQ(file_mgr->lastCheckpointedEpoch(), 2);
+
+  auto source_data = reinterpret_cast<int32_t*>(source_buffer->getMemoryPtr());
+  source_data[2] = 11;
+  source_data[3] = 13;
+  source_buffer->setUpdatedRange(2 * sizeof(int32_t), sizeof(int32_t));
+  source_buffer->setUpdatedRange(3 * sizeof(int32_t), sizeof(int32_t));
+  ASSERT_TRUE(source_buffer->isUpdated());
+  ASSERT_FALSE(source_buffer->isAppended());
+  // adjacent ranges are coalesced
+  ASSERT_EQ(source_buffer->getUpdatedRanges().size(), size_t(1));
+
+  AbstractBuffer* file_buffer = file_mgr->putBuffer(chunk_key, source_buffer);
+  ASSERT_FALSE(source_buffer->isDirty());
+  ASSERT_TRUE(source_buffer->getUpdatedRanges().empty());
+  ASSERT_EQ(file_buffer->size(), static_cast<size_t>(24));
+  file_mgr->checkpoint();
+  ASSERT_EQ(file_mgr->lastCheckpointedEpoch(), 3);
+  compareBuffers(source_buffer, file_buffer, 24);
+}
+
 TEST_F(FileMgrTest, buffer_append_and_recovery) {
   AbstractBuffer* source_buffer =
       dm->getChunkBuffer(chunk_key, Data_Namespace::MemoryLevel::CPU_LEVEL);
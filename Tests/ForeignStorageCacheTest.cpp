@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "Catalog/Catalog.h"
 
 extern bool g_enable_fsi;
@@ -361,6 +363,165 @@ TEST_F(CacheDiskStorageTest, RecoverCache_SingleChunk) {
   ASSERT_TRUE(chunk_wrapper1.test_buf->compare(cached_buf, 16));
 }
 
+TEST(FrequencySketchTest, HalvesCountsPeriodically) {
+  FrequencySketch sketch(16);
+  for (size_t i = 0; i < 20; i++) {
+    sketch.increment(chunk_key1);
+  }
+  ASSERT_EQ(sketch.estimate(chunk_key1), 15U);
+  // A sample is ten times the width of the sketch
+  for (size_t i = 0; i < 140; i++) {
+    sketch.increment(chunk_key2);
+  }
+  ASSERT_EQ(sketch.estimate(chunk_key1), 7U);
+}
+
+TEST(CacheAdmissionPolicyTest, AdmitsWhileSpaceIsLeft) {
+  CacheAdmissionPolicy policy(100, 0);
+  std::vector<ChunkKey> victims;
+  policy.insert(chunk_key1, 50);
+  ASSERT_TRUE(policy.admit(chunk_key2, 50, {}, victims));
+  ASSERT_TRUE(victims.empty());
+  ASSERT_FALSE(policy.admit(chunk_key2, 101, {}, victims));
+}
+
+TEST(CacheAdmissionPolicyTest, EvictsOnlyLessFrequentlyUsedChunks) {
+  CacheAdmissionPolicy policy(100, 0);
+  std::vector<ChunkKey> victims;
+  policy.insert(chunk_key1, 50);
+  policy.insert(chunk_key2, 50);
+  policy.recordAccess(chunk_key1);
+  policy.recordAccess(chunk_key2);
+
+  policy.recordAccess(chunk_key3);
+  ASSERT_FALSE(policy.admit(chunk_key3, 50, {}, victims));
+
+  policy.recordAccess(chunk_key3);
+  ASSERT_TRUE(policy.admit(chunk_key3, 50, {}, victims));
+  ASSERT_EQ(victims, std::vector<ChunkKey>{chunk_key1});
+}
+
+TEST(CacheAdmissionPolicyTest, TableSizeLimit) {
+  CacheAdmissionPolicy policy(0, 100);
+  std::vector<ChunkKey> victims;
+  policy.insert(chunk_key1, 80);
+  policy.insert(chunk_key_table2, 80);
+  policy.recordAccess(chunk_key2);
+  ASSERT_TRUE(policy.admit(chunk_key2, 50, {}, victims));
+  ASSERT_EQ(victims, std::vector<ChunkKey>{chunk_key1});
+  ASSERT_EQ(policy.getCachedSizeForTable(table_prefix1), 80U);
+  ASSERT_EQ(policy.getCachedSize(), 160U);
+}
+
+TEST(CacheAdmissionPolicyTest, OverflowVictims) {
+  CacheAdmissionPolicy policy(100, 0);
+  policy.insert(chunk_key1, 60);
+  policy.insert(chunk_key2, 60);
+  ASSERT_EQ(policy.getOverflowVictims({chunk_key1}), std::vector<ChunkKey>{chunk_key2});
+  policy.eraseTable(table_prefix1);
+  ASSERT_EQ(policy.getCachedSize(), 0U);
+}
+
+class ForeignStorageCacheAdmissionTest : public ForeignStorageCacheUnitTest {
+ protected:
+  static void SetUpTestSuite() {
+    cache_path_ = "./tmp/mapd_data/test_foreign_data_cache";
+  }
+  static void TearDownTestSuite() { boost::filesystem::remove_all(cache_path_); }
+  void SetUp() override {
+    boost::filesystem::remove_all(cache_path_);
+    // Room for two chunks of four integers
+    reinitializeCache(cache_, {cache_path_, DiskCacheLevel::fsi, 0, 40});
+  }
+};
+
+TEST_F(ForeignStorageCacheAdmissionTest, EvictsLeastRecentlyUsedChunkOnOverflow) {
+  const auto evictions = cache_->getTableCacheStats(table_prefix1).evictions;
+  ChunkWrapper<int32_t> chunk_wrapper1{kINT, {1, 2, 3, 4}};
+  ChunkWrapper<int32_t> chunk_wrapper2{kINT, {1, 2, 3, 4}};
+  ChunkWrapper<int32_t> chunk_wrapper3{kINT, {1, 2, 3, 4}};
+  chunk_wrapper1.cacheMetadataThenChunk(chunk_key1);
+  chunk_wrapper2.cacheMetadataThenChunk(chunk_key2);
+  cache_->recordChunkAccess(chunk_key1, true);
+  chunk_wrapper3.cacheMetadataThenChunk(chunk_key3);
+  ASSERT_EQ(cache_->getNumCachedChunks(), 2U);
+  ASSERT_NE(cache_->getCachedChunkIfExists(chunk_key1), nullptr);
+  ASSERT_EQ(cache_->getCachedChunkIfExists(chunk_key2), nullptr);
+  ASSERT_EQ(cache_->getCachedChunksSize(), 32U);
+  ASSERT_EQ(cache_->getTableCacheStats(table_prefix1).evictions, evictions + 1);
+}
+
+TEST_F(ForeignStorageCacheAdmissionTest, AdmitsFrequentlyRequestedChunk) {
+  const auto stats = cache_->getTableCacheStats(table_prefix1);
+  ChunkWrapper<int32_t> chunk_wrapper1{kINT, {1, 2, 3, 4}};
+  ChunkWrapper<int32_t> chunk_wrapper2{kINT, {1, 2, 3, 4}};
+  ChunkWrapper<int32_t> chunk_wrapper3{kINT, {1, 2, 3, 4}};
+  chunk_wrapper1.cacheMetadataThenChunk(chunk_key1);
+  chunk_wrapper2.cacheMetadataThenChunk(chunk_key2);
+  chunk_wrapper3.cacheMetadata(chunk_key3);
+  cache_->recordChunkAccess(chunk_key1, true);
+  cache_->recordChunkAccess(chunk_key2, true);
+
+  // Requested as often as the cached chunks
+  cache_->recordChunkAccess(chunk_key3, false);
+  ASSERT_FALSE(cache_->admitChunks(chunk_key3, {chunk_key3}));
+
+  cache_->recordChunkAccess(chunk_key3, false);
+  ASSERT_TRUE(cache_->admitChunks(chunk_key3, {chunk_key3}));
+  ASSERT_EQ(cache_->getCachedChunkIfExists(chunk_key1), nullptr);
+  ASSERT_NE(cache_->getCachedChunkIfExists(chunk_key2), nullptr);
+
+  const auto new_stats = cache_->getTableCacheStats(table_prefix1);
+  ASSERT_EQ(new_stats.hits, stats.hits + 2);
+  ASSERT_EQ(new_stats.misses, stats.misses + 2);
+  ASSERT_EQ(new_stats.rejections, stats.rejections + 1);
+  ASSERT_EQ(new_stats.evictions, stats.evictions + 1);
+}
+
+TEST_F(ForeignStorageCacheAdmissionTest, RejectedChunkUpdateErasesCachedVersion) {
+  const auto stats = cache_->getTableCacheStats(table_prefix1);
+  ChunkWrapper<int32_t> chunk_wrapper1{kINT, {1, 2, 3, 4}};
+  ChunkWrapper<int32_t> chunk_wrapper2{kINT, {1, 2, 3, 4}};
+  chunk_wrapper1.cacheMetadataThenChunk(chunk_key1);
+  chunk_wrapper2.cacheMetadataThenChunk(chunk_key2);
+  cache_->recordChunkAccess(chunk_key2, true);
+  ASSERT_NE(cache_->getCachedChunkIfExists(chunk_key1), nullptr);
+
+  // The new version of the first chunk does not fit without evicting the more
+  // frequently requested second chunk, so it is rejected
+  ChunkWrapper<int32_t> updated_chunk_wrapper1{kINT, {5, 6, 7, 8}};
+  updated_chunk_wrapper1.test_buf->clearDirtyBits();
+  cache_->cacheChunk(chunk_key1, updated_chunk_wrapper1.test_buf.get());
+
+  // The previous version must not be served anymore
+  ASSERT_EQ(cache_->getCachedChunkIfExists(chunk_key1), nullptr);
+  ASSERT_NE(cache_->getCachedChunkIfExists(chunk_key2), nullptr);
+  ASSERT_EQ(cache_->getCachedChunksSize(), 16U);
+  ASSERT_EQ(cache_->getTableCacheStats(table_prefix1).rejections, stats.rejections + 1);
+}
+
+TEST(DiskCacheBypassScopeTest, AppliesToCurrentThreadOnly) {
+  using foreign_storage::DiskCacheBypassScope;
+  EXPECT_FALSE(DiskCacheBypassScope::isBypassed());
+  {
+    DiskCacheBypassScope bypass_scope(true);
+    EXPECT_TRUE(DiskCacheBypassScope::isBypassed());
+    {
+      DiskCacheBypassScope nested_scope(false);
+      EXPECT_FALSE(DiskCacheBypassScope::isBypassed());
+    }
+    EXPECT_TRUE(DiskCacheBypassScope::isBypassed());
+
+    // a concurrent query on another thread keeps using the cache
+    bool bypassed_in_other_thread{true};
+    std::thread other_thread(
+        [&] { bypassed_in_other_thread = DiskCacheBypassScope::isBypassed(); });
+    other_thread.join();
+    EXPECT_FALSE(bypassed_in_other_thread);
+  }
+  EXPECT_FALSE(DiskCacheBypassScope::isBypassed());
+}
+
 class ForeignStorageCacheFileTest : public testing::Test {
  protected:
   std::string cache_path_;
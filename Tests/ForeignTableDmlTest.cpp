@@ -20,14 +20,20 @@
  */
 
 #include <gtest/gtest.h>
+#include <fstream>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+
 #include "DBHandlerTestHelpers.h"
 #include "DataMgr/ForeignStorage/ForeignStorageCache.h"
 #include "DataMgr/ForeignStorage/ForeignTableRefresh.h"
 #include "Geospatial/Types.h"
 #include "ImportExport/DelimitedParserUtils.h"
+#include "Shared/ArrowUtil.h"
 #include "TestHelpers.h"
 
 #ifndef BASE_PATH
@@ -993,6 +999,136 @@ TEST_F(SelectQueryTest, ExistingTableWithFsiDisabled) {
                           "FSI is currently disabled.");
 }
 
+/**
+ * Tests for CSV files that are large enough relative to the buffer size to be read in
+ * concurrent blocks during the metadata scan.
+ */
+class ConcurrentBlockScanTest : public SelectQueryTest {
+ protected:
+  void SetUp() override {
+    SelectQueryTest::SetUp();
+    file_path_ = getDataFilesPath() + ".tmp_block_scan.csv";
+  }
+
+  void TearDown() override {
+    SelectQueryTest::TearDown();
+    bf::remove_all(file_path_);
+  }
+
+  // Quoted text of each row, which varies in length and contains a line delimiter in
+  // every fifth row
+  static std::string getRowText(const size_t row_index, const size_t long_row_index) {
+    std::string text = "r" + std::to_string(row_index) + ", ";
+    if (row_index == long_row_index) {
+      return text + std::string(200, 'y');
+    }
+    text += std::string(row_index % 23, 'x');
+    if (row_index % 5 == 0) {
+      text += "\n";
+    }
+    return text + "z";
+  }
+
+  // Writes the given number of rows and returns the sum of their text lengths
+  size_t writeFile(const size_t row_count,
+                   const size_t long_row_index = std::numeric_limits<size_t>::max()) {
+    std::ofstream file(file_path_);
+    file << "i,t\n";
+    size_t text_length{0};
+    for (size_t row_index = 0; row_index < row_count; row_index++) {
+      const auto text = getRowText(row_index, long_row_index);
+      file << row_index << ",\"" << text << "\"\n";
+      text_length += text.size();
+    }
+    return text_length;
+  }
+
+  void createForeignTable() {
+    sql("CREATE FOREIGN TABLE test_foreign_table (i INTEGER, t TEXT ENCODING NONE) "
+        "SERVER omnisci_local_csv WITH (file_path = '" +
+        file_path_ + "', buffer_size = '16', fragment_size = '" +
+        std::to_string(fragment_size_) + "');");
+  }
+
+  void assertRowsAndFragments(const size_t row_count, const size_t text_length) {
+    TQueryResult result;
+    sql(result, "SELECT COUNT(*), SUM(i), SUM(CHAR_LENGTH(t)) FROM test_foreign_table;");
+    assertResultSetEqual({{i(row_count),
+                           i(row_count * (row_count - 1) / 2),
+                           i(text_length)}},
+                         result);
+
+    // Rows are assigned to fragments by row index, so each fragment holds the
+    // consecutive rows starting at its first row index
+    auto td = getCatalog().getMetadataForTable("test_foreign_table", false);
+    ASSERT_NE(td, nullptr);
+    ASSERT_NE(td->fragmenter, nullptr);
+    const auto column_id =
+        getCatalog().getMetadataForColumn(td->tableId, "i")->columnId;
+    const auto query_info = td->fragmenter->getFragmentsForQuery();
+    ASSERT_EQ(query_info.fragments.size(),
+              (row_count + fragment_size_ - 1) / fragment_size_);
+    for (const auto& fragment : query_info.fragments) {
+      const size_t first_row_index = fragment.fragmentId * fragment_size_;
+      const auto fragment_row_count =
+          std::min(fragment_size_, row_count - first_row_index);
+      EXPECT_EQ(fragment.getNumTuples(), fragment_row_count)
+          << "fragment " << fragment.fragmentId;
+      const auto& chunk_metadata =
+          fragment.getChunkMetadataMapPhysical().at(column_id);
+      EXPECT_EQ(chunk_metadata->chunkStats.min.intval,
+                static_cast<int32_t>(first_row_index))
+          << "fragment " << fragment.fragmentId;
+      EXPECT_EQ(chunk_metadata->chunkStats.max.intval,
+                static_cast<int32_t>(first_row_index + fragment_row_count - 1))
+          << "fragment " << fragment.fragmentId;
+    }
+  }
+
+  std::string file_path_;
+  const size_t fragment_size_{7};
+};
+
+TEST_F(ConcurrentBlockScanTest, RowsAndQuotedFieldsStraddlingBlocks) {
+  const size_t row_count{1000};
+  const auto text_length = writeFile(row_count);
+  createForeignTable();
+  assertRowsAndFragments(row_count, text_length);
+}
+
+TEST_F(ConcurrentBlockScanTest, RowsCarriedOverIntoSeparateRequests) {
+  // Rows fit, but a row carried over from previous blocks together with the complete
+  // rows of the next block do not
+  import_export::delimited_parser::set_max_buffer_resize(40);
+  const size_t row_count{1000};
+  const auto text_length = writeFile(row_count);
+  createForeignTable();
+  assertRowsAndFragments(row_count, text_length);
+}
+
+TEST_F(ConcurrentBlockScanTest, RowLongerThanMaxBufferResize) {
+  import_export::delimited_parser::set_max_buffer_resize(64);
+  const size_t long_row_index{500};
+  writeFile(1000, long_row_index);
+  createForeignTable();
+  const std::string row_start = std::to_string(long_row_index) + ",\"" +
+                                getRowText(long_row_index, long_row_index);
+  try {
+    sql("SELECT COUNT(*) FROM test_foreign_table;");
+    FAIL() << "An exception should have been thrown for this test case.";
+  } catch (const TOmniSciException& e) {
+    // The number of characters read depends on whether the file was read in blocks
+    EXPECT_NE(e.error_msg.find("Unable to find an end of line character after reading "),
+              std::string::npos)
+        << e.error_msg;
+    EXPECT_NE(e.error_msg.find("Row number: " + std::to_string(long_row_index + 1) +
+                               ". First few characters in row: " +
+                               row_start.substr(0, 50)),
+              std::string::npos)
+        << e.error_msg;
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(CachOnOffSelectQueryTests,
                          CacheControllingSelectQueryTest,
                          ::testing::Values(DiskCacheLevel::none, DiskCacheLevel::fsi),
@@ -1157,6 +1293,7 @@ INSTANTIATE_TEST_SUITE_P(
                       std::make_pair("example_1.bz2", "bz2"),
                       std::make_pair("example_1_multi.7z", "7z_multi"),
                       std::make_pair("example_1.csv.gz", "gz"),
+                      std::make_pair("example_1_bgzf.csv.gz", "bgzf"),
                       std::make_pair("example_1_dir", "dir"),
                       std::make_pair("example_1_dir_newline", "dir_newline"),
                       std::make_pair("example_1_dir_archives", "dir_archives"),
@@ -2353,6 +2490,132 @@ TEST_P(FragmentSizesAppendRefreshTest, AppendFrags) {
   bf::remove_all(getDataFilesPath() + "append_tmp");
 }
 
+class ParquetFileAppendRefreshTest : public RecoverCacheQueryTest {
+ protected:
+  const std::string default_name = "refresh_tmp";
+  DiskCacheLevel starting_cache_level_;
+
+  void SetUp() override {
+    RecoverCacheQueryTest::SetUp();
+    starting_cache_level_ = psm_->getDiskCacheConfig().enabled_level;
+    sqlDropForeignTable(0, default_name);
+    bf::remove_all(getDataFilesPath() + "append_tmp");
+    bf::create_directory(getDataFilesPath() + "append_tmp");
+  }
+
+  void TearDown() override {
+    sqlDropForeignTable(0, default_name);
+    if (psm_->getDiskCacheConfig().enabled_level != starting_cache_level_) {
+      resetPersistentStorageMgr(starting_cache_level_);
+    }
+    bf::remove_all(getDataFilesPath() + "append_tmp");
+    RecoverCacheQueryTest::TearDown();
+  }
+
+  std::string getFilePath() {
+    return getDataFilesPath() + "append_tmp/single_file_row_groups.parquet";
+  }
+
+  void writeFile(const std::vector<int64_t>& values, const int64_t row_group_size) {
+    arrow::Int64Builder builder;
+    ARROW_THROW_NOT_OK(builder.AppendValues(values));
+    std::shared_ptr<arrow::Array> array;
+    ARROW_THROW_NOT_OK(builder.Finish(&array));
+    auto table =
+        arrow::Table::Make(arrow::schema({arrow::field("i", arrow::int64())}), {array});
+    std::shared_ptr<arrow::io::FileOutputStream> out_file;
+    ARROW_ASSIGN_OR_THROW(out_file, arrow::io::FileOutputStream::Open(getFilePath()));
+    ARROW_THROW_NOT_OK(parquet::arrow::WriteTable(
+        *table, arrow::default_memory_pool(), out_file, row_group_size));
+    ARROW_THROW_NOT_OK(out_file->Close());
+  }
+
+  void createTable(const int fragment_size) {
+    sql("CREATE FOREIGN TABLE " + default_name + " (i BIGINT) "s +
+        "SERVER omnisci_local_parquet WITH (file_path = '" + getFilePath() +
+        "', fragment_size = '" + std::to_string(fragment_size) +
+        "', REFRESH_UPDATE_TYPE = 'APPEND');");
+  }
+
+  void assertValues(const std::vector<int64_t>& values) {
+    std::vector<std::vector<TargetValue>> expected;
+    for (const auto value : values) {
+      expected.push_back({i(value)});
+    }
+    sqlAndCompareResult("SELECT * FROM " + default_name + " ORDER BY i;", expected);
+  }
+
+  // Refreshes the table and returns the number of chunk metadata entries cached again
+  size_t refreshAndGetMetadataAddedCount() {
+    size_t metadata_count = cache_->getNumMetadataAdded();
+    sql("REFRESH FOREIGN TABLES " + default_name + ";");
+    return cache_->getNumMetadataAdded() - metadata_count;
+  }
+};
+
+TEST_F(ParquetFileAppendRefreshTest, UnchangedFile) {
+  writeFile({1, 2, 3, 4, 5}, 1);
+  createTable(2);
+  assertValues({1, 2, 3, 4, 5});
+
+  // Only metadata of the last fragment is cached again
+  ASSERT_EQ(size_t(1), refreshAndGetMetadataAddedCount());
+  assertValues({1, 2, 3, 4, 5});
+  ASSERT_TRUE(does_cache_contain_chunks(cat_, default_name, {{1, 0}, {1, 1}, {1, 2}}));
+}
+
+TEST_F(ParquetFileAppendRefreshTest, ModifiedTimeChangeOnly) {
+  writeFile({1, 2, 3, 4, 5}, 1);
+  createTable(2);
+  assertValues({1, 2, 3, 4, 5});
+
+  // Same content, so the footer hash of the scanned row groups is unchanged
+  writeFile({1, 2, 3, 4, 5}, 1);
+  bf::last_write_time(getFilePath(), bf::last_write_time(getFilePath()) + 10);
+  ASSERT_EQ(size_t(1), refreshAndGetMetadataAddedCount());
+  assertValues({1, 2, 3, 4, 5});
+  ASSERT_TRUE(does_cache_contain_chunks(cat_, default_name, {{1, 0}, {1, 1}, {1, 2}}));
+}
+
+TEST_F(ParquetFileAppendRefreshTest, AppendedRowGroups) {
+  writeFile({1, 2, 3, 4, 5}, 1);
+  createTable(2);
+  assertValues({1, 2, 3, 4, 5});
+
+  writeFile({1, 2, 3, 4, 5, 6, 7, 8}, 1);
+  size_t chunk_count = cache_->getNumChunksAdded();
+  // Only the new row groups are scanned, so only the last and new fragments change
+  ASSERT_EQ(size_t(2), refreshAndGetMetadataAddedCount());
+  ASSERT_EQ(size_t(1), cache_->getNumChunksAdded() - chunk_count);
+  ASSERT_TRUE(does_cache_contain_chunks(cat_, default_name, {{1, 0}, {1, 1}, {1, 2}}));
+  assertValues({1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+TEST_F(ParquetFileAppendRefreshTest, RewrittenFile) {
+  writeFile({1, 2, 3, 4, 5}, 1);
+  createTable(2);
+  assertValues({1, 2, 3, 4, 5});
+
+  // Different row groups change the footer hash, so the whole file is scanned again
+  writeFile({10, 20, 30, 40, 50, 60}, 2);
+  ASSERT_EQ(size_t(3), refreshAndGetMetadataAddedCount());
+  // Chunks of all previously loaded fragments are replaced
+  assertValues({10, 20, 30, 40, 50, 60});
+  ASSERT_TRUE(does_cache_contain_chunks(cat_, default_name, {{1, 0}, {1, 1}, {1, 2}}));
+}
+
+TEST_F(ParquetFileAppendRefreshTest, RewrittenFileWithoutDiskCache) {
+  resetPersistentStorageMgr(DiskCacheLevel::none);
+  writeFile({1, 2, 3, 4, 5}, 1);
+  createTable(2);
+  assertValues({1, 2, 3, 4, 5});
+
+  writeFile({10, 20, 30, 40, 50, 60}, 2);
+  sql("REFRESH FOREIGN TABLES " + default_name + ";");
+  // In memory chunks of all fragments are evicted, not only those of the last fragment
+  assertValues({10, 20, 30, 40, 50, 60});
+}
+
 // Test that string dictionaries are populated correctly after an append
 class StringDictAppendTest : public AppendRefreshTest {};
 
@@ -3330,6 +3593,103 @@ TEST_P(RowGroupAndFragmentSizeSelectQueryTest, Filter) {
   assertResultSetEqual({{i(5), i(7), i(10), -1.}, {i(6), i(8), i(1), -100.}}, result);
 }
 
+TEST_P(RowGroupAndFragmentSizeSelectQueryTest, FilterOnlyMatchingFragmentsProjected) {
+  auto param = GetParam();
+  int64_t row_group_size = param.first;
+  int64_t fragment_size = param.second;
+  std::stringstream filename_stream;
+  filename_stream << "example_row_group_size." << row_group_size;
+  const auto& query =
+      getCreateForeignTableQuery("(a BIGINT, b BIGINT, c BIGINT, d DOUBLE)",
+                                 {{"fragment_size", std::to_string(fragment_size)}},
+                                 filename_stream.str(),
+                                 "parquet");
+  sql(query);
+  setExecuteMode(TExecuteMode::CPU);
+
+  // Projected columns which are not part of the filter are loaded after the kernel ran,
+  // and only for fragments with matching rows.
+  {
+    TQueryResult result;
+    sql(result, "SELECT a, d FROM test_foreign_table WHERE c < b;");
+    assertResultSetEqual({{i(6), -100.}}, result);
+
+    // Comparing two columns cannot be pruned by fragment statistics, so every fragment
+    // is scanned, but only the one holding the last row has its projected columns loaded.
+    auto cache = getCatalog().getDataMgr().getPersistentStorageMgr()->getDiskCache();
+    ASSERT_NE(cache, nullptr);
+    const int64_t row_count{6};
+    const int matching_fragment_id = (row_count - 1) / fragment_size;
+    for (int fragment_id = 0; fragment_id < row_count / fragment_size; fragment_id++) {
+      auto chunk_key = [&](const int column_id) {
+        return getChunkKeyFromTable(
+            getCatalog(), "test_foreign_table", {column_id, fragment_id});
+      };
+      EXPECT_NE(cache->getCachedChunkIfExists(chunk_key(2)), nullptr);
+      EXPECT_NE(cache->getCachedChunkIfExists(chunk_key(3)), nullptr);
+      const bool matching = (fragment_id == matching_fragment_id);
+      EXPECT_EQ(cache->getCachedChunkIfExists(chunk_key(1)) != nullptr, matching)
+          << "fragment " << fragment_id;
+      EXPECT_EQ(cache->getCachedChunkIfExists(chunk_key(4)) != nullptr, matching)
+          << "fragment " << fragment_id;
+    }
+  }
+  {
+    TQueryResult result;
+    sql(result, "SELECT a, d FROM test_foreign_table WHERE b = 8;");
+    assertResultSetEqual({{i(6), -100.}}, result);
+  }
+  {
+    TQueryResult result;
+    sql(result, "SELECT a, d FROM test_foreign_table WHERE b > 8;");
+    assertResultSetEqual({}, result);
+  }
+  {
+    TQueryResult result;
+    sql(result, "SELECT a, c, d FROM test_foreign_table WHERE b IN (3, 7);");
+    assertResultSetEqual({{i(1), i(6), 7.1}, {i(5), i(10), -1.}}, result);
+  }
+}
+
+TEST_P(RowGroupAndFragmentSizeSelectQueryTest, FilterPrunedByRowGroupStats) {
+  auto param = GetParam();
+  int64_t row_group_size = param.first;
+  int64_t fragment_size = param.second;
+  std::stringstream filename_stream;
+  filename_stream << "example_row_group_size." << row_group_size;
+  const auto& query =
+      getCreateForeignTableQuery("(a BIGINT, b BIGINT, c BIGINT, d DOUBLE)",
+                                 {{"fragment_size", std::to_string(fragment_size)}},
+                                 filename_stream.str(),
+                                 "parquet");
+  sql(query);
+
+  {
+    TQueryResult result;
+    sql(result, "SELECT a FROM test_foreign_table WHERE c = 5;");
+    assertResultSetEqual({}, result);
+  }
+  {
+    TQueryResult result;
+    sql(result, "SELECT a FROM test_foreign_table WHERE c < 2;");
+    assertResultSetEqual({{i(6)}}, result);
+  }
+
+  // The last fragment holds c values 10 and 1, so its chunk metadata covers 5. Only
+  // separate row groups rule it out.
+  auto td = getCatalog().getMetadataForTable("test_foreign_table", false);
+  auto cd = getCatalog().getMetadataForColumn(td->tableId, "c");
+  ChunkKey table_key{getCatalog().getCurrentDB().dbId, td->tableId};
+  const int last_fragment_id = 6 / fragment_size - 1;
+  auto foreign_storage_mgr =
+      getCatalog().getDataMgr().getPersistentStorageMgr()->getForeignStorageMgr();
+  EXPECT_EQ(row_group_size > 1,
+            foreign_storage_mgr->fragmentMayMatch(
+                table_key, last_fragment_id, {{cd->columnId, kEQ, 5}}));
+  EXPECT_TRUE(foreign_storage_mgr->fragmentMayMatch(
+      table_key, last_fragment_id, {{cd->columnId, kEQ, 1}}));
+}
+
 using namespace foreign_storage;
 class ForeignStorageCacheQueryTest : public ForeignTableTest {
  protected:
@@ -14,11 +14,15 @@
  * limitations under the License.
  */
 
+#include "Geospatial/RTree.h"
 #include "Geospatial/Types.h"
 #include "Tests/TestHelpers.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 using namespace Geospatial;
 
 namespace {
@@ -306,6 +310,66 @@ TEST(GeoMisc, Inequality) {
                GeoMultiPolygon(sample_mpoly.wkt));
 }
 
+TEST(GeoRTree, Empty) {
+  StrRTree rtree({});
+  ASSERT_EQ(rtree.size(), size_t(0));
+  ASSERT_TRUE(rtree.query({-1.0, -1.0, 1.0, 1.0}).empty());
+
+  StrRTree rtree_of_empty_boxes({{BoundingBox::empty(), 0}});
+  ASSERT_EQ(rtree_of_empty_boxes.size(), size_t(0));
+}
+
+TEST(GeoRTree, Query) {
+  // Unit squares on a 10 x 10 grid
+  std::vector<std::pair<BoundingBox, int64_t>> entries;
+  for (int x = 0; x < 10; x++) {
+    for (int y = 0; y < 10; y++) {
+      entries.emplace_back(BoundingBox{x * 2.0, y * 2.0, x * 2.0 + 1, y * 2.0 + 1},
+                           x * 10 + y);
+    }
+  }
+  StrRTree rtree(entries, 4);
+  ASSERT_EQ(rtree.size(), entries.size());
+  ASSERT_GT(rtree.height(), size_t(2));
+
+  auto ids = rtree.query({2.5, 2.5, 4.5, 4.5});
+  std::sort(ids.begin(), ids.end());
+  ASSERT_EQ(ids, (std::vector<int64_t>{11, 12, 21, 22}));
+  ASSERT_TRUE(rtree.query({1.5, 1.5, 1.75, 1.75}).empty());
+  ASSERT_TRUE(rtree.query({-2.0, -2.0, -1.0, -1.0}).empty());
+  // Touching boxes intersect
+  ASSERT_EQ(rtree.query({-1.0, -1.0, 0.0, 0.0}), std::vector<int64_t>{0});
+  ASSERT_EQ(rtree.query(BoundingBox{1.5, 1.5, 1.75, 1.75}.expand(0.5)).size(), size_t(4));
+  ASSERT_EQ(rtree.query({-100.0, -100.0, 100.0, 100.0}).size(), entries.size());
+}
+
+TEST(GeoRTree, MatchesScan) {
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<double> coord(-180.0, 180.0);
+  std::uniform_real_distribution<double> extent(0.0, 10.0);
+  std::vector<std::pair<BoundingBox, int64_t>> entries;
+  for (int64_t id = 0; id < 1000; id++) {
+    const auto x = coord(gen);
+    const auto y = coord(gen);
+    entries.emplace_back(BoundingBox{x, y, x + extent(gen), y + extent(gen)}, id);
+  }
+  StrRTree rtree(entries);
+  for (size_t i = 0; i < 100; i++) {
+    const auto x = coord(gen);
+    const auto y = coord(gen);
+    const BoundingBox box{x, y, x + extent(gen) * 3, y + extent(gen) * 3};
+    std::vector<int64_t> expected_ids;
+    for (const auto& [entry_box, id] : entries) {
+      if (entry_box.intersects(box)) {
+        expected_ids.emplace_back(id);
+      }
+    }
+    auto ids = rtree.query(box);
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(ids, expected_ids);
+  }
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
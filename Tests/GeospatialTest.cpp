@@ -1537,6 +1537,12 @@ TEST(GeoSpatial, Math) {
         v<int64_t>(run_simple_agg(
             R"(SELECT ST_DWithin(ST_GeogFromText('POINT(-118.4079 33.9434)', 4326), ST_GeogFromText('POINT(2.5559 49.0083)', 4326), 10000000.0);)",
             dt)));
+    // ... but not within 9000km
+    ASSERT_EQ(
+        static_cast<int64_t>(0),
+        v<int64_t>(run_simple_agg(
+            R"(SELECT ST_DWithin(ST_GeogFromText('POINT(-118.4079 33.9434)', 4326), ST_GeogFromText('POINT(2.5559 49.0083)', 4326), 9000000.0);)",
+            dt)));
     // TODO: ST_DWithin support for geographic paths, needs geodesic
     // ST_Distance(linestring)
 
@@ -1776,6 +1782,20 @@ TEST_F(GeoSpatialTempTables, Geos) {
             "FROM geospatial_test WHERE id = 2;",
             dt)),
         static_cast<double>(0.00001));
+    // ST_Intersection of every poly with the same literal, which is reused across rows
+    ASSERT_NEAR(
+        static_cast<double>(26.0),
+        v<double>(run_simple_agg(
+            "SELECT SUM(ST_Area(ST_Intersection(poly, 'POLYGON((1 1,3 1,3 3,1 3,1 1))'))) "
+            "FROM geospatial_test;",
+            dt)),
+        static_cast<double>(0.00001));
+    // ST_Intersection with a literal whose bounding box is disjoint from all polys
+    ASSERT_EQ(static_cast<int64_t>(g_num_rows),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM geospatial_test WHERE ST_IsEmpty(ST_Intersection("
+                  "poly, 'POLYGON((20 20,21 20,21 21,20 21,20 20))'));",
+                  dt)));
     // ST_Union with poly: MULTIPOLYGON (((2 1,3 1,3 3,1 3,1 2,0 3,0 0,3 0,2 1)))
     ASSERT_NEAR(static_cast<double>(8.0),
                 v<double>(run_simple_agg(
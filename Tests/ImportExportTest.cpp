@@ -17,6 +17,7 @@
 #include <Tests/TestHelpers.h>
 
 #include <algorithm>
+#include <fstream>
 #include <limits>
 #include <string>
 
@@ -396,6 +397,84 @@ TEST_F(ImportTestSkipHeader, Skip_Header) {
   EXPECT_TRUE(import_test_local("skip_header.txt", 1, 1.0));
 }
 
+class ImportTestConcurrentBlocks : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_NO_THROW(run_ddl_statement("drop table if exists block_import;"));
+    ASSERT_NO_THROW(run_ddl_statement(
+        "CREATE TABLE block_import (i INTEGER, t TEXT ENCODING NONE);"));
+  }
+
+  void TearDown() override {
+    ASSERT_NO_THROW(run_ddl_statement("drop table if exists block_import;"));
+    boost::filesystem::remove(file_path_);
+  }
+
+  // quoted text of each row, which varies in length and contains a line delimiter in
+  // every fifth row
+  static std::string getRowText(const size_t row_index) {
+    std::string text = "r" + std::to_string(row_index) + ", " +
+                       std::string(row_index % 23, 'x');
+    if (row_index % 5 == 0) {
+      text += "\n";
+    }
+    return text + "z";
+  }
+
+  // the last row is not terminated by a line delimiter
+  void writeFile(const size_t row_count) {
+    std::ofstream file(file_path_);
+    file << "i,t";
+    for (size_t row_index = 0; row_index < row_count; row_index++) {
+      file << "\n" << row_index << ",\"" << getRowText(row_index) << "\"";
+    }
+  }
+
+  const std::string file_path_{"./block_import.csv"};
+};
+
+TEST_F(ImportTestConcurrentBlocks, RowsStraddlingBlocks) {
+  // a 16 byte buffer makes the file large enough to be read in blocks on two threads,
+  // with rows and quoted line delimiters straddling blocks
+  const size_t row_count = 500;
+  writeFile(row_count);
+  ASSERT_NO_THROW(run_ddl_statement(
+      "COPY block_import FROM '" + boost::filesystem::absolute(file_path_).string() +
+      "' WITH (header='true', quoted='true', buffer_size=16, threads=2);"));
+
+  auto rows = run_query("SELECT i, t FROM block_import ORDER BY i;");
+  ASSERT_EQ(row_count, rows->rowCount());
+  for (size_t row_index = 0; row_index < row_count; row_index++) {
+    const auto row = rows->getNextRow(true, true);
+    ASSERT_EQ(size_t(2), row.size());
+    ASSERT_EQ(int64_t(row_index), v<int64_t>(row[0]));
+    const auto text = v<NullableString>(row[1]);
+    const auto text_str = boost::get<std::string>(&text);
+    ASSERT_TRUE(text_str);
+    ASSERT_EQ(getRowText(row_index), *text_str);
+  }
+}
+
+TEST_F(ImportTestConcurrentBlocks, RowTooLong) {
+  SKIP_ALL_ON_AGGREGATOR();  // global variable not available on leaf nodes
+  const auto max_buffer_resize = import_export::delimited_parser::get_max_buffer_resize();
+  import_export::delimited_parser::set_max_buffer_resize(32);
+  ScopeGuard reset_max_buffer_resize = [max_buffer_resize] {
+    import_export::delimited_parser::set_max_buffer_resize(max_buffer_resize);
+  };
+  {
+    std::ofstream file(file_path_);
+    file << "i,t\n";
+    for (size_t row_index = 0; row_index < 50; row_index++) {
+      file << row_index << ",\"" << (row_index == 20 ? std::string(40, 'y') : "a")
+           << "\"\n";
+    }
+  }
+  EXPECT_ANY_THROW(run_ddl_statement(
+      "COPY block_import FROM '" + boost::filesystem::absolute(file_path_).string() +
+      "' WITH (header='true', quoted='true', buffer_size=16, threads=2);"));
+}
+
 const char* create_table_mini_sort = R"(
   CREATE TABLE sortab(
     i int,
@@ -1194,6 +1273,10 @@ TEST_F(ImportTest, One_gz_file) {
   EXPECT_TRUE(import_test_local("trip_data_9.gz", 100, 1.0));
 }
 
+TEST_F(ImportTest, One_bgzf_file) {
+  EXPECT_TRUE(import_test_local("trip_data_9_bgzf.gz", 100, 1.0));
+}
+
 TEST_F(ImportTest, One_bz2_file) {
   EXPECT_TRUE(import_test_local("trip_data_9.bz2", 100, 1.0));
 }
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file MetricsTest.cpp
+ * @brief Test suite for the metrics registry and its Prometheus text serialization
+ */
+
+#include <gtest/gtest.h>
+
+#include "Shared/Metrics.h"
+#include "TestHelpers.h"
+
+namespace {
+
+bool contains(const std::string& text, const std::string& line) {
+  return text.find(line) != std::string::npos;
+}
+
+}  // namespace
+
+TEST(Metrics, Counter) {
+  auto& registry = metrics::Registry::instance();
+  auto& cpu_hits = registry.counter("test_hits_total", "Test hits.", {{"level", "cpu"}});
+  auto& gpu_hits = registry.counter("test_hits_total", "Test hits.", {{"level", "gpu"}});
+  cpu_hits.increment();
+  cpu_hits.increment(2);
+  gpu_hits.increment();
+  EXPECT_EQ(&cpu_hits,
+            &registry.counter("test_hits_total", "Test hits.", {{"level", "cpu"}}));
+
+  const auto text = registry.toPrometheusText();
+  EXPECT_TRUE(contains(text, "# HELP test_hits_total Test hits.\n"));
+  EXPECT_TRUE(contains(text, "# TYPE test_hits_total counter\n"));
+  EXPECT_TRUE(contains(text, "test_hits_total{level=\"cpu\"} 3\n"));
+  EXPECT_TRUE(contains(text, "test_hits_total{level=\"gpu\"} 1\n"));
+}
+
+TEST(Metrics, Gauge) {
+  auto& registry = metrics::Registry::instance();
+  auto& depth = registry.gauge("test_queue_depth", "Test queue depth.");
+  depth.add(5);
+  depth.sub(2);
+  EXPECT_EQ(3, depth.value());
+  EXPECT_TRUE(contains(registry.toPrometheusText(), "test_queue_depth 3\n"));
+}
+
+TEST(Metrics, Histogram) {
+  auto& registry = metrics::Registry::instance();
+  auto& latency = registry.histogram(
+      "test_latency_seconds", "Test latency.", {{"op", "a\"b"}}, {0.25, 1});
+  latency.observe(0.125);
+  latency.observe(0.25);
+  latency.observe(0.5);
+  latency.observe(2);
+
+  const auto text = registry.toPrometheusText();
+  EXPECT_TRUE(contains(text, "# TYPE test_latency_seconds histogram\n"));
+  EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{op=\"a\\\"b\",le=\"0.25\"} 2\n"));
+  EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{op=\"a\\\"b\",le=\"1\"} 3\n"));
+  EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{op=\"a\\\"b\",le=\"+Inf\"} 4\n"));
+  EXPECT_TRUE(contains(text, "test_latency_seconds_sum{op=\"a\\\"b\"} 2.875\n"));
+  EXPECT_TRUE(contains(text, "test_latency_seconds_count{op=\"a\\\"b\"} 4\n"));
+}
+
+TEST(Metrics, TypeMismatch) {
+  auto& registry = metrics::Registry::instance();
+  registry.counter("test_type_mismatch", "Test type mismatch.");
+  EXPECT_THROW(registry.gauge("test_type_mismatch", "Test type mismatch."),
+               std::runtime_error);
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
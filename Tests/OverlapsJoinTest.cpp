@@ -20,6 +20,7 @@
 #include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "QueryEngine/ArrowResultSet.h"
 #include "QueryEngine/Execute.h"
@@ -78,7 +79,8 @@ const auto cleanup_stmts = {
     R"(drop table if exists does_intersect_b;)",
     R"(drop table if exists does_not_intersect_a;)",
     R"(drop table if exists does_not_intersect_b;)",
-    R"(drop table if exists empty_table;)"
+    R"(drop table if exists empty_table;)",
+    R"(drop table if exists geog_points;)"
 };
 
 // clang-format off
@@ -107,7 +109,8 @@ const auto init_stmts_ddl = {
                            poly geometry(polygon, 4326),
                            mpoly geometry(multipolygon, 4326),
                            pt geometry(point, 4326));
-    )"
+    )",
+    R"(create table geog_points (id int, pt geography(point, 4326));)"
 };
 
 const auto init_stmts_dml = {
@@ -164,7 +167,12 @@ const auto init_stmts_dml = {
               'polygon((2 2,2 4,4 2,4 4,2 2))',
               'multipolygon(((2 2,2 4,4 2,4 4,2 2)))',
               'point(2 2)');
-    )"
+    )",
+    R"(insert into geog_points values (0, 'point(2.3522 48.8566)');)",
+    R"(insert into geog_points values (1, 'point(-0.1276 51.5072)');)",
+    R"(insert into geog_points values (2, 'point(-74.006 40.7128)');)",
+    R"(insert into geog_points values (3, 'point(179.9 0)');)",
+    R"(insert into geog_points values (4, 'point(-179.9 0)');)"
 };
 // clang-format on
 
@@ -427,6 +435,94 @@ TEST_F(OverlapsTest, EmptyPolyPolyJoin) {
   });
 }
 
+// Runs a distance join count query from an empty hash table cache and checks that the
+// join was executed with an overlaps hash table when those are enabled
+void assertDistanceJoinCount(const std::string& sql,
+                             const int64_t expected,
+                             const ExecutorDeviceType dt) {
+  OverlapsJoinHashTable::getCacheInvalidator()();
+  ASSERT_EQ(expected, v<int64_t>(execSQL(sql, dt))) << sql;
+  if (g_enable_overlaps_hashjoin) {
+    ASSERT_GT(OverlapsJoinHashTable::getCombinedHashTableCacheSize(), size_t(0)) << sql;
+  }
+}
+
+TEST_F(OverlapsTest, PointPointDistanceJoin) {
+  executeAllScenarios([](ExecutorDeviceType dt) -> void {
+    for (const auto& [distance, expected] : std::vector<std::pair<std::string, int64_t>>{
+             {"1", 2}, {"10", 3}, {"20", 4}, {"8.48", 2}, {"8.49", 3}}) {
+      assertDistanceJoinCount(
+          "SELECT count(*) FROM does_intersect_a as a JOIN does_intersect_b as b "
+          "ON ST_DWithin(a.pt, b.pt, " +
+              distance + ");",
+          expected,
+          dt);
+      assertDistanceJoinCount(
+          "SELECT count(*) FROM does_intersect_a as a JOIN does_intersect_b as b "
+          "ON ST_DWithin(b.pt, a.pt, " +
+              distance + ");",
+          expected,
+          dt);
+      assertDistanceJoinCount(
+          "SELECT count(*) FROM does_intersect_a as a JOIN does_intersect_b as b "
+          "ON ST_Distance(a.pt, b.pt) < " +
+              distance + ";",
+          expected,
+          dt);
+    }
+  });
+}
+
+TEST_F(OverlapsTest, PointPointDistanceJoinCache) {
+  executeAllScenarios([](ExecutorDeviceType dt) -> void {
+    if (!g_enable_overlaps_hashjoin) {
+      return;
+    }
+    // the hash tables for different distances must not be shared
+    OverlapsJoinHashTable::getCacheInvalidator()();
+    size_t cache_size{0};
+    for (const auto& [distance, expected] : std::vector<std::pair<std::string, int64_t>>{
+             {"1", 2}, {"10", 3}, {"8.48", 2}}) {
+      ASSERT_EQ(expected,
+                v<int64_t>(execSQL("SELECT count(*) FROM does_intersect_a as a "
+                                   "JOIN does_intersect_b as b "
+                                   "ON ST_DWithin(a.pt, b.pt, " +
+                                       distance + ");",
+                                   dt)))
+          << distance;
+      const auto new_cache_size = OverlapsJoinHashTable::getCombinedHashTableCacheSize();
+      ASSERT_GT(new_cache_size, cache_size) << distance;
+      cache_size = new_cache_size;
+    }
+  });
+}
+
+TEST_F(OverlapsTest, GeodesicPointPointDistanceJoin) {
+  executeAllScenarios([](ExecutorDeviceType dt) -> void {
+    // Paris - London is ~344km, New York is ~5570km from London and ~5840km from Paris,
+    // and the points on both sides of the antimeridian are ~22km apart
+    for (const auto& [distance, expected] : std::vector<std::pair<std::string, int64_t>>{
+             {"1000", 5},
+             {"30000", 7},
+             {"300000", 7},
+             {"400000", 9},
+             {"6000000", 13}}) {
+      assertDistanceJoinCount(
+          "SELECT count(*) FROM geog_points as a JOIN geog_points as b "
+          "ON ST_DWithin(a.pt, b.pt, " +
+              distance + ");",
+          expected,
+          dt);
+      assertDistanceJoinCount(
+          "SELECT count(*) FROM geog_points as a JOIN geog_points as b "
+          "ON ST_Distance(a.pt, b.pt) <= " +
+              distance + ";",
+          expected,
+          dt);
+    }
+  });
+}
+
 class OverlapsJoinHashTableMock : public OverlapsJoinHashTable {
  public:
   struct ExpectedValues {
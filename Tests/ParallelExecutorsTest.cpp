@@ -18,12 +18,15 @@
 
 #include "Logger/Logger.h"
 
+#include "../LockMgr/LockMgr.h"
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "../QueryEngine/Execute.h"
 #include "../QueryRunner/QueryRunner.h"
 
 #include <array>
+#include <chrono>
 #include <future>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -599,6 +602,118 @@ TEST_F(UpdateDeleteTestEnv, UpdateDelete_TwoTables) {
   }
 }
 
+TEST_F(UpdateDeleteTestEnv, Update_DisjointFragments) {
+  const size_t iterations = 5;
+  const size_t num_writers = 4;
+  const size_t fragment_size = 10;
+  QR::get()->resizeDispatchQueue(g_max_num_executors);
+
+  run_ddl_statement("DROP TABLE IF EXISTS test_parallel_fragments;");
+  run_ddl_statement(
+      "CREATE TABLE test_parallel_fragments (i INT, v INT) WITH (fragment_size = " +
+      std::to_string(fragment_size) + ");");
+  for (size_t i = 0; i < num_writers * fragment_size; i++) {
+    QR::get()->runSQL(
+        "INSERT INTO test_parallel_fragments VALUES(" + std::to_string(i) + ", 0);",
+        ExecutorDeviceType::CPU);
+  }
+
+  for (size_t i = 0; i < iterations; i++) {
+    std::vector<std::future<void>> worker_threads;
+    // every writer updates the rows of its own fragment
+    for (size_t j = 0; j < num_writers; j++) {
+      worker_threads.push_back(std::async(std::launch::async, [i, j, fragment_size]() {
+        QR::get()->runSQL("UPDATE test_parallel_fragments SET v = " +
+                              std::to_string(i + j) + " WHERE i >= " +
+                              std::to_string(j * fragment_size) + " AND i < " +
+                              std::to_string((j + 1) * fragment_size) + ";",
+                          ExecutorDeviceType::CPU);
+      }));
+    }
+    for (auto& t : worker_threads) {
+      t.get();
+    }
+    for (size_t j = 0; j < num_writers; j++) {
+      EXPECT_EQ(int64_t(fragment_size),
+                v<int64_t>(run_simple_agg(
+                    "SELECT COUNT(*) FROM test_parallel_fragments WHERE v = " +
+                        std::to_string(i + j) + " AND i >= " +
+                        std::to_string(j * fragment_size) + " AND i < " +
+                        std::to_string((j + 1) * fragment_size) + ";",
+                    ExecutorDeviceType::CPU)));
+    }
+  }
+
+  if (!g_keep_data) {
+    run_ddl_statement("DROP TABLE IF EXISTS test_parallel_fragments;");
+  }
+}
+
+TEST_F(UpdateDeleteTestEnv, Update_FragmentLocks) {
+  const size_t fragment_size = 10;
+  QR::get()->resizeDispatchQueue(g_max_num_executors);
+
+  run_ddl_statement("DROP TABLE IF EXISTS test_fragment_locks;");
+  run_ddl_statement(
+      "CREATE TABLE test_fragment_locks (i INT, v INT) WITH (fragment_size = " +
+      std::to_string(fragment_size) + ");");
+  for (size_t i = 0; i < 2 * fragment_size; i++) {
+    QR::get()->runSQL(
+        "INSERT INTO test_fragment_locks VALUES(" + std::to_string(i) + ", 0);",
+        ExecutorDeviceType::CPU);
+  }
+  const auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable("test_fragment_locks");
+  ASSERT_TRUE(td);
+
+  auto update_fragment = [fragment_size](const size_t fragment_id, const int v) {
+    return std::async(std::launch::async, [fragment_size, fragment_id, v]() {
+      QR::get()->runSQL(
+          "UPDATE test_fragment_locks SET v = " + std::to_string(v) + " WHERE i >= " +
+              std::to_string(fragment_id * fragment_size) + " AND i < " +
+              std::to_string((fragment_id + 1) * fragment_size) + ";",
+          ExecutorDeviceType::CPU);
+    });
+  };
+
+  // hold the lock of the first fragment, as a concurrent update of it would
+  std::optional<lockmgr::WriteLock> fragment_lock =
+      lockmgr::FragmentDataLockMgr::getWriteLockForFragment(
+          cat->getDatabaseId(), td->tableId, 0);
+
+  // an update of the other fragment does not wait for it
+  auto disjoint_update = update_fragment(1, 1);
+  ASSERT_EQ(disjoint_update.wait_for(std::chrono::seconds(60)),
+            std::future_status::ready);
+  disjoint_update.get();
+
+  // an update of the locked fragment waits until the lock is released
+  auto overlapping_update = update_fragment(0, 2);
+  EXPECT_EQ(overlapping_update.wait_for(std::chrono::milliseconds(500)),
+            std::future_status::timeout);
+  EXPECT_EQ(int64_t(0),
+            v<int64_t>(run_simple_agg(
+                "SELECT COUNT(*) FROM test_fragment_locks WHERE v = 2;",
+                ExecutorDeviceType::CPU)));
+  fragment_lock.reset();
+  overlapping_update.get();
+
+  EXPECT_EQ(int64_t(fragment_size),
+            v<int64_t>(run_simple_agg(
+                "SELECT COUNT(*) FROM test_fragment_locks WHERE v = 1 AND i >= " +
+                    std::to_string(fragment_size) + ";",
+                ExecutorDeviceType::CPU)));
+  EXPECT_EQ(int64_t(fragment_size),
+            v<int64_t>(run_simple_agg(
+                "SELECT COUNT(*) FROM test_fragment_locks WHERE v = 2 AND i < " +
+                    std::to_string(fragment_size) + ";",
+                ExecutorDeviceType::CPU)));
+
+  if (!g_keep_data) {
+    run_ddl_statement("DROP TABLE IF EXISTS test_fragment_locks;");
+  }
+}
+
 int main(int argc, char* argv[]) {
   g_is_test_env = true;
 
@@ -82,6 +82,21 @@ TEST(CPU_MODE, ForceToCPUMode) {
   QR::get()->runDDLStatement(drop_table_ddl);
 }
 
+TEST(DISK_CACHE, BypassHint) {
+  const auto create_table_ddl = "CREATE TABLE SQL_HINT_DUMMY(key int)";
+  const auto drop_table_ddl = "DROP TABLE IF EXISTS SQL_HINT_DUMMY";
+  QR::get()->runDDLStatement(drop_table_ddl);
+  QR::get()->runDDLStatement(create_table_ddl);
+  ScopeGuard cleanup = [&] { QR::get()->runDDLStatement(drop_table_ddl); };
+
+  auto query_hints =
+      QR::get()->getParsedQueryHint("SELECT /*+ disk_cache_bypass */ * FROM SQL_HINT_DUMMY");
+  EXPECT_TRUE(query_hints.isHintRegistered("disk_cache_bypass"));
+  EXPECT_TRUE(query_hints.disk_cache_bypass);
+  query_hints = QR::get()->getParsedQueryHint("SELECT * FROM SQL_HINT_DUMMY");
+  EXPECT_FALSE(query_hints.isHintRegistered("disk_cache_bypass"));
+}
+
 TEST(OVERLAPS_JOIN_PARAM, Check_Overlaps_Join_Hint) {
   const auto overlaps_join_status_backup = g_enable_overlaps_hashjoin;
   g_enable_overlaps_hashjoin = true;
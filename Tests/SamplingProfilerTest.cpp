@@ -0,0 +1,240 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file SamplingProfilerTest.cpp
+ * @brief Test suite for the query tagged sampling profiler
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include "Shared/SamplingProfiler.h"
+#include "TestHelpers.h"
+
+namespace {
+
+const std::string profiles_dir{"./tmp/sampling_profiler_test"};
+
+// keeps the CPU busy for the given time, so that the profiling timer fires
+__attribute__((noinline)) double spin(const std::chrono::milliseconds duration) {
+  volatile double acc = 0;
+  const auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end) {
+    for (int i = 0; i < 1000; ++i) {
+      acc = acc + i * 0.5;
+    }
+  }
+  return acc;
+}
+
+struct FoldedStack {
+  std::vector<std::string> frames;
+  uint64_t count;
+};
+
+std::vector<FoldedStack> parse_folded_stacks(const std::string& folded_stacks) {
+  std::vector<FoldedStack> stacks;
+  std::istringstream iss(folded_stacks);
+  std::string line;
+  while (std::getline(iss, line)) {
+    const auto count_pos = line.rfind(' ');
+    EXPECT_NE(count_pos, std::string::npos) << line;
+    if (count_pos == std::string::npos) {
+      continue;
+    }
+    FoldedStack stack;
+    boost::split(stack.frames, line.substr(0, count_pos), boost::is_any_of(";"));
+    stack.count = std::stoull(line.substr(count_pos + 1));
+    stacks.push_back(stack);
+  }
+  return stacks;
+}
+
+uint64_t total_samples(const std::vector<FoldedStack>& stacks) {
+  uint64_t total{0};
+  for (const auto& stack : stacks) {
+    total += stack.count;
+  }
+  return total;
+}
+
+class SamplingProfilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { boost::filesystem::remove_all(profiles_dir); }
+
+  void TearDown() override {
+    profiler::SamplingProfiler::stop();
+    boost::filesystem::remove_all(profiles_dir);
+  }
+};
+
+}  // namespace
+
+TEST_F(SamplingProfilerTest, StartStop) {
+  EXPECT_THROW(profiler::SamplingProfiler::start(0, profiles_dir), std::runtime_error);
+  EXPECT_FALSE(profiler::SamplingProfiler::isRunning());
+
+  profiler::SamplingProfiler::start(1000, profiles_dir);
+  EXPECT_TRUE(profiler::SamplingProfiler::isRunning());
+  EXPECT_TRUE(boost::filesystem::is_directory(profiles_dir));
+  // starting again is a no-op
+  profiler::SamplingProfiler::start(1000, profiles_dir);
+  EXPECT_TRUE(profiler::SamplingProfiler::isRunning());
+
+  profiler::SamplingProfiler::stop();
+  EXPECT_FALSE(profiler::SamplingProfiler::isRunning());
+  profiler::SamplingProfiler::stop();
+
+  // restarts after being stopped
+  profiler::SamplingProfiler::start(1000, profiles_dir);
+  EXPECT_TRUE(profiler::SamplingProfiler::isRunning());
+}
+
+TEST_F(SamplingProfilerTest, AggregatedOutput) {
+  constexpr uint64_t query_id{1001};
+  constexpr uint64_t other_query_id{1002};
+  profiler::SamplingProfiler::start(1000, profiles_dir);
+  {
+    profiler::QueryScope query_scope(query_id);
+    profiler::PhaseScope phase_scope(profiler::Phase::kKernel);
+    EXPECT_EQ(profiler::current_tag().query_id, query_id);
+    EXPECT_EQ(profiler::current_tag().phase, profiler::Phase::kKernel);
+    spin(std::chrono::milliseconds(500));
+  }
+  EXPECT_EQ(profiler::current_tag().query_id, uint64_t(0));
+  // untagged work is not attributed to any query
+  spin(std::chrono::milliseconds(100));
+
+  const auto stacks =
+      parse_folded_stacks(profiler::SamplingProfiler::getFoldedStacks(query_id));
+  ASSERT_FALSE(stacks.empty());
+  EXPECT_GT(total_samples(stacks), uint64_t(0));
+  for (const auto& stack : stacks) {
+    ASSERT_GE(stack.frames.size(), size_t(2));
+    // the phase comes first, followed by the frames from the outermost one
+    EXPECT_EQ(stack.frames.front(), "kernel");
+    for (const auto& frame : stack.frames) {
+      EXPECT_FALSE(frame.empty());
+    }
+  }
+  EXPECT_TRUE(profiler::SamplingProfiler::getFoldedStacks(other_query_id).empty());
+
+  // flushing writes out the aggregated stacks and drops them, on the collector thread
+  // which stopping waits for
+  const auto folded_stacks = profiler::SamplingProfiler::getFoldedStacks(query_id);
+  profiler::SamplingProfiler::flushQuery(query_id);
+  profiler::SamplingProfiler::stop();
+  const auto profile_path = boost::filesystem::path(profiles_dir) /
+                            ("query_" + std::to_string(query_id) + ".folded");
+  ASSERT_TRUE(boost::filesystem::exists(profile_path));
+  std::ifstream profile_file(profile_path.string());
+  std::stringstream profile;
+  profile << profile_file.rdbuf();
+  EXPECT_EQ(total_samples(parse_folded_stacks(profile.str())),
+            total_samples(parse_folded_stacks(folded_stacks)));
+  EXPECT_TRUE(profiler::SamplingProfiler::getFoldedStacks(query_id).empty());
+}
+
+TEST_F(SamplingProfilerTest, ThreadTag) {
+  constexpr uint64_t query_id{1003};
+  profiler::SamplingProfiler::start(1000, profiles_dir);
+  profiler::QueryTag tag;
+  {
+    profiler::QueryScope query_scope(query_id);
+    profiler::PhaseScope phase_scope(profiler::Phase::kFetch);
+    tag = profiler::current_tag();
+  }
+  std::thread worker([tag] {
+    profiler::ThreadTagScope thread_tag_scope(tag);
+    spin(std::chrono::milliseconds(500));
+  });
+  worker.join();
+
+  const auto stacks =
+      parse_folded_stacks(profiler::SamplingProfiler::getFoldedStacks(query_id));
+  ASSERT_FALSE(stacks.empty());
+  for (const auto& stack : stacks) {
+    EXPECT_EQ(stack.frames.front(), "fetch");
+  }
+}
+
+TEST_F(SamplingProfilerTest, ExecutionScope) {
+  constexpr uint64_t query_id{1004};
+  profiler::SamplingProfiler::start(1000, profiles_dir);
+  const auto profile_path = boost::filesystem::path(profiles_dir) /
+                            ("query_" + std::to_string(query_id) + ".folded");
+  {
+    profiler::ExecutionScope outer_scope(query_id);
+    EXPECT_EQ(profiler::current_tag().query_id, query_id);
+    {
+      // a nested entry point keeps the tag of the outer one and does not flush
+      profiler::ExecutionScope inner_scope(query_id + 1);
+      EXPECT_EQ(profiler::current_tag().query_id, query_id);
+      spin(std::chrono::milliseconds(500));
+    }
+    EXPECT_FALSE(boost::filesystem::exists(profile_path));
+  }
+  EXPECT_EQ(profiler::current_tag().query_id, uint64_t(0));
+  profiler::SamplingProfiler::stop();
+  EXPECT_TRUE(boost::filesystem::exists(profile_path));
+  EXPECT_TRUE(profiler::SamplingProfiler::getFoldedStacks(query_id).empty());
+}
+
+TEST_F(SamplingProfilerTest, LateSamplesDropped) {
+  constexpr uint64_t query_id{1006};
+  profiler::SamplingProfiler::start(1000, profiles_dir);
+  {
+    profiler::QueryScope query_scope(query_id);
+    spin(std::chrono::milliseconds(200));
+  }
+  profiler::SamplingProfiler::flushQuery(query_id);
+  // e.g. a thread spawned for the query which outlives it
+  std::thread worker([] {
+    profiler::QueryScope query_scope(query_id);
+    spin(std::chrono::milliseconds(500));
+  });
+  worker.join();
+  profiler::SamplingProfiler::stop();
+
+  const auto profile_path = boost::filesystem::path(profiles_dir) /
+                            ("query_" + std::to_string(query_id) + ".folded");
+  EXPECT_TRUE(boost::filesystem::exists(profile_path));
+  // the samples taken after the flush are not kept around for the query
+  EXPECT_TRUE(profiler::SamplingProfiler::getFoldedStacks(query_id).empty());
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
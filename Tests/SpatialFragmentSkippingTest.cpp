@@ -0,0 +1,161 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file SpatialFragmentSkippingTest.cpp
+ * @brief Test suite for skipping fragments outside spatial filters against constants
+ */
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "DBHandlerTestHelpers.h"
+#include "QueryEngine/FragmentSpatialIndex.h"
+#include "TestHelpers.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern bool g_enable_spatial_fragment_skipping;
+
+namespace {
+
+const std::string contains_query{
+    "SELECT COUNT(*) FROM spatial_skipping_test WHERE ST_Contains(ST_GeomFromText("
+    "'POLYGON((9 9, 12 9, 12 12, 9 12, 9 9))'), p);"};
+const std::string dwithin_query{
+    "SELECT COUNT(*) FROM spatial_skipping_test WHERE ST_DWithin(p, "
+    "ST_GeomFromText('POINT(20 20)'), 1.5);"};
+const std::string intersects_query{
+    "SELECT COUNT(*) FROM spatial_skipping_test WHERE ST_Intersects(poly, "
+    "ST_GeomFromText('POLYGON((0.25 0.25, 1.25 0.25, 1.25 1.25, 0.25 1.25, "
+    "0.25 0.25))'));"};
+
+}  // namespace
+
+class SpatialFragmentSkippingTest : public DBHandlerTestFixture {
+ protected:
+  void SetUp() override {
+    DBHandlerTestFixture::SetUp();
+    g_enable_spatial_fragment_skipping = true;
+    sql("DROP TABLE IF EXISTS spatial_skipping_test;");
+    sql("CREATE TABLE spatial_skipping_test (p GEOMETRY(POINT), poly "
+        "GEOMETRY(POLYGON)) WITH (fragment_size = 2);");
+    // Three fragments around (0, 0), (10, 10) and (20, 20)
+    for (const int offset : {0, 10, 20}) {
+      insertRow(offset, offset);
+      insertRow(offset + 1, offset + 1);
+    }
+  }
+
+  void TearDown() override {
+    sql("DROP TABLE IF EXISTS spatial_skipping_test;");
+    g_enable_spatial_fragment_skipping = false;
+    DBHandlerTestFixture::TearDown();
+  }
+
+  void insertRow(const int x, const int y) {
+    const auto x0 = std::to_string(x);
+    const auto y0 = std::to_string(y);
+    const auto x1 = std::to_string(x + 0.5);
+    const auto y1 = std::to_string(y + 0.5);
+    sql("INSERT INTO spatial_skipping_test VALUES ('POINT(" + x0 + " " + y0 +
+        ")', 'POLYGON((" + x0 + " " + y0 + ", " + x1 + " " + y0 + ", " + x1 + " " + y1 +
+        ", " + x0 + " " + y1 + ", " + x0 + " " + y0 + "))');");
+  }
+
+  // Returns the number of fragments skipped by the first step of the query
+  size_t getSkippedFragmentCount(const std::string& query) {
+    TQueryResult result;
+    sql(result, "EXPLAIN ANALYZE " + query);
+    EXPECT_EQ(size_t(1), result.row_set.columns.size());
+    rapidjson::Document profile;
+    profile.Parse(result.row_set.columns[0].data.str_col[0].c_str());
+    EXPECT_FALSE(profile.HasParseError());
+    const auto& fragments = profile["steps"][0]["fragments"];
+    EXPECT_EQ(3u, fragments["total"].GetUint64());
+    return fragments["skipped"].GetUint64();
+  }
+
+  // Compares the result with and without spatial fragment skipping
+  void assertSkippedFragments(const std::string& query,
+                              const int64_t expected_count,
+                              const size_t expected_skipped_count) {
+    g_enable_spatial_fragment_skipping = false;
+    sqlAndCompareResult(query, {{i(expected_count)}});
+    EXPECT_EQ(size_t(0), getSkippedFragmentCount(query));
+
+    g_enable_spatial_fragment_skipping = true;
+    sqlAndCompareResult(query, {{i(expected_count)}});
+    EXPECT_EQ(expected_skipped_count, getSkippedFragmentCount(query));
+  }
+};
+
+TEST_F(SpatialFragmentSkippingTest, Contains) {
+  assertSkippedFragments(contains_query, 2, 2);
+}
+
+TEST_F(SpatialFragmentSkippingTest, DWithin) {
+  assertSkippedFragments(dwithin_query, 2, 2);
+}
+
+TEST_F(SpatialFragmentSkippingTest, Intersects) {
+  assertSkippedFragments(intersects_query, 2, 2);
+}
+
+TEST_F(SpatialFragmentSkippingTest, NoMatch) {
+  assertSkippedFragments(
+      "SELECT COUNT(*) FROM spatial_skipping_test WHERE ST_Contains(ST_GeomFromText("
+      "'POLYGON((50 50, 60 50, 60 60, 50 60, 50 50))'), p);",
+      0,
+      3);
+}
+
+TEST_F(SpatialFragmentSkippingTest, Truncate) {
+  sqlAndCompareResult(contains_query, {{i(2)}});
+  sql("TRUNCATE TABLE spatial_skipping_test;");
+  EXPECT_EQ(size_t(0), FragmentSpatialIndex::getNumCachedFragmentBounds());
+
+  // The fragments have the sizes of the truncated ones, but different bounds
+  for (const int offset : {20, 0, 10}) {
+    insertRow(offset, offset);
+    insertRow(offset + 1, offset + 1);
+  }
+  sqlAndCompareResult(contains_query, {{i(2)}});
+  sqlAndCompareResult(dwithin_query, {{i(2)}});
+}
+
+TEST_F(SpatialFragmentSkippingTest, Drop) {
+  sqlAndCompareResult(contains_query, {{i(2)}});
+  EXPECT_GT(FragmentSpatialIndex::getNumCachedFragmentBounds(), size_t(0));
+  sql("DROP TABLE spatial_skipping_test;");
+  EXPECT_EQ(size_t(0), FragmentSpatialIndex::getNumCachedFragmentBounds());
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  DBHandlerTestFixture::initTestArgs(argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
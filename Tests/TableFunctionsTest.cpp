@@ -257,6 +257,74 @@ TEST_F(TableFunctions, CallFailure) {
   }
 }
 
+TEST_F(TableFunctions, RowParallel) {
+  // large enough for the input rows to be split into ranges across threads
+  const int64_t num_rows = 1 << 17;
+  run_ddl_statement("DROP TABLE IF EXISTS tf_row_parallel_test;");
+  run_ddl_statement("CREATE TABLE tf_row_parallel_test (x BIGINT);");
+  run_multiple_agg("INSERT INTO tf_row_parallel_test VALUES (0);",
+                   ExecutorDeviceType::CPU);
+  for (int64_t row_count = 1; row_count < num_rows; row_count *= 2) {
+    run_multiple_agg("INSERT INTO tf_row_parallel_test SELECT x + " +
+                         std::to_string(row_count) + " FROM tf_row_parallel_test;",
+                     ExecutorDeviceType::CPU);
+  }
+
+  // the rows were inserted in increasing order of x, so the copies of the input row
+  // at position i have to be found at positions [i * copy_multiplier, (i + 1) *
+  // copy_multiplier) of the output, whichever thread produced them
+  for (const int64_t copy_multiplier : {1, 3}) {
+    const auto rows = run_multiple_agg(
+        "SELECT out0 FROM "
+        "TABLE(ct_row_parallel_copier(cursor(SELECT x FROM tf_row_parallel_test), " +
+            std::to_string(copy_multiplier) + "));",
+        ExecutorDeviceType::CPU);
+    ASSERT_EQ(rows->rowCount(), static_cast<size_t>(copy_multiplier * num_rows));
+    for (int64_t output_row_idx = 0; output_row_idx < copy_multiplier * num_rows;
+         output_row_idx++) {
+      const auto crt_row = rows->getNextRow(false, false);
+      ASSERT_EQ(TestHelpers::v<int64_t>(crt_row[0]), output_row_idx / copy_multiplier)
+          << "output row " << output_row_idx;
+    }
+  }
+  run_ddl_statement("DROP TABLE IF EXISTS tf_row_parallel_test;");
+}
+
+TEST_F(TableFunctions, TableFunctionSpecifiedOutputSize) {
+  {
+    const auto rows = run_multiple_agg(
+        "SELECT out0 FROM TABLE(ct_positive_filter(cursor(SELECT CAST(x AS BIGINT) - 2 "
+        "FROM tf_test))) ORDER BY out0;",
+        ExecutorDeviceType::CPU);
+    ASSERT_EQ(rows->rowCount(), size_t(2));
+    for (int64_t expected : {1, 2}) {
+      const auto crt_row = rows->getNextRow(false, false);
+      EXPECT_EQ(TestHelpers::v<int64_t>(crt_row[0]), expected);
+    }
+  }
+  {
+    const auto rows = run_multiple_agg(
+        "SELECT out0 FROM TABLE(ct_positive_filter(cursor(SELECT CAST(x AS BIGINT) - 10 "
+        "FROM tf_test)));",
+        ExecutorDeviceType::CPU);
+    ASSERT_EQ(rows->rowCount(), size_t(0));
+  }
+}
+
+TEST_F(TableFunctions, TableFunctionSpecifiedOutputSizeNotSet) {
+  EXPECT_THROW(run_multiple_agg("SELECT out0 FROM TABLE(ct_missing_output_size(cursor("
+                                "SELECT CAST(x AS BIGINT) FROM tf_test)));",
+                                ExecutorDeviceType::CPU),
+               std::runtime_error);
+
+  // the failed call leaves no output behind for the next table function
+  const auto rows = run_multiple_agg(
+      "SELECT out0 FROM TABLE(ct_positive_filter(cursor(SELECT CAST(x AS BIGINT) - 2 "
+      "FROM tf_test))) ORDER BY out0;",
+      ExecutorDeviceType::CPU);
+  ASSERT_EQ(rows->rowCount(), size_t(2));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
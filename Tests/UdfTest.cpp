@@ -91,6 +91,10 @@ std::string get_udf_ast_filename() {
   return udf_file_name_base + ".ast";
 }
 
+std::string get_udf_cache_key_filename() {
+  return get_udf_filename() + ".key";
+}
+
 bool skip_tests(const ExecutorDeviceType device_type) {
 #ifdef HAVE_CUDA
   return device_type == ExecutorDeviceType::GPU && !QR::get()->gpusPresent();
@@ -150,6 +154,11 @@ class SQLTestEnv : public ::testing::Environment {
       boost::filesystem::remove(udf_ast_file);
     }
 
+    boost::filesystem::path udf_cache_key_file(get_udf_cache_key_filename());
+    if (boost::filesystem::exists(udf_cache_key_file)) {
+      boost::filesystem::remove(udf_cache_key_file);
+    }
+
     QR::reset();
   }
 };
@@ -190,6 +199,34 @@ TEST_F(UDFCompilerTest, CompileTest) {
   // LOG(FATAL) which stops the process and does not return
 }
 
+TEST_F(UDFCompilerTest, CachedCompileTest) {
+  {
+    UdfCompiler compiler(getUdfFileName(), g_device_arch);
+    ASSERT_EQ(compiler.compileUdf(), 0);
+    ASSERT_EQ(compiler.getCacheKeyFileName(), get_udf_cache_key_filename());
+    ASSERT_TRUE(boost::filesystem::exists(compiler.getCacheKeyFileName()));
+  }
+
+  // an unchanged UDF file is not compiled again
+  const std::time_t compile_time = 0;
+  boost::filesystem::last_write_time(get_udf_cpu_ir_filename(), compile_time);
+  {
+    UdfCompiler compiler(getUdfFileName(), g_device_arch);
+    ASSERT_EQ(compiler.compileUdf(), 0);
+  }
+  EXPECT_EQ(boost::filesystem::last_write_time(get_udf_cpu_ir_filename()), compile_time);
+
+  // different compiler options invalidate the compiled files
+  {
+    UdfCompiler compiler(getUdfFileName(),
+                         g_device_arch,
+                         std::string(""),
+                         {std::string("-D UDF_COMPILER_OPTION")});
+    ASSERT_EQ(compiler.compileUdf(), 0);
+  }
+  EXPECT_NE(boost::filesystem::last_write_time(get_udf_cpu_ir_filename()), compile_time);
+}
+
 TEST_F(UDFCompilerTest, CompilerOptionTest) {
   UdfCompiler compiler(getUdfFileName(), g_device_arch);
   auto compile_result = compiler.compileUdf();
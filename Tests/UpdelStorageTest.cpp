@@ -978,6 +978,33 @@ TEST_F(UpdateStorageTest, Half_fixed_encoded_integer_passenger_count_x2_rollback
                                       4. * 1.0,
                                       false));
 }
+TEST_F(UpdateStorageTest, All_fixed_encoded_integer_passenger_count_x1_snapshot) {
+  UpdelRoll updelRoll;
+  std::vector<uint64_t> fragOffsets;
+  std::vector<ScalarTargetValue> rhsValues;
+  update_prepare_offsets_values<int64_t>(
+      UpdelTestConfig::fixNumRows, 1, 4 * 2, fragOffsets, rhsValues);
+  auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable("trips");
+  CHECK(td);
+  const auto cd = catalog->getMetadataForColumn(td->tableId, "passenger_count");
+  CHECK(cd);
+  td->fragmenter->updateColumn(catalog.get(),
+                               td,
+                               cd,
+                               0,
+                               fragOffsets,
+                               rhsValues,
+                               SQLTypeInfo(),
+                               Data_Namespace::MemoryLevel::CPU_LEVEL,
+                               updelRoll);
+  // queries see the last committed data until the update is published
+  EXPECT_TRUE(
+      compare_agg("trips", "passenger_count", UpdelTestConfig::fixNumRows, 4 * 1.0));
+  updelRoll.commitUpdate();
+  EXPECT_TRUE(
+      compare_agg("trips", "passenger_count", UpdelTestConfig::fixNumRows, 4 * 2.0));
+}
 
 TEST_F(UpdateStorageTest, All_int_trip_time_in_secs_x2) {
   EXPECT_TRUE(update_a_numeric_column(
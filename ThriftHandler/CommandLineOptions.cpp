@@ -47,6 +47,8 @@ extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
 extern size_t g_parallel_top_min;
 extern size_t g_parallel_top_max;
+extern bool g_enable_auto_vacuum;
+extern float g_vacuum_min_selectivity;
 
 namespace Catalog_Namespace {
 extern bool g_log_user_id;
@@ -155,6 +157,13 @@ void CommandLineOptions::fillOptions() {
                               ->implicit_value(true),
                           "Enable the overlaps hash join framework allowing for range "
                           "join (e.g. spatial overlaps) computation using a hash table.");
+  help_desc.add_options()(
+      "enable-spatial-fragment-skipping",
+      po::value<bool>(&g_enable_spatial_fragment_skipping)
+          ->default_value(g_enable_spatial_fragment_skipping)
+          ->implicit_value(true),
+      "Skip fragments whose geometries cannot pass spatial filters against constant "
+      "geometries, using an R-tree of the bounding boxes of the fragments.");
   help_desc.add_options()("enable-hashjoin-many-to-many",
                           po::value<bool>(&g_enable_hashjoin_many_to_many)
                               ->default_value(g_enable_hashjoin_many_to_many)
@@ -263,6 +272,27 @@ void CommandLineOptions::fillOptions() {
                           "Enable/disable inner join fragment skipping. This feature is "
                           "considered stable and is enabled by default. This "
                           "parameter will be removed in a future release.");
+  help_desc.add_options()(
+      "metrics-port",
+      po::value<int>(&metrics_port)->default_value(metrics_port),
+      "Port of the HTTP endpoint serving server metrics in the Prometheus text format "
+      "at /metrics. Disabled when 0.");
+  help_desc.add_options()("metrics-listen-address",
+                          po::value<std::string>(&metrics_listen_address)
+                              ->default_value(metrics_listen_address),
+                          "Address the metrics endpoint listens on.");
+  help_desc.add_options()(
+      "enable-sampling-profiler",
+      po::value<bool>(&enable_sampling_profiler)
+          ->default_value(enable_sampling_profiler)
+          ->implicit_value(true),
+      "Sample the stacks of threads running queries and write one folded stack profile "
+      "per query, tagged by execution phase, to mapd_log/query_profiles.");
+  help_desc.add_options()(
+      "sampling-profiler-frequency",
+      po::value<int>(&sampling_profiler_frequency)
+          ->default_value(sampling_profiler_frequency),
+      "Sampling frequency of the sampling profiler, in Hz.");
   help_desc.add_options()(
       "max-session-duration",
       po::value<int>(&max_session_duration)->default_value(max_session_duration),
@@ -359,6 +389,18 @@ void CommandLineOptions::fillOptions() {
       po::value<std::string>(&(disk_cache_level))->default_value("foreign_tables"),
       "Specify level of disk cache. Valid options are 'foreign_tables', "
       "'local_tables', 'none', and 'all'.");
+  help_desc.add_options()(
+      "disk-cache-size",
+      po::value<size_t>(&disk_cache_config.size_limit)
+          ->default_value(disk_cache_config.size_limit),
+      "Maximum size in bytes of the chunks held in the disk cache, 0 for no limit. "
+      "Once full, chunks are only cached at the expense of less frequently used ones.");
+  help_desc.add_options()(
+      "disk-cache-table-size",
+      po::value<size_t>(&disk_cache_config.table_size_limit)
+          ->default_value(disk_cache_config.table_size_limit),
+      "Maximum size in bytes of the chunks of any single table held in the disk cache, "
+      "0 for no limit.");
 
   help_desc.add_options()(
       "enable-interoperability",
@@ -704,6 +746,19 @@ void CommandLineOptions::fillAdvancedOptions() {
                                    ->default_value(g_enable_auto_metadata_update)
                                    ->implicit_value(true),
                                "Enable automatic metadata update.");
+  developer_desc.add_options()(
+      "enable-auto-vacuum",
+      po::value<bool>(&g_enable_auto_vacuum)
+          ->default_value(g_enable_auto_vacuum)
+          ->implicit_value(true),
+      "Enable automatic vacuuming of fragments after a delete. Only fragments with a "
+      "fraction of deleted rows of at least vacuum-min-selectivity are compacted.");
+  developer_desc.add_options()(
+      "vacuum-min-selectivity",
+      po::value<float>(&g_vacuum_min_selectivity)
+          ->default_value(g_vacuum_min_selectivity),
+      "Minimum fraction of deleted rows in a fragment (between 0 and 1) at which the "
+      "fragment is compacted when automatic vacuuming is enabled.");
   developer_desc.add_options()(
       "parallel-top-min",
       po::value<size_t>(&g_parallel_top_min)->default_value(g_parallel_top_min),
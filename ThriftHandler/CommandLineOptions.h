@@ -44,6 +44,10 @@ class CommandLineOptions {
     fillAdvancedOptions();
   }
   int http_port = 6278;
+  int metrics_port = 0;
+  std::string metrics_listen_address = "127.0.0.1";
+  bool enable_sampling_profiler = false;
+  int sampling_profiler_frequency = 99;
   size_t reserved_gpu_mem = 384 * 1024 * 1024;
   std::string base_path;
   DiskCacheConfig disk_cache_config;
@@ -160,6 +164,7 @@ extern bool g_enable_columnar_output;
 extern bool g_optimize_row_initialization;
 extern bool g_enable_overlaps_hashjoin;
 extern bool g_enable_hashjoin_many_to_many;
+extern bool g_enable_spatial_fragment_skipping;
 extern size_t g_overlaps_max_table_size_bytes;
 extern double g_overlaps_target_entries_per_bin;
 extern bool g_strip_join_covered_quals;
@@ -65,6 +65,7 @@
 #include "QueryEngine/TableOptimizer.h"
 #include "QueryEngine/ThriftSerializers.h"
 #include "Shared/ArrowUtil.h"
+#include "Shared/SamplingProfiler.h"
 #include "Shared/StringTransform.h"
 #include "Shared/import_helpers.h"
 #include "Shared/mapd_shared_mutex.h"
@@ -1162,6 +1163,7 @@ void DBHandler::convertData(TQueryResult& _return,
   if (result.empty()) {
     return;
   }
+  profiler::PhaseScope profiler_phase_scope(profiler::Phase::kSerialize);
 
   switch (result.getResultType()) {
     case ExecutionResult::QueryResult:
@@ -1208,6 +1210,7 @@ void DBHandler::sql_execute(TQueryResult& _return,
   stdlog.appendNameValuePairs("client", getConnectionInfo().toString());
   stdlog.appendNameValuePairs("nonce", nonce);
   auto timer = DEBUG_TIMER(__func__);
+  profiler::ExecutionScope profiler_execution_scope(query_state->getId());
   try {
     ScopeGuard reset_was_geo_copy_from = [this, &session_ptr] {
       geo_copy_from_sessions.remove(session_ptr->get_session_id());
@@ -1285,6 +1288,7 @@ void DBHandler::sql_execute(ExecutionResult& _return,
   auto query_state = create_query_state(session_ptr, actual_query);
   auto stdlog = STDLOG(session_ptr, query_state);
   auto timer = DEBUG_TIMER(__func__);
+  profiler::ExecutionScope profiler_execution_scope(query_state->getId());
 
   try {
     ScopeGuard reset_was_geo_copy_from = [this, &session_ptr] {
@@ -1370,6 +1374,7 @@ void DBHandler::sql_execute_df(TDataFrame& _return,
   auto session_ptr = get_session_ptr(session);
   auto query_state = create_query_state(session_ptr, query_str);
   auto stdlog = STDLOG(session_ptr, query_state);
+  profiler::ExecutionScope profiler_execution_scope(query_state->getId());
 
   if (device_type == TDeviceType::GPU) {
     const auto executor_device_type = session_ptr->get_executor_device_type();
@@ -1404,7 +1409,7 @@ void DBHandler::sql_execute_df(TDataFrame& _return,
         query_ra = result.plan_result;
       });
 
-      if (pw.isCalciteExplain()) {
+      if (pw.isCalciteExplain() || pw.isAnalyzeExplain()) {
         throw std::runtime_error("explain is not unsupported by current thrift API");
       }
       if (g_enable_runtime_query_interrupt) {
@@ -1502,6 +1507,7 @@ void DBHandler::sql_validate(TRowDescriptor& _return,
     stdlog.appendNameValuePairs("client", getConnectionInfo().toString());
     auto query_state = create_query_state(stdlog.getSessionInfo(), query_str);
     stdlog.setQueryState(query_state);
+    profiler::ExecutionScope profiler_execution_scope(query_state->getId());
 
     ParserWrapper pw{query_str};
     if ((pw.getExplainType() != ParserWrapper::ExplainType::None) || pw.is_ddl ||
@@ -5342,6 +5348,10 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
     const ExplainInfo& explain_info,
     const std::optional<size_t> executor_index) const {
   query_state::Timer timer = query_state_proxy.createTimer(__func__);
+  // runs on a dispatch queue worker, hence the query tag is set again here; work which
+  // is not covered by a narrower phase below counts as planning
+  profiler::QueryScope profiler_query_scope(query_state_proxy.getQueryState().getId());
+  profiler::PhaseScope profiler_phase_scope(profiler::Phase::kPlan);
 
   VLOG(1) << "Table Schema Locks:\n" << lockmgr::TableSchemaLockMgr::instance();
   VLOG(1) << "Table Data Locks:\n" << lockmgr::TableDataLockMgr::instance();
@@ -5356,6 +5366,9 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
                              cat,
                              query_ra,
                              query_state_proxy.getQueryState().shared_from_this());
+  if (explain_info.analyzeExplain()) {
+    ra_executor.enableQueryProfile();
+  }
   // handle hints
   const auto& query_hints = ra_executor.getParsedQueryHints();
   const bool cpu_mode_enabled = query_hints.isHintRegistered("cpu_mode");
@@ -5397,6 +5410,12 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
   // reduce execution time by the time spent during queue waiting
   _return.setExecutionTime(execution_time_ms -= _return.getRows()->getQueueTime());
   VLOG(1) << cat.getDataMgr().getSystemMemoryUsage();
+  if (explain_info.analyzeExplain()) {
+    const auto query_profile = ra_executor.getQueryProfile();
+    CHECK(query_profile);
+    _return.updateResultSet(query_profile->toJson(), ExecutionResult::Explaination);
+    return {};
+  }
   const auto& filter_push_down_info = _return.getPushedDownFilterInfo();
   if (!filter_push_down_info.empty()) {
     return filter_push_down_info;
@@ -5771,7 +5790,7 @@ void DBHandler::sql_execute_impl(ExecutionResult& _return,
               first_n,
               at_most_n,
               /*just_validate=*/false,
-              g_enable_filter_push_down && !g_cluster,
+              g_enable_filter_push_down && !g_cluster && !explain_info.analyzeExplain(),
               explain_info,
               executor_index);
           if (explain_info.justCalciteExplain() && filter_push_down_requests.empty()) {
@@ -6059,6 +6078,7 @@ std::pair<TPlanResult, lockmgr::LockedTableDescriptors> DBHandler::parse_to_ra(
     const SystemParameters& system_parameters,
     bool check_privileges) {
   query_state::Timer timer = query_state_proxy.createTimer(__func__);
+  profiler::PhaseScope profiler_phase_scope(profiler::Phase::kParse);
   ParserWrapper pw{query_str};
   const std::string actual_query{pw.isSelectExplain() ? pw.actual_query : query_str};
   TPlanResult result;
@@ -6129,11 +6149,13 @@ std::pair<TPlanResult, lockmgr::LockedTableDescriptors> DBHandler::parse_to_ra(
                 lockmgr::TableSchemaLockContainer<
                     lockmgr::ReadLock>::acquireTableDescriptor(*cat.get(), table)));
         if (write_only_tables.count(table)) {
-          // Aquire an insert data lock for updates/deletes, consistent w/ insert. The
-          // table data lock will be aquired in the fragmenter during checkpoint.
+          // Aquire a shared insert data lock for updates/deletes, which excludes inserts
+          // but not other updates/deletes. The fragments they change are write locked
+          // during execution, and the table data lock is aquired in the fragmenter to
+          // publish the changes.
           locks.emplace_back(
-              std::make_unique<lockmgr::TableInsertLockContainer<lockmgr::WriteLock>>(
-                  lockmgr::TableInsertLockContainer<lockmgr::WriteLock>::acquire(
+              std::make_unique<lockmgr::TableInsertLockContainer<lockmgr::ReadLock>>(
+                  lockmgr::TableInsertLockContainer<lockmgr::ReadLock>::acquire(
                       cat->getDatabaseId(), (*locks.back())())));
         } else {
           locks.emplace_back(
@@ -15,6 +15,7 @@ public class OmniSciHintStrategyTable {
             .hintStrategy("overlaps_bucket_threshold", HintPredicates.SET_VAR)
             .hintStrategy("overlaps_max_size", HintPredicates.SET_VAR)
             .hintStrategy("overlaps_allow_gpu_build", HintPredicates.SET_VAR)
+            .hintStrategy("disk_cache_bypass", HintPredicates.SET_VAR)
             .build();
   }
 }
@@ -55,6 +55,13 @@ class TExtArgumentType(object):
     TextEncodingDict8 = 35
     TextEncodingDict16 = 36
     TextEncodingDict32 = 37
+    ColumnListInt8 = 38
+    ColumnListInt16 = 39
+    ColumnListInt32 = 40
+    ColumnListInt64 = 41
+    ColumnListFloat = 42
+    ColumnListDouble = 43
+    ColumnListBool = 44
 
     _VALUES_TO_NAMES = {
         0: "Int8",
@@ -95,6 +102,13 @@ class TExtArgumentType(object):
         35: "TextEncodingDict8",
         36: "TextEncodingDict16",
         37: "TextEncodingDict32",
+        38: "ColumnListInt8",
+        39: "ColumnListInt16",
+        40: "ColumnListInt32",
+        41: "ColumnListInt64",
+        42: "ColumnListFloat",
+        43: "ColumnListDouble",
+        44: "ColumnListBool",
     }
 
     _NAMES_TO_VALUES = {
@@ -136,6 +150,13 @@ class TExtArgumentType(object):
         "TextEncodingDict8": 35,
         "TextEncodingDict16": 36,
         "TextEncodingDict32": 37,
+        "ColumnListInt8": 38,
+        "ColumnListInt16": 39,
+        "ColumnListInt32": 40,
+        "ColumnListInt64": 41,
+        "ColumnListFloat": 42,
+        "ColumnListDouble": 43,
+        "ColumnListBool": 44,
     }
 
 
@@ -143,17 +164,20 @@ class TOutputBufferSizeType(object):
     kConstant = 0
     kUserSpecifiedConstantParameter = 1
     kUserSpecifiedRowMultiplier = 2
+    kTableFunctionSpecifiedParameter = 3
 
     _VALUES_TO_NAMES = {
         0: "kConstant",
         1: "kUserSpecifiedConstantParameter",
         2: "kUserSpecifiedRowMultiplier",
+        3: "kTableFunctionSpecifiedParameter",
     }
 
     _NAMES_TO_VALUES = {
         "kConstant": 0,
         "kUserSpecifiedConstantParameter": 1,
         "kUserSpecifiedRowMultiplier": 2,
+        "kTableFunctionSpecifiedParameter": 3,
     }
 
 